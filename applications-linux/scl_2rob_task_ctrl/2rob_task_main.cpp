@@ -106,6 +106,8 @@ bool addCallbacks()
   bool flag = sutil::callbacks::add<scl::CCallbackHelp, std::string, std::vector<std::string> >(std::string("help") );
   flag = flag && sutil::callbacks::add<scl::CCallbackEcho, std::string, std::vector<std::string> >(std::string("echo") );
   flag = flag && sutil::callbacks::add<scl::CCallbackPrint, std::string, std::vector<std::string> >(std::string("print") );
+  flag = flag && sutil::callbacks::add<scl::CCallbackPerf, std::string, std::vector<std::string> >(std::string("perf") );
+  flag = flag && sutil::callbacks::add<scl::CCallbackXmlCache, std::string, std::vector<std::string> >(std::string("xmlcache") );
   flag = flag && scl::printableAddObject<scl::SDatabase>(*scl::CDatabase::getData());
   return flag;
 }
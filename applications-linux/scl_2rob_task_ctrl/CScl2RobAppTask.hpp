@@ -242,6 +242,10 @@ namespace scl_app
           flag = robot[i].setControllerCurrent(ctrl_name[i]);
           if(false == flag) { throw(std::runtime_error("Could not initialize robot's controller"));  }
 
+          //Don't integrate a robot that is holding still
+          flag = robot[i].setFlagSleep(true);
+          if(false == flag) { throw(std::runtime_error("Could not turn on sleeping for the robot"));  }
+
           /**********************Initialize Single Control Task *******************/
           flag = initMyController(argc,argv,i);
           if(false == flag)
@@ -283,6 +287,11 @@ namespace scl_app
     std::cout<<"\nTotal Simulated Time : "<<sutil::CSystemClock::getSimTime() <<" sec";
     std::cout<<"\nTotal Control Model and Servo Updates : "<<ctrl_ctr;
     std::cout<<"\nTotal Graphics Updates                : "<<gr_ctr;
+    for(int i=0; i<2; ++i)
+    {
+      std::cout<<"\nRobot "<<robot_name[i]<<" slept for "<<robot[i].getTicksAsleep()
+          <<" ticks ("<<robot[i].getNumSleeps()<<" times)";
+    }
 
     /******************************Termination************************************/
     bool flag = chai_gr.destroyGraphics();
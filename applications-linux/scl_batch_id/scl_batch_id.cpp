@@ -0,0 +1,90 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+/* \file scl_batch_id.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+//scl headers used
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl_ext/dynamics/scl_spatial/CInverseDynamicsBatch.hpp>
+
+//Standard includes
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <stdlib.h>
+
+/** Computes the generalized forces a recorded trajectory needed, with
+ * inverse dynamics on all cores (see scl_ext::CInverseDynamicsBatch).
+ *
+ * Reads a binary log (eg. from CRobot::setLogFile) with q, dq and ddq
+ * columns, and writes a binary log with the forces (row i for row i).
+ * Use scl_log_convert to turn the output into csv. */
+int main(int argc, char** argv)
+{
+  if(5 > argc)
+  {
+    std::cout<<"\nscl_batch_id : Computes inverse dynamics for every row of a binary robot log."
+        <<"\nThe command line input is: ./<executable> <config_file> <robot_name> <log_in> <log_out>"
+        <<"\n      <optional : -chunk rows (default 16384)> <optional : -threads n>\n";
+    return 0;
+  }
+
+  try
+  {
+    const std::string file(argv[1]), robot_name(argv[2]), file_in(argv[3]), file_out(argv[4]);
+    unsigned int n_chunk = 16384, n_threads = 0;
+
+    for(int i=5; i<argc; ++i)
+    {
+      const std::string a(argv[i]);
+      const int n_left = argc - i - 1;
+      if(a == "-chunk" && n_left >= 1) { n_chunk = static_cast<unsigned int>(atoi(argv[++i])); }
+      else if(a == "-threads" && n_left >= 1) { n_threads = static_cast<unsigned int>(atoi(argv[++i])); }
+      else { throw(std::runtime_error(std::string("Unknown (or incomplete) option : ")+a)); }
+    }
+
+    scl::SDatabase * db = scl::CDatabase::getData();
+    if(S_NULL==db) { throw(std::runtime_error("Database not initialized."));  }
+
+    scl::CParserScl parser;
+    const scl::SRobotParsed *rob_ds = scl_registry::parseRobot(file, robot_name, &parser);
+    if(S_NULL == rob_ds)
+    { throw(std::runtime_error(std::string("Could not parse robot : ")+robot_name+" in "+file)); }
+
+    scl_ext::CInverseDynamicsBatch id;
+    if(false == id.init(*rob_ds, n_threads))
+    { throw(std::runtime_error("Could not initialize the inverse dynamics")); }
+
+    std::cout<<"\nscl_batch_id : "<<robot_name<<" ("<<id.getDof()<<" dof) on "
+        <<id.getNumThreads()<<" threads. Processing "<<file_in<<std::flush;
+
+    scl_ext::SIdBatchStats stats;
+    if(false == id.processLog(file_in, file_out, n_chunk, &stats))
+    { throw(std::runtime_error(std::string("Could not process : ")+file_in)); }
+
+    std::cout<<"\nscl_batch_id : "<<stats.rows_<<" rows in "<<stats.t_total_<<"s ("
+        <<stats.rate()<<"/s; "<<stats.t_compute_<<"s computing). Saved "<<file_out<<"\n";
+  }
+  catch(std::exception& e)
+  {
+    std::cout<<"\nscl_batch_id : ERROR : "<<e.what()<<"\n";
+    return 1;
+  }
+  return 0;
+}
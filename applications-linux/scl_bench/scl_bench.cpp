@@ -0,0 +1,634 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+/* \file scl_bench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+//scl headers used
+#include <scl/scl.hpp>
+#include <scl_ext/scl_ext.hpp>
+#include <scl/serialization/SerializationJSON.hpp>
+#include <scl/util/CPerfStats.hpp>
+
+//sutil clock.
+#include <sutil/CSystemClock.hpp>
+
+// 3rd party libs
+#include <Eigen/Dense>
+#include <jsoncpp/json/json.h>
+
+//Standard includes
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+#include <cmath>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+
+/** The command line options */
+class SBenchOptions{
+public:
+  std::string dir_specs_ = "../../specs/";
+  std::string file_out_ = "";      // Write the results here (json)
+  std::string file_baseline_ = ""; // Compare the results against this (json)
+  std::string file_load_ = "";     // Compare these results (json) instead of running the cases
+  std::string filter_ = "";        // Only run cases whose names contain this
+  double time_per_case_ = 0.25;    // Seconds of timed calls per case
+  double tolerance_ = 0.10;        // A p50 that grows by more than this fraction is a regression
+  bool flag_redis_ = true;
+};
+
+/** One case's result. All times are per call, in nanoseconds. */
+class SBenchResult{
+public:
+  std::string name_;
+  long long calls_ = 0;
+  double mean_ns_ = 0, p50_ns_ = 0, p99_ns_ = 0, min_ns_ = 0, max_ns_ = 0;
+};
+
+/** A robot the dynamics, parser and serialization cases are run on. */
+class SBenchRobot{
+public:
+  const char* file_;       //Relative to the specs dir
+  const char* name_;
+  const char* ctrl_;       //A multi-task controller in the file (NULL if none)
+};
+
+static const SBenchRobot bench_robots[] = {
+    {"Pendulums/PendCfg.xml", "Pend6", NULL},
+    {"Pendulums/PendCfg.xml", "Pend6x2", NULL},
+    {"Pendulums/PendCfg.xml", "Pend6x4", NULL},
+    {"Pendulums/PendCfg.xml", "Pend6x8", NULL},
+    {"Pendulums/PendCfg.xml", "Pend6x16", NULL},
+    {"Pendulums/PendCfg.xml", "Pend6x64", NULL},
+    {"Puma/PumaCfg.xml", "PumaBot", "opc"},
+    {"Barrett/wamCfg.xml", "wamBot", "opc"},
+    {"Stanbot/StanbotCfg.xml", "Stanbot", "opc"}
+};
+
+/** Whether the case passes the -filter option */
+bool isSelected(const std::string& arg_name, const SBenchOptions& arg_opt)
+{ return arg_opt.filter_.empty() || std::string::npos != arg_name.find(arg_opt.filter_); }
+
+/** Times a case and appends its result.
+ *
+ * The calls are timed in batches, and each batch is sized to take at
+ * least a few microseconds, so cheap calls aren't swamped by the clock's
+ * overhead. The percentiles are over the batches' per call times.
+ *
+ * Returns false if the case was filtered out or a call failed. */
+template <typename F>
+bool runCase(const std::string& arg_name, const SBenchOptions& arg_opt,
+    std::vector<SBenchResult>& ret_results, F arg_fn)
+{
+  if(false == isSelected(arg_name,arg_opt)) { return false; }
+
+  const long long t_budget = static_cast<long long>(arg_opt.time_per_case_*1e9);
+  const long long t_batch_min = 20000; //20us
+
+  // Warm up (caches, lazy allocations) and size the batches.
+  long long batch = 1, t0, dt;
+  while(true)
+  {
+    t0 = scl::CPerfStats::nowNs();
+    for(long long i=0; i<batch; ++i)
+    { if(false == arg_fn()) { std::cout<<"\n "<<arg_name<<" : FAILED"; return false; } }
+    dt = scl::CPerfStats::nowNs() - t0;
+    if(dt >= t_batch_min || dt*10 >= t_budget) { break; }
+    batch *= 2;
+  }
+
+  std::vector<double> samples;
+  long long t_total = 0;
+  while((t_total < t_budget || samples.size() < 5) && samples.size() < 100000)
+  {
+    t0 = scl::CPerfStats::nowNs();
+    for(long long i=0; i<batch; ++i) { arg_fn(); }
+    dt = scl::CPerfStats::nowNs() - t0;
+    t_total += dt;
+    samples.push_back(static_cast<double>(dt)/batch);
+  }
+  std::sort(samples.begin(), samples.end());
+
+  SBenchResult r;
+  r.name_ = arg_name;
+  r.calls_ = batch * static_cast<long long>(samples.size());
+  r.mean_ns_ = static_cast<double>(t_total) / r.calls_;
+  r.p50_ns_ = samples[samples.size()/2];
+  r.p99_ns_ = samples[(samples.size()*99)/100];
+  r.min_ns_ = samples.front();
+  r.max_ns_ = samples.back();
+  ret_results.push_back(r);
+
+  std::cout<<"\n "<<std::left<<std::setw(44)<<arg_name<<std::right
+      <<std::setw(12)<<r.p50_ns_<<std::setw(12)<<r.p99_ns_
+      <<std::setw(12)<<r.mean_ns_<<std::setw(12)<<r.calls_<<std::flush;
+  return true;
+}
+
+/** Dynamics engines, controller ticks, parsing and serialization for one robot */
+void runRobotCases(const SBenchRobot& arg_rb, const SBenchOptions& arg_opt,
+    std::vector<SBenchResult>& ret_results)
+{
+  const std::string file = arg_opt.dir_specs_ + arg_rb.file_;
+  const std::string pre = std::string("::") + arg_rb.name_ + "::";
+
+  scl::CParserScl p;
+  scl::SRobotParsed rds;
+  scl::SGcModel rgcm;
+  scl::SRobotIO rio;
+  scl::CDynamicsScl dyn_scl;
+  scl_ext::CDynamicsSclSpatial dyn_sp;
+
+  bool flag = p.readRobotFromFile(file,arg_opt.dir_specs_,arg_rb.name_,rds);
+  flag = flag && rgcm.init(rds);
+  flag = flag && rio.init(rds);
+  flag = flag && dyn_scl.init(rds);
+  flag = flag && dyn_sp.init(rds);
+  if(false == flag)
+  { std::cout<<"\n Skipping "<<arg_rb.name_<<" : Could not initialize it from "<<file; return; }
+
+  // A fixed (non-singular) state, so runs are comparable.
+  const Eigen::VectorXd::Index dof = rio.dof_;
+  Eigen::VectorXd q0(dof), dq0(dof), ddq(dof), fgc(dof);
+  for(Eigen::VectorXd::Index i=0; i<dof; ++i)
+  { q0(i) = 0.3*std::sin(0.7*i+0.1); dq0(i) = 0.2*std::cos(1.3*i); }
+  rio.sensors_.q_ = q0; rio.sensors_.dq_ = dq0;
+  rio.sensors_.ddq_.setZero(dof);
+  rio.actuators_.force_gc_commanded_.setZero(dof);
+
+  // The link farthest down the tree (the most expensive Jacobian)
+  const scl::SRigidBodyDyn* link_last = S_NULL;
+  for(auto it = rgcm.rbdyn_tree_.begin(); it!=rgcm.rbdyn_tree_.end(); ++it)
+  {
+    if(it->link_ds_->is_root_) { continue; }
+    if(S_NULL == link_last || it->link_ds_->link_id_ > link_last->link_ds_->link_id_)
+    { link_last = &(*it); }
+  }
+  Eigen::MatrixXd J;
+
+  /** ********************** Parser ********************** */
+  runCase("parser"+pre+"readRobotFromFile", arg_opt, ret_results, [&]() {
+    scl::CParserScl p2; scl::SRobotParsed rds2;
+    return p2.readRobotFromFile(file,arg_opt.dir_specs_,arg_rb.name_,rds2); });
+
+  /** ********************** Dynamics ********************** */
+  runCase("dyn::scl"+pre+"gc_model", arg_opt, ret_results, [&]() {
+    return dyn_scl.computeGCModel(&rio.sensors_,&rgcm); });
+
+  if(S_NULL != link_last)
+  {
+    runCase("dyn::scl"+pre+"jacobian", arg_opt, ret_results, [&]() {
+      return dyn_scl.computeJacobian(J,*link_last,rio.sensors_.q_,Eigen::Vector3d::Zero()); });
+  }
+
+  // The spatial algorithms use the transforms from the gc model.
+  dyn_scl.computeGCModel(&rio.sensors_,&rgcm);
+
+  runCase("dyn::sclspatial"+pre+"fwd_crba", arg_opt, ret_results, [&]() {
+    return dyn_sp.forwardDynamicsCRBA(&rio,&rgcm,ddq); });
+
+  runCase("dyn::sclspatial"+pre+"fwd_aba", arg_opt, ret_results, [&]() {
+    return dyn_sp.forwardDynamicsABA(&rio,&rgcm,ddq); });
+
+  runCase("dyn::sclspatial"+pre+"inv_rnea", arg_opt, ret_results, [&]() {
+    return dyn_sp.inverseDynamicsNER(&rio,&rgcm,fgc); });
+
+  runCase("dyn::sclspatial"+pre+"integrate", arg_opt, ret_results, [&]() {
+    // Restart from the same state so the robot doesn't drift off
+    rio.sensors_.q_ = q0; rio.sensors_.dq_ = dq0;
+    return dyn_sp.integrate(rgcm,rio,0.001); });
+  rio.sensors_.q_ = q0; rio.sensors_.dq_ = dq0;
+
+  /** ********************** Serialization ********************** */
+  std::string str;
+  runCase("json"+pre+"serialize", arg_opt, ret_results, [&]() {
+    return scl::serializeToJSONString(rds,str,true); });
+
+  runCase("json"+pre+"deserialize", arg_opt, ret_results, [&]() {
+    scl::SRobotParsed rds2;
+    return scl::deserializeFromJSONString(rds2,str); });
+
+  /** ********************** Controller ********************** */
+  if(S_NULL == arg_rb.ctrl_) { return; }
+  if(false == isSelected("ctrl"+pre+"model",arg_opt) && false == isSelected("ctrl"+pre+"servo",arg_opt)
+      && false == isSelected("ctrl"+pre+"tick",arg_opt))
+  { return; } //Don't pay for the controller's init if none of its cases will run
+
+  scl::SCmdLineOptions_OneRobot rcmd;
+  rcmd.name_file_config_ = file;
+  rcmd.name_robot_ = arg_rb.name_;
+  rcmd.name_ctrl_ = arg_rb.ctrl_;
+
+  scl::CParserScl pc;
+  scl::SRobotParsed rds_c;
+  scl::SRobotIO rio_c;
+  scl::SGcModel rgcm_c;
+  scl::CDynamicsScl dyn_c;
+  scl::SControllerMultiTask rctr_ds;
+  scl::CControllerMultiTask rctr;
+  std::vector<scl::STaskBase*> rtasks;
+  std::vector<scl::SNonControlTaskBase*> rtasks_nc;
+  std::vector<scl::sString2> ctrl_params;
+
+  flag = scl::init::parseAndInitRobotAndController(pc, rcmd, rds_c, rio_c, rgcm_c, dyn_c,
+      rctr_ds, rctr, rtasks, rtasks_nc, ctrl_params);
+  if(false == flag)
+  { std::cout<<"\n Skipping ctrl"<<pre<<" : Could not initialize controller "<<arg_rb.ctrl_; return; }
+  rio_c.sensors_.q_ = q0; rio_c.sensors_.dq_ = dq0;
+  rctr.computeDynamics();
+
+  runCase("ctrl"+pre+"model", arg_opt, ret_results, [&]() {
+    return rctr.computeDynamics(); });
+
+  runCase("ctrl"+pre+"servo", arg_opt, ret_results, [&]() {
+    return rctr.computeControlForces(); });
+
+  runCase("ctrl"+pre+"tick", arg_opt, ret_results, [&]() {
+    return rctr.computeDynamics() && rctr.computeControlForces(); });
+}
+
+/** The analytic dynamics engine only supports the RPP bot */
+void runAnalyticCases(const SBenchOptions& arg_opt, std::vector<SBenchResult>& ret_results)
+{
+  const std::string file = arg_opt.dir_specs_ + "Bot-RPP/Bot-RPPCfg.xml";
+  scl::CParserScl p;
+  scl::SRobotParsed rds;
+  scl::SGcModel rgcm;
+  scl::SRobotIO rio;
+  scl::CDynamicsScl dyn_scl;
+  scl::CDynamicsAnalyticRPP dyn_rpp;
+
+  bool flag = p.readRobotFromFile(file,arg_opt.dir_specs_,"rppbot",rds);
+  flag = flag && rgcm.init(rds);
+  flag = flag && rio.init(rds);
+  flag = flag && dyn_scl.init(rds);
+  flag = flag && dyn_rpp.init(rds);
+  if(false == flag)
+  { std::cout<<"\n Skipping rppbot : Could not initialize it from "<<file; return; }
+
+  rio.sensors_.q_<<0.3, -0.2, 0.1;
+  Eigen::MatrixXd M, J;
+
+  runCase("dyn::analytic_rpp::rppbot::mgc", arg_opt, ret_results, [&]() {
+    return dyn_rpp.computeMgc(rio.sensors_.q_,M); });
+
+  runCase("dyn::analytic_rpp::rppbot::jcom", arg_opt, ret_results, [&]() {
+    return dyn_rpp.computeJcom(rio.sensors_.q_,2,J); });
+
+  // For comparison (the same quantities through the generic engine)
+  runCase("dyn::scl::rppbot::gc_model", arg_opt, ret_results, [&]() {
+    return dyn_scl.computeGCModel(&rio.sensors_,&rgcm); });
+}
+
+/** Redis (needs a local server) and shared memory round trips */
+void runIOCases(const SBenchOptions& arg_opt, std::vector<SBenchResult>& ret_results)
+{
+  Eigen::VectorXd v(7), v_ret(7);
+  v<<0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7;
+
+  scl::CIOShm ioshm;
+  scl::SIOShm ioshm_ds;
+  ioshm_ds.name_ = "/scl_bench";
+  if(ioshm.connect(ioshm_ds))
+  {
+    runCase("io::shm::set_vec7", arg_opt, ret_results, [&]() {
+      return ioshm.set(ioshm_ds,"scl::bench::vec",v); });
+    runCase("io::shm::get_vec7", arg_opt, ret_results, [&]() {
+      return ioshm.get(ioshm_ds,"scl::bench::vec",v_ret); });
+    ioshm.unlink(ioshm_ds);
+    ioshm.disconnect(ioshm_ds);
+  }
+  else { std::cout<<"\n Skipping io::shm : Could not map shared memory"; }
+
+  if(false == arg_opt.flag_redis_) { return; }
+  scl::CIORedis ioredis;
+  scl::SIORedis ioredis_ds;
+  if(false == ioredis.connect(ioredis_ds,true))
+  { std::cout<<"\n Skipping io::redis : No server at "<<ioredis_ds.hostname_<<":"<<ioredis_ds.port_; return; }
+
+  runCase("io::redis::set_vec7", arg_opt, ret_results, [&]() {
+    return ioredis.set(ioredis_ds,"scl::bench::vec",v); });
+  runCase("io::redis::get_vec7", arg_opt, ret_results, [&]() {
+    return ioredis.get(ioredis_ds,"scl::bench::vec",v_ret); });
+
+  ioredis_ds.reply_ = (redisReply *)redisCommand(ioredis_ds.context_, "DEL scl::bench::vec");
+  freeReplyObject((void*)ioredis_ds.reply_);
+}
+
+/** A 1kHz "simulator" thread. Sends arg_n samples of {q, dq, fgc}, either
+ * as packed pub/sub messages (scl_redis_sim -pub) or as keys followed by a
+ * {seq, publish time} key (what a poller watches). */
+void publishState(const int arg_n, const bool arg_flag_pub)
+{
+  scl::CIORedis io;
+  scl::SIORedis ds;
+  if(false == io.connect(ds)) { return; }
+
+  Eigen::VectorXd q(7), dq(7), fgc(7), seq(2);
+  q.setConstant(0.1); dq.setConstant(0.2); fgc.setConstant(0.3);
+  const Eigen::VectorXd* const vecs[3] = {&q, &dq, &fgc};
+
+  scl::CLoopScheduler sched;
+  sched.init(0.001);
+  for(int i=0; i<arg_n; ++i)
+  {
+    q(0) = i;
+    if(arg_flag_pub)
+    { io.publish(ds, "scl::bench::state", vecs, 3, i); }
+    else
+    {
+      io.set(ds, "scl::bench::q", q); io.set(ds, "scl::bench::dq", dq); io.set(ds, "scl::bench::fgc", fgc);
+      seq(0) = i; seq(1) = static_cast<double>(scl::CPerfStats::nowNs());
+      io.set(ds, "scl::bench::seq", seq);
+    }
+    sched.waitForNextTick();
+  }
+  redisFree(ds.context_);
+}
+
+/** Thread cpu time. In nsec. */
+long long threadCpuNs()
+{
+  timespec t;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+  return t.tv_sec*1000000000LL + t.tv_nsec;
+}
+
+/** Sim -> controller state transport at 1kHz : pub/sub vs polling.
+ *
+ * The controller side either blocks in waitForMessage() (scl_redis_ctrl
+ * -sub) or spins on GETs (scl_redis_ctrl without it). Checks that each
+ * sample triggers exactly one update, and saves the publish to update
+ * latency. Prints the controller thread's cpu use for both. */
+void runPubSubCases(const SBenchOptions& arg_opt, std::vector<SBenchResult>& ret_results)
+{
+  const int n_msgs = 1000; // 1 sec at 1kHz
+  const char* names[2] = {"io::redis::pubsub_1khz::latency", "io::redis::poll_1khz::latency"};
+  scl::CIORedis io;
+
+  for(int mode=0; mode<2; ++mode)
+  {
+    if(false == isSelected(names[mode],arg_opt)) { continue; }
+    const bool flag_pub = (0 == mode);
+
+    scl::SIORedis ds;
+    if(false == io.connect(ds,true))
+    { std::cout<<"\n Skipping "<<names[mode]<<" : No server at "<<ds.hostname_<<":"<<ds.port_; return; }
+    if(flag_pub && false == io.subscribe(ds,"scl::bench::state"))
+    { std::cout<<"\n "<<names[mode]<<" : FAILED (Could not subscribe)"; redisFree(ds.context_); continue; }
+    if(false == flag_pub)
+    {// Don't pick up a stale sample
+      ds.reply_ = (redisReply *)redisCommand(ds.context_, "DEL scl::bench::seq");
+      freeReplyObject((void*)ds.reply_);
+    }
+
+    Eigen::VectorXd q(7), dq(7), fgc(7), seq(2);
+    Eigen::VectorXd* const vecs[3] = {&q, &dq, &fgc};
+    std::vector<double> latency;
+    latency.reserve(n_msgs);
+    long long n_updates = 0, n_polls = 0, n_out_of_order = 0, seq_last = -1, seq_new;
+
+    const long long t0 = scl::CPerfStats::nowNs(), t0_cpu = threadCpuNs();
+    std::thread pub(publishState, n_msgs, flag_pub);
+    while(seq_last < n_msgs-1)
+    {
+      if(flag_pub)
+      {
+        if(false == io.waitForMessage(ds, vecs, 3, seq_new, 1.0)) { break; }
+        latency.push_back(static_cast<double>(scl::CPerfStats::nowNs() - ds.msg_t_pub_ns_last_));
+      }
+      else
+      {
+        n_polls++;
+        if(false == io.get(ds, "scl::bench::seq", seq)) { continue; }
+        seq_new = static_cast<long long>(seq(0));
+        if(seq_new == seq_last) { continue; }
+        latency.push_back(static_cast<double>(scl::CPerfStats::nowNs()) - seq(1));
+        io.get(ds, "scl::bench::q", q); io.get(ds, "scl::bench::dq", dq); io.get(ds, "scl::bench::fgc", fgc);
+      }
+      // One "control update" per sample
+      n_updates++;
+      if(seq_new != seq_last+1) { n_out_of_order++; }
+      seq_last = seq_new;
+    }
+    const long long dt = scl::CPerfStats::nowNs() - t0, dt_cpu = threadCpuNs() - t0_cpu;
+    pub.join();
+    redisFree(ds.context_);
+
+    if(n_msgs != n_updates || 0 != n_out_of_order || (flag_pub && 0 != ds.msg_ctr_skipped_))
+    {
+      std::cout<<"\n "<<names[mode]<<" : FAILED ("<<n_updates<<" updates for "<<n_msgs
+          <<" samples. "<<n_out_of_order<<" out of order)";
+      continue;
+    }
+
+    std::sort(latency.begin(), latency.end());
+    SBenchResult r;
+    r.name_ = names[mode];
+    r.calls_ = n_updates;
+    r.mean_ns_ = 0; for(double l : latency) { r.mean_ns_ += l; } r.mean_ns_ /= latency.size();
+    r.p50_ns_ = latency[latency.size()/2];
+    r.p99_ns_ = latency[(latency.size()*99)/100];
+    r.min_ns_ = latency.front();
+    r.max_ns_ = latency.back();
+    ret_results.push_back(r);
+
+    std::cout<<"\n "<<std::left<<std::setw(44)<<r.name_<<std::right
+        <<std::setw(12)<<r.p50_ns_<<std::setw(12)<<r.p99_ns_
+        <<std::setw(12)<<r.mean_ns_<<std::setw(12)<<r.calls_
+        <<"   (ctrl cpu "<<std::fixed<<std::setprecision(1)<<100.0*dt_cpu/dt<<"%, "
+        <<dt_cpu/n_updates/1000<<" usec/update, "<<(flag_pub ? n_updates : n_polls)<<" "
+        <<(flag_pub ? "wakeups" : "polls")<<")"<<std::defaultfloat<<std::setprecision(6)<<std::flush;
+  }
+}
+
+/** Saves the results as json */
+bool writeResults(const std::string& arg_file, const SBenchOptions& arg_opt,
+    const std::vector<SBenchResult>& arg_results)
+{
+  Json::Value root, arr(Json::arrayValue);
+  char host[256] = "unknown";
+  gethostname(host,sizeof(host)-1);
+  root["host"] = host;
+  root["time_per_case"] = arg_opt.time_per_case_;
+#ifdef DEBUG
+  root["build"] = "debug";
+#else
+  root["build"] = "release";
+#endif
+  for(const SBenchResult& r : arg_results)
+  {
+    Json::Value c;
+    c["name"] = r.name_;
+    c["calls"] = static_cast<Json::Int64>(r.calls_);
+    c["mean_ns"] = r.mean_ns_;
+    c["p50_ns"] = r.p50_ns_;
+    c["p99_ns"] = r.p99_ns_;
+    c["min_ns"] = r.min_ns_;
+    c["max_ns"] = r.max_ns_;
+    arr.append(c);
+  }
+  root["results"] = arr;
+
+  std::ofstream f(arg_file.c_str());
+  if(false == f.is_open()) { return false; }
+  Json::StyledStreamWriter w;
+  w.write(f,root);
+  return f.good();
+}
+
+/** Reads results saved by writeResults() */
+bool readResults(const std::string& arg_file, std::vector<SBenchResult>& ret_results)
+{
+  std::ifstream f(arg_file.c_str());
+  if(false == f.is_open()) { return false; }
+  Json::Value root;
+  Json::Reader reader;
+  if(false == reader.parse(f,root,false) || false == root["results"].isArray()) { return false; }
+
+  ret_results.clear();
+  for(const Json::Value& c : root["results"])
+  {
+    SBenchResult r;
+    r.name_ = c["name"].asString();
+    r.calls_ = c["calls"].asInt64();
+    r.mean_ns_ = c["mean_ns"].asDouble();
+    r.p50_ns_ = c["p50_ns"].asDouble();
+    r.p99_ns_ = c["p99_ns"].asDouble();
+    r.min_ns_ = c["min_ns"].asDouble();
+    r.max_ns_ = c["max_ns"].asDouble();
+    ret_results.push_back(r);
+  }
+  return true;
+}
+
+/** Compares the p50s against a baseline. Returns the number of regressions. */
+int compareResults(const std::vector<SBenchResult>& arg_base,
+    const std::vector<SBenchResult>& arg_cur, const double arg_tol)
+{
+  int n_regressions = 0;
+  std::cout<<"\n\n "<<std::left<<std::setw(44)<<"case"<<std::right
+      <<std::setw(14)<<"base p50(ns)"<<std::setw(14)<<"p50(ns)"<<std::setw(10)<<"change";
+  for(const SBenchResult& c : arg_cur)
+  {
+    const SBenchResult* b = NULL;
+    for(const SBenchResult& tmp : arg_base) { if(tmp.name_ == c.name_) { b = &tmp; break; } }
+
+    std::cout<<"\n "<<std::left<<std::setw(44)<<c.name_<<std::right;
+    if(NULL == b || b->p50_ns_ <= 0) { std::cout<<std::setw(14)<<"-"<<std::setw(14)<<c.p50_ns_<<"   (new)"; continue; }
+
+    double change = c.p50_ns_/b->p50_ns_ - 1.0;
+    std::cout<<std::setw(14)<<b->p50_ns_<<std::setw(14)<<c.p50_ns_
+        <<std::setw(9)<<std::fixed<<std::setprecision(1)<<100*change<<"%"<<std::defaultfloat<<std::setprecision(6);
+    if(change > arg_tol) { std::cout<<"  REGRESSION"; n_regressions++; }
+    else if(change < -arg_tol) { std::cout<<"  faster"; }
+  }
+  for(const SBenchResult& b : arg_base)
+  {
+    bool found = false;
+    for(const SBenchResult& c : arg_cur) { if(c.name_ == b.name_) { found = true; break; } }
+    if(false == found) { std::cout<<"\n "<<std::left<<std::setw(44)<<b.name_<<std::right<<"   (not run)"; }
+  }
+  std::cout<<"\n\n "<<n_regressions<<" regression(s) (p50 tolerance "<<100*arg_tol<<"%)";
+  return n_regressions;
+}
+
+/**
+ * Benchmarks the dynamics engines, controllers, parser, serialization and io.
+ *
+ * Save a baseline with -o and compare later runs against it with -compare.
+ * The exit code is non-zero if any case regressed, so it can gate a build.
+ */
+int main(int argc, char** argv)
+{
+  SBenchOptions opt;
+  for(int i=1; i<argc; ++i)
+  {
+    std::string a(argv[i]);
+    bool has_next = (i+1 < argc);
+    if(a == "-o" && has_next) { opt.file_out_ = argv[++i]; }
+    else if(a == "-compare" && has_next) { opt.file_baseline_ = argv[++i]; }
+    else if(a == "-load" && has_next) { opt.file_load_ = argv[++i]; }
+    else if(a == "-filter" && has_next) { opt.filter_ = argv[++i]; }
+    else if(a == "-time" && has_next) { opt.time_per_case_ = atof(argv[++i]); }
+    else if(a == "-tol" && has_next) { opt.tolerance_ = atof(argv[++i]); }
+    else if(a == "-specs" && has_next) { opt.dir_specs_ = argv[++i]; }
+    else if(a == "-noredis") { opt.flag_redis_ = false; }
+    else
+    {
+      std::cout<<"\n The 'scl_bench' application benchmarks scl's dynamics, controllers, parser, serialization and io."
+          <<"\n ERROR : Provided incorrect arguments. The correct input format is:"
+          <<"\n   ./scl_bench <optional: -o out.json> <optional: -compare baseline.json <optional: -tol 0.1> >"
+          <<"\n               <optional: -filter substring> <optional: -time sec_per_case>"
+          <<"\n               <optional: -specs dir> <optional: -noredis> <optional: -load results.json>"
+          <<"\n With -load, the saved results are compared against the baseline (nothing is run)."
+          <<"\n The exit code is 2 if any case's p50 grew by more than the tolerance.\n";
+      return 1;
+    }
+  }
+
+  std::vector<SBenchResult> results;
+  try
+  {
+    if(opt.file_load_.size())
+    {
+      if(false == readResults(opt.file_load_,results))
+      { throw(std::runtime_error(std::string("Could not read results from : ") + opt.file_load_)); }
+    }
+    else
+    {
+      if(false == sutil::CSystemClock::start()) { throw(std::runtime_error("Could not start clock"));  }
+      if(false == scl::init::registerNativeDynamicTypes())
+      { throw(std::runtime_error("Could not initialize native dynamic types (parser might not work)"));  }
+
+      std::cout<<"\n "<<std::left<<std::setw(44)<<"case"<<std::right
+          <<std::setw(12)<<"p50(ns)"<<std::setw(12)<<"p99(ns)"<<std::setw(12)<<"mean(ns)"<<std::setw(12)<<"calls";
+      for(const SBenchRobot& rb : bench_robots) { runRobotCases(rb,opt,results); }
+      runAnalyticCases(opt,results);
+      runIOCases(opt,results);
+      if(opt.flag_redis_) { runPubSubCases(opt,results); }
+
+      if(opt.file_out_.size())
+      {
+        if(false == writeResults(opt.file_out_,opt,results))
+        { throw(std::runtime_error(std::string("Could not write results to : ") + opt.file_out_)); }
+        std::cout<<"\n\n Saved "<<results.size()<<" results to "<<opt.file_out_;
+      }
+    }
+
+    if(opt.file_baseline_.size())
+    {
+      std::vector<SBenchResult> base;
+      if(false == readResults(opt.file_baseline_,base))
+      { throw(std::runtime_error(std::string("Could not read baseline from : ") + opt.file_baseline_)); }
+      if(compareResults(base,results,opt.tolerance_) > 0) { std::cout<<"\n"; return 2; }
+    }
+  }
+  catch(std::exception & e)
+  {
+    std::cout<<"\nscl_bench : ERROR : "<<e.what()<<"\n";
+    return 1;
+  }
+  std::cout<<"\n";
+  return 0;
+}
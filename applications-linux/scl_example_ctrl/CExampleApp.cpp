@@ -131,10 +131,9 @@ namespace scl_app
   {
     sutil::CSystemClock::tick(db_->sim_dt_);//Tick the clock.
 
-    //Update the operational point tasks (if any)
+    //NOTE : The ui thread sends the ui points to the tasks' goals (CRobotApp::sendUiGoals()).
+    //       The controller applies them at the start of the servo tick.
     std::vector<SUiCtrlPointData>::iterator it,ite;
-    for(it = taskvec_ui_ctrl_point_.begin(), ite = taskvec_ui_ctrl_point_.end(); it!=ite; ++it )
-    { it->task_->setGoalPos(db_->s_gui_.ui_point_[it->ui_pt_]); } //Set the goal position.
 
     if(ctrl_ctr_%1 == 0)           //Update dynamics at a slower rate
     {
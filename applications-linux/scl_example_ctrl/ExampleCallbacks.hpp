@@ -22,6 +22,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <scl/Singletons.hpp>
 
 #include <scl/callbacks/GenericCallbacks.hpp>
+#include <scl/control/task/CControllerMultiTask.hpp>
 #include <scl/callbacks/PrintablesJSON.hpp>
 
 #include <iostream>
@@ -31,8 +32,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 namespace scl_app
 {
-  /** This function registers all the console io callbacks */
-  bool registerCallbacks()
+  /** This function registers all the console io callbacks
+   *
+   * Pass the task controller (if any) to enable the shell's "goal"
+   * command. NOTE : Call this before starting the threads. */
+  bool registerCallbacks(scl::CControllerMultiTask* arg_ctrl=NULL)
   {
     bool flag;
     try
@@ -86,6 +90,33 @@ namespace scl_app
           std::string("echo") );
       if(false == flag){throw(std::runtime_error("Could not add an echo callback"));  }
 
+      /** ************************************************************************
+       * Add a perf function to the command line shell (timing percentiles)
+       * *************************************************************************/
+      flag = sutil::callbacks::add<scl::CCallbackPerf, std::string, std::vector<std::string> >(
+          std::string("perf") );
+      if(false == flag){throw(std::runtime_error("Could not add a perf callback"));  }
+
+      /** ************************************************************************
+       * Add an xml cache function to the command line shell (clears parsed files)
+       * *************************************************************************/
+      flag = sutil::callbacks::add<scl::CCallbackXmlCache, std::string, std::vector<std::string> >(
+          std::string("xmlcache") );
+      if(false == flag){throw(std::runtime_error("Could not add an xml cache callback"));  }
+
+      /** ************************************************************************
+       * Add a task goal function to the command line shell. It sends goals to the
+       * controller through a command channel (never races the servo thread).
+       * *************************************************************************/
+      if(NULL != arg_ctrl)
+      {
+        if(NULL == arg_ctrl->createCommandChannel("shell"))
+        { throw(std::runtime_error("Could not create the shell's command channel"));  }
+        flag = sutil::callbacks::add<scl::CCallbackTaskGoal, std::string, std::vector<std::string>,
+            scl::CControllerMultiTask >( std::string("goal"), arg_ctrl );
+        if(false == flag){throw(std::runtime_error("Could not add a task goal callback"));  }
+      }
+
       /** ************************************************************************
        * Add a print callback. NOTE : You also need to add printables to print
        * *************************************************************************/
@@ -56,12 +56,12 @@ int main(int argc, char** argv)
   if(false == app.init(argvec)) {   return 1;  }
 
   //Register all the callback functions.
-  if(false == registerCallbacks())
+  if(false == registerCallbacks(dynamic_cast<scl::CControllerMultiTask*>(app.robot_.getControllerCurrent())))
   { std::cout<<"\nFailed to register callbacks"; return 1; }
 
   //Set up the threads
 #ifndef DEBUG
-  omp_set_num_threads(3);
+  omp_set_num_threads(4);
 #else
   omp_set_num_threads(1);
 #endif
@@ -76,6 +76,7 @@ int main(int argc, char** argv)
 
     /***********************Main Loop*****************************/
     if(2 == thread_id) { scl::shell::runConsoleShell(*CDatabase::getData()); }
+    else if(3 == thread_id) { app.runModelLoopThreaded(); } //Only runs with -mr <rate>
     else {//No shell in debug mode for now.
 #ifndef DEBUG
       app.runMainLoopThreaded(thread_id);  //Run multi-threaded in release mode
@@ -51,6 +51,20 @@ namespace scl_app
           std::string("echo") );
       if(false == flag){throw(std::runtime_error("Could not add an echo callback"));  }
 
+      /** ************************************************************************
+       * Add a perf function to the command line shell (timing percentiles)
+       * *************************************************************************/
+      flag = sutil::callbacks::add<scl::CCallbackPerf, std::string, std::vector<std::string> >(
+          std::string("perf") );
+      if(false == flag){throw(std::runtime_error("Could not add a perf callback"));  }
+
+      /** ************************************************************************
+       * Add an xml cache function to the command line shell (clears parsed files)
+       * *************************************************************************/
+      flag = sutil::callbacks::add<scl::CCallbackXmlCache, std::string, std::vector<std::string> >(
+          std::string("xmlcache") );
+      if(false == flag){throw(std::runtime_error("Could not add an xml cache callback"));  }
+
       /** ************************************************************************
        * Add a print callback. NOTE : You also need to add printables to print
        * *************************************************************************/
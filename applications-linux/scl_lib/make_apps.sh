@@ -7,6 +7,10 @@ cd ../scl_2rob_task_ctrl
 sh make_rel.sh
 sh make_dbg.sh
 
+cd ../scl_bench
+sh make_rel.sh
+sh make_dbg.sh
+
 cd ../scl_dynamics
 sh make_rel.sh
 sh make_dbg.sh
@@ -27,6 +31,10 @@ cd ../scl_haptic_ctrl
 sh make_rel.sh
 sh make_dbg.sh
 
+cd ../scl_log_convert
+sh make_rel.sh
+sh make_dbg.sh
+
 cd ../scl_redis_ctrl
 sh make_rel.sh
 sh make_dbg.sh
@@ -51,6 +59,14 @@ cd ../scl_test
 sh make_rel.sh
 sh make_dbg.sh
 
+cd ../scl_workspace
+sh make_rel.sh
+sh make_dbg.sh
+
+cd ../scl_batch_id
+sh make_rel.sh
+sh make_dbg.sh
+
 cd ../scl_lib
 
 
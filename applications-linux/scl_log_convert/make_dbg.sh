@@ -0,0 +1,6 @@
+mkdir -p build_dbg &&
+cd build_dbg &&
+cmake .. -DCMAKE_BUILD_TYPE=Debug &&
+make -j8 &&
+cp -rf scl_* ../ &&
+cd ..
@@ -0,0 +1,157 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+/* \file scl_log_convert.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+//scl headers used
+#include <scl/util/CLoggerBinary.hpp>
+
+//Standard includes
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+
+/** Converts a binary log (written by scl::CLoggerBinary, eg. with CRobot::setLogFile)
+ * into csv or json.
+ *
+ * csv  : One header line with a name per double (eg. q[2], M_gc(0,1)) and one line per row.
+ * json : {"columns":[{"name":..,"rows":..,"cols":..},..], "rows":[{"q":[..], "M_gc":[[..],..], ..},..]}
+ *
+ * Matrices are written row by row (the log stores them column-major, like Eigen). */
+int main(int argc, char** argv)
+{
+  FILE *fin = NULL, *fout = stdout;
+  try
+  {
+    if(3 > argc || 4 < argc)
+    {
+      std::cout<<"\nscl_log_convert : Converts an scl binary log to csv or json."
+          <<"\nThe command line input is: ./<executable> <log_file> <csv|json> <optional : out_file (default : stdout)>\n";
+      return 0;
+    }
+    const std::string fmt(argv[2]);
+    if("csv" != fmt && "json" != fmt)
+    { throw(std::runtime_error(std::string("Unknown output format (use csv or json) : ")+fmt)); }
+
+    fin = fopen(argv[1],"rb");
+    if(NULL == fin)
+    { throw(std::runtime_error(std::string("Could not open log file : ")+argv[1])); }
+
+    std::vector<scl::SLogColumn> cols;
+    scl::sUInt row_doubles, header_bytes;
+    if(false == scl::CLoggerBinary::readHeader(fin, cols, row_doubles, header_bytes))
+    { throw(std::runtime_error(std::string("Could not read the log's header : ")+argv[1])); }
+
+    if(4 == argc)
+    {
+      fout = fopen(argv[3],"w");
+      if(NULL == fout) { throw(std::runtime_error(std::string("Could not open output file : ")+argv[3])); }
+    }
+
+    // Header
+    if("csv" == fmt)
+    {
+      bool first = true;
+      for(std::vector<scl::SLogColumn>::const_iterator it = cols.begin(); it != cols.end(); ++it)
+      {
+        for(scl::sUInt r=0; r<it->rows_; ++r)
+          for(scl::sUInt c=0; c<it->cols_; ++c)
+          {
+            if(!first) { fputc(',',fout); }
+            first = false;
+            if(1 == it->size()) { fprintf(fout,"%s",it->name_.c_str()); }
+            else if(1 == it->cols_) { fprintf(fout,"%s[%u]",it->name_.c_str(),r); }
+            else { fprintf(fout,"%s(%u,%u)",it->name_.c_str(),r,c); }
+          }
+      }
+      fputc('\n',fout);
+    }
+    else
+    {
+      fprintf(fout,"{\"columns\":[");
+      for(std::vector<scl::SLogColumn>::const_iterator it = cols.begin(); it != cols.end(); ++it)
+      {
+        fprintf(fout,"%s{\"name\":\"%s\",\"rows\":%u,\"cols\":%u}", it==cols.begin() ? "" : ",",
+            it->name_.c_str(), it->rows_, it->cols_);
+      }
+      fprintf(fout,"],\n\"rows\":[");
+    }
+
+    // Rows. NaNs (not logged) are written as empty csv fields or json nulls.
+    std::vector<double> row(row_doubles);
+    long n_rows = 0;
+    while(row_doubles == fread(row.data(), sizeof(double), row_doubles, fin))
+    {
+      if("csv" == fmt)
+      {
+        bool first = true;
+        for(std::vector<scl::SLogColumn>::const_iterator it = cols.begin(); it != cols.end(); ++it)
+          for(scl::sUInt r=0; r<it->rows_; ++r)
+            for(scl::sUInt c=0; c<it->cols_; ++c)
+            {
+              if(!first) { fputc(',',fout); }
+              first = false;
+              const double v = row[it->offset_ + c*it->rows_ + r];
+              if(v == v) { fprintf(fout,"%.17g",v); }
+            }
+        fputc('\n',fout);
+      }
+      else
+      {
+        fprintf(fout,"%s\n{", 0==n_rows ? "" : ",");
+        for(std::vector<scl::SLogColumn>::const_iterator it = cols.begin(); it != cols.end(); ++it)
+        {
+          fprintf(fout,"%s\"%s\":", it==cols.begin() ? "" : ",", it->name_.c_str());
+          // Scalars as numbers, vectors as [..] and matrices as [[row 0],[row 1],..]
+          const bool is_mat = (1 < it->cols_), is_vec = (1 != it->size());
+          if(is_vec) { fputc('[',fout); }
+          for(scl::sUInt r=0; r<it->rows_; ++r)
+          {
+            if(r > 0) { fputc(',',fout); }
+            if(is_mat) { fputc('[',fout); }
+            for(scl::sUInt c=0; c<it->cols_; ++c)
+            {
+              if(c > 0) { fputc(',',fout); }
+              const double v = row[it->offset_ + c*it->rows_ + r];
+              if(v == v) { fprintf(fout,"%.17g",v); } else { fprintf(fout,"null"); }
+            }
+            if(is_mat) { fputc(']',fout); }
+          }
+          if(is_vec) { fputc(']',fout); }
+        }
+        fputc('}',fout);
+      }
+      n_rows++;
+    }
+    if("json" == fmt) { fprintf(fout,"]}\n"); }
+
+    std::cerr<<"\nscl_log_convert : Converted "<<n_rows<<" rows ("<<cols.size()<<" columns).\n";
+    fclose(fin);
+    if(stdout != fout) { fclose(fout); }
+    return 0;
+  }
+  catch(std::exception & e)
+  {
+    std::cerr<<"\nscl_log_convert : "<<e.what()<<"\n";
+    if(NULL != fin) { fclose(fin); }
+    if(NULL != fout && stdout != fout) { fclose(fout); }
+  }
+  return 1;
+}
@@ -76,7 +76,11 @@ int main(int argc, char** argv)
   {
     std::cout<<"\n The 'scl_redis_ctrl' application computes fgc commands and sends them (to a robot) using a redis io interface."
         <<"\n ERROR : Provided incorrect arguments. The correct input format is:"
-        <<"\n   ./scl_redis_ctrl <file_name.xml> <robot_name> <controller_name>  -op <task0> -op <task1> ... \n";
+        <<"\n   ./scl_redis_ctrl <file_name.xml> <robot_name> <controller_name>  -op <task0> -op <task1> ... "
+        <<"\n Optional real-time args : -rate <hz> -rtprio <1-99> -cpu <n> -mlock"
+        <<"\n Optional io args : -shm (q, dq and fgc through shared memory), -shmname </shm_name> (-shm with another name)"
+        <<"\n                    -sub (wait for the state messages published by 'scl_redis_sim -pub')"
+        <<"\n Optional latency compensation : -predict <lookahead sec> (predict the state the command acts on)\n";
     return 0;
   }
   else
@@ -113,6 +117,16 @@ int main(int argc, char** argv)
       scl::CIORedis ioredis;
       scl::SIORedis ioredis_ds;
 
+      // A second redis connection that subscribes to the robot's state (with -sub)
+      scl::SIORedis iosub_ds;
+
+      // Shared memory structures (used for the robot's state with -shm)
+      scl::CIOShm ioshm;
+      scl::SIOShm ioshm_ds;
+
+      // Latency compensation (with -predict)
+      scl::CStatePredictor predictor;
+
       /******************************Parsing and Initialization************************************/
       flag = scl::cmdLineArgReaderOneRobot(argc,argv,rcmd);
       flag = flag && scl::init::parseAndInitRobotAndController(p, rcmd, rds, rio, rgcm, dyn_scl,
@@ -123,11 +137,39 @@ int main(int argc, char** argv)
       std::cout<<"\n *** Parsing successful";
       scl::print::prettyPrint(rcmd);
 
+      if(rcmd.flag_io_shm_ && rcmd.flag_io_redis_sub_)
+      { throw(std::runtime_error("Use either -shm or -sub (not both)")); }
+
+      if(rcmd.flag_predict_)
+      {
+        flag = predictor.init(&rgcm, rio.dof_, rcmd.predict_lookahead_);
+        if(false == flag) { throw(std::runtime_error("Could not initialize the state predictor")); }
+        std::cout<<"\n ** Predicting the state "<<(rcmd.flag_io_redis_sub_ ? "(sample age + " : "(")
+            <<rcmd.predict_lookahead_<<"s ahead) before the servo **\n";
+      }
+
       /******************************Redis Initialization************************************/
       flag = ioredis.connect(ioredis_ds,false);
       if(false == flag)
       { throw(std::runtime_error( std::string("Could not connect to redis server : ") + std::string(ioredis_ds.context_->errstr) ));  }
 
+      /******************************Shared Memory Initialization************************************/
+      // With -shm, the high rate keys (q, dq, fgc) go through shared memory. The low rate keys
+      // (fgc enable, ui points) stay in redis so the usual tools (redis-cli, guis) still work.
+      if(rcmd.flag_io_shm_)
+      {
+        ioshm_ds.name_ = rcmd.name_io_shm_;
+        flag = ioshm.connect(ioshm_ds);
+        if(false == flag) { throw(std::runtime_error( std::string("Could not connect to shared memory : ") + rcmd.name_io_shm_ ));  }
+        std::cout<<"\n ** Exchanging {q, dq, fgc} through shared memory : "<<rcmd.name_io_shm_<<" **\n";
+      }
+
+      // The robot's state io
+      auto getState = [&](const char* arg_key, Eigen::VectorXd& ret_vec) -> bool
+      { return rcmd.flag_io_shm_ ? ioshm.get(ioshm_ds, arg_key, ret_vec) : ioredis.get(ioredis_ds, arg_key, ret_vec); };
+      auto setState = [&](const char* arg_key, const Eigen::VectorXd& arg_vec) -> bool
+      { return rcmd.flag_io_shm_ ? ioshm.set(ioshm_ds, arg_key, arg_vec) : ioredis.set(ioredis_ds, arg_key, arg_vec); };
+
       // Set up the keys here so we don't have to run sprintfs in the while loop...
       char rstr_robot_base[SCL_MAX_REDIS_KEY_LEN_CHARS], 
         rstr_q[SCL_MAX_REDIS_KEY_LEN_CHARS], rstr_dq[SCL_MAX_REDIS_KEY_LEN_CHARS],
@@ -141,6 +183,25 @@ int main(int argc, char** argv)
       sprintf(rstr_q, "%s::sensors::q", rstr_robot_base);
       sprintf(rstr_dq, "%s::sensors::dq", rstr_robot_base);
 
+      // The timing percentiles go to <robot>::perf::ctrl::<timer> (see the shell's perf command)
+      char rstr_perf[SCL_MAX_REDIS_KEY_LEN_CHARS];
+      sprintf(rstr_perf, "%s::perf::ctrl::", rstr_robot_base);
+
+      /******************************Redis Subscription************************************/
+      // With -sub, the simulator publishes {q, dq, fgc} on this channel once per tick and the
+      // control loop blocks on it (instead of polling the keys).
+      char rstr_state_chan[SCL_MAX_REDIS_KEY_LEN_CHARS];
+      sprintf(rstr_state_chan, "%s::state", rstr_robot_base);
+      Eigen::VectorXd* state_vecs[3] = {&rio.sensors_.q_, &rio.sensors_.dq_, &rio.sensors_.force_gc_measured_};
+      long long state_seq = 0;
+      if(rcmd.flag_io_redis_sub_)
+      {
+        flag = ioredis.connect(iosub_ds,false);
+        flag = flag && ioredis.subscribe(iosub_ds, rstr_state_chan);
+        if(false == flag) { throw(std::runtime_error( std::string("Could not subscribe to : ") + rstr_state_chan ));  }
+        std::cout<<"\n ** Subscribed to state messages on : "<<rstr_state_chan<<" (run the sim with -pub) **\n";
+      }
+
       char rstr_ui_master[SCL_MAX_REDIS_KEY_LEN_CHARS];
       sprintf(rstr_ui_master, "scl::robot::%s::ui::master",rcmd.name_robot_.c_str());
 
@@ -155,8 +216,8 @@ int main(int argc, char** argv)
         flag = true;//Hopefully.
 
         // REDIS IO : Get q and dq keys. If unavailable, throw an error..
-        flag = flag && ioredis.get(ioredis_ds, rstr_q, rio.sensors_.q_);
-        flag = flag && ioredis.get(ioredis_ds, rstr_dq, rio.sensors_.dq_);
+        flag = flag && getState(rstr_q, rio.sensors_.q_);
+        flag = flag && getState(rstr_dq, rio.sensors_.dq_);
         if(flag){  break;  } // Found both keys and so flag is still true...
 
         std::cout<<"\n WARNING : Could not find {q, dq} redis keys for robot: (scl::robot::"<<rcmd.name_robot_<<"). Will wait for it...";
@@ -171,7 +232,7 @@ int main(int argc, char** argv)
 
       // REDIS IO : Create fgc key and set it to zero (initial state)
       rio.actuators_.force_gc_commanded_.setZero(rio.dof_);
-      flag = ioredis.set(ioredis_ds, rstr_fgc, rio.actuators_.force_gc_commanded_);
+      flag = setState(rstr_fgc, rio.actuators_.force_gc_commanded_);
 
       // Reset all task positions
       for(int j=0; j< rtask_ui_3d_ds.size(); ++j)
@@ -197,25 +258,87 @@ int main(int argc, char** argv)
         enable_fgc_command_pre = 1;// Needs to the the complement of enable_fgc_command
       }
 
+      /****************************** Loop Scheduler ************************************/
+      // Without -rate the loop runs as fast as redis allows (the scheduler only times the phases).
+      scl::CLoopScheduler sched;
+      const int ph_io = sched.addPhase("io"), ph_model = sched.addPhase("model"), ph_servo = sched.addPhase("servo");
+      const int ph_perf = sched.addPhase("perf", 0, 100);
+      if(0 < rcmd.loop_rate_hz_)
+      {
+        flag = sched.init(1.0/rcmd.loop_rate_hz_, rcmd.loop_rt_priority_, rcmd.loop_cpu_, rcmd.flag_loop_mlock_);
+        if(false == flag) { throw(std::runtime_error("Could not initialize the control loop scheduler")); }
+        std::cout<<"\n ** Control loop rate : "<<rcmd.loop_rate_hz_<<"Hz **\n"<<std::flush;
+      }
+
+      // With shared memory (and no -rate) the loop runs in lock-step with the simulator : It
+      // sleeps until a new q arrives. Redis keys are polled every few ticks to keep the loop fast.
+      const bool flag_lock_step = rcmd.flag_io_shm_ && (0 >= rcmd.loop_rate_hz_);
+      const long long redis_poll_ticks = (rcmd.flag_io_shm_ || rcmd.flag_io_redis_sub_) ? 10 : 1;
+      long long tick = 0;
+      long long t_perf_next_ns = scl::CPerfStats::nowNs();
+      unsigned int q_seq = 0;
+      if(flag_lock_step) { ioshm.getSeq(ioshm_ds, rstr_q, q_seq); }
+
       /****************************** Control Loop************************************/
       while(flag_running)
       {
         flag = true;
+        const bool flag_poll_redis = (0 == tick % redis_poll_ticks);
+        tick++;
+
+        // SHM IO : Wait for the simulator's next state (futex wakeup; times out if the sim stops).
+        if(flag_lock_step)
+        {
+          ioshm.waitForUpdate(ioshm_ds, rstr_q, q_seq, 0.1);
+          ioshm.getSeq(ioshm_ds, rstr_q, q_seq);
+        }
+
+        // REDIS SUB : Sleep until the next sample arrives (skips to the newest one if we fell behind).
+        if(rcmd.flag_io_redis_sub_ &&
+            false == ioredis.waitForMessage(iosub_ds, state_vecs, 3, state_seq, 0.1))
+        {
+          std::cout<<"\n WARNING : No state messages on : "<<rstr_state_chan<<". Will wait for them...";
+          sched.resync();
+          continue;
+        }
+
         /* ************************************ READ FROM REDIS ************************** */
         // REDIS IO : Get q and dq keys. If unavailable, throw an error..
-        flag = flag && ioredis.get(ioredis_ds, rstr_q, rio.sensors_.q_);
-        flag = flag && ioredis.get(ioredis_ds, rstr_dq, rio.sensors_.dq_);
-        flag = flag && ioredis.get(ioredis_ds, rstr_fgcenab, enable_fgc_command);
+        sched.startPhase(ph_io);
+        if(false == rcmd.flag_io_redis_sub_)
+        {
+          flag = flag && getState(rstr_q, rio.sensors_.q_);
+          flag = flag && getState(rstr_dq, rio.sensors_.dq_);
+        }
+        if(flag_poll_redis)
+        { flag = flag && ioredis.get(ioredis_ds, rstr_fgcenab, enable_fgc_command); }
+        sched.endPhase(ph_io);
 
         if(false == flag){
           std::cout<<"\n WARNING : Could not find {q, dq, fgcenab} redis keys for robot: "<<rstr_robot_base<<". Will wait for it...";
           const timespec ts = {0, 50000000};/*50ms sleep */ nanosleep(&ts,NULL);
+          sched.resync();
           continue;
         }
 
+        // Move the sample forward to when the command will act on it, using the last model and
+        // the command the robot is still executing. Only while it executes our commands.
+        if(rcmd.flag_predict_ && 1 == enable_fgc_command)
+        {
+          const double t_age = rcmd.flag_io_redis_sub_ ?
+              (scl::CPerfStats::nowNs() - iosub_ds.msg_t_pub_ns_last_)*1e-9 : 0.0;
+          predictor.predict(rio.sensors_, rio.actuators_.force_gc_commanded_, t_age);
+        }
+
         /* ************************************ COMPUTE CONTROL FORCES ************************** */
         // Compute control forces (note that these directly have access to the io data ds).
-        rctr.computeDynamics();
+        // If the loop is falling behind, skip a model update (reuse the last model), never the servo.
+        if(sched.hasTimeFor(ph_model))
+        {
+          sched.startPhase(ph_model);
+          rctr.computeDynamics();
+          sched.endPhase(ph_model);
+        }
 
         // If the torque command is enabled, use the latest goal position.
         if(1 == enable_fgc_command)
@@ -227,7 +350,7 @@ int main(int argc, char** argv)
           }
 
           // FGC Enabled : Read goal positions
-          for(int i=0; i< rtask_ui_3d_ds.size(); ++i)
+          for(int i=0; flag_poll_redis && i< rtask_ui_3d_ds.size(); ++i)
           {
             flag = ioredis.get(ioredis_ds, rstr_ui_pt[i], rtask_ui_3d_ds[i]->x_goal_);
             if(false == flag)
@@ -254,34 +377,60 @@ int main(int argc, char** argv)
           for(int i=0; i< rtask_ui_3d_ds.size(); ++i)
           {// Move the goal position to the actual position and reset it in redis...
             rtask_ui_3d_ds[i]->x_goal_ = rtask_ui_3d_ds[i]->x_;
-            flag = ioredis.set(ioredis_ds, rstr_ui_pt[i], rtask_ui_3d_ds[i]->x_goal_);
+            if(flag_poll_redis) { flag = ioredis.set(ioredis_ds, rstr_ui_pt[i], rtask_ui_3d_ds[i]->x_goal_); }
           }
 
           rio.actuators_.force_gc_commanded_.setZero(rio.dof_);
-          flag = flag && ioredis.set(ioredis_ds, rstr_fgc, rio.actuators_.force_gc_commanded_);
+          flag = flag && setState(rstr_fgc, rio.actuators_.force_gc_commanded_);
 
           if(false == flag) { std::cout<<"\n WARNING : Could not reset xgoal or fgc. Check robot before re-enabling fgc commands"; }
         }
 
+        sched.startPhase(ph_servo);
         rctr.computeControlForces(); //Directly update io data structure for now...
 
         /* ************************************ WRITE TO REDIS ************************** */
         // REDIS IO : Set fgc_commanded
-        flag = ioredis.set(ioredis_ds, rstr_fgc, rio.actuators_.force_gc_commanded_);
+        flag = setState(rstr_fgc, rio.actuators_.force_gc_commanded_);
         if(false == flag){  std::cout<<"\n ERROR : Could not set force gc and/or xgoal. Probably serious. Consider aborting."; }
-
-        // Optional, sleep a bit.
-//        const timespec ts = {0, 20000000};/*20ms sleep : ~50Hz update*/
-//        nanosleep(&ts,NULL);
+        sched.endPhase(ph_servo);
 
         // Need to refresh the enable command cycle..
         enable_fgc_command_pre = enable_fgc_command;
+
+        // Publish the timing percentiles about once a second (when the tick has time to spare).
+        if(scl::CPerfStats::nowNs() > t_perf_next_ns && sched.hasTimeFor(ph_perf))
+        {
+          sched.startPhase(ph_perf);
+          ioredis.setPerfStats(ioredis_ds, rstr_perf);
+          sched.endPhase(ph_perf);
+          t_perf_next_ns = scl::CPerfStats::nowNs() + 1000000000LL;
+        }
+
+        // Sleep till the next tick (a no-op without -rate).
+        sched.waitForNextTick();
       }// ************** END OF CONTROL LOOP!!!
 
+      sched.printStats();
+      scl::CPerfStats::print(std::cout);
+
+      if(rcmd.flag_io_redis_sub_ && 0 < iosub_ds.msg_ctr_)
+      {
+        std::cout<<"\n State messages : "<<iosub_ds.msg_ctr_<<" (skipped "<<iosub_ds.msg_ctr_skipped_<<")"
+            <<". Latency (us) mean : "<<1e6*iosub_ds.msg_latency_sum_/iosub_ds.msg_ctr_
+            <<", max : "<<1e6*iosub_ds.msg_latency_max_;
+      }
+      if(rcmd.flag_predict_)
+      {
+        std::cout<<"\n State predictions : "<<predictor.getNumPredictions()
+            <<" (clamped to "<<1e3*predictor.getDelayMax()<<"ms : "<<predictor.getNumClamped()<<")";
+      }
+
       /******************************Exit Gracefully************************************/
       // Send Zero torques to redis
       rio.actuators_.force_gc_commanded_.setZero(rio.dof_);
-      ioredis.set(ioredis_ds, rstr_fgc, rio.actuators_.force_gc_commanded_);
+      setState(rstr_fgc, rio.actuators_.force_gc_commanded_);
+      if(rcmd.flag_io_shm_) { ioshm.disconnect(ioshm_ds); }
 
       std::cout<<"\n\n Executed Successfully";
       std::cout<<"\n**********************************\n"<<std::flush;
@@ -70,13 +70,34 @@ int main(int argc, char** argv)
   sigIntHandler.sa_flags = 0;
   sigaction(SIGINT, &sigIntHandler, NULL);
 
+  // Pull out the optional args (-shm, -shmname </shm_name>, -pub, -json). The rest are positional.
+  bool flag_io_shm = false, flag_io_pub = false, flag_io_json = false, flag_args_ok = true;
+  std::string name_io_shm("/scl_io");
+  std::vector<std::string> args;
+  for(int i=0; i<argc; ++i)
+  {
+    if(std::string(argv[i]) == "-shm") { flag_io_shm = true; }
+    else if(std::string(argv[i]) == "-shmname")
+    {//Implies -shm. The name must start with a '/'
+      if(i+1 < argc && '/' == argv[i+1][0])
+      { flag_io_shm = true; name_io_shm = argv[i+1]; ++i; }
+      else { flag_args_ok = false; }
+    }
+    else if(std::string(argv[i]) == "-pub") { flag_io_pub = true; }
+    else if(std::string(argv[i]) == "-json") { flag_io_json = true; }
+    else { args.push_back(argv[i]); }
+  }
+
   bool flag;
-  if((argc != 2)&&(argc != 3))
+  if(false == flag_args_ok || ((args.size() != 2)&&(args.size() != 3)))
   {
     std::cout<<"\n The 'scl_redis_sim' application uses scl to simulate the physics of a robot with redis io."
         <<"\n ERROR : Provided incorrect arguments. The correct input format is:"
-        <<"\n   ./scl_redis_sim <file_name.xml> <optional: robot_name>"
-        <<"\n If a robot name isn't provided, the first one from the xml file will be used.\n";
+        <<"\n   ./scl_redis_sim <file_name.xml> <optional: robot_name> <optional: -shm> <optional: -shmname </shm_name> > <optional: -pub> <optional: -json>"
+        <<"\n If a robot name isn't provided, the first one from the xml file will be used."
+        <<"\n With -shm, q, dq and fgc go through shared memory (/scl_io) instead of redis. -shmname picks another name."
+        <<"\n With -pub, each tick's {q, dq, fgc} is also PUBLISHed (packed) on scl::robot::<name>::state"
+        <<"\n With -json, each tick's changes to the robot's io are PUBLISHed as JSON on scl::robot::<name>::io_json\n";
     return 0;
   }
   else
@@ -100,18 +121,18 @@ int main(int argc, char** argv)
       if(false == flag) { throw(std::runtime_error("Could not initialize native dynamic types (parser might not work)"));  }
 
       /******************************File Parsing************************************/
-      std::string name_infile(argv[1]);
+      std::string name_infile(args[1]);
       std::cout<<"\nRunning scl_redis_sim for input file: "<<name_infile;
 
       std::string name_robot;
-      if(argc==2)
+      if(args.size()==2)
       {//Use the first robot spec in the file if one isn't specified by the user.
         std::vector<std::string> robot_names;
         flag = p.listRobotsInFile(name_infile,robot_names);
         if(false == flag) { throw(std::runtime_error("Could not read robot names from the file"));  }
         name_robot = robot_names[0];//Use the first available robot.
       }
-      else { name_robot = argv[2];}
+      else { name_robot = args[2];}
 
       std::cout<<"\nParsing robot: "<<name_robot;
       if(false == flag) { throw(std::runtime_error("Could not read robot description from file"));  }
@@ -133,6 +154,25 @@ int main(int argc, char** argv)
       if(false == flag)
       { throw(std::runtime_error( std::string("Could not connect to redis server : ") + std::string(ioredis_ds.context_->errstr) ));  }
 
+      /******************************Shared Memory Initialization************************************/
+      // With -shm, the high rate keys (q, dq, fgc) go through shared memory. The low rate keys
+      // (dof, fgc enable) stay in redis so the usual tools (redis-cli, guis) still work.
+      scl::CIOShm ioshm;
+      scl::SIOShm ioshm_ds;
+      if(flag_io_shm)
+      {
+        ioshm_ds.name_ = name_io_shm;
+        flag = ioshm.connect(ioshm_ds);
+        if(false == flag) { throw(std::runtime_error( std::string("Could not connect to shared memory : ") + name_io_shm ));  }
+        std::cout<<"\n Exchanging {q, dq, fgc} through shared memory : "<<name_io_shm;
+      }
+
+      // The robot's state io
+      auto getState = [&](const char* arg_key, Eigen::VectorXd& ret_vec) -> bool
+      { return flag_io_shm ? ioshm.get(ioshm_ds, arg_key, ret_vec) : ioredis.get(ioredis_ds, arg_key, ret_vec); };
+      auto setState = [&](const char* arg_key, const Eigen::VectorXd& arg_vec) -> bool
+      { return flag_io_shm ? ioshm.set(ioshm_ds, arg_key, arg_vec) : ioredis.set(ioredis_ds, arg_key, arg_vec); };
+
       // Set up the keys here so we don't have to run sprintfs in the while loop...
       char rstr[1024], rstr_robot_base[1024], rstr_actfgc[1024], rstr_fgcenab[1024],
            rstr_q[1024], rstr_dq[1024], rstr_sensfgc[1024]; //For redis key formatting
@@ -143,6 +183,26 @@ int main(int argc, char** argv)
       sprintf(rstr_dq, "%s::sensors::dq", rstr_robot_base);
       sprintf(rstr_sensfgc, "%s::sensors::fgc", rstr_robot_base);
 
+      // The timing percentiles go to <robot>::perf::sim::<timer>
+      char rstr_perf[1024];
+      sprintf(rstr_perf, "%s::perf::sim::", rstr_robot_base);
+
+      // With -pub, controllers subscribe to this instead of polling the keys.
+      char rstr_state_chan[1024];
+      sprintf(rstr_state_chan, "%s::state", rstr_robot_base);
+      const Eigen::VectorXd* state_vecs[3] = {&rio.sensors_.q_, &rio.sensors_.dq_, &rio.sensors_.force_gc_measured_};
+
+      // With -json, the robot's io goes out as JSON (eg. for web viewers). Only the fields that
+      // changed since the last message are sent. A full message goes out once a second so that
+      // new subscribers catch up. The writer and the sent copy are reused (no allocations).
+      char rstr_json_chan[1024];
+      sprintf(rstr_json_chan, "%s::io_json", rstr_robot_base);
+      const long long json_full_ticks = 1000;
+      scl::CJSONStreamWriter json_writer;
+      scl::SRobotIO rio_sent;
+      flag = rio_sent.init(rds);
+      if(false == flag){ throw(std::runtime_error("Could not initialize the json io data structure"));  }
+
       std::cout<<"\n The default REDIS keys used are: ";
       std::cout<<"\n  "<<rstr_q<<"\n  "<<rstr_dq<<"\n  "<<rstr_sensfgc<<"\n  "<<rstr_actfgc<<"\n  "<<rstr_fgcenab;
       std::cout<<"\n  scl::robot::"<<name_robot<<"::dof";
@@ -157,7 +217,7 @@ int main(int argc, char** argv)
 
       // REDIS IO : Create fgc key and set it to zero (initial state)
       rio.actuators_.force_gc_commanded_.setZero(rio.dof_);
-      flag = flag && ioredis.set(ioredis_ds, rstr_actfgc, rio.actuators_.force_gc_commanded_);
+      flag = flag && setState(rstr_actfgc, rio.actuators_.force_gc_commanded_);
 
       if(false == flag) { throw(std::runtime_error("Could not complete initial redis key set/gets." ));  }
 
@@ -180,11 +240,21 @@ int main(int argc, char** argv)
       scl::sFloat t_start, t_end;
       t_start = sutil::CSystemClock::getSysTime();
 
+      // With shared memory or pub/sub, poll (and set) the redis keys every few ticks (keeps the loop fast)
+      const long long redis_poll_ticks = (flag_io_shm || flag_io_pub) ? 10 : 1;
+      long long tick = 0;
+      long long t_perf_next_ns = scl::CPerfStats::nowNs();
+      if(flag_io_pub) { std::cout<<"\n Publishing {q, dq, fgc} each tick on channel : "<<rstr_state_chan; }
+      if(flag_io_json) { std::cout<<"\n Publishing the io's changes (JSON) each tick on channel : "<<rstr_json_chan; }
+
       while(flag_sim_enabled)
       {
         // ***************** The physics integrator *****************
         sutil::CSystemClock::tick(sim_dt);
-        flag = dyn_scl_sp.integrate(rgcm, rio, sim_dt); // Run the integrator with a 1ms timestep..
+        {
+          SCL_PERF_SCOPE("sim::integrate");
+          flag = dyn_scl_sp.integrate(rgcm, rio, sim_dt); // Run the integrator with a 1ms timestep..
+        }
 
         /** Slow down sim to real time */
         double tcurr = sutil::CSystemClock::getSysTime() - t_start;
@@ -204,20 +274,58 @@ int main(int argc, char** argv)
         //rio.sensors_.dq_ -= rio.sensors_.dq_/1000;
 
         // ***************** The Redis IO *****************
-        flag = flag && ioredis.set(ioredis_ds, rstr_q, rio.sensors_.q_);   // REDIS IO : Set q
-        flag = flag && ioredis.set(ioredis_ds, rstr_dq, rio.sensors_.dq_); // REDIS IO : Set dq
-        flag = flag && ioredis.set(ioredis_ds, rstr_sensfgc, rio.sensors_.force_gc_measured_); // REDIS IO : Set fgc_sensed
-        flag = flag && ioredis.get(ioredis_ds, rstr_fgcenab, enable_fgc_command); // REDIS IO : Get fgc_enabled key : fgc_command_enabled
+        const bool flag_poll_redis = (0 == tick % redis_poll_ticks);
+
+        // REDIS PUB : Subscribed controllers wake up on this (exactly once per sample)
+        if(flag_io_pub)
+        { flag = flag && ioredis.publish(ioredis_ds, rstr_state_chan, state_vecs, 3, tick); }
+
+        // REDIS PUB : The io's changes as JSON
+        if(flag_io_json)
+        {
+          SCL_PERF_SCOPE("sim::io_json");
+          json_writer.clear();
+          flag = flag && scl::serializeToJSONStream(rio, json_writer,
+              (0 == tick % json_full_ticks) ? S_NULL : &rio_sent);
+          flag = flag && ioredis.publish(ioredis_ds, rstr_json_chan, json_writer.data(), json_writer.size());
+          // NOTE : Only copy what the sim changes. Copying all the sensors would
+          // also copy (and allocate) the external forces' mapped list every tick.
+          rio_sent.sensors_.q_ = rio.sensors_.q_;
+          rio_sent.sensors_.dq_ = rio.sensors_.dq_;
+          rio_sent.sensors_.ddq_ = rio.sensors_.ddq_;
+          rio_sent.sensors_.force_gc_measured_ = rio.sensors_.force_gc_measured_;
+          rio_sent.actuators_.force_gc_commanded_ = rio.actuators_.force_gc_commanded_;
+        }
+        tick++;
+
+        // NOTE : Set dq before q. With -shm, a lock-step controller wakes up when q is set.
+        // With -pub (and redis keys), the keys are only for monitoring so they are set less often.
+        if(flag_io_shm || false == flag_io_pub || flag_poll_redis)
+        {
+          flag = flag && setState(rstr_dq, rio.sensors_.dq_); // REDIS IO : Set dq
+          flag = flag && setState(rstr_sensfgc, rio.sensors_.force_gc_measured_); // REDIS IO : Set fgc_sensed
+          flag = flag && setState(rstr_q, rio.sensors_.q_);   // REDIS IO : Set q
+        }
+        if(flag_poll_redis)
+        { flag = flag && ioredis.get(ioredis_ds, rstr_fgcenab, enable_fgc_command); } // REDIS IO : Get fgc_enabled key : fgc_command_enabled
 
         if(false == flag){  enable_fgc_command = 0; } // Just to be safe..
 
         if(enable_fgc_command) //Read command torques if the enable flag is true
-        { flag = flag && ioredis.get(ioredis_ds, rstr_actfgc, rio.actuators_.force_gc_commanded_);  } // REDIS IO : Get fgc_commanded
+        { flag = flag && getState(rstr_actfgc, rio.actuators_.force_gc_commanded_);  } // REDIS IO : Get fgc_commanded
         else // If the enable flag is false, set torques to zero.
         { rio.actuators_.force_gc_commanded_.setZero(rio.dof_); }
 
         if(false == flag){ std::cout<<"\n ERROR : Can't get fgc command. Something is probably seriously wrong. Should quit"; break;  }
+
+        // Publish the timing percentiles about once a second
+        if(scl::CPerfStats::nowNs() > t_perf_next_ns)
+        {
+          ioredis.setPerfStats(ioredis_ds, rstr_perf);
+          t_perf_next_ns = scl::CPerfStats::nowNs() + 1000000000LL;
+        }
       } // End of while loop
+      scl::CPerfStats::print(std::cout);
 
       t_end = sutil::CSystemClock::getSysTime();
 
@@ -238,6 +346,14 @@ int main(int argc, char** argv)
       ioredis_ds.reply_ = (redisReply *)redisCommand(ioredis_ds.context_, "DEL %s::sensors::fgc", rstr_robot_base); freeReplyObject((void*)ioredis_ds.reply_);
       ioredis_ds.reply_ = (redisReply *)redisCommand(ioredis_ds.context_, "DEL %s::actuators::fgc", rstr_robot_base); freeReplyObject((void*)ioredis_ds.reply_);
 
+      // SHM IO : Remove the state keys (other processes may still use the segment).
+      if(flag_io_shm)
+      {
+        ioshm.del(ioshm_ds, rstr_q); ioshm.del(ioshm_ds, rstr_dq);
+        ioshm.del(ioshm_ds, rstr_sensfgc); ioshm.del(ioshm_ds, rstr_actfgc);
+        ioshm.disconnect(ioshm_ds);
+      }
+
       /****************************Print Collected Statistics*****************************/
       //Now you can get the energies
       std::cout<<"\nTotal Simulated Time : "<<sutil::CSystemClock::getSimTime() <<" sec";
@@ -36,6 +36,41 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "test_dynamics_sclspatial.hpp"
 //Test chai graphic rendering
 #include "test_graphics.hpp"
+//Test heap allocations in the controllers' servo loops
+#include "test_alloc.hpp"
+//Test trajectory files and splines
+#include "test_trajectory.hpp"
+//Test inverse kinematics
+#include "test_ik.hpp"
+//Test reachability maps
+#include "test_reachability.hpp"
+
+//Test batch inverse dynamics
+#include "test_inverse_dynamics_batch.hpp"
+
+//Test latency compensation
+#include "test_state_predictor.hpp"
+
+//Test sleeping robots
+#include "test_robot_sleep.hpp"
+
+//Test batches of simulations
+#include "test_env_batch.hpp"
+
+//Test muscles sharing the controller's Jacobians
+#include "test_actuator_muscle.hpp"
+
+//Test the multi-rate (model + servo threads) task controller
+#include "test_multi_rate.hpp"
+
+//Test engaging inequality tasks (constraint planes, joint limits)
+#include "test_task_engagement.hpp"
+
+//Loop scheduler tests
+#include "test_loop_scheduler.hpp"
+
+//Shared memory io tests
+#include "test_io_shm.hpp"
 
 #include <scl/Singletons.hpp>
 
@@ -205,6 +240,135 @@ int main(int argc, char** argv)
     }
     ++id;
 
+    if((tid==0)||(tid==id))
+    {//Test that the controllers' servos don't allocate (needs the malloc hooks)
+      std::cout<<"\n\nTest #"<<id<<". Zero allocation servo [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_controller_alloc(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test memory mapped trajectories and spline interpolation
+      std::cout<<"\n\nTest #"<<id<<". Trajectory files and splines [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_trajectory(id);
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test batched damped least squares inverse kinematics
+      std::cout<<"\n\nTest #"<<id<<". Inverse kinematics [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_ik(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test parallel reachability map generation and memory mapped queries
+      std::cout<<"\n\nTest #"<<id<<". Reachability maps [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_reachability(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test batch inverse dynamics over recorded logs
+      std::cout<<"\n\nTest #"<<id<<". Batch inverse dynamics [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_inverse_dynamics_batch(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test the latency compensating state predictor
+      std::cout<<"\n\nTest #"<<id<<". State predictor [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_state_predictor(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test sleeping and waking idle robots
+      std::cout<<"\n\nTest #"<<id<<". Robot sleep/wake [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_robot_sleep(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test running many simulations in one process
+      std::cout<<"\n\nTest #"<<id<<". Environment batches [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_env_batch(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test muscle actuators sharing the controller's Jacobian cache
+      std::cout<<"\n\nTest #"<<id<<". Muscle Jacobian cache [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_actuator_muscle(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test the task controller's model and servo threads
+      std::cout<<"\n\nTest #"<<id<<". Multi-rate controller [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_multi_rate(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test inequality tasks that only engage when they must
+      std::cout<<"\n\nTest #"<<id<<". Inequality task engagement [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_task_engagement(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test the loop scheduler
+      std::cout<<"\n\nTest #"<<id<<". Loop scheduler [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_loop_scheduler(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
+    if((tid==0)||(tid==id))
+    {//Test the shared memory io backend
+      std::cout<<"\n\nTest #"<<id<<". Shared memory io [Sys time, Sim time :"
+          <<sutil::CSystemClock::getSysTime()<<" "
+          <<sutil::CSystemClock::getSimTime()<<"]";
+      scl_test::test_io_shm(id);
+      scl::CDatabase::resetData(); sutil::CRegisteredDynamicTypes<std::string>::resetDynamicTypes();
+    }
+    ++id;
+
 
     /**** Under development
     if((tid==0)||(tid==99))
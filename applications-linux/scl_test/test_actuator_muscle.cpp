@@ -0,0 +1,134 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_actuator_muscle.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_actuator_muscle.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/robot/CRobot.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+#include <scl/actuation/muscles/CActuatorSetMuscle.hpp>
+#include <scl/control/task/CControllerMultiTask.hpp>
+#include <scl/Init.hpp>
+#include <scl_ext/dynamics/scl_spatial/CDynamicsSclSpatial.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace scl_test
+{
+  void test_actuator_muscle(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+    const int n_ticks = 100;
+    const double test_precision = 1e-10;
+
+    try
+    {
+      scl::SDatabase * db = scl::CDatabase::getData();
+      if(S_NULL==db)
+      { throw(std::runtime_error("Database not initialized."));  }
+      else
+      { std::cout<<"\nTest Result ("<<r_id++<<")  Initialized database"<<std::flush;  }
+      db->dir_specs_ = db->cwd_ + std::string("../../specs/");
+
+      flag = scl::init::registerNativeDynamicTypes();
+      if(false == flag)
+      { throw(std::runtime_error("Could not register native dynamic types"));  }
+
+      scl::CParserScl tmp_lparser;
+      flag = scl_registry::parseEverythingInFile(db->dir_specs_ + "ArmWithMuscles/ArmCfg.xml", &tmp_lparser);
+      if(false == flag)
+      { throw(std::runtime_error("Could not parse the muscle arm"));  }
+
+      scl::SRobotParsed *rob_ds = db->s_parser_.robots_.at("Arm5Bot");
+      if(S_NULL == rob_ds)
+      { throw(std::runtime_error("Could not find the muscle arm"));  }
+
+      // The robot deletes these
+      scl::CDynamicsScl* dyn_scl = new scl::CDynamicsScl();
+      scl_ext::CDynamicsSclSpatial* dyn_sp = new scl_ext::CDynamicsSclSpatial();
+      flag = dyn_scl->init(*rob_ds);
+      flag = flag && dyn_sp->init(*rob_ds);
+
+      scl::CRobot robot;
+      flag = flag && robot.initFromDb("Arm5Bot", dyn_scl, dyn_sp);
+      flag = flag && robot.setControllerCurrent("5opc");
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the muscle arm"));  }
+
+      scl::CControllerMultiTask* ctrl = dynamic_cast<scl::CControllerMultiTask*>(robot.getControllerCurrent());
+      if(S_NULL == ctrl)
+      { throw(std::runtime_error("The muscle arm's controller isn't a task controller"));  }
+      scl::SGcModel* gcm = robot.getData()->controller_current_->gc_model_;
+
+      scl::SActuatorSetBase** aset = robot.getData()->io_data_->actuators_.actuator_sets_.at("Arm5Msys");
+      scl::SActuatorSetMuscle* mset_ds = (S_NULL == aset) ? S_NULL : dynamic_cast<scl::SActuatorSetMuscle*>(*aset);
+      if(S_NULL == mset_ds)
+      { throw(std::runtime_error("Could not find the muscle arm's muscle set"));  }
+
+      // One muscle set shares the controller's cache. The other computes its own Jacobians.
+      scl::CActuatorSetMuscle mset_cached, mset;
+      flag = mset_cached.init(*mset_ds, *gcm, dyn_scl, &(ctrl->getJacobianCache()));
+      flag = flag && mset.init(*mset_ds, *gcm, dyn_scl);
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the muscle sets"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Initialized a muscle set with the controller's Jacobian cache";
+
+      Eigen::MatrixXd J_cached, J;
+      scl::sLongLong saved_by_muscles = 0;
+      for(int i=0; i<n_ticks; ++i)
+      {
+        robot.computeDynamics();
+        robot.computeServo();
+
+        const scl::sLongLong saved = ctrl->getJacobianCache().getChainWalksSaved();
+        flag = mset_cached.computeJacobian(robot.getGeneralizedCoordinates(), J_cached);
+        flag = flag && mset.computeJacobian(robot.getGeneralizedCoordinates(), J);
+        if(false == flag)
+        { throw(std::runtime_error("Could not compute the muscle Jacobians"));  }
+        if(saved >= ctrl->getJacobianCache().getChainWalksSaved())
+        { throw(std::runtime_error("The muscles didn't reuse any of the controller's Jacobians"));  }
+        saved_by_muscles += ctrl->getJacobianCache().getChainWalksSaved() - saved;
+
+        if((J - J_cached).cwiseAbs().maxCoeff() > test_precision)
+        {
+          std::cout<<"\nGeneralized Coordinates: "<<robot.getGeneralizedCoordinates().transpose();
+          std::cout<<"\nMuscle J :\n"<<J<<"\nCached muscle J :\n"<<J_cached;
+          throw(std::runtime_error("Cached and uncached muscle Jacobians don't match"));
+        }
+
+        robot.integrateDynamics();
+      }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Cached and uncached muscle Jacobians match over "<<n_ticks
+          <<" ticks. Chain walks saved by the muscles : "<<saved_by_muscles
+          <<", total walks : "<<ctrl->getJacobianCache().getChainWalks();
+
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
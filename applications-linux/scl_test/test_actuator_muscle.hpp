@@ -0,0 +1,30 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_actuator_muscle.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef TEST_ACTUATOR_MUSCLE_HPP_
+#define TEST_ACTUATOR_MUSCLE_HPP_
+
+namespace scl_test
+{
+  /** Runs a muscle actuated arm under a task controller and checks that
+   * the muscle set shares the controller's Jacobian cache : Its Jacobians
+   * match an uncached muscle set and the cache's saved walks go up. */
+  void test_actuator_muscle(int id);
+}
+
+#endif /* TEST_ACTUATOR_MUSCLE_HPP_ */
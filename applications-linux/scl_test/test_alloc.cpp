@@ -0,0 +1,163 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_alloc.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_alloc.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/robot/CRobot.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+#include <scl/util/CAllocTracker.hpp>
+#include <scl/util/CPerfStats.hpp>
+#include <scl/Init.hpp>
+#include <scl_ext/dynamics/scl_spatial/CDynamicsSclSpatial.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <sstream>
+#include <vector>
+#include <string>
+
+namespace scl_test
+{
+  void test_controller_alloc(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+
+    // The shipped controllers : {file, robot, controller}
+    const char* ctrls[][3] = {
+        {"Puma/PumaCfg.xml", "PumaBot", "PumaGcCtrl"},
+        {"Puma/PumaCfg.xml", "PumaBot", "opc"},
+        {"Barrett/wamCfg.xml", "wamBot", "wamGcCtrl"},
+        {"Barrett/wamCfg.xml", "wamBot", "opc"},
+        {"Stanbot/StanbotCfg.xml", "Stanbot", "StanbotGcCtrl"},
+        {"Stanbot/StanbotCfg.xml", "Stanbot", "opc"},
+        {"Pr2/Pr2Cfg.xml", "Pr2Bot", "Pr2GcCtrl"},
+        {"Pr2/Pr2Cfg.xml", "Pr2Bot", "opc"} };
+    const int n_ctrls = sizeof(ctrls)/sizeof(ctrls[0]);
+    const int n_warmup = 500, n_ticks = 2000;
+
+    try
+    {
+      if(false == scl::CAllocTracker::getHooksInstalled())
+      { throw(std::runtime_error("The malloc hooks aren't linked in (add util/CAllocTrackerHooks.cpp to the build)"));  }
+
+      scl::SDatabase * db = scl::CDatabase::getData();
+      if(S_NULL==db)
+      { throw(std::runtime_error("Database not initialized."));  }
+      else
+      { std::cout<<"\nTest Result ("<<r_id++<<")  Initialized database"<<std::flush;  }
+      db->dir_specs_ = db->cwd_ + std::string("../../specs/");
+
+      flag = scl::init::registerNativeDynamicTypes();
+      if(false == flag)
+      { throw(std::runtime_error("Could not register native dynamic types"));  }
+
+      int n_failed = 0;
+      std::string file_parsed("");
+      for(int c=0; c<n_ctrls; ++c)
+      {
+        const std::string file = db->dir_specs_ + ctrls[c][0];
+        const std::string name = std::string(ctrls[c][1]) + "::" + ctrls[c][2];
+
+        if(file != file_parsed)
+        {
+          scl::CParserScl tmp_lparser;
+          flag = scl_registry::parseEverythingInFile(file, &tmp_lparser);
+          if(false == flag)
+          { throw(std::runtime_error(std::string("Could not parse : ") + file));  }
+          file_parsed = file;
+        }
+
+        scl::SRobotParsed *rob_ds = db->s_parser_.robots_.at(ctrls[c][1]);
+        if(S_NULL == rob_ds)
+        { throw(std::runtime_error(std::string("Could not find robot : ") + ctrls[c][1]));  }
+
+        // The robot deletes these
+        scl::CDynamicsScl* dyn_scl = new scl::CDynamicsScl();
+        scl_ext::CDynamicsSclSpatial* dyn_sp = new scl_ext::CDynamicsSclSpatial();
+        flag = dyn_scl->init(*rob_ds);
+        flag = flag && dyn_sp->init(*rob_ds);
+
+        scl::CRobot robot;
+        flag = flag && robot.initFromDb(ctrls[c][1], dyn_scl, dyn_sp);
+        flag = flag && robot.setControllerCurrent(ctrls[c][2]);
+        if(false == flag)
+        { throw(std::runtime_error(std::string("Could not initialize : ") + name));  }
+
+        // Warm up : Sizes all the matrices, registers the timers etc.
+        for(int i=0; i<n_warmup; ++i)
+        { robot.computeDynamics(); robot.computeServo(); robot.integrateDynamics(); }
+
+        // Count the allocations in each part of the tick (this thread only)
+        scl::SAllocCount a0, a1;
+        scl::sLongLong n_servo = 0, n_model = 0, n_integ = 0;
+        scl::CAllocTracker::reset();
+        scl::CAllocTracker::setEnabled(true);
+        for(int i=0; i<n_ticks; ++i)
+        {
+          a0 = scl::CAllocTracker::getThreadCount();
+          robot.computeDynamics();
+          a1 = scl::CAllocTracker::getThreadCount();
+          n_model += a1.allocs_ - a0.allocs_;
+
+          robot.computeServo();
+          a0 = scl::CAllocTracker::getThreadCount();
+          n_servo += a0.allocs_ - a1.allocs_;
+
+          robot.integrateDynamics();
+          a1 = scl::CAllocTracker::getThreadCount();
+          n_integ += a1.allocs_ - a0.allocs_;
+        }
+        scl::CAllocTracker::setEnabled(false);
+
+        std::cout<<"\nTest Result ("<<r_id++<<")  "<<name<<" : "<<n_ticks<<" ticks. Allocations : servo "
+            <<n_servo<<", model "<<n_model<<", integrator "<<n_integ;
+        if(0 < n_servo + n_model + n_integ)
+        {
+          std::stringstream ss;
+          scl::CAllocTracker::print(ss);
+          std::cout<<ss.str();
+        }
+        if(0 < n_servo)
+        {
+          std::cout<<"\nTest Result ("<<r_id++<<")  ERROR : "<<name<<"'s servo allocates";
+          n_failed++;
+        }
+      }
+
+      if(0 < n_failed)
+      {
+        std::stringstream ss;
+        ss<<n_failed<<" controller servo(s) allocate in the steady state";
+        throw(std::runtime_error(ss.str()));
+      }
+
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      scl::CAllocTracker::setEnabled(false);
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
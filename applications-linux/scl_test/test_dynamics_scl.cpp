@@ -29,6 +29,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <scl/dynamics/scl/CDynamicsScl.hpp>
 
 #include <scl/dynamics/analytic/CDynamicsAnalyticRPP.hpp>
+#include <scl/dynamics/CJacobianCache.hpp>
 
 #include <iostream>
 #include <stdexcept>
@@ -450,6 +451,50 @@ namespace scl_test
             <<pow(double(int(6.28/double(gcstep))),3)*3.0/(t2-t1)<<" Hz";
         gcstep = gcstep * 2.0;
 
+        // *********************************************************************************************************
+        //                                Test Jacobian Cache (offset Jacobians)
+        // *********************************************************************************************************
+#ifdef DEBUG
+        std::cout<<"\n\n *** Testing cached Jacobians for a variety of GCs *** ";
+#endif
+        scl::CJacobianCache jcache;
+        flag = jcache.init(&dynamics, rob_gc_model.dof_robot_);
+        if (false==flag) { throw(std::runtime_error("Failed to initialize the Jacobian cache."));  }
+
+        Eigen::MatrixXd J_cached;
+        for (double a=-3.14;a<3.14;a+=gcstep)
+          for (double b=-3.14;b<3.14;b+=gcstep)
+            for (double c=-3.14;c<3.14;c+=gcstep)
+            {
+              q<<a,b,c;
+              flag = dynamics.computeTransformsForAllLinks(rob_gc_model.rbdyn_tree_,q);
+              jcache.invalidate();
+              for(it = rob_gc_model.rbdyn_tree_.begin(), ite = rob_gc_model.rbdyn_tree_.end();
+                  it!=ite; ++it)
+              {
+                if(it->link_ds_->is_root_) { continue; }
+                //Twice per link : At the com and at the link origin (second one is a cache hit)
+                for(int k=0; k<2; ++k)
+                {
+                  if(0==k) { pos = it->link_ds_->com_; } else { pos.setZero(3); }
+                  flag = dynamics.computeJacobian(Jcom_scl, *it, q, pos);
+                  flag = flag && jcache.computeJacobian(J_cached, *it, q, pos);
+                  if (false==flag) { throw(std::runtime_error("Failed to compute a Jacobian."));  }
+                  if ((Jcom_scl - J_cached).cwiseAbs().maxCoeff() > test_precision)
+                  {
+                    std::cout<<"\nGeneralized Coordinates: "<<q.transpose();
+                    std::cout<<"\nScl J_"<<it->name_<<":\n"<<Jcom_scl;
+                    std::cout<<"\nCached J_"<<it->name_<<":\n"<<J_cached;
+                    throw(std::runtime_error("Scl and cached Jacobians don't match."));
+                  }
+                }
+              }
+            }
+        if(jcache.getChainWalks() != jcache.getChainWalksSaved())
+        { throw(std::runtime_error("Jacobian cache didn't reuse the link Jacobians.")); }
+        std::cout<<"\nTest Result ("<<r_id++<<")  Scl and cached Jacobians match for all links and gcs [-pi,pi]. "
+            <<"Chain walks : "<<jcache.getChainWalks()<<", saved : "<<jcache.getChainWalksSaved();
+
 
         // *********************************************************************************************************
         //                                         Test Generalized Inertia Matrix
@@ -0,0 +1,151 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_env_batch.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_env_batch.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/robot/CRobotEnvBatch.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/Init.hpp>
+
+#include <sutil/CSystemClock.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+namespace scl_test
+{
+  void test_env_batch(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+    const scl::sUInt n_envs = 16, n_ticks = 3000;
+    const scl::sFloat dt = 0.001;
+
+    try
+    {
+      scl::SDatabase * db = scl::CDatabase::getData();
+      if(S_NULL==db)
+      { throw(std::runtime_error("Database not initialized."));  }
+      else
+      { std::cout<<"\nTest Result ("<<r_id++<<")  Initialized database"<<std::flush;  }
+      db->dir_specs_ = db->cwd_ + std::string("../../specs/");
+
+      flag = scl::init::registerNativeDynamicTypes();
+      if(false == flag)
+      { throw(std::runtime_error("Could not register native dynamic types"));  }
+
+      scl::CParserScl tmp_lparser;
+      flag = scl_registry::parseEverythingInFile(db->dir_specs_ + "Puma/PumaCfg.xml", &tmp_lparser);
+      if(false == flag)
+      { throw(std::runtime_error("Could not parse the Puma"));  }
+
+      const scl::SRobotParsed *rob_ds = db->s_parser_.robots_.at("PumaBot");
+      if(S_NULL == rob_ds)
+      { throw(std::runtime_error("Could not find the Puma"));  }
+
+      // Use the gains of the Puma's gc controller
+      std::vector<scl::SControllerBase*> ctrls;
+      db->s_controller_.getControllersForRobot("PumaBot", ctrls);
+      const scl::SControllerGc* ctrl_ds = S_NULL;
+      for(size_t i=0; i<ctrls.size() && S_NULL == ctrl_ds; ++i)
+      { ctrl_ds = dynamic_cast<const scl::SControllerGc*>(ctrls[i]); }
+      if(S_NULL == ctrl_ds)
+      { throw(std::runtime_error("Could not find a gc controller for the Puma"));  }
+
+      const scl::sUInt dof = rob_ds->dof_;
+      scl::CRobotEnvBatch batch, batch_1thread;
+      flag = batch.init(*rob_ds, *ctrl_ds, n_envs, dt);
+      flag = flag && batch_1thread.init(*rob_ds, *ctrl_ds, n_envs, dt, 1, 1);
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the environments"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Initialized "<<n_envs<<" environments on "
+          <<batch.getNumThreads()<<" threads";
+
+      // ********** 1. Reach the goals **********
+      scl::CRobotEnvBatch::MatrixEnv goals(n_envs, dof);
+      for(scl::sUInt i=0; i<n_envs; ++i)
+      { goals.row(i).setConstant(0.05*i - 0.4); }
+
+      batch.seedAll(3);
+      flag = batch.resetAll(0.3);
+      flag = flag && batch.setGoals(goals);
+      if(false == flag)
+      { throw(std::runtime_error("Could not reset the environments and set their goals"));  }
+      if(batch.getQ().row(0) == batch.getQ().row(1))
+      { throw(std::runtime_error("Differently seeded environments started at the same state"));  }
+
+      scl::sFloat t = sutil::CSystemClock::getSysTime();
+      flag = batch.step(n_ticks);
+      t = sutil::CSystemClock::getSysTime() - t;
+      if(false == flag)
+      { throw(std::runtime_error("Could not step the environments"));  }
+
+      const double err = (batch.getQ() - goals).cwiseAbs().maxCoeff();
+      std::cout<<"\nTest Result ("<<r_id++<<")  "<<n_envs*n_ticks/t<<" env steps/sec. Max goal error after "
+          <<n_ticks*dt<<"s : "<<err;
+      if(err > 0.05)
+      { throw(std::runtime_error("The environments didn't reach their goals"));  }
+      if(n_ticks*dt != batch.getTime(0))
+      { throw(std::runtime_error("Miscounted an environment's time"));  }
+
+      // Row i is environment i, contiguous
+      if(batch.getQ().data()[3*dof+2] != batch.getIO(3)->sensors_.q_(2))
+      { throw(std::runtime_error("The state array isn't laid out a row per environment"));  }
+
+      // ********** 2. Seeded runs repeat on any number of threads **********
+      batch_1thread.seedAll(3);
+      flag = batch_1thread.resetAll(0.3);
+      flag = flag && batch_1thread.setGoals(goals);
+      flag = flag && batch_1thread.step(n_ticks);
+      if(false == flag)
+      { throw(std::runtime_error("Could not run the single threaded environments"));  }
+      if(batch.getQ() != batch_1thread.getQ() || batch.getDq() != batch_1thread.getDq())
+      { throw(std::runtime_error("A seeded run didn't repeat on one thread"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Seeded runs repeat on 1 and "<<batch.getNumThreads()<<" threads";
+
+      // ********** 3. Resetting one environment leaves the others alone **********
+      const scl::CRobotEnvBatch::MatrixEnv q_before = batch.getQ();
+      const Eigen::VectorXd q_new = Eigen::VectorXd::Constant(dof, 0.2);
+      flag = batch.reset(2, q_new, Eigen::VectorXd::Zero(dof));
+      if(false == flag || batch.getQ().row(2).transpose() != q_new || 0 != batch.getTime(2))
+      { throw(std::runtime_error("Could not reset an environment"));  }
+      for(scl::sUInt i=0; i<n_envs; ++i)
+      {
+        if(2 != i && batch.getQ().row(i) != q_before.row(i))
+        { throw(std::runtime_error("Resetting an environment changed another"));  }
+      }
+
+      if(batch.setGoals(goals.topRows(n_envs-1)) || batch.setGoal(n_envs, q_new) ||
+          batch.reset(0, Eigen::VectorXd::Zero(dof+1), Eigen::VectorXd::Zero(dof)))
+      { throw(std::runtime_error("Accepted a command of the wrong size"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Resets one environment at a time and rejects bad sizes";
+
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
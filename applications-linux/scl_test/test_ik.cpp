@@ -0,0 +1,166 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_ik.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_ik.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+#include <scl/dynamics/scl/CInverseKinematicsScl.hpp>
+
+#include <sutil/CSystemClock.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+
+namespace scl_test
+{
+  void test_ik(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+
+    const int n_targets = 2000;
+
+    try
+    {
+      scl::SDatabase * db = scl::CDatabase::getData();
+      if(S_NULL==db)
+      { throw(std::runtime_error("Database not initialized."));  }
+      else
+      { std::cout<<"\nTest Result ("<<r_id++<<")  Initialized database"<<std::flush;  }
+      db->dir_specs_ = db->cwd_ + std::string("../../specs/");
+
+      scl::CParserScl tmp_lparser;
+      flag = scl_registry::parseRobot(db->dir_specs_ + "Puma/PumaCfg.xml", "PumaBot", &tmp_lparser);
+      if(false == flag)
+      { throw(std::runtime_error("Could not register the Puma with the database"));  }
+
+      scl::SRobotParsed *rob_ds = db->s_parser_.robots_.at("PumaBot");
+      if(S_NULL == rob_ds)
+      { throw(std::runtime_error("Could not find the Puma in the database"));  }
+
+      scl::CDynamicsScl dynamics;
+      flag = dynamics.init(*rob_ds);
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize scl dynamics"));  }
+
+      // ********** 1. Batched, parallel solves (position + orientation) **********
+      scl::CInverseKinematicsScl ik;
+      flag = ik.init(*rob_ds, &dynamics);
+      flag = flag && ik.addOpPoint("end-effector", Eigen::Vector3d(0,0,0.1), true);
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the ik solver"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Initialized the ik solver with "
+          <<ik.getNumThreads()<<" threads";
+
+      // Goals that random configurations reach, and seeds near them.
+      srand(1);
+      std::vector<scl::SIkTarget> targets(n_targets);
+      std::vector<Eigen::VectorXd> seeds(n_targets), q_ik;
+      std::vector<scl::SIkStats> stats;
+      for(int i=0; i<n_targets; ++i)
+      {
+        Eigen::VectorXd q = Eigen::VectorXd::Random(rob_ds->dof_) * 2.5;
+        ik.computeOpPoints(q, targets[i]);
+        seeds[i] = q + Eigen::VectorXd::Random(rob_ds->dof_) * 0.3;
+      }
+
+      scl::sFloat t1 = sutil::CSystemClock::getSysTime();
+      ik.solveBatch(targets, seeds, q_ik, stats);
+      scl::sFloat t2 = sutil::CSystemClock::getSysTime();
+
+      int n_converged = 0; scl::sLongLong n_iters = 0;
+      for(int i=0; i<n_targets; ++i)
+      {
+        n_iters += stats[i].iterations_;
+        if(false == stats[i].converged_) { continue; }
+        n_converged++;
+
+        // Check the solutions independently
+        scl::SIkTarget x;
+        ik.computeOpPoints(q_ik[i], x);
+        if((x.pos_[0] - targets[i].pos_[0]).norm() > 2*ik.getOptions().tol_pos_)
+        { throw(std::runtime_error("A converged solution doesn't reach its goal"));  }
+      }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Batch ik : "<<n_converged<<"/"<<n_targets
+          <<" converged. Avg iterations "<<static_cast<double>(n_iters)/n_targets
+          <<". Time per solve "<<(t2-t1)*1e6/n_targets<<"us";
+      // A few goals are close to singularities, where damped least squares crawls.
+      if(n_converged < 0.99*n_targets)
+      { throw(std::runtime_error("Too many goals didn't converge"));  }
+
+      // ********** 2. Single solves (position only) **********
+      scl::CInverseKinematicsScl ik_pos;
+      flag = ik_pos.init(*rob_ds, &dynamics, 1);
+      flag = flag && ik_pos.addOpPoint("end-effector", Eigen::Vector3d::Zero());
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the position only ik solver"));  }
+
+      scl::SIkTarget target; scl::SIkStats stat;
+      Eigen::VectorXd q_sol, q_zero;
+      q_zero.setZero(rob_ds->dof_);
+      target.pos_.push_back(Eigen::Vector3d(0.2, 0.3, 0.1));
+      flag = ik_pos.solve(target, q_zero, q_sol, stat);
+      if(false == flag)
+      { throw(std::runtime_error("Single position goal didn't converge"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Position goal converged in "<<stat.iterations_
+          <<" iterations. Error "<<stat.err_pos_;
+
+      // Out of reach : Shouldn't converge, but should get as close as it can.
+      target.pos_[0] = Eigen::Vector3d(5, 0, 0);
+      flag = ik_pos.solve(target, q_zero, q_sol, stat);
+      if(flag || false == stat.err_pos_ < 5.0)
+      { throw(std::runtime_error("Out of reach goal misbehaved"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Out of reach goal stopped with error "<<stat.err_pos_;
+
+      // ********** 3. Gc limits **********
+      rob_ds->gc_pos_limit_max_.setConstant(rob_ds->dof_, 0.5);
+      rob_ds->gc_pos_limit_min_.setConstant(rob_ds->dof_, -0.5);
+      scl::CInverseKinematicsScl ik_lim;
+      flag = ik_lim.init(*rob_ds, &dynamics, 1);
+      flag = flag && ik_lim.addOpPoint("end-effector", Eigen::Vector3d::Zero());
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the limited ik solver"));  }
+
+      for(int i=0; i<100; ++i)
+      {
+        Eigen::VectorXd q = Eigen::VectorXd::Random(rob_ds->dof_) * 2.5;
+        ik_pos.computeOpPoints(q, target);
+        ik_lim.solve(target, q_zero, q_sol, stat);
+        if(q_sol.cwiseAbs().maxCoeff() > 0.5)
+        { throw(std::runtime_error("A solution violates the gc limits"));  }
+      }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Solutions respect the gc limits";
+
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
@@ -0,0 +1,169 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_inverse_dynamics_batch.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_inverse_dynamics_batch.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/data_structs/SGcModel.hpp>
+#include <scl/util/CLoggerBinary.hpp>
+#include <scl_ext/dynamics/scl_spatial/CDynamicsSclSpatial.hpp>
+#include <scl_ext/dynamics/scl_spatial/CInverseDynamicsBatch.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+namespace scl_test
+{
+  void test_inverse_dynamics_batch(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+
+    const std::string file_in("./test_id_batch_in.log"), file_out("./test_id_batch_out.log");
+    const scl::sLongLong n_rows = 200000;
+    const double test_precision = 1e-9;
+
+    try
+    {
+      scl::SDatabase * db = scl::CDatabase::getData();
+      if(S_NULL==db)
+      { throw(std::runtime_error("Database not initialized."));  }
+      else
+      { std::cout<<"\nTest Result ("<<r_id++<<")  Initialized database"<<std::flush;  }
+      db->dir_specs_ = db->cwd_ + std::string("../../specs/");
+
+      scl::CParserScl tmp_lparser;
+      const scl::SRobotParsed *rob_ds = scl_registry::parseRobot(
+          db->dir_specs_ + "Puma/PumaCfg.xml", "PumaBot", &tmp_lparser);
+      if(S_NULL == rob_ds)
+      { throw(std::runtime_error("Could not register the Puma with the database"));  }
+      const scl::sUInt dof = rob_ds->dof_;
+
+      // ********** 1. Match the spatial dynamics engine's NER **********
+      scl_ext::CDynamicsSclSpatial dyn_sp;
+      scl::SGcModel gc_model;
+      flag = dyn_sp.init(*rob_ds);
+      flag = flag && gc_model.init(*rob_ds);
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the spatial dynamics"));  }
+
+      scl_ext::CInverseDynamicsBatch id_batch;
+      flag = id_batch.init(*rob_ds);
+      if(false == flag || dof != id_batch.getDof())
+      { throw(std::runtime_error("Could not initialize the batch inverse dynamics"));  }
+
+      srand(7);
+      scl::SRobotIO io;
+      Eigen::VectorXd f_ner, f_batch;
+      double err_max = 0;
+      for(int i=0; i<1000; ++i)
+      {
+        io.sensors_.q_ = Eigen::VectorXd::Random(dof) * M_PI;
+        io.sensors_.dq_ = Eigen::VectorXd::Random(dof) * 2;
+        io.sensors_.ddq_ = Eigen::VectorXd::Random(dof) * 5;
+        flag = dyn_sp.inverseDynamicsNER(&io, &gc_model, f_ner);
+        flag = flag && id_batch.computeTorques(io.sensors_.q_, io.sensors_.dq_, io.sensors_.ddq_, f_batch);
+        if(false == flag)
+        { throw(std::runtime_error("Could not compute inverse dynamics"));  }
+        err_max = std::max(err_max, (f_ner - f_batch).cwiseAbs().maxCoeff());
+      }
+      if(err_max > test_precision)
+      { throw(std::runtime_error("Batch inverse dynamics don't match the NER"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Matches the NER for 1000 random states. Max error : "<<err_max;
+
+      // ********** 2. Stream a log through it **********
+      std::remove(file_in.c_str()); std::remove(file_out.c_str());
+      scl::CLoggerBinary logger;
+      const scl::sInt c_t = logger.addColumn("t_sim",1), c_q = logger.addColumn("q",dof),
+          c_dq = logger.addColumn("dq",dof), c_ddq = logger.addColumn("ddq",dof);
+      if(0 > c_t || 0 > c_q || 0 > c_dq || 0 > c_ddq || false == logger.open(file_in, 8192))
+      { throw(std::runtime_error("Could not create a test log"));  }
+
+      // Rows are smooth functions of time (so row i can be checked later)
+      Eigen::VectorXd q(dof), dq(dof), ddq(dof);
+      for(scl::sLongLong i=0; i<n_rows; ++i)
+      {
+        const double t = i*0.001;
+        for(scl::sUInt j=0; j<dof; ++j)
+        { q(j) = std::sin(t+j); dq(j) = std::cos(t+j); ddq(j) = -std::sin(t+j); }
+        double* row;
+        while(S_NULL == (row = logger.beginRow())) { std::this_thread::yield(); }
+        logger.setColumn(row, c_t, t);
+        logger.setColumn(row, c_q, q);
+        logger.setColumn(row, c_dq, dq);
+        logger.setColumn(row, c_ddq, ddq);
+        logger.endRow();
+      }
+      logger.close();
+
+      scl_ext::SIdBatchStats stats;
+      flag = id_batch.processLog(file_in, file_out, 4096, &stats);
+      if(false == flag || n_rows != stats.rows_)
+      { throw(std::runtime_error("Could not process the log"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Processed "<<stats.rows_<<" rows on "<<id_batch.getNumThreads()
+          <<" threads in "<<stats.t_total_<<"s ("<<stats.rate()<<" rows/s)";
+
+      // ********** 3. Check the output **********
+      FILE* f = fopen(file_out.c_str(), "rb");
+      std::vector<scl::SLogColumn> cols;
+      scl::sUInt row_doubles, header_bytes;
+      flag = scl::CLoggerBinary::readHeader(f, cols, row_doubles, header_bytes);
+      if(false == flag || 2 != cols.size() || "t_sim" != cols[0].name_ ||
+          "force_gc_id" != cols[1].name_ || dof + 1 != row_doubles)
+      { if(f) { fclose(f); } throw(std::runtime_error("The output log's schema is wrong"));  }
+
+      std::vector<double> row(row_doubles);
+      err_max = 0;
+      for(scl::sLongLong i=0; i<n_rows; ++i)
+      {
+        if(1 != fread(row.data(), row_doubles*sizeof(double), 1, f))
+        { fclose(f); throw(std::runtime_error("The output log is too short"));  }
+        if(0 != i%997) { continue; }
+        const double t = i*0.001;
+        for(scl::sUInt j=0; j<dof; ++j)
+        { q(j) = std::sin(t+j); dq(j) = std::cos(t+j); ddq(j) = -std::sin(t+j); }
+        id_batch.computeTorques(q, dq, ddq, f_batch);
+        err_max = std::max(err_max, (Eigen::Map<Eigen::VectorXd>(row.data()+1, dof) - f_batch).cwiseAbs().maxCoeff());
+        if(row[0] != t)
+        { fclose(f); throw(std::runtime_error("The output's rows don't match the input's"));  }
+      }
+      fclose(f);
+      if(err_max > test_precision)
+      { throw(std::runtime_error("The output log's forces are wrong"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  The output log matches row by row. Max error : "<<err_max;
+
+      std::remove(file_in.c_str()); std::remove(file_out.c_str());
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      std::remove(file_in.c_str()); std::remove(file_out.c_str());
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
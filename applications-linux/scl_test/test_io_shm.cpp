@@ -0,0 +1,232 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_io_shm.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_io_shm.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/io/CIOShm.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+namespace scl_test
+{
+  static double elapsedSec(const std::chrono::steady_clock::time_point& arg_t0)
+  { return std::chrono::duration<double>(std::chrono::steady_clock::now() - arg_t0).count(); }
+
+  void test_io_shm(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+    const double test_precision = 0.0; // Binary copies. Must be exact.
+    const int n_lat = 20000, n_ping = 2000;
+
+    scl::CIOShm io;
+    scl::SIOShm ds;
+    // Don't touch the apps' segment
+    ds.name_ = "/scl_io_test";
+
+    try
+    {
+      io.unlink(ds); // Start empty. Fails if it doesn't exist, which is fine.
+      if(false == io.connect(ds))
+      { throw(std::runtime_error("Could not connect to shared memory"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Connected to shared memory "<<ds.name_;
+
+      // ********** 1. Round trip each value type **********
+      Eigen::VectorXd v(7), v_ret(2); // v_ret has to grow
+      v<<1.0/3.0, -2.5e-300, 1e300, 0.0, -0.0, 3.14159265358979, 42;
+      Eigen::Vector3d v3(0.1, -0.2, 0.3), v3_ret;
+      std::string str("scl::robot::test::sensors::q"), str_ret;
+      int i_ret = 0;
+      bool b_ret = false;
+
+      flag = io.set(ds, "test::vec", v) && io.get(ds, "test::vec", v_ret);
+      if(false == flag || v.rows() != v_ret.rows() || (v-v_ret).cwiseAbs().maxCoeff() > test_precision)
+      { throw(std::runtime_error("Could not round trip a vector"));  }
+      v.conservativeResize(3);
+      flag = io.set(ds, "test::vec", v) && io.get(ds, "test::vec", v_ret);
+      if(false == flag || 3 != v_ret.rows() || (v-v_ret).cwiseAbs().maxCoeff() > test_precision)
+      { throw(std::runtime_error("Could not round trip a vector that shrank"));  }
+
+      flag = io.set(ds, "test::vec3", v3) && io.get(ds, "test::vec3", v3_ret);
+      if(false == flag || (v3-v3_ret).cwiseAbs().maxCoeff() > test_precision)
+      { throw(std::runtime_error("Could not round trip a 3d vector"));  }
+
+      flag = io.set(ds, "test::str", str) && io.get(ds, "test::str", str_ret);
+      if(false == flag || str != str_ret)
+      { throw(std::runtime_error("Could not round trip a string"));  }
+
+      flag = io.set(ds, "test::int", -12345) && io.get(ds, "test::int", i_ret);
+      if(false == flag || -12345 != i_ret)
+      { throw(std::runtime_error("Could not round trip an int"));  }
+
+      flag = io.set(ds, "test::bool", true) && io.get(ds, "test::bool", b_ret);
+      if(false == flag || true != b_ret)
+      { throw(std::runtime_error("Could not round trip a bool"));  }
+
+      if(io.get(ds, "test::str", i_ret) || io.get(ds, "test::int", str_ret))
+      { throw(std::runtime_error("Read a key as the wrong type"));  }
+      Eigen::VectorXd v_big(SCL_MAX_SHM_VAL_BYTES/sizeof(double)+1);
+      v_big.setZero();
+      if(io.set(ds, "test::big", v_big))
+      { throw(std::runtime_error("Set a value bigger than a slot"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Round tripped vector, 3d vector, string, int and bool keys";
+
+      // ********** 2. Deleting a key frees its slot **********
+      io.del(ds, "test::vec"); io.del(ds, "test::vec3"); io.del(ds, "test::str");
+      io.del(ds, "test::int"); io.del(ds, "test::bool");
+      if(io.get(ds, "test::int", i_ret))
+      { throw(std::runtime_error("Read a deleted key"));  }
+
+      for(int i=0; i<SCL_MAX_SHM_KEYS; ++i)
+      {
+        std::stringstream ss; ss<<"test::fill::"<<i;
+        if(false == io.set(ds, ss.str().c_str(), i))
+        { throw(std::runtime_error(std::string("Could not fill the segment at ")+ss.str()));  }
+      }
+      if(io.set(ds, "test::one_too_many", 1))
+      { throw(std::runtime_error("Set a key in a full segment"));  }
+      if(false == io.del(ds, "test::fill::17"))
+      { throw(std::runtime_error("Could not delete a key"));  }
+      flag = io.set(ds, "test::one_too_many", 1) && io.get(ds, "test::one_too_many", i_ret);
+      if(false == flag || 1 != i_ret)
+      { throw(std::runtime_error("Deleting a key didn't free its slot"));  }
+      // The other keys are still there
+      flag = io.get(ds, "test::fill::18", i_ret) && (18 == i_ret);
+      if(false == flag || io.get(ds, "test::fill::17", i_ret))
+      { throw(std::runtime_error("Deleting a key changed the other keys"));  }
+
+      for(int i=0; i<SCL_MAX_SHM_KEYS; ++i)
+      { std::stringstream ss; ss<<"test::fill::"<<i; io.del(ds, ss.str().c_str()); }
+      io.del(ds, "test::one_too_many");
+      std::cout<<"\nTest Result ("<<r_id++<<")  Filled all "<<SCL_MAX_SHM_KEYS
+          <<" slots. Deleting a key freed its slot for a new key";
+
+      // ********** 3. Waiting for updates **********
+      unsigned int seq;
+      flag = io.set(ds, "test::ping", 0) && io.getSeq(ds, "test::ping", seq);
+      if(false == flag)
+      { throw(std::runtime_error("Could not get a key's sequence counter"));  }
+      if(io.waitForUpdate(ds, "test::no_such_key", 0, 0.01))
+      { throw(std::runtime_error("Waited for a key that doesn't exist"));  }
+
+      std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+      if(io.waitForUpdate(ds, "test::ping", seq, 0.02))
+      { throw(std::runtime_error("waitForUpdate returned without an update"));  }
+      double t = elapsedSec(t0);
+      if(t < 0.02)
+      { throw(std::runtime_error("waitForUpdate returned before its timeout"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  waitForUpdate timed out after "<<t<<"s (timeout 0.02s)";
+
+      // Another thread (with its own mapping, like another process) sets the key
+      std::thread writer([&]()
+      {
+        scl::CIOShm io_w; scl::SIOShm ds_w; ds_w.name_ = ds.name_;
+        if(false == io_w.connect(ds_w)) { return; }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        io_w.set(ds_w, "test::ping", 1);
+        io_w.disconnect(ds_w);
+      });
+      t0 = std::chrono::steady_clock::now();
+      flag = io.waitForUpdate(ds, "test::ping", seq, 2.0);
+      t = elapsedSec(t0);
+      writer.join();
+      if(false == flag || false == io.get(ds, "test::ping", i_ret) || 1 != i_ret)
+      { throw(std::runtime_error("waitForUpdate didn't return the other thread's set"));  }
+      if(t > 1.0)
+      { throw(std::runtime_error("waitForUpdate didn't wake up on the other thread's set"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  waitForUpdate woke up "<<t<<"s after the wait started (set at 0.02s)";
+
+      // ********** 4. Latency **********
+      // One thread : A set and a get (what a poll costs)
+      v.setRandom(6); v_ret.setZero(6);
+      t0 = std::chrono::steady_clock::now();
+      for(int i=0; i<n_lat; ++i)
+      {
+        v(0) = i;
+        io.set(ds, "test::lat", v);
+        io.get(ds, "test::lat", v_ret);
+      }
+      t = elapsedSec(t0)/n_lat;
+      if(v(0) != v_ret(0))
+      { throw(std::runtime_error("Read a stale value"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Set + get round trip (6 dof) : "<<t*1e6<<" usec";
+      if(t > 10e-6)
+      { throw(std::runtime_error("The set + get round trip isn't in single digit microseconds"));  }
+
+      // Two threads : ping -> pong -> ping, each side blocked in waitForUpdate
+      // (like a controller waiting for the simulator's sensors).
+      io.set(ds, "test::pong", 0);
+      std::atomic<bool> flag_pong_ready(false);
+      std::thread pong([&]()
+      {
+        scl::CIOShm io_p; scl::SIOShm ds_p; ds_p.name_ = ds.name_;
+        if(false == io_p.connect(ds_p)) { return; }
+        unsigned int s; int x;
+        io_p.getSeq(ds_p, "test::ping", s);
+        flag_pong_ready = true;
+        for(int i=0; i<n_ping; ++i)
+        {
+          if(false == io_p.waitForUpdate(ds_p, "test::ping", s, 1.0)) { break; }
+          io_p.getSeq(ds_p, "test::ping", s);
+          io_p.get(ds_p, "test::ping", x);
+          io_p.set(ds_p, "test::pong", x);
+        }
+        io_p.disconnect(ds_p);
+      });
+      while(false == flag_pong_ready) { std::this_thread::yield(); }
+
+      std::vector<double> t_rt;
+      t_rt.reserve(n_ping);
+      for(int i=0; i<n_ping; ++i)
+      {
+        io.getSeq(ds, "test::pong", seq);
+        t0 = std::chrono::steady_clock::now();
+        io.set(ds, "test::ping", i+2);
+        if(false == io.waitForUpdate(ds, "test::pong", seq, 1.0) ||
+            false == io.get(ds, "test::pong", i_ret) || i+2 != i_ret)
+        { pong.join(); throw(std::runtime_error("Lost a ping pong message"));  }
+        t_rt.push_back(elapsedSec(t0));
+      }
+      pong.join();
+      std::sort(t_rt.begin(), t_rt.end());
+      std::cout<<"\nTest Result ("<<r_id++<<")  Two thread round trip (usec) : median "<<t_rt[n_ping/2]*1e6
+          <<", p99 "<<t_rt[(n_ping*99)/100]*1e6<<", max "<<t_rt.back()*1e6
+          <<". Futex wakes : "<<ds.ctr_futex_wakes_<<". Read retries : "<<ds.ctr_read_retries_;
+
+      io.disconnect(ds);
+      io.unlink(ds);
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      io.disconnect(ds);
+      io.unlink(ds);
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
@@ -0,0 +1,137 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_loop_scheduler.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_loop_scheduler.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/util/CLoopScheduler.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <cmath>
+#include <chrono>
+#include <thread>
+
+namespace scl_test
+{
+  static double elapsedSec(const std::chrono::steady_clock::time_point& arg_t0)
+  { return std::chrono::duration<double>(std::chrono::steady_clock::now() - arg_t0).count(); }
+
+  void test_loop_scheduler(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+    // Coarse enough for a loaded (non rt) test machine
+    const double period = 0.005;
+    const int n_ticks = 40;
+
+    try
+    {
+      // ********** 1. Without init it runs free **********
+      scl::CLoopScheduler sched_free;
+      const int ph_free = sched_free.addPhase("free");
+      std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+      for(int i=0; i<n_ticks; ++i)
+      {
+        if(false == sched_free.hasTimeFor(ph_free))
+        { throw(std::runtime_error("A free running scheduler skipped a phase"));  }
+        sched_free.startPhase(ph_free); sched_free.endPhase(ph_free);
+        if(false == sched_free.waitForNextTick())
+        { throw(std::runtime_error("A free running scheduler overran"));  }
+      }
+      if(elapsedSec(t0) > n_ticks*period/2)
+      { throw(std::runtime_error("A free running scheduler slept"));  }
+      if(n_ticks != sched_free.getTicks() || 0 != sched_free.getOverruns() ||
+          0 != sched_free.getTicksDropped() || n_ticks != sched_free.getPhases()[ph_free].runs_)
+      { throw(std::runtime_error("A free running scheduler's counters are off"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Ran free without init. Counted "<<n_ticks<<" ticks";
+
+      // ********** 2. Bad periods fail **********
+      scl::CLoopScheduler sched;
+      flag = sched.init(0.0) || sched.init(-period);
+      if(flag || sched.hasBeenInit())
+      { throw(std::runtime_error("Initialized the scheduler with a bad period"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Rejected bad periods";
+
+      // ********** 3. The period **********
+      const int ph_work = sched.addPhase("work", period/5),
+          ph_opt = sched.addPhase("optional", 0, 1);
+      if(false == sched.init(period))
+      { throw(std::runtime_error("Could not initialize the scheduler"));  }
+      if(std::abs(sched.getPeriod() - period) > 1e-9)
+      { throw(std::runtime_error("The scheduler's period doesn't match the requested one"));  }
+
+      t0 = std::chrono::steady_clock::now();
+      for(int i=0; i<n_ticks; ++i)
+      {
+        sched.startPhase(ph_work); sched.endPhase(ph_work);
+        sched.waitForNextTick();
+      }
+      double t = elapsedSec(t0);
+      // The first deadline is one period after init
+      if(t < (n_ticks-1)*period || t > 2*n_ticks*period)
+      { throw(std::runtime_error("The loop didn't run at its period"));  }
+      if(n_ticks != sched.getTicks() || n_ticks != sched.getPhases()[ph_work].runs_ ||
+          0 != sched.getPhases()[ph_work].overruns_)
+      { throw(std::runtime_error("The tick or phase counters are off"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Ran "<<n_ticks<<" ticks in "<<t<<"s at a "<<period
+          <<"s period. Overran "<<sched.getOverruns()<<" times";
+
+      // ********** 4. Overruns drop the missed ticks **********
+      sched.resync();
+      const scl::sLongLong n_over = sched.getOverruns(), n_drop = sched.getTicksDropped();
+      sched.startPhase(ph_work);
+      std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long>(3.5*period*1e6)));
+      sched.endPhase(ph_work);
+      if(sched.waitForNextTick())
+      { throw(std::runtime_error("Didn't report an overrun for a tick that ran 3.5 periods"));  }
+      if(n_over+1 != sched.getOverruns())
+      { throw(std::runtime_error("Didn't count the overrun"));  }
+      // Ran 2.5 periods past the deadline : 3 deadlines passed, 2 were dropped
+      if(n_drop+2 > sched.getTicksDropped())
+      { throw(std::runtime_error("Didn't drop the missed ticks"));  }
+      if(1 != sched.getPhases()[ph_work].overruns_)
+      { throw(std::runtime_error("Didn't count the phase running over its budget"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Counted the overrun. Dropped "
+          <<sched.getTicksDropped()-n_drop<<" missed ticks. Counted the phase overrun";
+
+      // ********** 5. Optional phases are skipped after an overrun **********
+      if(sched.hasTimeFor(ph_opt))
+      { throw(std::runtime_error("Didn't skip the optional phase after an overrun"));  }
+      if(false == sched.hasTimeFor(ph_opt))
+      { throw(std::runtime_error("Skipped the optional phase more than its max in a row"));  }
+      if(1 != sched.getPhases()[ph_opt].skips_)
+      { throw(std::runtime_error("Didn't count the skip"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Skipped the optional phase once after the overrun";
+
+      // Back on time : The next tick catches up to a period boundary without a burst
+      t0 = std::chrono::steady_clock::now();
+      sched.waitForNextTick();
+      if(elapsedSec(t0) > 2*period)
+      { throw(std::runtime_error("The tick after an overrun waited too long"));  }
+
+      sched.printStats();
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
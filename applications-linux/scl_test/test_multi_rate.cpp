@@ -0,0 +1,181 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_multi_rate.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_multi_rate.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/robot/CRobot.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+#include <scl/control/task/CControllerMultiTask.hpp>
+#include <scl/Init.hpp>
+#include <scl_ext/dynamics/scl_spatial/CDynamicsSclSpatial.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <atomic>
+
+namespace scl_test
+{
+  /** Runs the model and the servo one after the other (lock step). Each
+   * servo tick must adopt the model computed from the state the previous
+   * servo tick handed over. */
+  static void runLockStep(scl::CRobot& arg_robot, scl::CControllerMultiTask& arg_ctrl,
+      const scl::CDynamicsBase& arg_dyn, const scl::SRobotParsed& arg_rob_ds, const int arg_ticks)
+  {
+    const double test_precision = 1e-10;
+    scl::SGcModel gcm_ref;
+    if(false == gcm_ref.init(arg_rob_ds))
+    { throw(std::runtime_error("Could not initialize the reference gc model"));  }
+    scl::SRobotSensors sensors_sent = arg_robot.getData()->io_data_->sensors_;
+
+    for(int i=0; i<arg_ticks; ++i)
+    {
+      const scl::sLongLong n_pub = arg_ctrl.getModelUpdatesPublished(),
+          n_adopt = arg_ctrl.getModelUpdatesAdopted();
+
+      arg_robot.computeDynamicsBuffered();
+      if(n_pub+1 != arg_ctrl.getModelUpdatesPublished())
+      { throw(std::runtime_error("The model thread didn't publish a model"));  }
+
+      arg_robot.computeServo();
+      if(n_adopt+1 != arg_ctrl.getModelUpdatesAdopted())
+      { throw(std::runtime_error("The servo didn't adopt the published model"));  }
+
+      // The first model was computed from the state before multi-rate mode was on
+      if(0 < i)
+      {
+        if(false == arg_dyn.computeGCModel(&sensors_sent, &gcm_ref))
+        { throw(std::runtime_error("Could not compute the reference gc model"));  }
+        const scl::SGcModel* gcm = arg_robot.getData()->controller_current_->gc_model_;
+        if((gcm->M_gc_ - gcm_ref.M_gc_).cwiseAbs().maxCoeff() > test_precision ||
+            (gcm->force_gc_grav_ - gcm_ref.force_gc_grav_).cwiseAbs().maxCoeff() > test_precision)
+        { throw(std::runtime_error("The adopted model doesn't match the model at the state the servo sent"));  }
+      }
+      sensors_sent.q_ = arg_robot.getData()->io_data_->sensors_.q_;
+      sensors_sent.dq_ = arg_robot.getData()->io_data_->sensors_.dq_;
+
+      arg_robot.integrateDynamics();
+    }
+  }
+
+  void test_multi_rate(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+    const int n_ticks_lock_step = 200, n_ticks_threaded = 3000;
+
+    try
+    {
+      scl::SDatabase * db = scl::CDatabase::getData();
+      if(S_NULL==db)
+      { throw(std::runtime_error("Database not initialized."));  }
+      else
+      { std::cout<<"\nTest Result ("<<r_id++<<")  Initialized database"<<std::flush;  }
+      db->dir_specs_ = db->cwd_ + std::string("../../specs/");
+
+      flag = scl::init::registerNativeDynamicTypes();
+      if(false == flag)
+      { throw(std::runtime_error("Could not register native dynamic types"));  }
+
+      scl::CParserScl tmp_lparser;
+      flag = scl_registry::parseEverythingInFile(db->dir_specs_ + "Puma/PumaCfg.xml", &tmp_lparser);
+      if(false == flag)
+      { throw(std::runtime_error("Could not parse the Puma"));  }
+
+      scl::SRobotParsed *rob_ds = db->s_parser_.robots_.at("PumaBot");
+      if(S_NULL == rob_ds)
+      { throw(std::runtime_error("Could not find the Puma"));  }
+
+      // The robot deletes these
+      scl::CDynamicsScl* dyn_scl = new scl::CDynamicsScl();
+      scl_ext::CDynamicsSclSpatial* dyn_sp = new scl_ext::CDynamicsSclSpatial();
+      flag = dyn_scl->init(*rob_ds);
+      flag = flag && dyn_sp->init(*rob_ds);
+
+      scl::CRobot robot;
+      flag = flag && robot.initFromDb("PumaBot", dyn_scl, dyn_sp);
+      flag = flag && robot.setControllerCurrent("opc");
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the Puma"));  }
+
+      scl::CControllerMultiTask* ctrl = dynamic_cast<scl::CControllerMultiTask*>(robot.getControllerCurrent());
+      if(S_NULL == ctrl)
+      { throw(std::runtime_error("The Puma's opc controller isn't a task controller"));  }
+
+      robot.computeDynamics();
+      robot.computeServo();
+      robot.integrateDynamics();
+
+      flag = robot.setFlagMultiRate(true);
+      if(false == flag || false == ctrl->getMultiRate())
+      { throw(std::runtime_error("Could not turn on multi-rate mode"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Turned on multi-rate mode";
+
+      // ********** 1. Lock step : Every published model is adopted **********
+      runLockStep(robot, *ctrl, *dyn_scl, *rob_ds, n_ticks_lock_step);
+      std::cout<<"\nTest Result ("<<r_id++<<")  Adopted all "<<n_ticks_lock_step
+          <<" published models in lock step. They match the model at the state the servo sent";
+
+      // ********** 2. Tasks can't change under the model thread **********
+      if(ctrl->removeTask("NullSpaceDampingTask") || S_NULL == ctrl->getTask("NullSpaceDampingTask"))
+      { throw(std::runtime_error("Removed a task in multi-rate mode"));  }
+
+      flag = robot.setFlagMultiRate(false);
+      flag = flag && ctrl->removeTask("NullSpaceDampingTask");
+      flag = flag && robot.setFlagMultiRate(true);
+      if(false == flag)
+      { throw(std::runtime_error("Could not remove a task with multi-rate mode off"));  }
+      runLockStep(robot, *ctrl, *dyn_scl, *rob_ds, n_ticks_lock_step);
+      std::cout<<"\nTest Result ("<<r_id++<<")  Rejected a task removal in multi-rate mode. Removed it with the mode off";
+
+      // ********** 3. Model and servo threads **********
+      const scl::sLongLong n_adopt = ctrl->getModelUpdatesAdopted();
+      std::atomic<bool> flag_run(true);
+      std::thread model_thread([&]() { while(flag_run) { robot.computeDynamicsBuffered(); } });
+      for(int i=0; i<n_ticks_threaded; ++i)
+      {
+        robot.computeServo();
+        robot.integrateDynamics();
+      }
+      flag_run = false;
+      model_thread.join();
+
+      const scl::sLongLong n_adopted = ctrl->getModelUpdatesAdopted() - n_adopt;
+      if(0 == n_adopted)
+      { throw(std::runtime_error("The servo didn't adopt any of the model thread's models"));  }
+      if(ctrl->getModelUpdatesAdopted() > ctrl->getModelUpdatesPublished())
+      { throw(std::runtime_error("The servo adopted more models than were published"));  }
+      if(false == robot.getGeneralizedCoordinates().allFinite())
+      { throw(std::runtime_error("The robot's state blew up in multi-rate mode"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Two threads : The servo adopted "<<n_adopted
+          <<" models in "<<n_ticks_threaded<<" ticks";
+
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
@@ -16,6 +16,10 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "test_random_stuff.hpp"
 
 #include <sutil/CSystemClock.hpp>
+#include <scl/util/CSpscQueue.hpp>
+#include <scl/util/CSeqLock.hpp>
+#include <scl/util/CLoggerBinary.hpp>
+#include <scl/util/CPerfStats.hpp>
 
 #include <string>
 #include <vector>
@@ -28,6 +32,10 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <time.h>
 
 #include <stdexcept>
+#include <cmath>
+#include <omp.h>
+#include <atomic>
+#include <sched.h>
 
 //#define SCL_RANDOM_SLIM_TEST 1
 
@@ -365,6 +373,143 @@ namespace scl_test
       t2 = sutil::CSystemClock::getSysTime();
       std::cout<<"\nTest Result ("<<r_id++<<")  : 2 Pointer Redirects Time taken : "<<t2-t1<<"sec";
 
+      //Test the lock-free spsc queue (one producer and one consumer thread)
+      scl::CSpscQueue<long long, 64> spscq;
+      long long n_recv = 0, n_out_of_order = 0;
+      t1 = sutil::CSystemClock::getSysTime();
+#pragma omp parallel num_threads(2)
+      {
+        if(0 == omp_get_thread_num())
+        {//Producer : Yield when the queue is full
+          for(long long i=0;i<test_ctr;)
+          { if(spscq.push(i)) { ++i; } else { sched_yield(); } }
+        }
+        else
+        {//Consumer : Items must arrive in order
+          while(n_recv < test_ctr)
+          {
+            long long* v = spscq.front();
+            if(NULL == v) { sched_yield(); continue; }
+            if(*v != n_recv) { n_out_of_order++; }
+            n_recv++;
+            spscq.pop();
+          }
+        }
+      }
+      t2 = sutil::CSystemClock::getSysTime();
+      if(n_recv != test_ctr || 0 != n_out_of_order || false == spscq.empty())
+      { throw(std::runtime_error("Spsc queue lost or reordered items."));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  : Spsc queue passed "<<test_ctr<<" items between threads. Time taken : "<<t2-t1<<"sec";
+
+      //Test the seqlock (one writer and one reader thread). Every read must
+      //be consistent (all entries equal) and never go back in time.
+      struct SSeqTest { long long v_[16]; };
+      scl::CSeqLock<SSeqTest> seql;
+      std::atomic<bool> seql_done(false);
+      const long long seql_ctr = test_ctr < 1000000 ? test_ctr : 1000000;
+      long long n_reads = 0, n_torn = 0, n_stale = 0;
+      t1 = sutil::CSystemClock::getSysTime();
+#pragma omp parallel num_threads(2)
+      {
+        if(0 == omp_get_thread_num())
+        {//Writer
+          for(long long i=1;i<=seql_ctr;++i)
+          {
+            SSeqTest* w = seql.beginWrite();
+            for(int j=0;j<16;++j) { w->v_[j] = i; }
+            seql.endWrite();
+            if(0 == i%64) { sched_yield(); }
+          }
+          seql_done = true;
+        }
+        else
+        {//Reader
+          SSeqTest r; long long last = 0;
+          while(false == seql_done)
+          {
+            if(false == seql.read(r)) { sched_yield(); continue; }
+            n_reads++;
+            for(int j=1;j<16;++j) { if(r.v_[j] != r.v_[0]) { n_torn++; break; } }
+            if(r.v_[0] < last) { n_stale++; }
+            if(r.v_[0] == last) { sched_yield(); }//Nothing new yet
+            last = r.v_[0];
+          }
+        }
+      }
+      t2 = sutil::CSystemClock::getSysTime();
+      if(0 != n_torn || 0 != n_stale || static_cast<unsigned long>(seql_ctr) != seql.getPublishCount())
+      { throw(std::runtime_error("Seqlock returned torn or stale reads."));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  : Seqlock published "<<seql_ctr<<" buffers, "<<n_reads<<" consistent reads. Time taken : "<<t2-t1<<"sec";
+
+      //Test the binary logger : Log rows through the ring buffer, then read
+      //the file back (the header and every row must match).
+      const char* log_file = "./test_random_stuff_log.bin";
+      remove(log_file);
+      const long long log_ctr = test_ctr < 100000 ? test_ctr : 100000;
+      long long n_logged = 0;
+      t1 = sutil::CSystemClock::getSysTime();
+      {
+        scl::CLoggerBinary logger;
+        int lc_i = logger.addColumn("i",1), lc_v = logger.addColumn("v",3), lc_m = logger.addColumn("m",2,2);
+        if(0 > lc_m || false == logger.open(log_file, 1024, 0.001))
+        { throw(std::runtime_error("Could not open the binary log."));  }
+        Eigen::Vector3d v(1,2,3); Eigen::MatrixXd m(2,2); m<<4,5,6,7;
+        for(long long i=0;i<log_ctr;++i)
+        {
+          double* row = logger.beginRow();
+          if(S_NULL == row) { sched_yield(); continue; } //Dropped (the writer is behind)
+          logger.setColumn(row,lc_i,static_cast<double>(i));
+          logger.setColumn(row,lc_v,v.data(),3);
+          logger.setColumn(row,lc_m,m);
+          logger.endRow(); n_logged++;
+        }
+        logger.close();
+        if(n_logged != logger.getRowsWritten() || log_ctr != n_logged + logger.getRowsDropped())
+        { throw(std::runtime_error("Binary logger lost rows."));  }
+      }
+      FILE* flog = fopen(log_file,"rb");
+      std::vector<scl::SLogColumn> log_cols; scl::sUInt log_row_doubles, log_hbytes;
+      if(S_NULL == flog || false == scl::CLoggerBinary::readHeader(flog,log_cols,log_row_doubles,log_hbytes) ||
+          3 != log_cols.size() || 8 != log_row_doubles || "m" != log_cols[2].name_ || 0 != log_hbytes%64)
+      { if(S_NULL != flog) { fclose(flog); } throw(std::runtime_error("Binary log has a bad header."));  }
+      double log_row[8]; long long n_read = 0, last_i = -1;
+      while(1 == fread(log_row,sizeof(log_row),1,flog))
+      {
+        if(log_row[0] <= last_i || 3 != log_row[3] || 6 != log_row[5] || 5 != log_row[6])
+        { fclose(flog); throw(std::runtime_error("Binary log has a bad row."));  }
+        last_i = static_cast<long long>(log_row[0]); n_read++;
+      }
+      fclose(flog); remove(log_file);
+      t2 = sutil::CSystemClock::getSysTime();
+      if(n_read != n_logged)
+      { throw(std::runtime_error("Binary log has the wrong number of rows."));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  : Binary logger wrote and read back "<<n_read<<" rows. Time taken : "<<t2-t1<<"sec";
+
+      //Test the timing histograms : Two threads record 1..10000 usec. The
+      //merged percentiles must be within a bucket (~6%) of the exact ones.
+      const int perf_id = scl::CPerfStats::getId("test::random_stuff");
+      t1 = sutil::CSystemClock::getSysTime();
+#pragma omp parallel num_threads(2)
+      {
+        for(long long i=1+omp_get_thread_num();i<=10000;i+=2)
+        { scl::CPerfStats::record(perf_id, i*1000); }
+      }
+      std::vector<scl::SPerfSummary> perf_sums;
+      scl::CPerfStats::getSummaries(perf_sums);
+      t2 = sutil::CSystemClock::getSysTime();
+      scl::SPerfSummary perf_s;
+      for(std::size_t i=0;i<perf_sums.size();++i)
+      { if("test::random_stuff" == perf_sums[i].name_) { perf_s = perf_sums[i]; } }
+      if(10000 != perf_s.n_ || 10000000 != perf_s.max_ns_ ||
+          std::fabs(perf_s.p50_ns_ - 5e6) > 0.07*5e6 || std::fabs(perf_s.p99_ns_ - 9.9e6) > 0.07*9.9e6)
+      { throw(std::runtime_error("Timing histogram percentiles are off."));  }
+      scl::CPerfStats::reset();
+      scl::CPerfStats::getSummaries(perf_sums);
+      for(std::size_t i=0;i<perf_sums.size();++i)
+      { if("test::random_stuff" == perf_sums[i].name_) { throw(std::runtime_error("Timing histogram reset failed.")); } }
+      std::cout<<"\nTest Result ("<<r_id++<<")  : Timing histogram p50 "<<perf_s.p50_ns_*1e-3<<"us, p99 "
+          <<perf_s.p99_ns_*1e-3<<"us (exact : 5000, 9900). Time taken : "<<t2-t1<<"sec";
+
       std::cout<<"\nTest #"<<id<<" : Succeeded.";
     }
     catch (std::exception& ee)
@@ -0,0 +1,158 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_reachability.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_reachability.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+#include <scl/dynamics/scl/CReachabilityMap.hpp>
+#include <scl/dynamics/scl/CInverseKinematicsScl.hpp>
+
+#include <sutil/CSystemClock.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+namespace scl_test
+{
+  void test_reachability(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+
+    const std::string file("./test_reachability.sclreach");
+    const Eigen::Vector3d pos_ee(0,0,0.1);
+    const scl::sLongLong n_samples = 500000;
+
+    try
+    {
+      scl::SDatabase * db = scl::CDatabase::getData();
+      if(S_NULL==db)
+      { throw(std::runtime_error("Database not initialized."));  }
+      else
+      { std::cout<<"\nTest Result ("<<r_id++<<")  Initialized database"<<std::flush;  }
+      db->dir_specs_ = db->cwd_ + std::string("../../specs/");
+
+      scl::CParserScl tmp_lparser;
+      const scl::SRobotParsed *rob_ds = scl_registry::parseRobot(
+          db->dir_specs_ + "Puma/PumaCfg.xml", "PumaBot", &tmp_lparser);
+      if(S_NULL == rob_ds)
+      { throw(std::runtime_error("Could not register the Puma with the database"));  }
+
+      scl::CDynamicsScl dynamics;
+      flag = dynamics.init(*rob_ds);
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize scl dynamics"));  }
+
+      // ********** 1. Sample (random, then stratified) and write **********
+      scl::CReachabilityMapBuilder builder;
+      flag = builder.init(*rob_ds, &dynamics, "end-effector", pos_ee);
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the map builder"));  }
+
+      scl::sFloat t1 = sutil::CSystemClock::getSysTime();
+      flag = builder.sample(n_samples, false, 1);
+      flag = flag && builder.sample(n_samples, true, 2);
+      scl::sFloat t2 = sutil::CSystemClock::getSysTime();
+      if(false == flag)
+      { throw(std::runtime_error("Sampling failed"));  }
+      if(0 < builder.getNumSamplesOutside())
+      { throw(std::runtime_error("The automatic grid doesn't bound the reach"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Sampled "<<builder.getNumSamples()<<" configurations on "
+          <<builder.getNumThreads()<<" threads in "<<t2-t1<<"s. Voxels reached "<<builder.getNumVoxelsReached();
+
+      flag = builder.write(file);
+      if(false == flag)
+      { throw(std::runtime_error("Could not write the map"));  }
+
+      // ********** 2. Map it and query it **********
+      scl::CReachabilityMap rmap;
+      flag = rmap.open(file);
+      if(false == flag)
+      { throw(std::runtime_error("Could not map the map"));  }
+      if(rmap.getNumSamples() != builder.getNumSamples() || "end-effector" != rmap.getLinkName())
+      { throw(std::runtime_error("The map's header doesn't match the builder"));  }
+
+      // The end-effector positions of random configurations should (mostly)
+      // land in reached voxels. Sparse voxels at the edges may be missed.
+      scl::CInverseKinematicsScl ik;
+      flag = ik.init(*rob_ds, &dynamics, 1);
+      flag = flag && ik.addOpPoint("end-effector", pos_ee);
+      if(false == flag)
+      { throw(std::runtime_error("Could not set up forward kinematics"));  }
+
+      srand(3);
+      int n_missed = 0; const int n_checks = 10000;
+      scl::SIkTarget x;
+      for(int i=0; i<n_checks; ++i)
+      {
+        Eigen::VectorXd q = Eigen::VectorXd::Random(rob_ds->dof_) * M_PI;
+        ik.computeOpPoints(q, x);
+        if(false == rmap.isReachable(x.pos_[0])) { n_missed++; }
+        const scl::sFloat m = rmap.getManipulability(x.pos_[0]);
+        if(m < 0 || m > 1)
+        { throw(std::runtime_error("Normalized manipulability out of [0,1]"));  }
+      }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Random configurations in unreached voxels : "
+          <<n_missed<<"/"<<n_checks;
+      if(n_missed > n_checks/10)
+      { throw(std::runtime_error("The map misses too many reachable points"));  }
+
+      if(rmap.isReachable(Eigen::Vector3d(5,0,0)) || S_NULL != rmap.query(Eigen::Vector3d(5,0,0)))
+      { throw(std::runtime_error("A point outside the grid is reachable"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Points out of reach are rejected";
+
+      for(scl::sUInt iz=0; iz<rmap.getNz(); ++iz)
+        for(scl::sUInt iy=0; iy<rmap.getNy(); ++iy)
+          for(scl::sUInt ix=0; ix<rmap.getNx(); ++ix)
+          {
+            const scl::SReachabilityVoxel* v = rmap.query(rmap.getVoxelCenter(ix,iy,iz));
+            if(S_NULL == v || &rmap.getVoxel(ix,iy,iz) != v)
+            { throw(std::runtime_error("Voxel lookup doesn't match the grid"));  }
+          }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Voxel lookups match the grid";
+
+      // ********** 3. The samples don't depend on the number of threads **********
+      scl::CReachabilityMapBuilder builder1;
+      flag = builder1.init(*rob_ds, &dynamics, "end-effector", pos_ee, 1);
+      flag = flag && builder1.sample(n_samples, false, 1);
+      flag = flag && builder1.sample(n_samples, true, 2);
+      if(false == flag)
+      { throw(std::runtime_error("Single threaded sampling failed"));  }
+      if(builder1.getNumVoxelsReached() != builder.getNumVoxelsReached())
+      { throw(std::runtime_error("Sampling depends on the number of threads"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Single and multi-threaded maps match";
+
+      std::remove(file.c_str());
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      std::remove(file.c_str());
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
@@ -132,6 +132,33 @@ namespace scl_test
         sleep(1);
       }
 
+      //5. Checkpoints : Restoring a saved state replays the same rollout
+      std::string state_blob;
+      flag = app.robot.saveState(state_blob);
+      if(false==flag) { throw(std::runtime_error("Could not save the robot's state"));  }
+      scl::sLongLong ctrl_ctr_saved = app.ctrl_ctr;
+      const int n_rollout_steps = 1000;
+
+      for(int i=0; i<n_rollout_steps; ++i) { app.stepMySimulation(); }
+      Eigen::VectorXd q_rollout = app.robot.getGeneralizedCoordinates();
+      double t_rollout = sutil::CSystemClock::getSimTime();
+
+      for(int j=0; j<3; ++j)
+      {
+        t1 = sutil::CSystemClock::getSysTime();
+        flag = app.robot.restoreState(state_blob);
+        t2 = sutil::CSystemClock::getSysTime();
+        if(false==flag) { throw(std::runtime_error("Could not restore the robot's state"));  }
+        app.ctrl_ctr = ctrl_ctr_saved;
+
+        for(int i=0; i<n_rollout_steps; ++i) { app.stepMySimulation(); }
+        if(q_rollout != app.robot.getGeneralizedCoordinates() ||
+            t_rollout != sutil::CSystemClock::getSimTime())
+        { throw(std::runtime_error("A rollout from a restored state didn't match the original"));  }
+      }
+      std::cout<<"\nTest Result ("<<r_id++<<") Checkpoint. State size: "<<state_blob.size()
+          <<" bytes. Restore time: "<<t2-t1<<". Rollouts match."<<std::flush;
+
       app.terminate();
       std::cout<<"\nTest #"<<id<<" (Task Controller: "<<arg_robot_name<<", "<<arg_controller_name<<") : Succeeded.";
     }
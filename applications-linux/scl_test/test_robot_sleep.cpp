@@ -0,0 +1,162 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_robot_sleep.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_robot_sleep.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/robot/CRobot.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+#include <scl/Init.hpp>
+#include <scl_ext/dynamics/scl_spatial/CDynamicsSclSpatial.hpp>
+
+#include <sutil/CSystemClock.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace scl_test
+{
+  /** Steps the robot until it falls asleep. Returns the number of
+   * ticks it took (-1 if it didn't). */
+  static long stepUntilAsleep(scl::CRobot& arg_robot, const long arg_max_ticks)
+  {
+    for(long i=0; i<arg_max_ticks; ++i)
+    {
+      arg_robot.computeDynamics();
+      arg_robot.computeServo();
+      arg_robot.integrateDynamics();
+      if(arg_robot.isAsleep()) { return i+1; }
+    }
+    return -1;
+  }
+
+  void test_robot_sleep(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+    const long n_ticks_max = 100000;
+
+    try
+    {
+      scl::SDatabase * db = scl::CDatabase::getData();
+      if(S_NULL==db)
+      { throw(std::runtime_error("Database not initialized."));  }
+      else
+      { std::cout<<"\nTest Result ("<<r_id++<<")  Initialized database"<<std::flush;  }
+      db->dir_specs_ = db->cwd_ + std::string("../../specs/");
+
+      flag = scl::init::registerNativeDynamicTypes();
+      if(false == flag)
+      { throw(std::runtime_error("Could not register native dynamic types"));  }
+
+      scl::CParserScl tmp_lparser;
+      flag = scl_registry::parseEverythingInFile(db->dir_specs_ + "Puma/PumaCfg.xml", &tmp_lparser);
+      if(false == flag)
+      { throw(std::runtime_error("Could not parse the Puma"));  }
+
+      scl::SRobotParsed *rob_ds = db->s_parser_.robots_.at("PumaBot");
+      if(S_NULL == rob_ds)
+      { throw(std::runtime_error("Could not find the Puma"));  }
+
+      // The robot deletes these
+      scl::CDynamicsScl* dyn_scl = new scl::CDynamicsScl();
+      scl_ext::CDynamicsSclSpatial* dyn_sp = new scl_ext::CDynamicsSclSpatial();
+      flag = dyn_scl->init(*rob_ds);
+      flag = flag && dyn_sp->init(*rob_ds);
+
+      scl::CRobot robot;
+      flag = flag && robot.initFromDb("PumaBot", dyn_scl, dyn_sp);
+      flag = flag && robot.setControllerCurrent("PumaGcCtrl");
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the Puma"));  }
+
+      if(robot.setFlagSleep(true, 1e-6, 1e-3, 0))
+      { throw(std::runtime_error("Accepted a zero idle tick count"));  }
+      flag = robot.setFlagSleep(true, 1e-6, 1e-3, 100);
+      if(false == flag)
+      { throw(std::runtime_error("Could not turn on sleeping"));  }
+
+      // ********** 1. Settle and fall asleep **********
+      long n = stepUntilAsleep(robot, n_ticks_max);
+      if(0 > n)
+      { throw(std::runtime_error("The robot didn't fall asleep"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Fell asleep after "<<n<<" ticks";
+
+      // ********** 2. Stay put while asleep **********
+      const Eigen::VectorXd q_sleep = robot.getGeneralizedCoordinates();
+      if(0 != robot.getGeneralizedVelocities().norm())
+      { throw(std::runtime_error("The robot didn't come to rest when it fell asleep"));  }
+
+      const int n_asleep = 1000;
+      scl::sFloat t_asleep = sutil::CSystemClock::getSysTime();
+      for(int i=0; i<n_asleep; ++i)
+      { robot.computeDynamics(); robot.computeServo(); robot.integrateDynamics(); }
+      t_asleep = sutil::CSystemClock::getSysTime() - t_asleep;
+
+      if(false == robot.isAsleep() || q_sleep != robot.getGeneralizedCoordinates())
+      { throw(std::runtime_error("The robot moved while it was asleep"));  }
+      if(n_asleep >= robot.getTicksAsleep())
+      { throw(std::runtime_error("Didn't count the ticks asleep"));  }
+
+      // ********** 3. Wake up on an external force **********
+      scl::SRobotIO *io = robot.getData()->io_data_;
+      if(S_NULL == io->sensors_.forces_external_.create("push"))
+      { throw(std::runtime_error("Could not add an external force"));  }
+      robot.computeServo();
+      robot.integrateDynamics();
+      if(robot.isAsleep())
+      { throw(std::runtime_error("The robot slept through an external force"));  }
+      io->sensors_.forces_external_.erase("push");
+
+      n = stepUntilAsleep(robot, n_ticks_max);
+      if(0 > n)
+      { throw(std::runtime_error("The robot didn't fall asleep after the push"));  }
+
+      // ********** 4. Wake up on a state change and settle again **********
+      Eigen::VectorXd q = robot.getGeneralizedCoordinates();
+      q.array() += 0.1;
+      robot.setGeneralizedCoordinates(q);
+      if(robot.isAsleep())
+      { throw(std::runtime_error("The robot slept through a state change"));  }
+
+      scl::sFloat t_awake = sutil::CSystemClock::getSysTime();
+      n = stepUntilAsleep(robot, n_ticks_max);
+      t_awake = sutil::CSystemClock::getSysTime() - t_awake;
+      if(0 > n)
+      { throw(std::runtime_error("The robot didn't settle after the state change"));  }
+      if(3 != robot.getNumSleeps())
+      { throw(std::runtime_error("Miscounted the number of times the robot fell asleep"));  }
+      if((q_sleep - robot.getGeneralizedCoordinates()).norm() > 0.1)
+      { throw(std::runtime_error("The robot fell asleep away from its goal"));  }
+
+      std::cout<<"\nTest Result ("<<r_id++<<")  Woke up on a push and a state change. Settled again after "
+          <<n<<" ticks. Tick cost : awake "<<t_awake/n*1e6<<"us, asleep "<<t_asleep/n_asleep*1e6<<"us";
+
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
@@ -20,6 +20,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <scl/data_structs/SRobotParsed.hpp>
 #include <scl/robot/DbRegisterFunctions.hpp>
 #include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/parser/sclparser/CParserSclCache.hpp>
 
 #include <scl/Singletons.hpp>
 #include <scl/DataTypes.hpp>
@@ -28,7 +29,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <string>
 #include <vector>
 #include <stdio.h>
+#include <sys/stat.h>
 #include <iostream>
+#include <fstream>
 #include <sstream>
 #include <stdexcept>
 
@@ -137,6 +140,84 @@ void test_scl_parser(int id)
     { throw(std::runtime_error("Could not parse the Puma spec")); }
     else
     { std::cout<<"\nTest Result ("<<r_id++<<") Parsed full PumaCfg.xml file"; }
+    if(0 != scl::CParserScl::getXmlCacheStats().entries_)
+    { throw(std::runtime_error("Xml cache kept the parsed files after the load")); }
+
+    //9. Test the xml document cache (read calls should share one parsed file)
+    scl::CParserScl::clearXmlCache();
+    scl::SXmlCacheStats xst = scl::CParserScl::getXmlCacheStats();
+    std::shared_ptr<scl_tinyxml::TiXmlDocument> xdoc0 = scl::CParserScl::loadXmlFile(tmp_infile);
+    std::shared_ptr<scl_tinyxml::TiXmlDocument> xdoc1 = scl::CParserScl::loadXmlFile(tmp_infile);
+    if(S_NULL == xdoc0 || xdoc0 != xdoc1 || xst.hits_+1 != scl::CParserScl::getXmlCacheStats().hits_)
+    { throw(std::runtime_error("Xml cache didn't share the parsed cfg file")); }
+    scl::CParserScl::clearXmlCache();
+    if(xdoc0 == scl::CParserScl::loadXmlFile(tmp_infile))
+    { throw(std::runtime_error("Xml cache didn't re-parse the cfg file after a clear")); }
+    scl::CParserScl::clearXmlCache();
+    {
+      scl::CXmlLoadScope s0;
+      { scl::CXmlLoadScope s1; scl::CParserScl::loadXmlFile(tmp_infile); }
+      if(1 != scl::CParserScl::getXmlCacheStats().entries_)
+      { throw(std::runtime_error("Xml cache was cleared by a nested load")); }
+    }
+    if(0 != scl::CParserScl::getXmlCacheStats().entries_)
+    { throw(std::runtime_error("Xml cache kept the parsed files after a load scope")); }
+    std::cout<<"\nTest Result ("<<r_id++<<") Xml cache shares parsed files. Clear and the end of a load re-parse them.";
+
+    //10. Test the compiled robot cache (on a copy of the cfg file so we can edit it)
+    scl::CParserSclCache::setEnabled(true);
+    scl::CParserSclCache::setDir("/tmp/scl_test_cache/");
+    scl::CParserSclCache::clear();
+    std::string cache_cfg = "/tmp/scl_test_cache/PumaCfg.xml";
+    {
+      std::ifstream fin(tmp_infile.c_str());
+      std::stringstream ss; ss<<fin.rdbuf();
+      mkdir("/tmp/scl_test_cache", 0755);
+      std::ofstream fout(cache_cfg.c_str());
+      fout<<ss.str();
+      if(!fin || !fout)
+      { throw(std::runtime_error("Could not copy the cfg file to the cache dir")); }
+    }
+
+    std::uint64_t hits = scl::CParserSclCache::getHits(), misses = scl::CParserSclCache::getMisses();
+    scl::SRobotParsed rob_xml, rob_cache, rob_stale;
+    flag = tmp_parser.readRobotFromFile(cache_cfg, scl::CDatabase::getData()->dir_specs_, robot_names[0], rob_xml);
+    flag = flag && tmp_parser.readRobotFromFile(cache_cfg, scl::CDatabase::getData()->dir_specs_, robot_names[0], rob_cache);
+    if(false == flag)
+    { throw(std::runtime_error("Could not read the robot with the cache enabled")); }
+    if(misses+1 != scl::CParserSclCache::getMisses() || hits+1 != scl::CParserSclCache::getHits())
+    { throw(std::runtime_error("Second read didn't use the compiled cache")); }
+
+    if(rob_xml.dof_ != rob_cache.dof_ || rob_xml.rb_tree_.size() != rob_cache.rb_tree_.size() ||
+        rob_xml.robot_tree_numeric_id_to_name_ != rob_cache.robot_tree_numeric_id_to_name_ ||
+        rob_xml.gravity_ != rob_cache.gravity_ || rob_xml.gc_pos_default_ != rob_cache.gc_pos_default_ ||
+        rob_xml.actuator_sets_.size() != rob_cache.actuator_sets_.size())
+    { throw(std::runtime_error("Cached robot doesn't match the parsed robot")); }
+
+    for(auto it = rob_xml.rb_tree_.begin(), ite = rob_xml.rb_tree_.end(); it!=ite; ++it)
+    {
+      const scl::SRigidBody* lnk = rob_cache.rb_tree_.at_const(it->name_);
+      if(S_NULL == lnk || lnk->link_id_ != it->link_id_ || lnk->parent_name_ != it->parent_name_ ||
+          lnk->mass_ != it->mass_ || lnk->inertia_ != it->inertia_ || lnk->com_ != it->com_ ||
+          lnk->pos_in_parent_ != it->pos_in_parent_ ||
+          lnk->ori_parent_quat_.coeffs() != it->ori_parent_quat_.coeffs() ||
+          lnk->joint_type_ != it->joint_type_ ||
+          lnk->graphics_obj_vec_.size() != it->graphics_obj_vec_.size())
+      { throw(std::runtime_error(std::string("Cached link doesn't match the parsed link : ") + it->name_)); }
+      if(!lnk->is_root_ && (S_NULL == lnk->parent_addr_ || lnk->parent_addr_->name_ != lnk->parent_name_))
+      { throw(std::runtime_error(std::string("Cached link's parent isn't linked : ") + it->name_)); }
+    }
+    std::cout<<"\nTest Result ("<<r_id++<<") Read robot from the compiled cache. Matches the xml.";
+
+    {// Editing the cfg file should make the cache stale
+      std::ofstream fout(cache_cfg.c_str(), std::ios::app);
+      fout<<"\n<!-- Edited -->\n";
+    }
+    misses = scl::CParserSclCache::getMisses();
+    flag = tmp_parser.readRobotFromFile(cache_cfg, scl::CDatabase::getData()->dir_specs_, robot_names[0], rob_stale);
+    if(false == flag || misses+1 != scl::CParserSclCache::getMisses() || rob_stale.dof_ != rob_xml.dof_)
+    { throw(std::runtime_error("Didn't re-parse the robot after its cfg file changed")); }
+    std::cout<<"\nTest Result ("<<r_id++<<") Edited cfg file invalidated the compiled cache.";
 
     std::cout<<"\nTest #"<<id<<" : Succeeded.";
   }
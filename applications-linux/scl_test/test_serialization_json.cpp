@@ -17,6 +17,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "test_serialization_json.hpp"
 
 #include <scl/serialization/SerializationJSON.hpp>
+#include <scl/serialization/SerializationJSONStream.hpp>
 #include <scl/parser/sclparser/CParserScl.hpp>
 #include <scl/data_structs/SRigidBody.hpp>
 
@@ -177,6 +178,61 @@ namespace scl_test
       std::cout<<"\nTest Result ("<<r_id++<<")  : Serialized SActuatorSetMuscleParsed object to compact JSON string : "<<std::endl;
       std::cout<<str<<std::endl;
 
+      //10. Stream a robot's io (no DOM) and check it against the DOM serializer
+      scl::SRobotIO io;
+      flag = io.init(rparsed);
+      if(!flag) { throw(std::runtime_error("Could not initialize the Puma's io data structure")); }
+      io.sensors_.q_.setRandom();
+      io.sensors_.dq_.setRandom();
+      io.sensors_.q_(0) = 1.0/3.0; //Needs 16 digits
+
+      scl::CJSONStreamWriter json_stream;
+      flag = scl::serializeToJSONStream(io, json_stream);
+      if(!flag) { throw(std::runtime_error("Could not stream SRobotIO to JSON")); }
+
+      Json::Value json_stream_val, json_dom_val;
+      flag = json_reader.parse(json_stream.getString(), json_stream_val);
+      if(!flag) { throw(std::runtime_error("Streamed SRobotIO isn't valid JSON")); }
+      flag = scl::serializeToJSON(io, json_dom_val);
+      if(!flag) { throw(std::runtime_error("Could not serialize SRobotIO to JSON value")); }
+      for(auto&& key : json_dom_val.getMemberNames())
+      {
+        if(!json_stream_val.isMember(key))
+        { throw(std::runtime_error(std::string("Streamed SRobotIO is missing : ")+key)); }
+      }
+      for(int i=0; i<io.sensors_.q_.size(); ++i)
+      {
+        if(json_stream_val["sensors_"]["q_"][i].asDouble() != io.sensors_.q_(i))
+        { throw(std::runtime_error("Streamed SRobotIO q_ doesn't read back exactly")); }
+      }
+      std::cout<<"\nTest Result ("<<r_id++<<")  : Streamed SRobotIO to JSON (matches the DOM, doubles round trip) : "<<std::endl;
+      std::cout<<json_stream.getString()<<std::endl;
+
+      //11. Stream only the changes
+      scl::SRobotIO io_sent;
+      io_sent.init(rparsed);
+      io_sent.sensors_ = io.sensors_;
+      io_sent.actuators_.force_gc_commanded_ = io.actuators_.force_gc_commanded_;
+      const char* stream_mem = json_stream.data();
+      json_stream.clear();
+      flag = scl::serializeToJSONStream(io, json_stream, &io_sent);
+      if(!flag || !json_reader.parse(json_stream.getString(), json_stream_val))
+      { throw(std::runtime_error("Could not stream an SRobotIO delta to JSON")); }
+      if(1 != json_stream_val.size() || !json_stream_val.isMember("name_"))
+      { throw(std::runtime_error("SRobotIO delta without changes should only have the name")); }
+      if(stream_mem != json_stream.data())
+      { throw(std::runtime_error("Streaming reallocated the (large enough) buffer")); }
+
+      io.sensors_.q_(1) += 0.1;
+      json_stream.clear();
+      flag = scl::serializeToJSONStream(io, json_stream, &io_sent);
+      if(!flag || !json_reader.parse(json_stream.getString(), json_stream_val))
+      { throw(std::runtime_error("Could not stream an SRobotIO delta to JSON")); }
+      if(2 != json_stream_val.size() || 1 != json_stream_val["sensors_"].size() ||
+          !json_stream_val["sensors_"].isMember("q_"))
+      { throw(std::runtime_error("SRobotIO delta should only have the changed q_")); }
+      std::cout<<"\nTest Result ("<<r_id++<<")  : Streamed SRobotIO changes to JSON : "<<json_stream.getString()<<std::endl;
+
       std::cout<<"\nTest #"<<id<<" : Succeeded.";
     }
     catch (std::exception& ee)
@@ -0,0 +1,143 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_state_predictor.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_state_predictor.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/data_structs/SGcModel.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+#include <scl/control/task/CStatePredictor.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+
+namespace scl_test
+{
+  void test_state_predictor(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+
+    try
+    {
+      scl::SDatabase * db = scl::CDatabase::getData();
+      if(S_NULL==db)
+      { throw(std::runtime_error("Database not initialized."));  }
+      else
+      { std::cout<<"\nTest Result ("<<r_id++<<")  Initialized database"<<std::flush;  }
+      db->dir_specs_ = db->cwd_ + std::string("../../specs/");
+
+      scl::CParserScl tmp_lparser;
+      const scl::SRobotParsed *rob_ds = scl_registry::parseRobot(
+          db->dir_specs_ + "Puma/PumaCfg.xml", "PumaBot", &tmp_lparser);
+      if(S_NULL == rob_ds)
+      { throw(std::runtime_error("Could not register the Puma with the database"));  }
+      const scl::sUInt dof = rob_ds->dof_;
+
+      scl::CDynamicsScl dynamics;
+      scl::SGcModel gcm, gcm_ref;
+      flag = dynamics.init(*rob_ds);
+      flag = flag && gcm.init(*rob_ds);
+      flag = flag && gcm_ref.init(*rob_ds);
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the dynamics"));  }
+
+      scl::CStatePredictor predictor;
+      flag = predictor.init(&gcm, dof);
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the state predictor"));  }
+
+      // ********** 1. Predict over a 3ms delay **********
+      // The reference integrates with 300 steps, updating the model at every step.
+      const scl::sFloat delay = 0.003;
+      const int n_ref_steps = 300;
+      double err_pred = 0, err_none = 0;
+      srand(5);
+      for(int i=0; i<50; ++i)
+      {
+        scl::SRobotSensors s;
+        s.q_ = Eigen::VectorXd::Random(dof) * 2;
+        s.dq_ = Eigen::VectorXd::Random(dof);
+        s.ddq_.setZero(dof);
+        flag = dynamics.computeGCModel(&s, &gcm);
+        if(false == flag)
+        { throw(std::runtime_error("Could not compute the gc model"));  }
+
+        // A gravity compensating command plus some random torques
+        const Eigen::VectorXd fgc = -gcm.force_gc_grav_ + Eigen::VectorXd::Random(dof) * 5;
+
+        scl::SRobotSensors s_ref = s;
+        const double h = delay/n_ref_steps;
+        for(int k=0; k<n_ref_steps; ++k)
+        {
+          dynamics.computeGCModel(&s_ref, &gcm_ref);
+          const Eigen::VectorXd ddq = gcm_ref.M_gc_inv_ * (fgc + gcm_ref.force_gc_grav_ - gcm_ref.force_gc_cc_);
+          s_ref.q_ += h*s_ref.dq_ + 0.5*h*h*ddq;
+          s_ref.dq_ += h*ddq;
+        }
+
+        scl::SRobotSensors s_pred = s;
+        flag = predictor.predict(s_pred, fgc, delay);
+        if(false == flag)
+        { throw(std::runtime_error("Could not predict the state"));  }
+
+        err_pred = std::max(err_pred, (s_pred.q_ - s_ref.q_).norm() + delay*(s_pred.dq_ - s_ref.dq_).norm());
+        err_none = std::max(err_none, (s.q_ - s_ref.q_).norm() + delay*(s.dq_ - s_ref.dq_).norm());
+      }
+      std::cout<<"\nTest Result ("<<r_id++<<")  State error after "<<delay*1000<<"ms. Predicted : "
+          <<err_pred<<", Not predicted : "<<err_none;
+      if(err_pred > 1e-5 || err_pred*100 > err_none)
+      { throw(std::runtime_error("The prediction isn't accurate enough"));  }
+
+      // ********** 2. Clamping, the lookahead and size checks **********
+      scl::SRobotSensors s;
+      s.q_.setZero(dof); s.dq_.setZero(dof);
+      dynamics.computeGCModel(&s, &gcm);
+      const Eigen::VectorXd fgc = Eigen::VectorXd::Zero(dof);
+
+      flag = predictor.predict(s, fgc, 1.0);
+      if(false == flag || predictor.getDelayMax() != predictor.getDelayLast() || 1 != predictor.getNumClamped())
+      { throw(std::runtime_error("Didn't clamp a stale sample's delay"));  }
+
+      predictor.setLookahead(0.001);
+      flag = predictor.predict(s, fgc, -0.5);
+      if(false == flag || 0.001 != predictor.getDelayLast())
+      { throw(std::runtime_error("Didn't treat a negative delay as zero (plus the lookahead)"));  }
+
+      scl::SRobotSensors s_bad = s;
+      s_bad.dq_.setZero(dof+1);
+      const Eigen::VectorXd q_bad = s_bad.q_;
+      if(predictor.predict(s_bad, fgc, 0.002) || q_bad != s_bad.q_)
+      { throw(std::runtime_error("Predicted a state whose size doesn't match the model"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Clamps stale samples, adds the lookahead and rejects bad sizes";
+
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
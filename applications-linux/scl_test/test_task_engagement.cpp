@@ -0,0 +1,215 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_task_engagement.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_task_engagement.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/robot/CRobot.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+#include <scl/control/task/CControllerMultiTask.hpp>
+#include <scl/control/task/tasks/data_structs/STaskConstraintPlane.hpp>
+#include <scl/util/RobotMath.hpp>
+#include <scl/Init.hpp>
+#include <scl_ext/dynamics/scl_spatial/CDynamicsSclSpatial.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+namespace scl_test
+{
+  /** Holds a task's spec till the controller's task type creates the
+   * real data structure (like the parser's) */
+  class STaskSpecTest : public scl::STaskBase
+  {
+  public:
+    virtual bool initTaskParams() { return false;  }
+  };
+
+  static scl::STaskBase* makeTaskSpec(const std::string& arg_name, const std::string& arg_type,
+      const scl::sUInt arg_dof, const double arg_kp, const double arg_kv,
+      const std::vector<scl::sString2>& arg_params)
+  {
+    scl::STaskBase* t = new STaskSpecTest();
+    t->name_ = arg_name; t->type_task_ = arg_type;
+    t->priority_ = 0; t->dof_task_ = arg_dof;
+    t->kp_.setConstant(1, arg_kp); t->kv_.setConstant(1, arg_kv);
+    t->ka_.setZero(1); t->ki_.setZero(1);
+    t->force_task_max_.setConstant(1, 100); t->force_task_min_.setConstant(1, -100);
+    t->task_nonstd_params_ = arg_params;
+    return t;
+  }
+
+  static scl::sString2 param(const char* arg_name, const char* arg_val)
+  { scl::sString2 s; s.data_[0] = arg_name; s.data_[1] = arg_val; return s; }
+
+  /** The gc forces of the activated and engaged tasks, through their range spaces */
+  static Eigen::VectorXd sumTaskForces(scl::CControllerMultiTask& arg_ctrl,
+      const std::vector<std::string>& arg_tasks)
+  {
+    Eigen::VectorXd f;
+    for(size_t i=0; i<arg_tasks.size(); ++i)
+    {
+      const scl::STaskBase* t = arg_ctrl.getTask(arg_tasks[i])->getTaskData();
+      if(0 == i) { f.setZero(t->force_gc_.size()); }
+      if(t->has_been_activated_ && t->is_engaged_)
+      { f += t->range_space_ * t->force_gc_; }
+    }
+    return f;
+  }
+
+  void test_task_engagement(int id)
+  {
+    scl::sUInt r_id=0;
+    bool flag;
+    const double test_precision = 1e-10;
+
+    try
+    {
+      scl::SDatabase * db = scl::CDatabase::getData();
+      if(S_NULL==db)
+      { throw(std::runtime_error("Database not initialized."));  }
+      else
+      { std::cout<<"\nTest Result ("<<r_id++<<")  Initialized database"<<std::flush;  }
+      db->dir_specs_ = db->cwd_ + std::string("../../specs/");
+
+      flag = scl::init::registerNativeDynamicTypes();
+      if(false == flag)
+      { throw(std::runtime_error("Could not register native dynamic types"));  }
+
+      scl::CParserScl tmp_lparser;
+      flag = scl_registry::parseEverythingInFile(db->dir_specs_ + "Puma/PumaCfg.xml", &tmp_lparser);
+      if(false == flag)
+      { throw(std::runtime_error("Could not parse the Puma"));  }
+
+      scl::SRobotParsed *rob_ds = db->s_parser_.robots_.at("PumaBot");
+      scl::SControllerBase** ctrl_base = db->s_controller_.controllers_.at("opc");
+      scl::SControllerMultiTask* ctrl_ds = (S_NULL == ctrl_base) ? S_NULL : dynamic_cast<scl::SControllerMultiTask*>(*ctrl_base);
+      if(S_NULL == rob_ds || S_NULL == ctrl_ds)
+      { throw(std::runtime_error("Could not find the Puma or its task controller"));  }
+
+      // ********** 0. Add the inequality tasks to the hand's level **********
+      // A plane far below the robot, and limit centering that engages within 10% of a limit.
+      std::vector<scl::sString2> params_plane, params_lim;
+      params_plane.push_back(param("parent_link", "end-effector"));
+      params_plane.push_back(param("pos_in_parent", "0 0 0"));
+      params_plane.push_back(param("p0", "1 0 -5"));
+      params_plane.push_back(param("p1", "0 1 -5"));
+      params_plane.push_back(param("p2", "1 1 -5"));
+      params_plane.push_back(param("pfree", "0 0 1"));
+      params_lim.push_back(param("engage_margin", "0.1"));
+
+      std::vector<scl::STaskBase*> specs;
+      specs.push_back(makeTaskSpec("plane", "TaskConstraintPlane", 3, 100, 10, params_plane));
+      specs.push_back(makeTaskSpec("limits", "TaskGcLimitCentering", 0, 50, 10, params_lim));
+      std::vector<scl::SNonControlTaskBase*> specs_nc;
+      const int n_added = scl::init::initMultiTaskCtrlDsFromParsedTasks(specs, specs_nc, *ctrl_ds);
+      for(size_t i=0; i<specs.size(); ++i) { delete specs[i]; }
+      if(2 != n_added)
+      { throw(std::runtime_error("Could not add the inequality tasks to the controller"));  }
+      // The database deletes the task data structures (like the parsed ones)
+      db->s_controller_.tasks_.create("plane", *(ctrl_ds->tasks_.at("plane")));
+      db->s_controller_.tasks_.create("limits", *(ctrl_ds->tasks_.at("limits")));
+
+      // The robot deletes these
+      scl::CDynamicsScl* dyn_scl = new scl::CDynamicsScl();
+      scl_ext::CDynamicsSclSpatial* dyn_sp = new scl_ext::CDynamicsSclSpatial();
+      flag = dyn_scl->init(*rob_ds);
+      flag = flag && dyn_sp->init(*rob_ds);
+
+      scl::CRobot robot;
+      flag = flag && robot.initFromDb("PumaBot", dyn_scl, dyn_sp);
+      flag = flag && robot.setControllerCurrent("opc");
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the Puma"));  }
+
+      scl::CControllerMultiTask* ctrl = dynamic_cast<scl::CControllerMultiTask*>(robot.getControllerCurrent());
+      if(S_NULL == ctrl || S_NULL == ctrl->getTask("plane") || S_NULL == ctrl->getTask("limits"))
+      { throw(std::runtime_error("The Puma's task controller doesn't have the inequality tasks"));  }
+      scl::STaskConstraintPlane* plane = dynamic_cast<scl::STaskConstraintPlane*>(ctrl->getTask("plane")->getTaskData());
+      scl::STaskBase* lim = ctrl->getTask("limits")->getTaskData();
+      const scl::STaskBase* hand = ctrl->getTask("hand")->getTaskData();
+      const scl::STaskBase* gcset = ctrl->getTask("JointAngleSetTask")->getTaskData();
+
+      std::vector<std::string> tasks_eq;
+      tasks_eq.push_back("hand"); tasks_eq.push_back("JointAngleSetTask"); tasks_eq.push_back("NullSpaceDampingTask");
+
+      // ********** 1. Disengaged : No force, no range space used **********
+      Eigen::VectorXd q = (rob_ds->gc_pos_limit_max_ + rob_ds->gc_pos_limit_min_)/2;
+      robot.setGeneralizedCoordinates(q);
+      robot.computeDynamics();
+      robot.computeServo();
+
+      if(plane->is_engaged_ || lim->is_engaged_)
+      { throw(std::runtime_error("An inequality task engaged away from its plane or limits"));  }
+      if(0 != plane->force_gc_.norm() || 0 != lim->force_gc_.norm())
+      { throw(std::runtime_error("A disengaged inequality task has a non-zero force"));  }
+      if((robot.getData()->io_data_->actuators_.force_gc_commanded_ -
+          sumTaskForces(*ctrl, tasks_eq)).cwiseAbs().maxCoeff() > test_precision)
+      { throw(std::runtime_error("Disengaged inequality tasks changed the command"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Disengaged inequality tasks add no force";
+
+      // The limit task's null space is zero. Disengaged, it must not zero out the next level.
+      if((gcset->range_space_ - hand->null_space_).cwiseAbs().maxCoeff() > test_precision)
+      { throw(std::runtime_error("A disengaged inequality task used up range space"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Disengaged inequality tasks are skipped by the range spaces";
+
+      // ********** 2. A joint nears its limit **********
+      // Only the servo runs. It must update the range spaces itself when a task engages.
+      q(0) = rob_ds->gc_pos_limit_max_(0) - 0.05*(rob_ds->gc_pos_limit_max_(0) - rob_ds->gc_pos_limit_min_(0));
+      robot.setGeneralizedCoordinates(q);
+      robot.computeServo();
+      if(false == lim->is_engaged_ || 0 == lim->force_gc_.norm())
+      { throw(std::runtime_error("The limit task didn't engage near a joint limit"));  }
+      if(0 != gcset->range_space_.norm())
+      { throw(std::runtime_error("The engaged limit task didn't use up the next level's range space"));  }
+      if(plane->is_engaged_)
+      { throw(std::runtime_error("The plane engaged without being penetrated"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  The limit task engaged near a joint limit (and took the range space)";
+
+      // ********** 3. The hand penetrates the plane **********
+      // Move the plane above the robot, with the free side further up.
+      plane->p0_<<1,0,5; plane->p1_<<0,1,5; plane->p2_<<1,1,5; plane->pfree_<<0,0,10;
+      flag = scl::computePlaneCoefficients(plane->p0_, plane->p1_, plane->p2_, plane->a_, plane->b_, plane->c_, plane->d_);
+      if(false == flag)
+      { throw(std::runtime_error("Could not compute the plane's coefficients"));  }
+      plane->mul_dist_ = (scl::computePlanePointDistance(plane->a_, plane->b_, plane->c_, plane->d_, plane->pfree_) > 0) ? 1 : -1;
+
+      robot.computeDynamics();
+      robot.computeServo();
+      if(false == plane->is_engaged_ || 0 == plane->force_gc_.norm())
+      { throw(std::runtime_error("The plane didn't engage when the hand penetrated it"));  }
+      tasks_eq.push_back("plane"); tasks_eq.push_back("limits");
+      if((robot.getData()->io_data_->actuators_.force_gc_commanded_ -
+          sumTaskForces(*ctrl, tasks_eq)).cwiseAbs().maxCoeff() > test_precision)
+      { throw(std::runtime_error("The engaged inequality tasks' forces aren't in the command"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  The plane engaged when the hand penetrated it";
+
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
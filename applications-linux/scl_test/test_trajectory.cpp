@@ -0,0 +1,216 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* \file test_trajectory.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "test_trajectory.hpp"
+
+#include <scl/DataTypes.hpp>
+#include <scl/trajectory/CTrajectoryFile.hpp>
+#include <scl/trajectory/CTrajectorySpline.hpp>
+#include <scl/trajectory/CTrajectoryGenerator.hpp>
+#include <scl/trajectory/CTrajectoryOtg.hpp>
+
+#include <sutil/CMappedList.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <sstream>
+#include <cstdio>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+namespace scl_test
+{
+  void test_trajectory(int id)
+  {
+    scl::sUInt r_id=0;
+    const std::string file("./test_trajectory.scltraj");
+    try
+    {
+      // ********************************************************
+      // 1. Write a 10s, 1kHz trajectory : q_i(t) = sin(t + i)
+      // ********************************************************
+      const scl::sUInt dof = 3;
+      const scl::sLongLong n_pts = 10001;
+      const double dt = 0.001;
+      scl::CTrajectoryFileWriter writer;
+      if(false == writer.open(file, dof))
+      { throw(std::runtime_error("Could not open a trajectory file to write"));  }
+      double pos[dof];
+      for(scl::sLongLong i=0; i<n_pts; ++i)
+      {
+        for(scl::sUInt j=0; j<dof; ++j) { pos[j] = std::sin(i*dt + j); }
+        if(false == writer.append(i*dt, pos))
+        { throw(std::runtime_error("Could not append a waypoint"));  }
+      }
+      if(false == writer.close())
+      { throw(std::runtime_error("Could not close the trajectory file"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Wrote a trajectory file with "<<n_pts<<" waypoints";
+
+      // ********************************************************
+      // 2. Map it and check the header
+      // ********************************************************
+      scl::CTrajectoryFile traj;
+      if(false == traj.open(file))
+      { throw(std::runtime_error("Could not map the trajectory file"));  }
+      if(dof != traj.getDof() || n_pts != traj.getNumPoints() || traj.hasVelocities())
+      { throw(std::runtime_error("Mapped trajectory's header doesn't match what was written"));  }
+      if(std::fabs(traj.getPos(1234)[2] - std::sin(1.234 + 2)) > 1e-15)
+      { throw(std::runtime_error("Mapped trajectory's waypoints don't match what was written"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Mapped the trajectory file";
+
+      // ********************************************************
+      // 3. Sweep the splines at 3kHz (between the waypoints)
+      // ********************************************************
+      Eigen::VectorXd p, v, a;
+      for(int type = 0; type < 2; ++type)
+      {
+        scl::CTrajectorySpline spline;
+        if(false == spline.init(&traj, type ? scl::CTrajectorySpline::SPLINE_QUINTIC :
+            scl::CTrajectorySpline::SPLINE_CUBIC))
+        { throw(std::runtime_error("Could not initialize the spline"));  }
+
+        double err_p = 0, err_v = 0;
+        for(double t = dt/3; t < 9.99; t += dt/3)
+        {
+          if(false == spline.evaluate(t,p,v,a))
+          { throw(std::runtime_error("Spline ended before the trajectory did"));  }
+          for(scl::sUInt j=0; j<dof; ++j)
+          {
+            err_p = std::max(err_p, std::fabs(p(j) - std::sin(t + j)));
+            err_v = std::max(err_v, std::fabs(v(j) - std::cos(t + j)));
+          }
+        }
+        std::cout<<"\nTest Result ("<<r_id++<<")  "<<(type ? "Quintic" : "Cubic")
+            <<" spline max errors : pos "<<err_p<<", vel "<<err_v
+            <<". Cursor searches : "<<spline.getNumSearches();
+        if(err_p > 1e-7 || err_v > 1e-5)
+        { throw(std::runtime_error("Spline doesn't interpolate the trajectory accurately"));  }
+        if(0 != spline.getNumSearches())
+        { throw(std::runtime_error("Spline searched on a forward sweep"));  }
+
+        // Jump back and then past the end
+        if(false == spline.evaluate(1.0,p,v,a) || std::fabs(p(0) - std::sin(1.0)) > 1e-7)
+        { throw(std::runtime_error("Spline didn't evaluate correctly after jumping back"));  }
+        if(true == spline.evaluate(11.0,p,v,a) || std::fabs(p(0) - std::sin(10.0)) > 1e-12 ||
+            0 != v.norm())
+        { throw(std::runtime_error("Spline didn't hold the last waypoint past the end"));  }
+      }
+      traj.close();
+
+      // ********************************************************
+      // 4. Generator : function trajectory and ring buffer log
+      // ********************************************************
+      scl::CTrajectoryGenerator<3> gen;
+      Eigen::Vector3d lim(10,10,10), zero(0,0,0), ones(1,1,1);
+      if(false == gen.initTraj(dt, lim, lim, lim, -lim, -lim, -lim, 100))
+      { throw(std::runtime_error("Could not initialize the trajectory generator"));  }
+      if(false == gen.setTrajFromFunc(std::sin, 1001, dt, zero, ones, zero))
+      { throw(std::runtime_error("Could not set a function trajectory"));  }
+
+      Eigen::Vector3d gp, gv, ga;
+      int n_goals = 0;
+      while(gen.getCurrGoal(gp,gv,ga))
+      {
+        gen.saveCurrState(gp, n_goals*dt);
+        n_goals++;
+        if(n_goals > 2000) { break; }
+      }
+      if(1001 != n_goals)
+      {
+        std::stringstream ss; ss<<"Generator returned "<<n_goals<<" goals for 1001 slices";
+        throw(std::runtime_error(ss.str()));
+      }
+      if(100 != gen.getNumLoggedStates())
+      { throw(std::runtime_error("Generator's log didn't stay at its capacity"));  }
+
+      sutil::CMappedList<scl::sFloat, Eigen::Matrix<scl::sFloat,3,1> > logged;
+      if(false == gen.getLoggedPositions(logged))
+      { throw(std::runtime_error("Could not read the generator's log"));  }
+      Eigen::Matrix<scl::sFloat,3,1>* oldest = logged.at(901*dt);
+      if(S_NULL == oldest || std::fabs((*oldest)(0) - std::sin(901*dt)) > 1e-12)
+      { throw(std::runtime_error("Generator's log didn't keep the latest states"));  }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Generator tracked "<<n_goals
+          <<" goals and logged the last "<<gen.getNumLoggedStates();
+
+      // ********************************************************
+      // 5. Online trajectory generation : limits, overshoot and
+      //    (near) time optimality for goal jumps
+      // ********************************************************
+      const double vmax = 1.0, amax = 2.0, jmax = 20.0;
+      for(int jerk = 0; jerk < 2; ++jerk)
+      {
+        scl::CTrajectoryOtg otg;
+        Eigen::VectorXd lv(1), la(1), lj(jerk ? 1 : 0);
+        lv(0) = vmax; la(0) = amax; if(jerk) { lj(0) = jmax; }
+        if(false == otg.init(2, lv, la, lj, dt))
+        { throw(std::runtime_error("Could not initialize the online trajectory generator"));  }
+        otg.reset(Eigen::Vector2d(0,0), Eigen::Vector2d(0,0));
+
+        // Rest to rest : dof 0 moves 1m (reaches max vel), dof 1 moves 0.01m (doesn't)
+        Eigen::Vector2d goal(1.0, -0.01);
+        double acc_pre = 0, err_lim = 0, overshoot = 0;
+        int ticks = 0;
+        while(false == otg.update(goal) && ticks < 10000)
+        {
+          ticks++;
+          err_lim = std::max(err_lim, otg.getVel().cwiseAbs().maxCoeff() - vmax);
+          err_lim = std::max(err_lim, otg.getAcc().cwiseAbs().maxCoeff() - amax);
+          if(jerk) { err_lim = std::max(err_lim, std::fabs(otg.getAcc()(0) - acc_pre)/dt - jmax); }
+          acc_pre = otg.getAcc()(0);
+          overshoot = std::max(overshoot, otg.getPos()(0) - goal(0));
+          overshoot = std::max(overshoot, goal(1) - otg.getPos()(1));
+        }
+        // The optimal time : d/V + V/A (+ A/J with a jerk limit)
+        const double t_opt = 1.0/vmax + vmax/amax + (jerk ? amax/jmax : 0.0);
+        std::cout<<"\nTest Result ("<<r_id++<<")  Otg ("<<(jerk ? "jerk" : "acc")
+            <<" limited) rest to rest : "<<ticks*dt<<"s (optimal "<<t_opt<<"s). Overshoot "
+            <<overshoot<<", limit excess "<<err_lim;
+        if(10000 == ticks || ticks*dt > t_opt + 0.01)
+        { throw(std::runtime_error("Otg didn't reach the goal (near) time optimally"));  }
+        if(overshoot > 1e-9 || err_lim > 1e-9)
+        { throw(std::runtime_error("Otg overshot the goal or exceeded its limits"));  }
+
+        // Jumpy goals (eg. a ui point) : never exceed the limits, always settle
+        srand(1); err_lim = 0; acc_pre = otg.getAcc()(0);
+        for(int i=0; i<20000; ++i)
+        {
+          if(0 == i%150) { goal = Eigen::Vector2d::Random(); }
+          otg.update(goal);
+          err_lim = std::max(err_lim, otg.getVel().cwiseAbs().maxCoeff() - vmax);
+          err_lim = std::max(err_lim, otg.getAcc().cwiseAbs().maxCoeff() - amax);
+          if(jerk) { err_lim = std::max(err_lim, std::fabs(otg.getAcc()(0) - acc_pre)/dt - jmax); }
+          acc_pre = otg.getAcc()(0);
+        }
+        for(ticks = 0; false == otg.update(goal) && ticks < 10000; ++ticks) {}
+        if(err_lim > 1e-9 || 10000 == ticks)
+        { throw(std::runtime_error("Otg exceeded its limits or didn't settle with jumpy goals"));  }
+      }
+      std::cout<<"\nTest Result ("<<r_id++<<")  Otg stayed within its limits for jumpy goals";
+
+      std::remove(file.c_str());
+      std::cout<<"\nTest #"<<id<<" : Succeeded.";
+    }
+    catch (std::exception& ee)
+    {
+      std::remove(file.c_str());
+      std::cout<<"\nTest Result ("<<r_id++<<") : "<<ee.what();
+      std::cout<<"\nTest #"<<id<<" : Failed.";
+    }
+  }
+}
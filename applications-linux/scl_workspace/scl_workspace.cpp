@@ -0,0 +1,131 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+/* \file scl_workspace.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+//scl headers used
+#include <scl/DataTypes.hpp>
+#include <scl/Singletons.hpp>
+#include <scl/robot/DbRegisterFunctions.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+#include <scl/dynamics/scl/CReachabilityMap.hpp>
+#include <scl/util/CPerfStats.hpp>
+
+#include <Eigen/Dense>
+
+//Standard includes
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+
+/** Builds a reachability map (see scl::CReachabilityMap) for a robot's op point
+ * by sampling configurations within its gc limits on all cores.
+ *
+ * The map is a voxel grid with the number of samples, the best and mean
+ * manipulability and the best inverse condition number in each voxel.
+ * Controllers memory map it and query it in O(1). */
+int main(int argc, char** argv)
+{
+  if(5 > argc)
+  {
+    std::cout<<"\nscl_workspace : Builds a reachability and manipulability map for a robot's op point."
+        <<"\nThe command line input is: ./<executable> <config_file> <robot_name> <link_name> <out_file>"
+        <<"\n      <optional : -n samples (default 1e7)> <optional : -stratified>"
+        <<"\n      <optional : -pos x y z (op point in link coords)> <optional : -voxel size (default 0.02m)>"
+        <<"\n      <optional : -bounds xmin ymin zmin xmax ymax zmax> <optional : -seed s> <optional : -threads n>\n";
+    return 0;
+  }
+
+  try
+  {
+    const std::string file(argv[1]), robot_name(argv[2]), link_name(argv[3]), file_out(argv[4]);
+    scl::sLongLong n_samples = 10000000;
+    bool flag_stratified = false, flag_bounds = false;
+    Eigen::Vector3d pos(0,0,0), bmin, bmax;
+    double voxel = 0.02;
+    unsigned int seed = 1, n_threads = 0;
+
+    for(int i=5; i<argc; ++i)
+    {
+      const std::string a(argv[i]);
+      const int n_left = argc - i - 1;
+      if(a == "-n" && n_left >= 1) { n_samples = atoll(argv[++i]); }
+      else if(a == "-stratified") { flag_stratified = true; }
+      else if(a == "-pos" && n_left >= 3)
+      { for(int j=0; j<3; ++j) { pos(j) = atof(argv[++i]); } }
+      else if(a == "-voxel" && n_left >= 1) { voxel = atof(argv[++i]); }
+      else if(a == "-bounds" && n_left >= 6)
+      {
+        for(int j=0; j<3; ++j) { bmin(j) = atof(argv[++i]); }
+        for(int j=0; j<3; ++j) { bmax(j) = atof(argv[++i]); }
+        flag_bounds = true;
+      }
+      else if(a == "-seed" && n_left >= 1) { seed = static_cast<unsigned int>(atoi(argv[++i])); }
+      else if(a == "-threads" && n_left >= 1) { n_threads = static_cast<unsigned int>(atoi(argv[++i])); }
+      else { throw(std::runtime_error(std::string("Unknown (or incomplete) option : ")+a)); }
+    }
+
+    scl::SDatabase * db = scl::CDatabase::getData();
+    if(S_NULL==db) { throw(std::runtime_error("Database not initialized."));  }
+
+    scl::CParserScl parser;
+    const scl::SRobotParsed *rob_ds = scl_registry::parseRobot(file, robot_name, &parser);
+    if(S_NULL == rob_ds)
+    { throw(std::runtime_error(std::string("Could not parse robot : ")+robot_name+" in "+file)); }
+
+    scl::CDynamicsScl dynamics;
+    if(false == dynamics.init(*rob_ds)) { throw(std::runtime_error("Could not initialize the dynamics")); }
+
+    scl::CReachabilityMapBuilder builder;
+    if(false == builder.init(*rob_ds, &dynamics, link_name, pos, n_threads))
+    { throw(std::runtime_error("Could not initialize the map builder")); }
+    if(flag_bounds || 0.02 != voxel)
+    {
+      if(false == flag_bounds)
+      {// Keep the automatic bounds
+        bmin = builder.getGridMin();
+        bmax = bmin + 0.02*Eigen::Vector3d(builder.getNx(), builder.getNy(), builder.getNz());
+      }
+      if(false == builder.setGrid(bmin, bmax, voxel)) { throw(std::runtime_error("Invalid grid")); }
+    }
+
+    std::cout<<"\nscl_workspace : "<<robot_name<<"::"<<link_name<<". Sampling "<<builder.getNumChainGcs()
+        <<" gcs ("<<(flag_stratified ? "stratified" : "random")<<") on "<<builder.getNumThreads()<<" threads. Grid "
+        <<builder.getNx()<<"x"<<builder.getNy()<<"x"<<builder.getNz()<<std::flush;
+
+    const scl::sLongLong t0 = scl::CPerfStats::nowNs();
+    if(false == builder.sample(n_samples, flag_stratified, seed))
+    { throw(std::runtime_error("Sampling failed")); }
+    const double dt = static_cast<double>(scl::CPerfStats::nowNs() - t0) * 1e-9;
+
+    if(false == builder.write(file_out))
+    { throw(std::runtime_error(std::string("Could not write : ")+file_out)); }
+
+    std::cout<<"\nscl_workspace : "<<builder.getNumSamples()<<" samples in "<<dt<<"s ("
+        <<builder.getNumSamples()/dt<<"/s). "<<builder.getNumSamplesOutside()<<" outside the grid. "
+        <<builder.getNumVoxelsReached()<<" voxels reached. Saved "<<file_out<<"\n";
+  }
+  catch(std::exception& e)
+  {
+    std::cout<<"\nscl_workspace : ERROR : "<<e.what()<<"\n";
+    return 1;
+  }
+  return 0;
+}
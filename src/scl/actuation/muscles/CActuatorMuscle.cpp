@@ -40,7 +40,7 @@ namespace scl
   /** Default constructor. Sets stuff to NULL. */
   CActuatorMuscle::CActuatorMuscle() :
       robot_(NULL),
-      mset_parsed_(NULL), muscle_(NULL), dynamics_(NULL)
+      mset_parsed_(NULL), muscle_(NULL), dynamics_(NULL), jcache_(NULL)
   {}
 
   /** Initializes the actuator. This involves determining whether the muscle
@@ -243,8 +243,12 @@ namespace scl
         tmp_pt_set.x_glob_0_ = tmp_pt_set.rigid_body_dyn_0_->T_o_lnk_ * tmp_pt_set.pos_in_parent_0_;
 
         //1.c.0: Compute Jacobians at the via points.
-        flag = flag && dynamics_->computeJacobian(tmp_pt_set.J_0_, *tmp_pt_set.rigid_body_dyn_0_,
-            arg_q, tmp_pt_set.pos_in_parent_0_);
+        if(NULL != jcache_)
+        { flag = flag && jcache_->computeJacobian(tmp_pt_set.J_0_, *tmp_pt_set.rigid_body_dyn_0_,
+            arg_q, tmp_pt_set.pos_in_parent_0_); }
+        else
+        { flag = flag && dynamics_->computeJacobian(tmp_pt_set.J_0_, *tmp_pt_set.rigid_body_dyn_0_,
+            arg_q, tmp_pt_set.pos_in_parent_0_); }
         //Use the position jacobian only. This is a point task.
         tmp_pt_set.J_0_ = tmp_pt_set.J_0_.block(0,0,3,robot_->dof_);
       }
@@ -254,8 +258,12 @@ namespace scl
         tmp_pt_set.x_glob_1_ = tmp_pt_set.rigid_body_dyn_1_->T_o_lnk_ * tmp_pt_set.pos_in_parent_1_;
 
         //1.c.1: Compute Jacobians at the via points.
-        flag = flag && dynamics_->computeJacobian(tmp_pt_set.J_1_, *tmp_pt_set.rigid_body_dyn_1_,
-            arg_q, tmp_pt_set.pos_in_parent_1_);
+        if(NULL != jcache_)
+        { flag = flag && jcache_->computeJacobian(tmp_pt_set.J_1_, *tmp_pt_set.rigid_body_dyn_1_,
+            arg_q, tmp_pt_set.pos_in_parent_1_); }
+        else
+        { flag = flag && dynamics_->computeJacobian(tmp_pt_set.J_1_, *tmp_pt_set.rigid_body_dyn_1_,
+            arg_q, tmp_pt_set.pos_in_parent_1_); }
         //Use the position jacobian only. This is a point task.
         tmp_pt_set.J_1_ = tmp_pt_set.J_1_.block(0,0,3,robot_->dof_);
       }
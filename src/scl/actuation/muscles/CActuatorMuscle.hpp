@@ -40,6 +40,7 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <scl/data_structs/SRobotParsed.hpp>
 #include <scl/data_structs/SActuatorSetMuscleParsed.hpp>
 #include <scl/dynamics/CDynamicsBase.hpp>
+#include <scl/dynamics/CJacobianCache.hpp>
 
 #include <scl/actuation/muscles/data_structs/SActuatorMuscle.hpp>
 
@@ -142,6 +143,11 @@ namespace scl
     /** Has this actuator been initialized */
     virtual inline sBool hasBeenInit();
 
+    /** Shares a (controller's) Jacobian cache with this actuator.
+     * Pass NULL to compute Jacobians directly with the dynamics object. */
+    void setJacobianCache(CJacobianCache* arg_jcache)
+    { jcache_ = arg_jcache; }
+
     /* *****************************************************************
      *                        Constructors
      * ***************************************************************** */
@@ -166,6 +172,9 @@ namespace scl
 
     /** Dynamics specification (to compute robot Jacobians) */
     CDynamicsBase *dynamics_;
+
+    /** Memoized link Jacobians (may be NULL) */
+    CJacobianCache *jcache_;
   };
 
 } /* namespace scl */
@@ -49,7 +49,8 @@ namespace scl
   sBool CActuatorSetMuscle::init(
       SActuatorSetMuscle &arg_mset,
       SGcModel &arg_rgcm,
-      CDynamicsBase *arg_dynamics)
+      CDynamicsBase *arg_dynamics,
+      CJacobianCache *arg_jcache)
   {
     bool flag;
     try
@@ -63,6 +64,8 @@ namespace scl
       { throw(std::runtime_error("Passed uninitialized robot gc model")); }
       if(false==arg_dynamics->hasBeenInit())
       { throw(std::runtime_error("Passed uninitialized robot dynamics object")); }
+      if(NULL != arg_jcache && false==arg_jcache->hasBeenInit())
+      { throw(std::runtime_error("Passed uninitialized Jacobian cache")); }
 
       if(NULL == arg_mset.mset_parsed_->robot_)
       { throw(std::runtime_error("Passed mset is linked to a mset_parsed data struct that has a null robot pointer")); }
@@ -87,6 +90,8 @@ namespace scl
         flag = musc->init(it->name_,*(arg_mset.mset_parsed_), arg_rgcm, arg_dynamics);
         if(false == flag)
         { throw(std::runtime_error(std::string("Could not initialize muscle: ")+it->name_)); }
+
+        musc->setJacobianCache(arg_jcache);
       }
 
       flag = muscles_.sort(data_->mset_parsed_->muscle_id_to_name_);
@@ -115,6 +120,14 @@ namespace scl
     return has_been_init_;
   }
 
+  /** Shares a (controller's) Jacobian cache with all the muscles. */
+  void CActuatorSetMuscle::setJacobianCache(CJacobianCache* arg_jcache)
+  {
+    sutil::CMappedList<std::string, CActuatorMuscle>::iterator itm,itme;
+    for (itm = muscles_.begin(), itme = muscles_.end(); itm != itme; ++itm)
+    { itm->setJacobianCache(arg_jcache); }
+  }
+
 
   /** Some actuator sets don't directly actuate the generalized coordinates
    * and require a Jacobian to compute their contribution to the generalized
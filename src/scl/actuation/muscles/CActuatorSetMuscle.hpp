@@ -106,15 +106,23 @@ namespace scl
      * ***************************************************************** */
     /** Initializes the actuators. This involves determining whether the muscle
      * matches the robot etc. It also sets up the Jacobians to be computed etc.
+     *
+     * Pass the controller's Jacobian cache (and the controller's gc model) to
+     * share link Jacobians with its tasks. See setJacobianCache().
      */
     virtual sBool init(
         SActuatorSetMuscle &arg_mset,
         SGcModel &arg_rgcm,
-        CDynamicsBase *arg_dynamics);
+        CDynamicsBase *arg_dynamics,
+        CJacobianCache *arg_jcache = NULL);
 
     /** Has this actuator been initialized */
     virtual sBool hasBeenInit();
 
+    /** Shares a (controller's) Jacobian cache with all the muscles.
+     * Pass NULL to compute Jacobians directly with the dynamics object. */
+    void setJacobianCache(CJacobianCache* arg_jcache);
+
     /* *****************************************************************
      *                        Constructors
      * ***************************************************************** */
@@ -34,8 +34,13 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <sutil/CRegisteredCallbacks.hpp>
 #include <sutil/CRegisteredPrintables.hpp>
 
+#include <scl/control/task/CControllerMultiTask.hpp>
+#include <scl/util/CPerfStats.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
+
 #include <string>
 #include <iostream>
+#include <sstream>
 
 
 namespace scl
@@ -117,6 +122,45 @@ namespace scl
   CCallbackSet::base* CCallbackSet::createObject()
   { return dynamic_cast<CCallbackSet::base*>(new CCallbackSet()); }
 
+  /** Sets a task's goal position through the controller's
+   * shell command channel. */
+  void CCallbackTaskGoal::call(std::vector<std::string>& arg)
+  {
+    if(2 >= arg.size() || "--help" == arg[1])
+    { std::cout<<" >>goal <task_name> <val_0> <val_1> ... <val_n>\n Sets a task's goal position"; return; }
+
+    if(S_NULL == data_)
+    { std::cout<<"Controller not set"; return; }
+
+    CTaskCommandChannel* ch = data_->getCommandChannel("shell");
+    if(S_NULL == ch)
+    { std::cout<<"Controller doesn't have a 'shell' command channel"; return; }
+
+    CTaskBase* task = data_->getTask(arg[1]);
+    if(S_NULL == task)
+    { std::cout<<"Task not found : "<<arg[1]; return; }
+
+    STaskCommand* cmd = ch->getWriteSlot();
+    if(S_NULL == cmd)
+    { std::cout<<"Command channel is full (is the controller running?)"; return; }
+
+    cmd->val_.setZero(arg.size()-2);
+    for(size_t i=2; i<arg.size(); ++i)
+    {
+      std::stringstream ss(arg[i]);
+      ss>>cmd->val_(i-2);
+      if(ss.fail())
+      { std::cout<<"Not a number : "<<arg[i]; return; }
+    }
+    cmd->task_ = task;
+    cmd->type_ = STaskCommand::CMD_GOAL_POS;
+    ch->commitWrite();
+    std::cout<<"Sent goal : "<<cmd->val_.transpose();
+  }
+
+  CCallbackTaskGoal::base* CCallbackTaskGoal::createObject()
+  { return dynamic_cast<CCallbackTaskGoal::base*>(new CCallbackTaskGoal()); }
+
   /** Prints out a generic help message and also lists all the
    * other available commands */
   void CCallbackHelp::call(std::vector<std::string>& arg)
@@ -139,6 +183,59 @@ namespace scl
   CCallbackHelp::base* CCallbackHelp::createObject()
   { return dynamic_cast<base*>(new CCallbackHelp()); }
 
+  /** Prints (or resets) the timing percentiles */
+  void CCallbackPerf::call(std::vector<std::string>& arg)
+  {
+    if(1 >= arg.size())
+    { CPerfStats::print(std::cout); }
+    else if("--help" == arg[1])
+    { std::cout<<" >>perf <optional: reset | on | off | alloc <optional: on | off | reset> >\n Prints the timing percentiles (usec) of the control, model, io and loop timers"
+        <<"\n >>perf alloc prints the heap allocations in each timer (needs the malloc hooks)"; }
+    else if("reset" == arg[1])
+    { CPerfStats::reset(); std::cout<<"Cleared the timing histograms"; }
+    else if("on" == arg[1])
+    { CPerfStats::setEnabled(true); std::cout<<"Timing on"; }
+    else if("off" == arg[1])
+    { CPerfStats::setEnabled(false); std::cout<<"Timing off"; }
+    else if("alloc" == arg[1])
+    {
+      if(2 >= arg.size()) { CAllocTracker::print(std::cout); }
+      else if("on" == arg[2]) { CAllocTracker::setEnabled(true); std::cout<<"Allocation counting on"; }
+      else if("off" == arg[2]) { CAllocTracker::setEnabled(false); std::cout<<"Allocation counting off"; }
+      else if("reset" == arg[2]) { CAllocTracker::reset(); std::cout<<"Cleared the allocation counts"; }
+      else { std::cout<<"Unknown option : "<<arg[2]<<". Type: perf --help"; }
+    }
+    else
+    { std::cout<<"Unknown option : "<<arg[1]<<". Type: perf --help"; }
+  }
+
+  CCallbackPerf::base* CCallbackPerf::createObject()
+  { return dynamic_cast<base*>(new CCallbackPerf()); }
+
+  /** Prints (or clears) the parser's xml document cache */
+  void CCallbackXmlCache::call(std::vector<std::string>& arg)
+  {
+    if(1 >= arg.size())
+    {
+      SXmlCacheStats st = CParserScl::getXmlCacheStats();
+      std::cout<<"Xml cache ("<<(CParserScl::getXmlCacheEnabled() ? "on" : "off")<<") : "
+          <<st.entries_<<" documents. Hits : "<<st.hits_<<". Misses : "<<st.misses_;
+    }
+    else if("--help" == arg[1])
+    { std::cout<<" >>xmlcache <optional: clear | on | off>\n Prints or clears the parsed xml files shared by the parser's read calls"; }
+    else if("clear" == arg[1])
+    { CParserScl::clearXmlCache(); std::cout<<"Cleared the xml cache"; }
+    else if("on" == arg[1])
+    { CParserScl::setXmlCacheEnabled(true); std::cout<<"Xml cache on"; }
+    else if("off" == arg[1])
+    { CParserScl::setXmlCacheEnabled(false); std::cout<<"Xml cache off"; }
+    else
+    { std::cout<<"Unknown option : "<<arg[1]<<". Type: xmlcache --help"; }
+  }
+
+  CCallbackXmlCache::base* CCallbackXmlCache::createObject()
+  { return dynamic_cast<base*>(new CCallbackXmlCache()); }
+
 
   /** Key hander callbacks for decrementing a double data member
    * (5x data change if key is caps) */
@@ -39,6 +39,9 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 
 namespace scl
 {
+  //Forward declare the controller (for the task goal callback)
+  class CControllerMultiTask;
+
   /** A set of generic callbacks (to be used with the CRobotApp console).
    *
    * Please read the documentation for the CRobotApp console
@@ -89,6 +92,23 @@ namespace scl
     virtual base* createObject();
   };
 
+  /** Sets a task's goal position from the shell :
+   *   >>goal <task_name> <val_0> <val_1> ... <val_n>
+   *
+   * Sends the goal through the controller's "shell" command channel
+   * (so the shell thread never writes into a task the servo is using).
+   * Register it with the controller as the data pointer, after creating
+   * the channel with CControllerMultiTask::createCommandChannel("shell"). */
+  class CCallbackTaskGoal : public sutil::CCallbackBase<std::string, std::vector<std::string>, CControllerMultiTask>
+  {
+  public:
+    typedef sutil::CCallbackBase<std::string, std::vector<std::string>, CControllerMultiTask> base;
+
+    virtual void call(std::vector<std::string>& arg);
+
+    virtual base* createObject();
+  };
+
   /** Prints out a generic help message and also lists all the
    * other available commands */
   class CCallbackHelp : public sutil::CCallbackBase<std::string, std::vector<std::string> >
@@ -101,6 +121,35 @@ namespace scl
     virtual base* createObject();
   };
 
+  /** Prints the timing percentiles of all the CPerfStats timers :
+   *   >>perf            : Prints n, mean, p50, p99, p99.9 and max (usec)
+   *   >>perf reset      : Clears the histograms
+   *   >>perf on | off   : Turns timing on or off
+   *   >>perf alloc <optional: on | off | reset> : Heap allocations per timer (see CAllocTracker) */
+  class CCallbackPerf : public sutil::CCallbackBase<std::string, std::vector<std::string> >
+  {
+  public:
+    typedef sutil::CCallbackBase<std::string, std::vector<std::string> > base;
+
+    virtual void call(std::vector<std::string>& arg);
+
+    virtual base* createObject();
+  };
+
+  /** Manages the parser's xml document cache :
+   *   >>xmlcache          : Prints the number of cached documents, hits and misses
+   *   >>xmlcache clear    : Drops all the cached documents (the next read re-parses)
+   *   >>xmlcache on | off : Turns the cache on or off */
+  class CCallbackXmlCache : public sutil::CCallbackBase<std::string, std::vector<std::string> >
+  {
+  public:
+    typedef sutil::CCallbackBase<std::string, std::vector<std::string> > base;
+
+    virtual void call(std::vector<std::string>& arg);
+
+    virtual base* createObject();
+  };
+
   /** Key hander callbacks for decrementing a double data member
    * (5x data change if key is caps) */
   class CCallbackDecrement : public sutil::CCallbackBase<char, bool, double>
@@ -43,6 +43,8 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 /** Multi-Task Controller : Base control formulation */
 #include <scl/control/task/CControllerMultiTask.hpp>
 #include <scl/control/task/CServo.hpp>
+#include <scl/control/task/CStatePredictor.hpp>
+#include <scl/control/task/STaskCommand.hpp>
 #include <scl/control/task/data_structs/SControllerMultiTask.hpp>
 #include <scl/control/task/data_structs/SServo.hpp>
 
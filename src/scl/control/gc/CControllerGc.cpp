@@ -31,6 +31,7 @@ scl. If not, see <http://www.gnu.org/licenses/>.
  */
 
 #include <scl/control/gc/CControllerGc.hpp>
+#include <scl/util/CPerfStats.hpp>
 
 #include <stdexcept>
 #include <iostream>
@@ -49,28 +50,29 @@ namespace scl
 
   sBool CControllerGc::computeControlForces()
   {
+    SCL_PERF_SCOPE("ctrl::servo");
     //Compute the servo torques
-    static Eigen::VectorXd tmp1, tmp2, tmp3;
 
-    tmp1 = (data_->des_q_ - data_->io_data_->sensors_.q_);
-    tmp1 =  data_->kp_.array() * tmp1.array();
+    tmp1_ = (data_->des_q_ - data_->io_data_->sensors_.q_);
+    tmp1_ =  data_->kp_.array() * tmp1_.array();
 
-    tmp2 = (data_->des_dq_ - data_->io_data_->sensors_.dq_);
-    tmp2 = data_->kv_.array() * tmp2.array();
+    tmp2_ = (data_->des_dq_ - data_->io_data_->sensors_.dq_);
+    tmp2_ = data_->kv_.array() * tmp2_.array();
 
-    tmp3 = (data_->des_ddq_ - data_->io_data_->sensors_.ddq_);
-    tmp3 = data_->ka_.array() * tmp3.array();
+    tmp3_ = (data_->des_ddq_ - data_->io_data_->sensors_.ddq_);
+    tmp3_ = data_->ka_.array() * tmp3_.array();
 
     //Obtain force to be applied to a unit mass floating about
     //in space (ie. A dynamically decoupled mass).
-    tmp3 += tmp2 + tmp1;
+    tmp3_ += tmp2_ + tmp1_;
 
     //Apply Task's Force Limits
-    tmp3 = tmp3.array().min(data_->force_gc_max_.array()); // Remain below the upper bound.
-    tmp3 = tmp3.array().max(data_->force_gc_min_.array()); // Remain above the lower bound.
+    tmp3_ = tmp3_.array().min(data_->force_gc_max_.array()); // Remain below the upper bound.
+    tmp3_ = tmp3_.array().max(data_->force_gc_min_.array()); // Remain above the lower bound.
 
     // We do not use the centrifugal/coriolis forces. They can cause instabilities.
-    data_->des_force_gc_ = data_->gc_model_->M_gc_ * tmp3 - data_->gc_model_->force_gc_grav_;
+    data_->des_force_gc_.noalias() = data_->gc_model_->M_gc_ * tmp3_;
+    data_->des_force_gc_ -= data_->gc_model_->force_gc_grav_;
 
     // Now set the forces in the io data structure
     data_->io_data_->actuators_.force_gc_commanded_ = data_->des_force_gc_;
@@ -82,23 +84,23 @@ namespace scl
   {
     //Compute the servo generalized forces :
     //F_gc_star = M(q) (-kp(q-q_des)-kv(dq/dt)) + b(q,dq/dt) + g(q)
-    static Eigen::VectorXd tmp1, tmp2, tmp3;
 
-    tmp1 = data_->io_data_->sensors_.q_ - data_->des_q_;
-    tmp1 = data_->kp_.array() * tmp1.array();
+    tmp1_ = data_->io_data_->sensors_.q_ - data_->des_q_;
+    tmp1_ = data_->kp_.array() * tmp1_.array();
 
-    tmp2 = data_->kv_.array() * data_->io_data_->sensors_.dq_.array();
+    tmp2_ = data_->kv_.array() * data_->io_data_->sensors_.dq_.array();
 
     //Obtain force to be applied to a unit mass floating about
     //in space (ie. A dynamically decoupled mass).
-    tmp3 = -tmp2 - tmp1;
+    tmp3_ = -tmp2_ - tmp1_;
 
     //Apply Task's Force Limits
-    tmp3 = tmp3.array().min(data_->force_gc_max_.array()); // Remain below the upper bound.
-    tmp3 = tmp3.array().max(data_->force_gc_min_.array()); // Remain above the lower bound.
+    tmp3_ = tmp3_.array().min(data_->force_gc_max_.array()); // Remain below the upper bound.
+    tmp3_ = tmp3_.array().max(data_->force_gc_min_.array()); // Remain above the lower bound.
 
     // We do not use the centrifugal/coriolis forces. They can cause instabilities.
-    data_->des_force_gc_ = data_->gc_model_->M_gc_ * tmp3 - data_->gc_model_->force_gc_grav_;
+    data_->des_force_gc_.noalias() = data_->gc_model_->M_gc_ * tmp3_;
+    data_->des_force_gc_ -= data_->gc_model_->force_gc_grav_;
 
     // Now set the forces in the io data structure
     data_->io_data_->actuators_.force_gc_commanded_ = data_->des_force_gc_;
@@ -113,16 +115,15 @@ namespace scl
     data_->integral_gain_time_curr_ = arg_time;
 
     //Compute the servo torques
-    static Eigen::VectorXd tmp1, tmp2, tmp3;
 
-    tmp1 = (data_->des_q_ - data_->io_data_->sensors_.q_);
-    tmp1 =  data_->kp_.array() * tmp1.array();
+    tmp1_ = (data_->des_q_ - data_->io_data_->sensors_.q_);
+    tmp1_ =  data_->kp_.array() * tmp1_.array();
 
-    tmp2 = (data_->des_dq_ - data_->io_data_->sensors_.dq_);
-    tmp2 = data_->kv_.array() * tmp2.array();
+    tmp2_ = (data_->des_dq_ - data_->io_data_->sensors_.dq_);
+    tmp2_ = data_->kv_.array() * tmp2_.array();
 
-    tmp3 = (data_->des_ddq_ - data_->io_data_->sensors_.ddq_);
-    tmp3 = data_->ka_.array() * tmp3.array();
+    tmp3_ = (data_->des_ddq_ - data_->io_data_->sensors_.ddq_);
+    tmp3_ = data_->ka_.array() * tmp3_.array();
 
     double tmp_int_dt = data_->integral_gain_time_curr_ - data_->integral_gain_time_pre_;
     // All the array() casts are for element wise operations.
@@ -131,14 +132,15 @@ namespace scl
 
     //Obtain force to be applied to a unit mass floating about
     //in space (ie. A dynamically decoupled mass).
-    tmp3 += tmp2 + tmp1 + data_->integral_force_;
+    tmp3_ += tmp2_ + tmp1_ + data_->integral_force_;
 
     //Apply Task's Force Limits
-    tmp3 = tmp3.array().min(data_->force_gc_max_.array()); // Remain below the upper bound.
-    tmp3 = tmp3.array().max(data_->force_gc_min_.array()); // Remain above the lower bound.
+    tmp3_ = tmp3_.array().min(data_->force_gc_max_.array()); // Remain below the upper bound.
+    tmp3_ = tmp3_.array().max(data_->force_gc_min_.array()); // Remain above the lower bound.
 
     // We do not use the centrifugal/coriolis forces. They can cause instabilities.
-    data_->des_force_gc_ = data_->gc_model_->M_gc_ * tmp3 - data_->gc_model_->force_gc_grav_;
+    data_->des_force_gc_.noalias() = data_->gc_model_->M_gc_ * tmp3_;
+    data_->des_force_gc_ -= data_->gc_model_->force_gc_grav_;
 
     // Now set the forces in the io data structure
     data_->io_data_->actuators_.force_gc_commanded_ = data_->des_force_gc_;
@@ -150,36 +152,36 @@ namespace scl
   {
     //Compute the servo generalized forces : Gravity compensation + damping
     //F_gc_star = M(q) (-kp(q-q_des)-kv(dq/dt)) + b(q,dq/dt) + g(q)
-    static Eigen::VectorXd tmp1;
 
-    tmp1 = -(data_->kv_.array() * data_->io_data_->sensors_.dq_.array());
+    tmp1_ = -(data_->kv_.array() * data_->io_data_->sensors_.dq_.array());
 
     //Apply Task's Force Limits
-    tmp1 = tmp1.array().min(data_->force_gc_max_.array()); // Remain below the upper bound.
-    tmp1 = tmp1.array().max(data_->force_gc_min_.array()); // Remain above the lower bound.
+    tmp1_ = tmp1_.array().min(data_->force_gc_max_.array()); // Remain below the upper bound.
+    tmp1_ = tmp1_.array().max(data_->force_gc_min_.array()); // Remain above the lower bound.
 
-    data_->des_force_gc_ = data_->gc_model_->M_gc_ * tmp1 - data_->gc_model_->force_gc_grav_;
+    data_->des_force_gc_ = data_->gc_model_->M_gc_ * tmp1_ - data_->gc_model_->force_gc_grav_;
 
     // Now set the forces in the io data structure
     data_->io_data_->actuators_.force_gc_commanded_ = data_->des_force_gc_;
 
 #ifdef DEBUG
-    Eigen::VectorXd tmp2 = data_->gc_model_->M_gc_ * tmp1;
-    std::cout<<"\n******* F* *******\n"<<tmp1.transpose()
+    Eigen::VectorXd tmp_ma = data_->gc_model_->M_gc_ * tmp1_;
+    std::cout<<"\n******* F* *******\n"<<tmp1_.transpose()
         <<"\n******* A *******\n"<<data_->gc_model_->M_gc_
         <<"\n******* g *******\n"<<data_->gc_model_->force_gc_grav_.transpose()
         <<"\n******* q *******\n"<<data_->io_data_->sensors_.q_.transpose()
         <<"\n******* dq *******\n"<<data_->io_data_->sensors_.dq_.transpose()
         <<"\n******* ddq *******\n"<<data_->io_data_->sensors_.ddq_.transpose()
         <<"\n******* kv *******\n"<<data_->kv_.transpose()
-        <<"\n******* pd *******\n"<<tmp1.transpose()
-        <<"\n******* A*pd *******\n"<<tmp2.transpose();
+        <<"\n******* pd *******\n"<<tmp1_.transpose()
+        <<"\n******* A*pd *******\n"<<tmp_ma.transpose();
 #endif
     return true;
   }
 
   sBool CControllerGc::computeDynamics()
   {
+    SCL_PERF_SCOPE("ctrl::gc_model");
     bool flag = dynamics_->computeGCModel(&(data_->io_data_->sensors_),data_->gc_model_);
     return flag;
   }
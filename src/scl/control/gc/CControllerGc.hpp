@@ -131,6 +131,10 @@ namespace scl
   protected:
 
     SControllerGc* data_;
+
+    /** Scratch for the servo. Per controller (not static) so that
+     * separate controllers can run on separate threads. */
+    Eigen::VectorXd tmp1_, tmp2_, tmp3_;
   };
 
 }
@@ -99,12 +99,13 @@ namespace scl
       const Eigen::VectorXd & arg_ka,
       const Eigen::VectorXd & arg_ki,
       const Eigen::VectorXd & arg_fgc_max,
-      const Eigen::VectorXd & arg_fgc_min)
+      const Eigen::VectorXd & arg_fgc_min,
+      SGcModel* arg_gc_model)
   {
     bool flag;
     try
     {
-      flag = SControllerBase::init(arg_controller_name,arg_robot_ds,arg_robot_io_ds);
+      flag = SControllerBase::init(arg_controller_name,arg_robot_ds,arg_robot_io_ds,arg_gc_model);
       if(false == flag)
       { throw(std::runtime_error("Failed to initialize gc controller data structure")); }
 
@@ -102,7 +102,8 @@ namespace scl
         SRobotParsed* arg_robot_ds,
         SRobotIO* arg_robot_io_ds);
 
-    /* Initialization function. Sets all the control parameters */
+    /* Initialization function. Sets all the control parameters.
+     * Pass a gc model to use it instead of allocating a new one. */
     sBool init(const std::string & arg_controller_name,
         SRobotParsed* arg_robot_ds,
         SRobotIO* arg_robot_io_ds,
@@ -112,7 +113,8 @@ namespace scl
         const Eigen::VectorXd & arg_ka,
         const Eigen::VectorXd & arg_ki,
         const Eigen::VectorXd & arg_fgc_max,
-        const Eigen::VectorXd & arg_fgc_min);
+        const Eigen::VectorXd & arg_fgc_min,
+        SGcModel* arg_gc_model=S_NULL);
 
     /** Inherits:
       std::string name_;
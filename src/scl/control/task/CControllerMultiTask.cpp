@@ -31,11 +31,14 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 
 #include "CControllerMultiTask.hpp"
 
+#include <scl/util/CPerfStats.hpp>
+
 #include <sutil/CRegisteredDynamicTypes.hpp>
 
 #include <iostream>
 #include <stdexcept>
 #include <sstream>
+#include <algorithm>
 
 namespace scl
 {
@@ -49,6 +52,11 @@ namespace scl
     dynamics_ = S_NULL;
     task_count_ = 0;
     task_non_ctrl_count_ = 0;
+    multi_rate_ = false;
+    model_ctr_published_ = 0;
+    model_ctr_adopted_ = 0;
+    cmd_ctr_applied_ = 0;
+    cmd_ctr_rejected_ = 0;
   }
 
   sBool CControllerMultiTask::init(SControllerBase* arg_data,
@@ -56,6 +64,8 @@ namespace scl
   {
     try
     {
+      sBool flag;
+
       //Reset the computational object (remove all the associated data).
       reset();
 
@@ -114,11 +124,14 @@ namespace scl
         }
       }
 
+      flag = jcache_.init(dynamics_, data_->robot_->dof_);
+      if(false == flag)
+      { throw(std::runtime_error("Couldn't initialize the Jacobian cache.")); }
+
       has_been_init_ = true;
 
       //Point the servo computational object to the data struct
       //This also initializes the servo data
-      sBool flag;
       flag = servo_.init(data_->robot_name_, &(data_->servo_) );
       if(false == flag)
       { throw(std::runtime_error("Couldn't initialize the servo object.")); }
@@ -221,6 +234,16 @@ namespace scl
 
     active_task_ = S_NULL;
 
+    multi_rate_ = false;
+    model_ctr_published_ = 0;
+    model_ctr_adopted_ = 0;
+    clearModelTasks();
+
+    //Pending commands point to the old tasks.
+    cmd_channels_.clear();
+    cmd_ctr_applied_ = 0;
+    cmd_ctr_rejected_ = 0;
+
     return true;
   }
 
@@ -236,13 +259,27 @@ namespace scl
       if(NULL==arg_task)
       { throw(std::runtime_error("Passed  a NULL task pointer. Can't do anything with it."));  }
 
+      if(multi_rate_)
+      { throw(std::runtime_error("Can't add a task in multi-rate mode. Turn it off first."));  }
+
       //Initialize the task's data structure.
       flag = arg_task->hasBeenInit();
       if(false == flag) { throw(std::runtime_error("Passed an un-initialized task."));  }
 
+      //Only goal-setting tasks run a trajectory generator. Don't ignore the otg_* params silently.
+      if(arg_task->getTaskData()->flag_otg_ && false == arg_task->getOtg().hasBeenInit())
+      { throw(std::runtime_error("The task's type doesn't support online trajectory generation (otg_* params)."));  }
+
       scl::CTaskBase** ret = tasks_.create(arg_task_name, arg_task, arg_level);
       if(NULL == ret) { throw(std::runtime_error("Could not create a task computational object."));  }
 
+      //All tasks share the controller's Jacobians
+      arg_task->setJacobianCache(&jcache_);
+
+      //Time the task's servo and model updates
+      arg_task->setPerfIds(CPerfStats::getId(std::string("task::")+arg_task_name+"::servo"),
+          CPerfStats::getId(std::string("task::")+arg_task_name+"::model"));
+
       //Works best for only one task
       if(0 == task_count_)
       { active_task_ = arg_task;  }
@@ -256,6 +293,16 @@ namespace scl
     return false;
   }
 
+  void CControllerMultiTask::invalidateCaches()
+  {
+    jcache_.invalidate();
+
+    //The references were generated from the old state
+    sutil::CMappedMultiLevelList<std::basic_string<char>, scl::CTaskBase*>::iterator it, ite;
+    for(it = tasks_.begin(), ite = tasks_.end(); it!=ite; ++it)
+    { (*it)->restartOtg(); }
+  }
+
   sBool CControllerMultiTask::removeTask(const std::string &arg_task_name)
   {
     bool flag;
@@ -265,6 +312,9 @@ namespace scl
       if(S_NULL == tmp)
       { throw(std::runtime_error("Could not find task to delete."));  }
 
+      if(multi_rate_)
+      { throw(std::runtime_error("Can't remove a task in multi-rate mode. Turn it off first."));  }
+
       flag = deactivateTask(arg_task_name);
       if(false == flag)
       { throw(std::runtime_error("Could not deactivate the task. Required before removal."));  }
@@ -514,9 +564,30 @@ namespace scl
   {
     //Compute the task torques
     sBool flag=true;
+
+    //Tick boundary : Pick up goals etc. sent by other threads
+    applyCommands();
+
+    if(multi_rate_)
+    {//Hand the latest state to the model thread and pick up its latest model (if any)
+      SServoStateBuffered* s = servo_state_buf_.getWriteBuffer();
+      s->sensors_.q_ = data_->io_data_->sensors_.q_;
+      s->sensors_.dq_ = data_->io_data_->sensors_.dq_;
+      for(size_t i=0; i<tasks_mt_.size(); ++i)
+      { s->task_state_[i] = getRangeSpaceState(tasks_mt_[i].task_servo_->getTaskData()); }
+      servo_state_buf_.publish();
+
+      if(model_buf_.consume())
+      { flag = adoptBufferedModel(); }
+    }
+
     if(1==task_count_)
     {
-      flag = active_task_->computeServo(&(data_->io_data_->sensors_));
+      {
+        CPerfScope tm(active_task_->getPerfIdServo());
+        flag = active_task_->computeServo(&(data_->io_data_->sensors_));
+      }
+      SCL_PERF_SCOPE("ctrl::servo");
       flag = flag && servo_.computeControlForces();
 
       STaskBase* t = active_task_->getTaskData();
@@ -524,6 +595,7 @@ namespace scl
     }
     else
     {
+      sBool engagement_changed = false;
       sutil::CMappedMultiLevelList<std::basic_string<char>, scl::CTaskBase*>::iterator it, ite;
       for(it = tasks_.begin(), ite = tasks_.end(); it!=ite; ++it)
       {
@@ -533,11 +605,24 @@ namespace scl
         assert(task->getTaskData()->has_been_init_); //Must have been initialized by now
 #endif
         if(task->hasBeenActivated())
-        { flag = flag && task->computeServo(&(data_->io_data_->sensors_));  }
+        {
+          STaskBase* t = task->getTaskData();
+          sBool was_engaged = t->is_engaged_;
+          CPerfScope tm(task->getPerfIdServo());
+          flag = flag && task->computeServo(&(data_->io_data_->sensors_));
+          if(was_engaged != t->is_engaged_)
+          { engagement_changed = true; }
+        }
       }
 
+      //An inequality task engaged (or let go) since the last model update.
+      //Its null space must now be included in (or dropped from) the hierarchy.
+      if(engagement_changed)
+      { flag = flag && computeRangeSpaces(); }
+
       //Compute the command torques by filtering the
       //various tasks through their range spaces.
+      SCL_PERF_SCOPE("ctrl::servo");
       flag = flag && servo_.computeControlForces();
 
       data_->io_data_->actuators_.force_gc_commanded_ = data_->servo_.force_gc_;
@@ -551,13 +636,29 @@ namespace scl
     sBool flag=true;
 
     //Update the joint space dynamic matrices
-    flag = dynamics_->computeGCModel(&(data_->io_data_->sensors_), data_->gc_model_);
+    {
+      SCL_PERF_SCOPE("ctrl::gc_model");
+      flag = dynamics_->computeGCModel(&(data_->io_data_->sensors_), data_->gc_model_);
+    }
+    jcache_.invalidate();
 
     // Compute the task space dynamics
+    flag = flag && computeTaskModels();
+
+    return flag;
+  }
+
+  sBool CControllerMultiTask::computeTaskModels()
+  {
+    sBool flag=true;
+
     if(0==task_count_)
     { return false; }
     if(1==task_count_)
-    { flag = flag && active_task_->computeModel(&(data_->io_data_->sensors_));  }
+    {
+      CPerfScope tm(active_task_->getPerfIdModel());
+      flag = flag && active_task_->computeModel(&(data_->io_data_->sensors_));
+    }
     else
     {
       sutil::CMappedMultiLevelList<std::basic_string<char>, scl::CTaskBase*>::iterator it, ite;
@@ -569,7 +670,10 @@ namespace scl
         assert(task->getTaskData()->has_been_init_); //Must have been initialized by now
 #endif
         if(task->hasBeenActivated())
-        { flag = flag && task->computeModel(&(data_->io_data_->sensors_));  }
+        {
+          CPerfScope tm(task->getPerfIdModel());
+          flag = flag && task->computeModel(&(data_->io_data_->sensors_));
+        }
       }
     }
 
@@ -579,6 +683,359 @@ namespace scl
     return flag;
   }
 
+  /**********************************************
+   *               COMMAND CHANNELS
+   ***********************************************/
+  CTaskCommandChannel* CControllerMultiTask::createCommandChannel(const std::string& arg_name)
+  {
+    try
+    {
+      if(0 == arg_name.size())
+      { throw(std::runtime_error("Channel name is empty.")); }
+      if(S_NULL != cmd_channels_.at(arg_name))
+      { throw(std::runtime_error(std::string("Channel already exists : ")+arg_name)); }
+
+      CTaskCommandChannel* ch = cmd_channels_.create(arg_name);
+      if(S_NULL == ch)
+      { throw(std::runtime_error(std::string("Could not create channel : ")+arg_name)); }
+      return ch;
+    }
+    catch(std::exception& e)
+    { std::cout<<"\nCControllerMultiTask::createCommandChannel() : Failed. "<<e.what();  }
+    return S_NULL;
+  }
+
+  CTaskCommandChannel* CControllerMultiTask::getCommandChannel(const std::string& arg_name)
+  { return cmd_channels_.at(arg_name); }
+
+  sBool CControllerMultiTask::applyCommands()
+  {//This function doesn't use std::exceptions (for speed).
+    sBool flag = true, activation_changed = false;
+    sutil::CMappedList<std::string, CTaskCommandChannel>::iterator it, ite;
+    for(it = cmd_channels_.begin(), ite = cmd_channels_.end(); it!=ite; ++it)
+    {
+      CTaskCommandChannel& ch = *it;
+      for(STaskCommand* cmd = ch.front(); S_NULL != cmd; ch.pop(), cmd = ch.front())
+      {
+        sBool ret = false;
+        if(S_NULL != cmd->task_)
+        {
+          switch(cmd->type_)
+          {
+            case STaskCommand::CMD_GOAL_POS: ret = cmd->task_->setGoalPos(cmd->val_); break;
+            case STaskCommand::CMD_GOAL_VEL: ret = cmd->task_->setGoalVel(cmd->val_); break;
+            case STaskCommand::CMD_GOAL_ACC: ret = cmd->task_->setGoalAcc(cmd->val_); break;
+            case STaskCommand::CMD_ACTIVATE:
+              ret = cmd->task_->setActivated(true); activation_changed = true; break;
+            case STaskCommand::CMD_DEACTIVATE:
+              ret = cmd->task_->setActivated(false); activation_changed = true; break;
+          }
+        }
+        if(ret) { cmd_ctr_applied_++; }
+        else { cmd_ctr_rejected_++; flag = false; }
+      }
+    }
+
+    //The task hierarchy changed. Update the range spaces before the servo runs.
+    if(activation_changed && 0 < task_count_)
+    { computeRangeSpaces(); }
+
+    return flag;
+  }
+
+  /**********************************************
+   *               MULTI-RATE MODE
+   ***********************************************/
+  sBool CControllerMultiTask::setMultiRate(sBool arg_flag)
+  {
+    try
+    {
+      if(S_NULL == data_ || false == has_been_init_)
+      { throw(std::runtime_error("Controller not initialized.")); }
+
+      if(false == arg_flag)
+      { multi_rate_ = false; return true;  }
+
+      if(false == initModelTasks())
+      { throw(std::runtime_error("Could not set up the model thread's tasks.")); }
+
+      model_ctr_published_ = 0;
+      model_ctr_adopted_ = 0;
+      multi_rate_ = true;
+      return true;
+    }
+    catch(std::exception& e)
+    { std::cout<<"\nCControllerMultiTask::setMultiRate() : Failed. "<<e.what();  }
+    return false;
+  }
+
+  sBool CControllerMultiTask::initModelTasks()
+  {
+    try
+    {
+      clearModelTasks();
+
+      if(false == gc_model_mt_.hasBeenInit())
+      {
+        if(false == gc_model_mt_.init(*(data_->robot_)))
+        { throw(std::runtime_error("Could not initialize the model thread's gc model.")); }
+      }
+      gc_model_mt_.mass_ = data_->gc_model_->mass_;
+
+      if(false == jcache_mt_.init(dynamics_, data_->robot_->dof_))
+      { throw(std::runtime_error("Could not initialize the model thread's Jacobian cache.")); }
+
+      //Copy every task : Same type and params, but bound to the model thread's gc model
+      sutil::CMappedMultiLevelList<std::basic_string<char>, scl::CTaskBase*>::iterator it, ite;
+      for(it = tasks_.begin(), ite = tasks_.end(); it!=ite; ++it)
+      {
+        const STaskBase* t = (*it)->getTaskData();
+        SModelTask mt;
+        mt.task_servo_ = *it; mt.task_ = S_NULL; mt.data_ = S_NULL;
+
+        void* obj = S_NULL;
+        if(false == sutil::CRegisteredDynamicTypes<std::string>::getObjectForType("S"+t->type_task_,obj))
+        { throw(std::runtime_error(std::string("Dynamic data type not initialized for task : ")+t->name_)); }
+        mt.data_ = reinterpret_cast<STaskBase*>(obj);
+
+        obj = S_NULL;
+        if(false == sutil::CRegisteredDynamicTypes<std::string>::getObjectForType("C"+t->type_task_,obj))
+        {
+          delete mt.data_;
+          throw(std::runtime_error(std::string("Dynamic controller type not initialized for task : ")+t->name_));
+        }
+        mt.task_ = reinterpret_cast<CTaskBase*>(obj);
+        tasks_mt_.push_back(mt); //Cleaned up by clearModelTasks() from here on
+
+        if(false == mt.data_->init(t->name_, t->type_task_, t->priority_, t->dof_task_,
+            t->robot_, &gc_model_mt_, t->kp_, t->kv_, t->ka_, t->ki_,
+            t->force_task_max_, t->force_task_min_, t->task_nonstd_params_))
+        { throw(std::runtime_error(std::string("Could not initialize the model copy of task : ")+t->name_)); }
+        mt.data_->setParentController(t->parent_controller_);
+
+        if(false == mt.task_->init(mt.data_, dynamics_))
+        { throw(std::runtime_error(std::string("Could not initialize the model copy of task : ")+t->name_)); }
+        mt.task_->setJacobianCache(&jcache_mt_);
+      }
+
+      //The range spaces are computed level by level
+      struct SPriorityLess {
+        bool operator()(const SModelTask& a, const SModelTask& b) const
+        { return a.data_->priority_ < b.data_->priority_; }
+      };
+      std::stable_sort(tasks_mt_.begin(), tasks_mt_.end(), SPriorityLess());
+
+      //Size the buffers (all the copies below are one time allocations)
+      model_buf_.reset();
+      servo_state_buf_.reset();
+      for(unsigned int i=0; i<model_buf_.size(); ++i)
+      {
+        SGcModel& gcm = model_buf_.getBuffer(i).gc_model_;
+        if(false == gcm.hasBeenInit())
+        {
+          if(false == gcm.init(*(data_->robot_)))
+          { throw(std::runtime_error("Could not initialize a gc model back buffer.")); }
+        }
+        gcm.mass_ = data_->gc_model_->mass_;
+
+        std::vector<STaskModelBuffered>& tmb = model_buf_.getBuffer(i).tasks_;
+        tmb.resize(tasks_mt_.size());
+        for(size_t j=0; j<tasks_mt_.size(); ++j)
+        {
+          const STaskBase* t = tasks_mt_[j].task_servo_->getTaskData();
+          tmb[j].J_ = t->J_;
+          tmb[j].J_6_ = t->J_6_;
+          tmb[j].J_dyn_inv_ = t->J_dyn_inv_;
+          tmb[j].null_space_ = t->null_space_;
+          tmb[j].M_task_ = t->M_task_;
+          tmb[j].M_task_inv_ = t->M_task_inv_;
+          tmb[j].force_task_cc_ = t->force_task_cc_;
+          tmb[j].force_task_grav_ = t->force_task_grav_;
+          tmb[j].range_space_ = t->range_space_;
+          tmb[j].has_model_ = false;
+          tmb[j].state_ = 0;
+        }
+
+        SServoStateBuffered& s = servo_state_buf_.getBuffer(i);
+        s.sensors_.q_ = data_->io_data_->sensors_.q_;
+        s.sensors_.dq_ = data_->io_data_->sensors_.dq_;
+        s.task_state_.resize(tasks_mt_.size());
+        for(size_t j=0; j<tasks_mt_.size(); ++j)
+        { s.task_state_[j] = getRangeSpaceState(tasks_mt_[j].task_servo_->getTaskData()); }
+      }
+      return true;
+    }
+    catch(std::exception& e)
+    { std::cout<<"\nCControllerMultiTask::initModelTasks() : Failed. "<<e.what();  }
+    clearModelTasks();
+    return false;
+  }
+
+  void CControllerMultiTask::clearModelTasks()
+  {
+    std::vector<SModelTask>::iterator it, ite;
+    for(it = tasks_mt_.begin(), ite = tasks_mt_.end(); it!=ite; ++it)
+    { delete it->task_; delete it->data_; }
+    tasks_mt_.clear();
+  }
+
+  sBool CControllerMultiTask::computeDynamicsBuffered()
+  {
+    if(false == multi_rate_) { return false; }
+
+    //Use the latest state the servo handed over (or the previous one if none arrived)
+    servo_state_buf_.consume();
+    const SServoStateBuffered& s = *servo_state_buf_.getReadBuffer();
+    SModelBuffered& m = *model_buf_.getWriteBuffer();
+
+    sBool flag;
+    {
+      SCL_PERF_SCOPE("ctrl::gc_model");
+      flag = dynamics_->computeGCModel(&(s.sensors_), &gc_model_mt_);
+    }
+    if(false == flag) { return false; }
+    jcache_mt_.invalidate();
+
+    //Copy the gc model out. The tasks keep pointing at the model thread's one.
+    SGcModel& gcm = m.gc_model_;
+    gcm.M_gc_ = gc_model_mt_.M_gc_;
+    gcm.M_gc_inv_ = gc_model_mt_.M_gc_inv_;
+    gcm.force_gc_cc_ = gc_model_mt_.force_gc_cc_;
+    gcm.force_gc_grav_ = gc_model_mt_.force_gc_grav_;
+    gcm.q_ = gc_model_mt_.q_;
+    gcm.dq_ = gc_model_mt_.dq_;
+    gcm.pos_com_ = gc_model_mt_.pos_com_;
+    sutil::CMappedTree<std::string, SRigidBodyDyn>::const_iterator its,itse;
+    sutil::CMappedTree<std::string, SRigidBodyDyn>::iterator itd,itde;
+    for(its = gc_model_mt_.rbdyn_tree_.begin(), itse = gc_model_mt_.rbdyn_tree_.end(),
+        itd = gcm.rbdyn_tree_.begin(), itde = gcm.rbdyn_tree_.end();
+        its!=itse && itd!=itde; ++its, ++itd)
+    {
+      itd->J_com_ = its->J_com_;
+      itd->T_o_lnk_ = its->T_o_lnk_;
+      itd->T_lnk_ = its->T_lnk_;
+      itd->q_T_ = its->q_T_;
+    }
+
+    //Compute the task models (for the tasks the servo had activated)
+    for(size_t i=0; i<tasks_mt_.size(); ++i)
+    {
+      STaskModelBuffered& tm = m.tasks_[i];
+      tm.state_ = s.task_state_[i];
+      tm.has_model_ = (1==tasks_mt_.size()) || (0 != tm.state_);
+      if(false == tm.has_model_) { continue; }
+
+      {
+        CPerfScope tmr(tasks_mt_[i].task_servo_->getPerfIdModel());
+        flag = flag && tasks_mt_[i].task_->computeModel(&(s.sensors_));
+      }
+      const STaskBase* t = tasks_mt_[i].data_;
+      tm.J_ = t->J_;
+      tm.J_6_ = t->J_6_;
+      tm.J_dyn_inv_ = t->J_dyn_inv_;
+      tm.null_space_ = t->null_space_;
+      tm.M_task_ = t->M_task_;
+      tm.M_task_inv_ = t->M_task_inv_;
+      tm.force_task_cc_ = t->force_task_cc_;
+      tm.force_task_grav_ = t->force_task_grav_;
+    }
+    if(false == flag) { return false; }
+
+    //Compute the range spaces (same as computeRangeSpaces(), with the servo's task states)
+    const sUInt dof = data_->robot_->dof_;
+    if(1==tasks_mt_.size())
+    { m.tasks_[0].range_space_.setIdentity(dof, dof); }
+    else
+    {
+      Eigen::MatrixXd& null_space = tmp_null_space_mt_, & lvl_null_space = tmp_lvl_null_space_mt_;
+      null_space.setIdentity(dof, dof);
+      lvl_null_space.setIdentity(dof, dof);
+      for(size_t i=0; i<tasks_mt_.size(); ++i)
+      {
+        STaskModelBuffered& tm = m.tasks_[i];
+        if(0 != tm.state_)
+        {
+          tm.range_space_ = null_space;
+          if(2 == tm.state_)
+          { lvl_null_space *= tm.null_space_; }
+        }
+        //The next level's range space is filtered through this level's null space
+        if(i+1 == tasks_mt_.size() ||
+            tasks_mt_[i+1].data_->priority_ != tasks_mt_[i].data_->priority_)
+        {
+          null_space *= lvl_null_space;
+          lvl_null_space.setIdentity(dof, dof);
+        }
+      }
+    }
+
+    model_buf_.publish();
+    model_ctr_published_++;
+    return true;
+  }
+
+  sBool CControllerMultiTask::adoptBufferedModel()
+  {
+    SModelBuffered* src = model_buf_.getReadBuffer();
+    SGcModel* dst = data_->gc_model_;
+
+    //Dynamic matrices swap their storage (no copies)
+    dst->M_gc_.swap(src->gc_model_.M_gc_);
+    dst->M_gc_inv_.swap(src->gc_model_.M_gc_inv_);
+    dst->force_gc_cc_.swap(src->gc_model_.force_gc_cc_);
+    dst->force_gc_grav_.swap(src->gc_model_.force_gc_grav_);
+    dst->q_.swap(src->gc_model_.q_);
+    dst->dq_.swap(src->gc_model_.dq_);
+    dst->pos_com_.swap(src->gc_model_.pos_com_);
+
+    //Both trees were built from the same parsed robot, so their nodes line up.
+    sutil::CMappedTree<std::string, SRigidBodyDyn>::iterator its,itse,itd,itde;
+    for(its = src->gc_model_.rbdyn_tree_.begin(), itse = src->gc_model_.rbdyn_tree_.end(),
+        itd = dst->rbdyn_tree_.begin(), itde = dst->rbdyn_tree_.end();
+        its!=itse && itd!=itde; ++its, ++itd)
+    {
+      itd->J_com_.swap(its->J_com_);
+      itd->T_o_lnk_ = its->T_o_lnk_;
+      itd->T_lnk_ = its->T_lnk_;
+      itd->q_T_ = its->q_T_;
+    }
+
+    //So do the task models
+    sBool range_spaces_valid = true;
+    for(size_t i=0; i<tasks_mt_.size(); ++i)
+    {
+      STaskModelBuffered& tm = src->tasks_[i];
+      STaskBase* t = tasks_mt_[i].task_servo_->getTaskData();
+      if(tm.state_ != getRangeSpaceState(t))
+      { range_spaces_valid = false; }
+      if(false == tm.has_model_) { continue; }
+
+      t->J_.swap(tm.J_);
+      t->J_6_.swap(tm.J_6_);
+      t->J_dyn_inv_.swap(tm.J_dyn_inv_);
+      t->null_space_.swap(tm.null_space_);
+      t->M_task_.swap(tm.M_task_);
+      t->M_task_inv_.swap(tm.M_task_inv_);
+      t->force_task_cc_.swap(tm.force_task_cc_);
+      t->force_task_grav_.swap(tm.force_task_grav_);
+    }
+
+    jcache_.invalidate();
+    model_ctr_adopted_++;
+
+    //A task was (de)activated or (dis)engaged after the model thread ran.
+    if(false == range_spaces_valid)
+    { return computeRangeSpaces(); }
+
+    for(size_t i=0; i<tasks_mt_.size(); ++i)
+    {
+      STaskModelBuffered& tm = src->tasks_[i];
+      if(1==tasks_mt_.size() || 0 != tm.state_)
+      { tasks_mt_[i].task_servo_->getTaskData()->range_space_.swap(tm.range_space_); }
+    }
+    return true;
+  }
+
   /** Computes the non-control tasks : I/O etc..     */
   sBool CControllerMultiTask::computeNonControlOperations()
   {
@@ -639,7 +1096,8 @@ namespace scl
           if(task_ds->has_been_activated_)
           {
             task_ds->range_space_ = null_space;//Set this task's range space to the higher level's null_space
-            lvl_null_space *= task_ds->null_space_;//Reduce this level's null space
+            if(task_ds->is_engaged_)//Disengaged inequality tasks don't use up any space
+            { lvl_null_space *= task_ds->null_space_; }//Reduce this level's null space
           }
         }
         //The next level's range space is filtered through this level's null space
@@ -38,11 +38,15 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <scl/control/task/CTaskBase.hpp>
 #include <scl/control/task/CNonControlTaskBase.hpp>
 #include <scl/control/task/CServo.hpp>
+#include <scl/control/task/STaskCommand.hpp>
+#include <scl/dynamics/CJacobianCache.hpp>
+#include <scl/util/CTripleBuffer.hpp>
 
 #include <sutil/CMappedMultiLevelList.hpp>
 
 #include <string>
 #include <vector>
+#include <atomic>
 
 namespace scl
 {
@@ -95,8 +99,8 @@ namespace scl
     /** Default constructor : just sets pointers to NULL */
     CControllerMultiTask();
 
-    /** Default destructor : does nothing */
-    virtual ~CControllerMultiTask(){}
+    /** Default destructor : Deletes the model thread's task copies (if any) */
+    virtual ~CControllerMultiTask(){ clearModelTasks(); }
 
     /** Equal to task forces or generalized coordinate forces
      * depending on the type of controller that implements this API */
@@ -133,13 +137,19 @@ namespace scl
      * Priority levels start at 0 (highest priority) > 1 > 2 ...
      *
      * If a higher level than max is supplied, new levels
-     * are created. */
+     * are created.
+     *
+     * Fails in multi-rate mode (the model thread's task copies would go
+     * stale). Turn it off, add the task and turn it back on. */
     bool addTask(const std::string &arg_task_name,
         CTaskBase* arg_task, const sUInt arg_level);
 
     /** Removes a task from the controller.
      * NOTE : This only removes the task from the controller. The data
-     * structure is still conserved in the Database (for possible use later). */
+     * structure is still conserved in the Database (for possible use later).
+     *
+     * Fails in multi-rate mode (the model thread's task copies point to
+     * the servo's tasks). Turn it off, remove the task and turn it back on. */
     bool removeTask(const std::string &arg_task_name);
 
     /** Returns the task by this name */
@@ -185,7 +195,106 @@ namespace scl
     /** Deactivates a task within the controller */
     sBool deactivateNonControlTask(const std::string& arg_type);
 
+    /** The Jacobian cache shared by all the tasks. Use its counters
+     * to see how many chain walks the cache saved. */
+    const CJacobianCache& getJacobianCache() const { return jcache_; }
+
+    /** The Jacobian cache, to share with other users of the controller's
+     * gc model (eg. pass it to CActuatorSetMuscle::init()). It is
+     * invalidated with every gc model update. */
+    CJacobianCache& getJacobianCache() { return jcache_; }
+
+    /** Drops the cached Jacobians and restarts the tasks' online
+     * trajectories from the current state. Call it after changing the gc
+     * model or robot state outside the controller (eg. restoring a saved
+     * state). */
+    void invalidateCaches();
+
+    /**********************************************
+     *     Command channels (other threads -> servo)
+     ***********************************************/
+    /** Creates a named command channel. Each thread that sends the
+     * controller task commands (goals, activation) needs its own.
+     *
+     * The servo applies all pending commands at the start of every
+     * computeControlForces() call. Sending never blocks (a full channel
+     * rejects the command), and the servo never waits on a sender.
+     *
+     * NOTE : Create all the channels before the threads start. */
+    CTaskCommandChannel* createCommandChannel(const std::string& arg_name);
+
+    /** Returns a channel created earlier (NULL if it doesn't exist) */
+    CTaskCommandChannel* getCommandChannel(const std::string& arg_name);
+
+    /** Servo thread : Applies all the pending commands. Called
+     * automatically by computeControlForces(). */
+    sBool applyCommands();
+
+    /** The number of commands applied and rejected (eg. a goal that
+     * doesn't match the task's size) by the servo */
+    sLongLong getCommandsApplied() const { return cmd_ctr_applied_; }
+    sLongLong getCommandsRejected() const { return cmd_ctr_rejected_; }
+
+    /**********************************************
+     *     Multi-rate mode (model + servo threads)
+     ***********************************************/
+    /** Enables (or disables) multi-rate mode.
+     *
+     * In multi-rate mode a model thread repeatedly calls
+     * computeDynamicsBuffered(), which computes the gc model, the task
+     * models and the range spaces into a back buffer and publishes it
+     * with an atomic swap. The servo thread keeps calling
+     * computeControlForces(), which picks up the latest published
+     * model (if any) without ever waiting on the model thread.
+     *
+     * The model thread computes the task models with its own copies of
+     * the tasks (same types and params, bound to its own gc model).
+     *
+     * NOTE : Only toggle this while neither thread is running. Tasks can't
+     * be added or removed while it is on. Toggle it again after changing
+     * the tasks' params. */
+    sBool setMultiRate(sBool arg_flag);
+
+    /** Whether multi-rate mode is on */
+    sBool getMultiRate() const { return multi_rate_; }
+
+    /** Multi-rate mode (model thread) : Computes the gc model, the task
+     * models and the range spaces for the latest state published by the
+     * servo and publishes them. Returns false if multi-rate mode is off. */
+    sBool computeDynamicsBuffered();
+
+    /** Multi-rate mode : Number of models published by the model thread */
+    sLongLong getModelUpdatesPublished() const { return model_ctr_published_; }
+
+    /** Multi-rate mode : Number of models picked up by the servo thread */
+    sLongLong getModelUpdatesAdopted() const { return model_ctr_adopted_; }
+
   protected:
+    /** Computes the task models and range spaces. Assumes that the
+     * gc model has already been updated. */
+    sBool computeTaskModels();
+
+    /** Multi-rate mode (servo thread) : Swaps the latest published gc
+     * and task models into the controller's gc model and tasks.
+     *
+     * The swap is O(1) for the dynamic matrices and O(n) for the link
+     * transforms, so the servo never pays for the O(n^3) model update.
+     * The range spaces are only recomputed if a task was (de)activated
+     * or (dis)engaged after the model thread computed them. */
+    sBool adoptBufferedModel();
+
+    /** Multi-rate mode : Creates the model thread's task copies and
+     * sizes the buffers that pass their models to the servo */
+    sBool initModelTasks();
+
+    /** Multi-rate mode : Deletes the model thread's task copies */
+    void clearModelTasks();
+
+    /** Multi-rate mode : A task's state as far as the range spaces are
+     * concerned (0 : Inactive, 1 : Activated, 2 : Activated and engaged) */
+    static sInt getRangeSpaceState(const STaskBase* arg_task)
+    { return arg_task->has_been_activated_ ? (arg_task->is_engaged_ ? 2 : 1) : 0; }
+
     /** Computes range spaces for all its tasks according to
      * their priorities. Starts with task level i and goes
      * down.
@@ -213,6 +322,69 @@ namespace scl
     /** The number of tasks */
     sUInt task_non_ctrl_count_;
 
+    /** Memoizes link Jacobians for all the tasks. Invalidated
+     * whenever the gc model changes. */
+    CJacobianCache jcache_;
+
+    /** Multi-rate mode state */
+    sBool multi_rate_;
+
+    /** Multi-rate mode : A task's model, as computed by the model thread */
+    struct STaskModelBuffered
+    {
+      Eigen::MatrixXd J_, J_6_, J_dyn_inv_, null_space_, M_task_, M_task_inv_;
+      Eigen::MatrixXd force_task_cc_, force_task_grav_, range_space_;
+      /** Whether the model thread updated this task's model */
+      sBool has_model_;
+      /** The task's range space state (see getRangeSpaceState()) */
+      sInt state_;
+    };
+
+    /** Multi-rate mode : Everything the model thread publishes at once */
+    struct SModelBuffered
+    {
+      SGcModel gc_model_;
+      std::vector<STaskModelBuffered> tasks_;
+    };
+
+    /** Multi-rate mode : The servo state the model thread works from */
+    struct SServoStateBuffered
+    {
+      SRobotSensors sensors_;
+      std::vector<sInt> task_state_;
+    };
+
+    /** Multi-rate mode : A model thread copy of one of the tasks */
+    struct SModelTask
+    {
+      CTaskBase* task_servo_;
+      CTaskBase* task_;
+      STaskBase* data_;
+    };
+
+    /** Model thread writes, servo thread reads */
+    CTripleBuffer<SModelBuffered> model_buf_;
+
+    /** Servo thread writes (q, dq, task states), model thread reads */
+    CTripleBuffer<SServoStateBuffered> servo_state_buf_;
+
+    /** Multi-rate mode : The model thread's gc model, tasks (sorted by
+     * priority) and Jacobian cache. Only the model thread touches these. */
+    SGcModel gc_model_mt_;
+    std::vector<SModelTask> tasks_mt_;
+    CJacobianCache jcache_mt_;
+    Eigen::MatrixXd tmp_null_space_mt_, tmp_lvl_null_space_mt_;
+
+    /** Multi-rate mode counters */
+    std::atomic<sLongLong> model_ctr_published_;
+    sLongLong model_ctr_adopted_;
+
+    /** Commands from other threads. One SPSC channel per sender. */
+    sutil::CMappedList<std::string, CTaskCommandChannel> cmd_channels_;
+
+    /** Command counters (servo thread) */
+    sLongLong cmd_ctr_applied_, cmd_ctr_rejected_;
+
   public:
     /** When only one task is to be executed
      * Speeds up this special (but fairly common) case.
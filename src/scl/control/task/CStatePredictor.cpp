@@ -0,0 +1,92 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CStatePredictor.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include <scl/control/task/CStatePredictor.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace scl
+{
+  sBool CStatePredictor::init(const SGcModel* arg_gc_model, const sUInt arg_dof,
+      const sFloat arg_lookahead, const sFloat arg_delay_max)
+  {
+    try
+    {
+      has_been_init_ = false;
+      if(S_NULL == arg_gc_model)
+      { throw(std::runtime_error("Passed a NULL gc model.")); }
+      if(0 == arg_dof)
+      { throw(std::runtime_error("Can not predict the state of a robot with 0 dof.")); }
+      if(0 > arg_lookahead || 0 >= arg_delay_max)
+      { throw(std::runtime_error("The lookahead must be >= 0 and the max delay > 0.")); }
+
+      gc_model_ = arg_gc_model;
+      dof_ = arg_dof;
+      lookahead_ = arg_lookahead;
+      delay_max_ = arg_delay_max;
+      delay_last_ = 0;
+      ctr_predictions_ = 0; ctr_clamped_ = 0;
+      ftmp_.setZero(dof_);
+
+      has_been_init_ = true;
+    }
+    catch(std::exception& e)
+    { std::cerr<<"\nCStatePredictor::init() : "<<e.what(); }
+    return has_been_init_;
+  }
+
+  sBool CStatePredictor::predict(SRobotSensors& arg_sensors, const Eigen::VectorXd& arg_fgc,
+      const sFloat arg_delay)
+  {
+    if(false == has_been_init_) { return false; }
+
+    const Eigen::VectorXd::Index n = static_cast<Eigen::VectorXd::Index>(dof_);
+    if(arg_sensors.q_.size() != n || arg_sensors.dq_.size() != n || arg_fgc.size() != n ||
+        gc_model_->M_gc_inv_.rows() != n || gc_model_->M_gc_inv_.cols() != n ||
+        gc_model_->force_gc_grav_.size() != n || gc_model_->force_gc_cc_.size() != n)
+    { return false; }
+
+    sFloat T = (arg_delay > 0 ? arg_delay : 0) + lookahead_;
+    if(T > delay_max_) { T = delay_max_; ctr_clamped_++; }
+    delay_last_ = T;
+    ctr_predictions_++;
+
+    // M ddq + b = fgc + g
+    ftmp_ = arg_fgc + gc_model_->force_gc_grav_ - gc_model_->force_gc_cc_;
+    if(arg_sensors.ddq_.size() != n) { arg_sensors.ddq_.setZero(n); }
+    arg_sensors.ddq_.noalias() = gc_model_->M_gc_inv_ * ftmp_;
+
+    arg_sensors.q_ += T*arg_sensors.dq_ + (0.5*T*T)*arg_sensors.ddq_;
+    arg_sensors.dq_ += T*arg_sensors.ddq_;
+    return true;
+  }
+}
@@ -0,0 +1,127 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CStatePredictor.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CSTATEPREDICTOR_HPP_
+#define CSTATEPREDICTOR_HPP_
+
+#include <scl/DataTypes.hpp>
+#include <scl/data_structs/SGcModel.hpp>
+#include <scl/data_structs/SRobotIO.hpp>
+
+#include <Eigen/Core>
+
+namespace scl
+{
+  /** Compensates for the IO latency between the robot's sensors and its
+   * actuators by predicting the state the command will act on.
+   *
+   * A sensor sample arrives some time after it was measured, and the
+   * command computed from it reaches the actuators some time later. The
+   * servo effectively acts on an old state, which eats into its phase
+   * margin. The predictor moves the sample forward by the total delay
+   * with the cached dynamic model (gravity, coriolis/centrifugal and the
+   * inverse mass matrix, all from the last model update) and the force
+   * the robot is still executing (the previous command) :
+   *
+   *   ddq = Minv (fgc + g - b)
+   *   q  += dq T + 0.5 ddq T^2
+   *   dq += ddq T
+   *
+   * It is one explicit step (constant acceleration over the delay), so it
+   * costs one dof x dof matrix-vector product.
+   *
+   * Usage (servo thread, before computing the control forces) :
+   *   predict(sensors, previous fgc command, sample time, now)
+   *   controller.computeControlForces()
+   *
+   * NOTE : Call it before the model update too if the model runs on the
+   *        same tick, so the task positions match the predicted state. */
+  class CStatePredictor
+  {
+  public:
+    /** Uses the gc model's cached M_gc_inv_, force_gc_grav_ and
+     * force_gc_cc_ (the model must stay alive while predicting).
+     *
+     * @param arg_lookahead A fixed extra delay (sec) added to every
+     *        prediction. Eg. the time the command takes to reach the
+     *        actuators, which the sample's timestamp doesn't include.
+     * @param arg_delay_max The longest delay (sec) to predict over. Stale
+     *        samples are only moved forward this much. */
+    sBool init(const SGcModel* arg_gc_model, const sUInt arg_dof,
+        const sFloat arg_lookahead=0.0, const sFloat arg_delay_max=0.01);
+
+    /** Moves the sensed q and dq forward by arg_delay (+ the lookahead)
+     * seconds, assuming the robot executes arg_fgc meanwhile. Also sets
+     * the sensors' ddq to the predicted acceleration.
+     *
+     * Leaves the sensors alone (and returns false) if the sizes don't
+     * match the model. Negative delays are treated as zero. */
+    sBool predict(SRobotSensors& arg_sensors, const Eigen::VectorXd& arg_fgc,
+        const sFloat arg_delay);
+
+    /** Same as above, with the delay computed from the time the sample was
+     * measured and the current time (sec, on the same clock). */
+    sBool predict(SRobotSensors& arg_sensors, const Eigen::VectorXd& arg_fgc,
+        const sFloat arg_t_sensed, const sFloat arg_t_now)
+    { return predict(arg_sensors, arg_fgc, arg_t_now - arg_t_sensed); }
+
+    sFloat getLookahead() const { return lookahead_; }
+    void setLookahead(const sFloat arg_lookahead) { lookahead_ = arg_lookahead; }
+    sFloat getDelayMax() const { return delay_max_; }
+
+    /** The delay (sec) used by the last prediction (including the
+     * lookahead, after clamping) */
+    sFloat getDelayLast() const { return delay_last_; }
+
+    /** Counters : Predictions, and predictions whose delay was clamped
+     * to the max (a sign that the IO is slower than expected) */
+    sLongLong getNumPredictions() const { return ctr_predictions_; }
+    sLongLong getNumClamped() const { return ctr_clamped_; }
+
+    sBool hasBeenInit() const { return has_been_init_; }
+
+    CStatePredictor() : gc_model_(S_NULL), dof_(0), lookahead_(0), delay_max_(0.01),
+        delay_last_(0), ctr_predictions_(0), ctr_clamped_(0), has_been_init_(false) {}
+
+  private:
+    const SGcModel* gc_model_;
+    sUInt dof_;
+    sFloat lookahead_, delay_max_, delay_last_;
+    sLongLong ctr_predictions_, ctr_clamped_;
+
+    /** Scratch (preallocated; predict() doesn't allocate) */
+    Eigen::VectorXd ftmp_;
+
+    sBool has_been_init_;
+  };
+}
+
+#endif /* CSTATEPREDICTOR_HPP_ */
@@ -39,6 +39,8 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <scl/data_structs/SRobotIO.hpp>
 
 #include <scl/dynamics/CDynamicsBase.hpp>
+#include <scl/dynamics/CJacobianCache.hpp>
+#include <scl/trajectory/CTrajectoryOtg.hpp>
 
 #ifdef DEBUG
 #include <cassert>
@@ -104,7 +106,10 @@ public:
   /** Constructor does nothing */
   CTaskBase():
     has_been_init_(false),
-    dynamics_(S_NULL) {}
+    dynamics_(S_NULL),
+    jcache_(S_NULL),
+    perf_id_servo_(-1),
+    perf_id_model_(-1) {}
 
   /** Destructor does nothing */
   virtual ~CTaskBase(){}
@@ -123,6 +128,26 @@ public:
    * are up to date. Ready to contribute to a controller. */
   virtual sBool hasBeenInit() { return has_been_init_;  }
 
+  /** Shares the parent controller's Jacobian cache with this task.
+   * Pass NULL to compute Jacobians directly with the dynamics object. */
+  void setJacobianCache(CJacobianCache* arg_jcache)
+  { jcache_ = arg_jcache; }
+
+  /** The CPerfStats timers for this task's computeServo() and computeModel()
+   * (-1 : not timed). Set by the parent controller. */
+  void setPerfIds(const int arg_servo, const int arg_model)
+  { perf_id_servo_ = arg_servo; perf_id_model_ = arg_model; }
+  int getPerfIdServo() const { return perf_id_servo_; }
+  int getPerfIdModel() const { return perf_id_model_; }
+
+  /** The online trajectory generator (only initialized if the task
+   * data enables it; see STaskBase::flag_otg_) */
+  const CTrajectoryOtg& getOtg() const { return otg_; }
+
+  /** Restarts the online trajectory from the current state at the next
+   * servo tick (eg. after the robot's state was restored) */
+  void restartOtg() { otg_.stop(); }
+
   /* **************************************************************
    *                   Runtime Enable/Disable Functions
    * ************************************************************** */
@@ -138,6 +163,7 @@ public:
     if(S_NULL == t_ds) { return false; }        //Can't access task data struct.
     if(!t_ds->has_been_init_) { return false; } //Task data struct not initialized
     t_ds->has_been_activated_=arg_activate;
+    if(!arg_activate) { otg_.stop(); } //Restart the reference from the current state
     return true;
   }
 
@@ -163,6 +189,51 @@ protected:
 
   /** A Dynamics model required to compute the task's dynamics */
   CDynamicsBase* dynamics_;
+
+  /** The parent controller's Jacobian cache (may be NULL) */
+  CJacobianCache* jcache_;
+
+  /** CPerfStats timer ids */
+  int perf_id_servo_, perf_id_model_;
+
+  /** Moves the task's reference toward its goal (if enabled) */
+  CTrajectoryOtg otg_;
+
+  /** Goal-setting tasks call this in init() to support online
+   * trajectory generation. Does nothing if the task data doesn't enable it. */
+  sBool initOtg(const STaskBase& arg_data)
+  {
+    if(!arg_data.flag_otg_) { return true; }
+    return otg_.init(arg_data.dof_task_, arg_data.otg_max_vel_, arg_data.otg_max_acc_,
+        arg_data.otg_max_jerk_, arg_data.otg_cycle_time_);
+  }
+
+  /** Goal-setting tasks call this in computeServo() before using their goals.
+   * If online trajectory generation is on, moves the reference one cycle
+   * toward arg_goal (starting at the current state : arg_x, arg_dx) and
+   * returns true. The task then tracks otg_'s position, velocity and
+   * acceleration instead of its goals. */
+  sBool computeOtgReference(const Eigen::Ref<const Eigen::VectorXd>& arg_goal,
+      const Eigen::Ref<const Eigen::VectorXd>& arg_x,
+      const Eigen::Ref<const Eigen::VectorXd>& arg_dx)
+  {
+    if(!otg_.hasBeenInit()) { return false; }
+    if(!otg_.isStarted()) { otg_.reset(arg_x, arg_dx); }
+    otg_.update(arg_goal);
+    return true;
+  }
+
+  /** Computes a Jacobian through the Jacobian cache (if available).
+   * Tasks should use this instead of dynamics_->computeJacobian. */
+  sBool computeJacobian(Eigen::MatrixXd& ret_J,
+      const SRigidBodyDyn& arg_link,
+      const Eigen::VectorXd& arg_q,
+      const Eigen::Vector3d& arg_pos_local)
+  {
+    if(S_NULL != jcache_)
+    { return jcache_->computeJacobian(ret_J, arg_link, arg_q, arg_pos_local); }
+    return dynamics_->computeJacobian(ret_J, arg_link, arg_q, arg_pos_local);
+  }
 };
 
 }
@@ -0,0 +1,74 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file STaskCommand.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef STASKCOMMAND_HPP_
+#define STASKCOMMAND_HPP_
+
+#include <scl/DataTypes.hpp>
+#include <scl/util/CSpscQueue.hpp>
+
+#include <Eigen/Core>
+
+/** The number of slots in a task command channel (power of two) */
+#define SCL_TASK_CMD_CHANNEL_LEN 64
+
+namespace scl
+{
+  //Forward declare the task API.
+  class CTaskBase;
+
+  /** A command for a task in a CControllerMultiTask.
+   *
+   * Non real-time threads (gui, shell, redis etc.) send these to the
+   * controller through a CTaskCommandChannel instead of writing into
+   * the task data directly. The controller applies them at the start
+   * of a servo tick, so the servo never sees a half-written goal. */
+  struct STaskCommand
+  {
+    enum ECmdType { CMD_GOAL_POS, CMD_GOAL_VEL, CMD_GOAL_ACC, CMD_ACTIVATE, CMD_DEACTIVATE };
+
+    /** The task to command. Get it from the controller (getTask()) at setup. */
+    CTaskBase* task_;
+
+    ECmdType type_;
+
+    /** The goal (ignored for activation commands) */
+    Eigen::VectorXd val_;
+
+    STaskCommand() : task_(S_NULL), type_(CMD_GOAL_POS) {}
+  };
+
+  /** A lock-free channel from one (non real-time) thread into the controller.
+   * Use one channel per sending thread. */
+  typedef CSpscQueue<STaskCommand, SCL_TASK_CMD_CHANNEL_LEN> CTaskCommandChannel;
+}
+
+#endif /* STASKCOMMAND_HPP_ */
@@ -33,6 +33,7 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdexcept>
 #include <iostream>
+#include <sstream>
 
 
 namespace scl
@@ -49,6 +50,9 @@ namespace scl
     has_been_init_ = false;
     has_been_activated_ = false;
     has_control_null_space_ = true;
+    is_engaged_ = true;
+    flag_otg_ = false;
+    otg_cycle_time_ = 0.001;
   }
 
   STaskBase::STaskBase() : SObject("STaskBase")
@@ -62,6 +66,9 @@ namespace scl
     has_been_init_ = false;
     has_been_activated_ = false;
     has_control_null_space_ = true;
+    is_engaged_ = true;
+    flag_otg_ = false;
+    otg_cycle_time_ = 0.001;
   }
 
   bool STaskBase::init(const std::string & arg_name,
@@ -208,12 +215,17 @@ namespace scl
       //Store the nonstandard params
       task_nonstd_params_ = arg_nonstd_params;
 
+      flag = initOtgParams();
+      if(false == flag)
+      { throw(std::runtime_error("Could not initialize the online trajectory generation parameters.")); }
+
       flag = initTaskParams();
       if(false == flag)
       { throw(std::runtime_error("Could not initialize the non standard task parameters. \nTODO : Subclass STaskBase, implement your task data structure, and make the function return true.")); }
 
       has_been_init_ = true;
       has_been_activated_ = true;
+      is_engaged_ = true;
     }
     catch(std::exception& e)
     {
@@ -226,6 +238,71 @@ namespace scl
     return has_been_init_;
   }
 
+  bool STaskBase::initOtgParams()
+  {
+    try
+    {
+      flag_otg_ = false;
+      otg_cycle_time_ = 0.001;
+      otg_max_vel_.resize(0);
+      otg_max_acc_.resize(0);
+      otg_max_jerk_.resize(0);
+
+      std::vector<scl::sString2>::const_iterator it,ite;
+      for(it = task_nonstd_params_.begin(), ite = task_nonstd_params_.end();
+          it!=ite;++it)
+      {
+        const sString2& param = *it;
+        Eigen::VectorXd* lim = S_NULL;
+        if(param.data_[0] == std::string("otg_max_vel")) { lim = &otg_max_vel_; }
+        else if(param.data_[0] == std::string("otg_max_acc")) { lim = &otg_max_acc_; }
+        else if(param.data_[0] == std::string("otg_max_jerk")) { lim = &otg_max_jerk_; }
+        else if(param.data_[0] == std::string("otg_cycle_time"))
+        {
+          std::stringstream ss(param.data_[1]);
+          ss>>otg_cycle_time_;
+          if(ss.fail() || 0 >= otg_cycle_time_)
+          { throw(std::runtime_error("otg_cycle_time should be a positive number")); }
+          continue;
+        }
+        else { continue; }
+
+        //Read a limit : one value, or one per task dof
+        std::stringstream ss(param.data_[1]);
+        std::vector<sFloat> vals;
+        sFloat tmp;
+        while(ss>>tmp) { vals.push_back(tmp); }
+        if(1 != vals.size() && dof_task_ != vals.size())
+        { throw(std::runtime_error(param.data_[0] + " should have 1 or task-dof values")); }
+        lim->setZero(dof_task_);
+        for(sUInt i=0; i<dof_task_; ++i)
+        { (*lim)(i) = (1 == vals.size()) ? vals[0] : vals[i]; }
+      }
+
+      if(0 == otg_max_vel_.size() && 0 == otg_max_acc_.size())
+      {
+        if(0 < otg_max_jerk_.size())
+        { throw(std::runtime_error("otg_max_jerk needs otg_max_vel and otg_max_acc")); }
+        return true; //Not using online trajectory generation
+      }
+
+      if(0 == otg_max_vel_.size() || 0 == otg_max_acc_.size())
+      { throw(std::runtime_error("Online trajectory generation needs both otg_max_vel and otg_max_acc")); }
+
+      if(0 >= otg_max_vel_.minCoeff() || 0 >= otg_max_acc_.minCoeff())
+      { throw(std::runtime_error("otg_max_vel and otg_max_acc should be positive")); }
+
+      flag_otg_ = true;
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nSTaskBase::initOtgParams() : "<<e.what();
+      flag_otg_ = false;
+      return false;
+    }
+    return true;
+  }
+
   bool STaskBase::setParentController(const SControllerMultiTask* arg_parent)
   {
     if(NULL == arg_parent)
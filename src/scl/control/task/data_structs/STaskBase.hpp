@@ -80,6 +80,15 @@ namespace scl
      * True after init() */
     scl::sBool has_been_activated_;
 
+    /** Whether an (activated) task currently acts on the robot.
+     * Inequality tasks (joint limits, workspace boundaries etc.) only
+     * engage when a cheap check (distance, limit proximity) says they
+     * must. While disengaged, they skip their Jacobian/model work,
+     * produce no force, and the controller treats them as absent
+     * (their null space doesn't restrict lower priority tasks).
+     * Default = true. Regular tasks never change it. */
+    scl::sBool is_engaged_;
+
     /** Is control task. This variable controls whether the controller
      * computes remaining null spaces for lower level tasks or not. If
      * it is true, the lower level task null spaces are not computed,
@@ -172,6 +181,24 @@ namespace scl
      *    */
     std::vector<sString2> task_nonstd_params_;
 
+    /* *********************************************************************
+     *                       Online trajectory generation
+     * ********************************************************************* */
+    /** Whether the task's servo tracks an online (velocity, acceleration and
+     * jerk limited) reference that moves toward the goal every servo tick,
+     * instead of the goal itself. Default = false.
+     *
+     * Goal-setting tasks opt in with the (generic) non standard params :
+     *    otg_max_vel, otg_max_acc : Required. One value, or one per task dof.
+     *    otg_max_jerk             : Optional. (Default : no jerk limit)
+     *    otg_cycle_time           : Optional. The servo period (Default : 0.001s)
+     * While the reference is on, the goal velocity and acceleration are
+     * replaced by the reference's. Supported by the gc, gc set, op pos and
+     * com pos tasks. Controllers reject other tasks that set these. */
+    sBool flag_otg_;
+    Eigen::VectorXd otg_max_vel_, otg_max_acc_, otg_max_jerk_;
+    sFloat otg_cycle_time_;
+
     /* *********************************************************************
      *                       External shared data interface
      * ********************************************************************* */
@@ -213,6 +240,10 @@ namespace scl
          * require various values */
         const std::vector<scl::sString2>& arg_nonstd_params);
 
+    /** Parses the online trajectory generation params (see flag_otg_)
+     * from task_nonstd_params_. Called by init(). */
+    bool initOtgParams();
+
     /** Sets the parent controller */
     bool setParentController(const SControllerMultiTask* arg_parent);
 
@@ -89,6 +89,9 @@ namespace scl
       //It will be used later.
       qr_.compute(data_->M_task_);
 
+      if(false == initOtg(*data_))
+      { throw(std::runtime_error("Couldn't initialize the online trajectory generator")); }
+
       has_been_init_ = true;
     }
     catch(std::exception& e)
@@ -176,31 +179,40 @@ namespace scl
 #endif
     if(data_->has_been_init_)
     {
+      //The com moves with the model (which a model thread may have swapped in)
+      data_->x_ = data_->gc_model_->pos_com_;
+
       Eigen::MatrixXd &tmp_J = data_->J_;
       //Global coordinates : dx = J . dq
-      data_->dx_ = tmp_J * arg_sensors->dq_;
+      data_->dx_.noalias() = tmp_J * arg_sensors->dq_;
+
+      //Track the goal (or the online trajectory's reference toward it)
+      Eigen::Vector3d x_goal(data_->x_goal_), dx_goal(data_->dx_goal_), ddx_goal(data_->ddx_goal_);
+      if(computeOtgReference(data_->x_goal_, data_->x_, data_->dx_))
+      { x_goal = otg_.getPos(); dx_goal = otg_.getVel(); ddx_goal = otg_.getAcc(); }
 
       //Compute the servo torques
-      tmp1 = (data_->x_goal_ - data_->x_);
+      tmp1 = (x_goal - data_->x_);
       tmp1 =  data_->kp_.array() * tmp1.array();
 
-      tmp2 = (data_->dx_goal_ - data_->dx_);
+      tmp2 = (dx_goal - data_->dx_);
       tmp2 = data_->kv_.array() * tmp2.array();
 
       //Obtain force to be applied to a unit mass floating about
       //in space (ie. A dynamically decoupled mass).
-      data_->ddx_ = data_->ka_.array() * (data_->ddx_goal_ - data_->ddx_).array();
+      data_->ddx_ = data_->ka_.array() * (ddx_goal - data_->ddx_).array();
       data_->ddx_ += tmp2 + tmp1;
 
       data_->ddx_ = data_->ddx_.array().min(data_->force_task_max_.array());//Min of self and max
       data_->ddx_ = data_->ddx_.array().max(data_->force_task_min_.array());//Max of self and min
 
       // NOTE : We subtract gravity (since we want to apply an equal and opposite force
-      data_->force_task_ = data_->M_task_ * data_->ddx_ - data_->force_task_grav_;
+      data_->force_task_.noalias() = data_->M_task_ * data_->ddx_;
+      data_->force_task_ -= data_->force_task_grav_;
 
       // T = J' ( M x F* + p)
       // We do not use the centrifugal/coriolis forces. They can cause instabilities.
-      data_->force_gc_ = data_->J_.transpose() * data_->force_task_;
+      data_->force_gc_.noalias() = data_->J_.transpose() * data_->force_task_;
 
       return true;
     }
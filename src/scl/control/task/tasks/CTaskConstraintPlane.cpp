@@ -128,29 +128,37 @@ bool CTaskConstraintPlane::computeServo(const SRobotSensors* arg_sensors)
 #endif
   if(data_->has_been_init_)
   {
-    dynamics_->computeJacobian(data_->J_6_,*(data_->rbd_),
-        arg_sensors->q_,data_->pos_in_parent_);
-
-    //Use the position jacobian only. This is an op-point task.
-    data_->J_ = data_->J_6_.block(0,0,3,data_->robot_->dof_);
-
-    //Step 1: Find position and velocity of the op_point
+    //Step 1: Find the position of the op_point. This is cheap (no Jacobian).
     data_->x_ = data_->rbd_->T_o_lnk_ * data_->pos_in_parent_;
-    data_->dx_ = data_->J_ * arg_sensors->dq_;
 
     //Now find the distance it has advanced into the constraint plane.
     double dist = data_->mul_dist_ * computePlanePointDistance(data_->a_, data_->b_, data_->c_, data_->d_, data_->x_);
 
     if(dist > 0)
-    {// The constraint is inactive
-      data_->force_task_ *= 0;
-      data_->force_gc_ *= 0;
+    {// The constraint is inactive. Skip the Jacobian and force computation.
+      if(data_->is_active_)
+      {//Only need to clear these when it lets go
+        data_->force_task_.setZero();
+        data_->force_gc_.setZero();
+      }
+      data_->dx_.setZero();
       data_->is_active_ = false;
+      data_->is_engaged_ = false;
       return true;
     }
 
     // The constraint is now active..
     data_->is_active_ = true;
+    data_->is_engaged_ = true;
+
+    computeJacobian(data_->J_6_,*(data_->rbd_),
+        arg_sensors->q_,data_->pos_in_parent_);
+
+    //Use the position jacobian only. This is an op-point task.
+    data_->J_ = data_->J_6_.block(0,0,3,data_->robot_->dof_);
+
+    //Step 2: Find the velocity of the op_point
+    data_->dx_ = data_->J_ * arg_sensors->dq_;
 
     // Find the plane normal
     tmp1(0) = data_->a_;
@@ -68,6 +68,9 @@ namespace scl
       data_->J_dyn_inv_.setIdentity(data_->robot_->dof_,data_->robot_->dof_);
       data_->null_space_.setZero(data_->robot_->dof_,data_->robot_->dof_);
 
+      if(false == initOtg(*data_))
+      { throw(std::runtime_error("Couldn't initialize the online trajectory generator")); }
+
       has_been_init_ = true;
     }
     catch(std::exception& e)
@@ -157,25 +160,25 @@ namespace scl
       data_->q_ = arg_sensors->q_;
       data_->dq_ = arg_sensors->dq_;
 
-      //Compute the servo torques
-      Eigen::VectorXd tmp1, tmp2;
-
-      tmp1 = (data_->q_goal_ - data_->q_);
-      tmp1 =  data_->kp_.array() * tmp1.array();
-
-      tmp2 = (data_->dq_goal_ - data_->dq_);
-      tmp2 = data_->kv_.array() * tmp2.array();
+      //Track the goal (or the online trajectory's reference toward it)
+      const Eigen::VectorXd *q_goal = &data_->q_goal_, *dq_goal = &data_->dq_goal_,
+          *ddq_goal = &data_->ddq_goal_;
+      if(computeOtgReference(data_->q_goal_, data_->q_, data_->dq_))
+      { q_goal = &otg_.getPos(); dq_goal = &otg_.getVel(); ddq_goal = &otg_.getAcc(); }
 
+      //Compute the servo torques
       //Obtain force to be applied to a unit mass floating about
       //in space (ie. A dynamically decoupled mass).
-      data_->force_task_ = data_->ka_.array() * (data_->ddq_goal_ - data_->ddq_).array();
-      data_->force_task_ += tmp2 + tmp1;
+      //NOTE : One coefficient-wise expression, so there are no heap temporaries.
+      data_->force_task_ = data_->ka_.array() * (ddq_goal->array() - data_->ddq_.array())
+          + data_->kv_.array() * (dq_goal->array() - data_->dq_.array())
+          + data_->kp_.array() * (q_goal->array() - data_->q_.array());
 
       data_->force_task_ = data_->force_task_.array().min(data_->force_task_max_.array());//Min of self and max
       data_->force_task_ = data_->force_task_.array().max(data_->force_task_min_.array());//Max of self and min
 
       if(data_->flag_compute_inertia_)
-      { data_->force_gc_ = data_->gc_model_->M_gc_ * data_->force_task_;  }
+      { data_->force_gc_.noalias() = data_->gc_model_->M_gc_ * data_->force_task_;  }
       else
       { data_->force_gc_ = data_->force_task_;  }
 
@@ -131,6 +131,31 @@ namespace scl
       data_->q_ = arg_sensors->q_;
       data_->dq_ = arg_sensors->dq_;
 
+      //Cheap limit check first. Stay out of the way till a joint nears its limits.
+      if(data_->engage_margin_ > 0)
+      {
+        const SRobotParsed& r = *(data_->robot_);
+        bool near_lim = false;
+        for(int i=0; i<data_->q_.size() && !near_lim; ++i)
+        {
+          sFloat margin = data_->engage_margin_ * (r.gc_pos_limit_max_(i) - r.gc_pos_limit_min_(i));
+          near_lim = (data_->q_(i) < r.gc_pos_limit_min_(i) + margin) ||
+              (data_->q_(i) > r.gc_pos_limit_max_(i) - margin);
+        }
+
+        if(false == near_lim)
+        {
+          if(data_->is_engaged_)
+          {//Only need to clear these when it lets go
+            data_->force_task_.setZero();
+            data_->force_gc_.setZero();
+          }
+          data_->is_engaged_ = false;
+          return true;
+        }
+      }
+      data_->is_engaged_ = true;
+
       //Compute the servo torques
       Eigen::VectorXd tmp1, tmp2;
 
@@ -72,6 +72,11 @@ namespace scl
       for(sUInt i=0; i<data_->dof_task_; ++i)
       { data_->null_space_(data_->q_sel_[i],data_->q_sel_[i]) = 0.0;  }
 
+      if(false == initOtg(*data_))
+      { throw(std::runtime_error("Couldn't initialize the online trajectory generator")); }
+      q_sel_curr_.setZero(data_->dof_task_);
+      dq_sel_curr_.setZero(data_->dof_task_);
+
       has_been_init_ = true;
     }
     catch(std::exception& e)
@@ -160,6 +165,20 @@ namespace scl
     {
       data_->force_gc_.array().setZero();
 
+      //Track the goal (or the online trajectory's reference toward it)
+      const Eigen::VectorXd *q_goal = &data_->q_goal_, *dq_goal = &data_->dq_goal_,
+          *ddq_goal = &data_->ddq_goal_;
+      if(otg_.hasBeenInit())
+      {
+        for(sUInt i=0; i<data_->dof_task_; ++i)
+        {
+          q_sel_curr_(i) = arg_sensors->q_(data_->q_sel_[i]);
+          dq_sel_curr_(i) = arg_sensors->dq_(data_->q_sel_[i]);
+        }
+        if(computeOtgReference(data_->q_goal_, q_sel_curr_, dq_sel_curr_))
+        { q_goal = &otg_.getPos(); dq_goal = &otg_.getVel(); ddq_goal = &otg_.getAcc(); }
+      }
+
       for(sUInt i=0; i<data_->dof_task_; ++i)
       {
 #ifdef DEBUG
@@ -175,15 +194,15 @@ namespace scl
         //Compute the servo torques
         sFloat tmp1, tmp2;
 
-        tmp1 = (data_->q_goal_[i] - arg_sensors->q_[data_->q_sel_[i]]);
+        tmp1 = ((*q_goal)[i] - arg_sensors->q_[data_->q_sel_[i]]);
         tmp1 =  data_->kp_[i] * tmp1;
 
-        tmp2 = (data_->dq_goal_[i] - arg_sensors->dq_[data_->q_sel_[i]]);
+        tmp2 = ((*dq_goal)[i] - arg_sensors->dq_[data_->q_sel_[i]]);
         tmp2 = data_->kv_[i] * tmp2;
 
         //Obtain force to be applied to a unit mass floating about
         //in space (ie. A dynamically decoupled mass).
-        data_->force_task_[i] = data_->ka_(i) * (data_->ddq_goal_[i] - arg_sensors->ddq_[data_->q_sel_[i]]);
+        data_->force_task_[i] = data_->ka_(i) * ((*ddq_goal)[i] - arg_sensors->ddq_[data_->q_sel_[i]]);
         data_->force_task_[i] += tmp2 + tmp1;
 
         //Min of self and max
@@ -119,6 +119,8 @@ namespace scl
     /** These are the generalized coordinates selected on the
      * basis of their name */
     Eigen::VectorXd selected_gcs_;
+    /** The selected gcs' current state (starts the online trajectory) */
+    Eigen::VectorXd q_sel_curr_, dq_sel_curr_;
   };
 
 } /* namespace scl */
@@ -98,7 +98,8 @@ namespace scl
       data_->force_task_ = data_->force_task_.array().min(data_->force_task_max_.array());//Min of self and max
       data_->force_task_ = data_->force_task_.array().max(data_->force_task_min_.array());//Max of self and min
 
-      data_->force_gc_ = -1* data_->gc_model_->M_gc_ * data_->force_task_;
+      data_->force_gc_.noalias() = data_->gc_model_->M_gc_ * data_->force_task_;
+      data_->force_gc_ *= -1;
       return true;
     }
     else
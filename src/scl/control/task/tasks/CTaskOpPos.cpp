@@ -91,6 +91,9 @@ namespace scl
       //It will be used later.
       qr_.compute(data_->M_task_);
 
+      if(false == initOtg(*data_))
+      { throw(std::runtime_error("Couldn't initialize the online trajectory generator")); }
+
       has_been_init_ = true;
     }
     catch(std::exception& e)
@@ -182,18 +185,24 @@ bool CTaskOpPos::computeServo(const SRobotSensors* arg_sensors)
     data_->x_ = data_->rbd_->T_o_lnk_ * data_->pos_in_parent_;
 
     //Global coordinates : dx = J . dq
-    data_->dx_ = data_->J_ * arg_sensors->dq_;
+    data_->dx_.noalias() = data_->J_ * arg_sensors->dq_;
+
+    //Track the goal (or the online trajectory's reference toward it)
+    const Eigen::VectorXd *x_goal = &data_->x_goal_, *dx_goal = &data_->dx_goal_,
+        *ddx_goal = &data_->ddx_goal_;
+    if(computeOtgReference(data_->x_goal_, data_->x_, data_->dx_))
+    { x_goal = &otg_.getPos(); dx_goal = &otg_.getVel(); ddx_goal = &otg_.getAcc(); }
 
     //Compute the servo torques
-    tmp1 = (data_->x_goal_ - data_->x_);
+    tmp1 = (*x_goal - data_->x_);
     tmp1 =  data_->kp_.array() * tmp1.array();
 
-    tmp2 = (data_->dx_goal_ - data_->dx_);
+    tmp2 = (*dx_goal - data_->dx_);
     tmp2 = data_->kv_.array() * tmp2.array();
 
     //Obtain force to be applied to a unit mass floating about
     //in space (ie. A dynamically decoupled mass).
-    data_->ddx_ = data_->ka_.array() * (data_->ddx_goal_ - data_->ddx_).array();
+    data_->ddx_ = data_->ka_.array() * (*ddx_goal - data_->ddx_).array();
     data_->ddx_ += tmp2 + tmp1;
 
     // NOTE : We apply the force limits in "task space". This is the whole point of
@@ -205,7 +214,7 @@ bool CTaskOpPos::computeServo(const SRobotSensors* arg_sensors)
     data_->ddx_ = data_->ddx_.array().max(data_->force_task_min_.array());//Max of self and min
 
     if(data_->flag_compute_op_inertia_)
-    { data_->force_task_ = data_->M_task_ * data_->ddx_;  }
+    { data_->force_task_.noalias() = data_->M_task_ * data_->ddx_;  }
     else
     { data_->force_task_ = data_->ddx_;  }
 
@@ -218,7 +227,7 @@ bool CTaskOpPos::computeServo(const SRobotSensors* arg_sensors)
 
     // T = J' ( M x F* + p)
     // We do not use the centrifugal/coriolis forces. They can cause instabilities.
-    data_->force_gc_ = data_->J_.transpose() * data_->force_task_;
+    data_->force_gc_.noalias() = data_->J_.transpose() * data_->force_task_;
   }
   else
   { return false; }
@@ -241,7 +250,7 @@ bool CTaskOpPos::computeModel(const SRobotSensors* arg_sensors)
     bool flag = true;
     const SGcModel* gcm = data_->gc_model_;
 
-    flag = flag && dynamics_->computeJacobian(data_->J_6_,*(data_->rbd_),
+    flag = flag && computeJacobian(data_->J_6_,*(data_->rbd_),
         arg_sensors->q_,data_->pos_in_parent_);
 
     //Use the position jacobian only. This is an op-point task.
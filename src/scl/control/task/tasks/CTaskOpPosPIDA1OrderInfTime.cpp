@@ -93,6 +93,9 @@ namespace scl
       //It will be used later.
       qr_.compute(data_->M_task_);
 
+      if(false == initOtg(*data_))
+      { throw(std::runtime_error("Couldn't initialize the online trajectory generator")); }
+
       has_been_init_ = true;
     }
     catch(std::exception& e)
@@ -188,25 +191,31 @@ bool CTaskOpPosPIDA1OrderInfTime::computeServo(const SRobotSensors* arg_sensors)
     data_->x_ = data_->rbd_->T_o_lnk_ * data_->pos_in_parent_;
 
     //Global coordinates : dx = J . dq
-    data_->dx_ = data_->J_ * arg_sensors->dq_;
+    data_->dx_.noalias() = data_->J_ * arg_sensors->dq_;
+
+    //Track the goal (or the online trajectory's reference toward it)
+    const Eigen::VectorXd *x_goal = &data_->x_goal_, *dx_goal = &data_->dx_goal_,
+        *ddx_goal = &data_->ddx_goal_;
+    if(computeOtgReference(data_->x_goal_, data_->x_, data_->dx_))
+    { x_goal = &otg_.getPos(); dx_goal = &otg_.getVel(); ddx_goal = &otg_.getAcc(); }
 
     //Compute the servo torques
-    tmp1 = (data_->x_goal_ - data_->x_);
+    tmp1 = (*x_goal - data_->x_);
     tmp1 =  data_->kp_.array() * tmp1.array();
 
-    tmp2 = (data_->dx_goal_ - data_->dx_);
+    tmp2 = (*dx_goal - data_->dx_);
     tmp2 = data_->kv_.array() * tmp2.array();
 
     //Obtain force to be applied to a unit mass floating about
     //in space (ie. A dynamically decoupled mass).
-    data_->ddx_ = data_->ka_.array() * (data_->ddx_goal_ - data_->ddx_).array();
+    data_->ddx_ = data_->ka_.array() * (*ddx_goal - data_->ddx_).array();
     data_->ddx_ += tmp2 + tmp1;
 
     // Compute the integral force
     double tmp_int_dt = data_->integral_gain_time_curr_ - data_->integral_gain_time_pre_;
     // All the array() casts are for element wise operations.
     data_->integral_force_ = data_->integral_force_.array() +
-        data_->ki_.array() * (data_->x_goal_ - data_->x_).array() * tmp_int_dt;
+        data_->ki_.array() * (*x_goal - data_->x_).array() * tmp_int_dt;
 
     //Add the integral force.
     data_->ddx_ += data_->integral_force_;
@@ -217,13 +226,13 @@ bool CTaskOpPosPIDA1OrderInfTime::computeServo(const SRobotSensors* arg_sensors)
 
     // NOTE : We subtract gravity (since we want to apply an equal and opposite force
     if(flag_compute_gravity_)
-    { data_->force_task_ = data_->M_task_ * data_->ddx_ - data_->force_task_grav_;  }
+    { data_->force_task_.noalias() = data_->M_task_ * data_->ddx_; data_->force_task_ -= data_->force_task_grav_;  }
     else
-    { data_->force_task_ = data_->M_task_ * data_->ddx_;  }
+    { data_->force_task_.noalias() = data_->M_task_ * data_->ddx_;  }
 
     // T = J' ( M x F* + p)
     // We do not use the centrifugal/coriolis forces. They can cause instabilities.
-    data_->force_gc_ = data_->J_.transpose() * data_->force_task_;
+    data_->force_gc_.noalias() = data_->J_.transpose() * data_->force_task_;
 
     return true;
   }
@@ -246,7 +255,7 @@ bool CTaskOpPosPIDA1OrderInfTime::computeModel(const SRobotSensors* arg_sensors)
     bool flag = true;
     const SGcModel* gcm = data_->gc_model_;
 
-    flag = flag && dynamics_->computeJacobian(data_->J_6_,*(data_->rbd_),arg_sensors->q_,data_->pos_in_parent_);
+    flag = flag && computeJacobian(data_->J_6_,*(data_->rbd_),arg_sensors->q_,data_->pos_in_parent_);
 
     //Use the position jacobian only. This is an op-point task.
     data_->J_ = data_->J_6_.block(0,0,3,data_->robot_->dof_);
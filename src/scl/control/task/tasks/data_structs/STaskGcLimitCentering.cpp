@@ -33,6 +33,7 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdexcept>
 #include <iostream>
+#include <sstream>
 
 namespace scl
 {
@@ -41,7 +42,8 @@ namespace scl
 #define SCL_GCTASK_SPATIAL_RESOLUTION 0.005
 
   STaskGcLimitCentering::STaskGcLimitCentering() : STaskBase("STaskGcLimitCentering"),
-    spatial_resolution_(SCL_GCTASK_SPATIAL_RESOLUTION)
+    spatial_resolution_(SCL_GCTASK_SPATIAL_RESOLUTION),
+    engage_margin_(0)
   { }
 
   STaskGcLimitCentering::~STaskGcLimitCentering()
@@ -51,6 +53,22 @@ namespace scl
   {
     try
     {
+      engage_margin_ = 0;
+
+      std::vector<scl::sString2>::const_iterator it,ite;
+      for(it = task_nonstd_params_.begin(), ite = task_nonstd_params_.end();
+          it!=ite;++it)
+      {
+        const sString2& param = *it;
+        if(param.data_[0] == std::string("engage_margin"))
+        {//Optional, so we don't need to check it with contains_
+          std::stringstream ss(param.data_[1]);
+          ss>>engage_margin_;
+          if(engage_margin_ >= 0.5)
+          { throw(std::runtime_error("Engage margin must be < 0.5 (the limits' mid-point).")); }
+        }
+      }
+
       // To test whether the goal position has been achieved.
       spatial_resolution_ = SCL_GCTASK_SPATIAL_RESOLUTION;
 
@@ -50,6 +50,11 @@ namespace scl
 
     sFloat spatial_resolution_;     //Meters (acceptable error).
 
+    /** The task only engages when a joint gets within this fraction of
+     * its range from either limit. Eg. 0.1 engages it in the outer 10%.
+     * <= 0 (default) : Always engaged. */
+    sFloat engage_margin_;
+
     /** Default constructor sets stuff to S_NULL */
     STaskGcLimitCentering();
 
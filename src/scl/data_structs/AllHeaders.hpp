@@ -45,6 +45,7 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <scl/data_structs/SRigidBodyDyn.hpp>
 #include <scl/data_structs/SRobotIO.hpp>
 #include <scl/data_structs/SRobotParsed.hpp>
+#include <scl/data_structs/SRobotSnapshot.hpp>
 #include <scl/data_structs/SUIParsed.hpp>
 
 // An all-in-one data struct used by some programs. Contains all of
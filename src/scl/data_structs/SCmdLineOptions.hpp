@@ -70,6 +70,35 @@ namespace scl
      *  py-cam script : Controls camera (disable gui from controlling camera) */
     bool flag_is_redis_master_ = false;
 
+    /** Real-time control loop options (see CLoopScheduler).
+     *   -rate <hz>  : Loop rate. 0 (default) : Run as fast as possible.
+     *   -rtprio <p> : SCHED_FIFO priority (1-99). 0 : Normal scheduling.
+     *   -cpu <n>    : Pin the loop to a cpu. -1 : Don't pin.
+     *   -mlock      : Lock memory and prefault the stack. */
+    double loop_rate_hz_ = 0;
+    int loop_rt_priority_ = 0;
+    int loop_cpu_ = -1;
+    bool flag_loop_mlock_ = false;
+
+    /** IO transport options (see CIOShm).
+     *   -shm : Exchange the robot's state through POSIX shared memory
+     *          (default name "/scl_io") instead of redis.
+     *   -shmname </name> : Same as -shm, with another shared memory name. */
+    bool flag_io_shm_ = false;
+    std::string name_io_shm_ = "/scl_io";
+
+    /**   -sub : Block on the robot's published state messages (redis pub/sub)
+     *           instead of polling its redis keys. */
+    bool flag_io_redis_sub_ = false;
+
+    /** Latency compensation (see CStatePredictor).
+     *   -predict <sec> : Predict the state the command will act on. Moves
+     *                    each sample forward by its measured age (with
+     *                    -sub) plus this lookahead (eg. the actuation
+     *                    latency). */
+    bool flag_predict_ = false;
+    double predict_lookahead_ = 0;
+
     SCmdLineOptions_OneRobot() : SObject("SCmdLineOptions_OneRobot")
     {
       time_t curtime;
@@ -0,0 +1,80 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file SRobotSnapshot.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef SROBOTSNAPSHOT_HPP_
+#define SROBOTSNAPSHOT_HPP_
+
+#include <scl/DataTypes.hpp>
+
+#include <Eigen/Dense>
+#include <Eigen/StdVector>
+
+#include <vector>
+
+namespace scl
+{
+  /** A consistent copy of a robot's state at one simulation tick.
+   *
+   * The simulation thread publishes these (see CRobot::publishSnapshot)
+   * so that non real-time readers (graphics, loggers, network publishers)
+   * never read a half-integrated state, and never make the simulation
+   * wait for them.
+   *
+   * NOTE : Size it with init() before use. Copying a sized snapshot into
+   * another of the same size doesn't allocate. */
+  struct SRobotSnapshot
+  {
+  public:
+    /** The generalized coordinates, velocities and commanded forces */
+    Eigen::VectorXd q_, dq_, force_gc_commanded_;
+
+    /** The link transforms (origin <- link), indexed by link id.
+     * Empty if the publisher doesn't compute transforms. */
+    std::vector<Eigen::Affine3d, Eigen::aligned_allocator<Eigen::Affine3d> > T_o_lnk_;
+
+    /** The publisher's tick counter and the simulation time at the tick */
+    sLongLong tick_ = 0;
+    sFloat t_ = 0.0;
+
+    /** Allocates the state for a robot with arg_dof dofs (and
+     * arg_dof link transforms if arg_with_transforms) */
+    void init(const sUInt arg_dof, const sBool arg_with_transforms)
+    {
+      q_.setZero(arg_dof);
+      dq_.setZero(arg_dof);
+      force_gc_commanded_.setZero(arg_dof);
+      T_o_lnk_.assign(arg_with_transforms ? arg_dof : 0, Eigen::Affine3d::Identity());
+      tick_ = 0; t_ = 0.0;
+    }
+  };
+}
+
+#endif /* SROBOTSNAPSHOT_HPP_ */
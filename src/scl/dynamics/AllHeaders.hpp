@@ -35,6 +35,15 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 // The standard dynamics class.
 #include <scl/dynamics/scl/CDynamicsScl.hpp>
 
+// Memoizes link Jacobians between gc model updates.
+#include <scl/dynamics/CJacobianCache.hpp>
+
+// Damped least squares inverse kinematics (batched, parallel).
+#include <scl/dynamics/scl/CInverseKinematicsScl.hpp>
+
+// Reachability and manipulability maps (memory mapped voxel grids).
+#include <scl/dynamics/scl/CReachabilityMap.hpp>
+
 // Analytic dynamics for certain robots.
 #include <scl/dynamics/analytic/CDynamicsAnalyticRPP.hpp>
 
@@ -0,0 +1,112 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CJacobianCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "CJacobianCache.hpp"
+
+#include <stdexcept>
+#include <iostream>
+
+namespace scl
+{
+  sBool CJacobianCache::init(const CDynamicsBase* arg_dynamics, const sUInt arg_dof)
+  {
+    try
+    {
+      if(S_NULL == arg_dynamics)
+      { throw(std::runtime_error("Passed NULL dynamics object.")); }
+      if(0 == arg_dof)
+      { throw(std::runtime_error("Can not cache Jacobians for a robot with 0 dof.")); }
+
+      dynamics_ = arg_dynamics;
+      dof_ = arg_dof;
+
+      entries_.clear();
+      entries_.resize(dof_);
+      for(sUInt i=0; i<dof_; ++i)
+      { entries_[i].J_.setZero(6,dof_); }
+
+      version_ = 0;
+      resetStats();
+      has_been_init_ = true;
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCJacobianCache::init() : "<<e.what();
+      has_been_init_ = false;
+    }
+    return has_been_init_;
+  }
+
+  sBool CJacobianCache::computeJacobian(
+      Eigen::MatrixXd& ret_J,
+      const SRigidBodyDyn& arg_link,
+      const Eigen::VectorXd& arg_q,
+      const Eigen::Vector3d& arg_pos_local)
+  {//This function doesn't use std::exceptions (for speed).
+    if(false == has_been_init_) { return false; }
+
+    //The root never moves.
+    if(arg_link.link_ds_->is_root_)
+    { ret_J.setZero(6,arg_q.rows()); ctr_walks_saved_++; return true; }
+
+    const int id = arg_link.link_ds_->link_id_;
+    if(0 > id || static_cast<sUInt>(id) >= dof_)
+    {//Not a link this cache knows about. Just compute it.
+      ctr_walks_++;
+      return dynamics_->computeJacobian(ret_J, arg_link, arg_q, arg_pos_local);
+    }
+
+    SJacobianEntry& e = entries_[id];
+    if(e.version_ != version_ || e.link_ != &arg_link)
+    {//Walk up the chain once (at the link's origin)
+      if(false == dynamics_->computeJacobian(e.J_, arg_link, arg_q, Eigen::Vector3d::Zero()))
+      { e.version_ = -1; return false; }
+      e.link_ = &arg_link;
+      e.version_ = version_;
+      ctr_walks_++;
+    }
+    else
+    { ctr_walks_saved_++; }
+
+    ret_J = e.J_;
+
+    //Shift to the offset point : Jv += Jw x r, where r is the offset in global coords.
+    // NOTE : The link transforms are rigid so linear() is the rotation.
+    if(false == arg_pos_local.isZero(0.0))
+    {
+      const Eigen::Vector3d r = arg_link.T_o_lnk_.linear() * arg_pos_local;
+      for(int j=0; j<ret_J.cols(); ++j)
+      { ret_J.block<3,1>(0,j) += ret_J.block<3,1>(3,j).cross(r); }
+    }
+
+    return true;
+  }
+}
@@ -0,0 +1,120 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CJacobianCache.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CJACOBIANCACHE_HPP_
+#define CJACOBIANCACHE_HPP_
+
+#include <scl/DataTypes.hpp>
+#include <scl/dynamics/CDynamicsBase.hpp>
+#include <scl/data_structs/SRigidBodyDyn.hpp>
+
+#include <Eigen/Dense>
+
+#include <vector>
+
+namespace scl
+{
+  /** Memoizes link Jacobians for a gc model.
+   *
+   * Link Jacobians only depend on the link transforms, which only
+   * change when the gc model is updated. So each 6 x dof link Jacobian
+   * (at the link's origin) is computed (one walk up the chain) at most
+   * once per model update. Jacobians at an offset point are derived
+   * from it in O(dof):
+   *     Jv_offset = Jv_link + Jw x (R_o_lnk * pos_local)
+   *
+   * Controllers own one of these, call invalidate() after every gc
+   * model update, and hand it to their tasks.
+   *
+   * NOTE : Not thread-safe. Use it from the thread that updates the
+   *        controller's gc model. */
+  class CJacobianCache
+  {
+  public:
+    /** Computes the 6 x dof Jacobian at an offset from a link.
+     * Same semantics as CDynamicsBase::computeJacobian. */
+    sBool computeJacobian(
+        /** The Jacobain will be saved here. */
+        Eigen::MatrixXd& ret_J,
+        /** The link at which the Jacobian is to be calculated */
+        const SRigidBodyDyn& arg_link,
+        /** The current generalized coordinates. */
+        const Eigen::VectorXd& arg_q,
+        /** The offset from the link's frame (in link coordinates). */
+        const Eigen::Vector3d& arg_pos_local);
+
+    /** Marks all cached Jacobians as stale. Call this whenever the
+     * link transforms change (ie. after every gc model update). */
+    void invalidate() { version_++; }
+
+    /** The number of times a Jacobian was computed by walking up the chain */
+    sLongLong getChainWalks() const { return ctr_walks_; }
+
+    /** The number of times a cached Jacobian was reused */
+    sLongLong getChainWalksSaved() const { return ctr_walks_saved_; }
+
+    /** Resets the counters */
+    void resetStats() { ctr_walks_ = 0; ctr_walks_saved_ = 0; }
+
+    /** Sets up the cache for a robot with the given dof */
+    sBool init(const CDynamicsBase* arg_dynamics, const sUInt arg_dof);
+
+    sBool hasBeenInit() const { return has_been_init_; }
+
+    CJacobianCache() : dynamics_(S_NULL), dof_(0), version_(0),
+        ctr_walks_(0), ctr_walks_saved_(0), has_been_init_(false) {}
+
+  private:
+    /** A cached link Jacobian */
+    struct SJacobianEntry
+    {
+      Eigen::MatrixXd J_;
+      const SRigidBodyDyn* link_;
+      sLongLong version_;
+      SJacobianEntry() : link_(S_NULL), version_(-1) {}
+    };
+
+    /** Indexed by link id (one entry per dof) */
+    std::vector<SJacobianEntry> entries_;
+
+    const CDynamicsBase* dynamics_;
+    sUInt dof_;
+
+    /** The current state version */
+    sLongLong version_;
+
+    sLongLong ctr_walks_, ctr_walks_saved_;
+
+    sBool has_been_init_;
+  };
+}
+
+#endif /* CJACOBIANCACHE_HPP_ */
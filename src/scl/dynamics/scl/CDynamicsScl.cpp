@@ -266,6 +266,8 @@ namespace scl
     Eigen::Vector3d pos_wrt_joint_global_frame, axis_global_frame;
 
     //Walk up the tree.
+    //NOTE : The link transforms are rigid, so linear() is their rotation. (rotation()
+    //would do a polar decomposition (an svd) per call, which dominated this function).
     while(flag && rbd != NULL)
     {//Keep going till you reach the ancestor
       // NOTE : T_to_joint is going to be identity in the first loop (we are at
@@ -279,15 +281,15 @@ namespace scl
          */
         case JOINT_TYPE_PRISMATIC_X:
           //Jv
-          arg_J.block(0,i,3,1) = rbd->T_o_lnk_.rotation()*Eigen::Vector3d::UnitX();
+          arg_J.block(0,i,3,1) = rbd->T_o_lnk_.linear()*Eigen::Vector3d::UnitX();
           break;
         case JOINT_TYPE_PRISMATIC_Y:
           //Jv
-          arg_J.block(0,i,3,1) = rbd->T_o_lnk_.rotation()*Eigen::Vector3d::UnitY();
+          arg_J.block(0,i,3,1) = rbd->T_o_lnk_.linear()*Eigen::Vector3d::UnitY();
           break;
         case JOINT_TYPE_PRISMATIC_Z:
           //Jv
-          arg_J.block(0,i,3,1) = rbd->T_o_lnk_.rotation()*Eigen::Vector3d::UnitZ();
+          arg_J.block(0,i,3,1) = rbd->T_o_lnk_.linear()*Eigen::Vector3d::UnitZ();
           break;
         /** For rotational joints:
          * Jv => cross product of operational point and angular velocity at the given dof.
@@ -295,24 +297,24 @@ namespace scl
          */
         case JOINT_TYPE_REVOLUTE_X:
           //Jv
-          pos_wrt_joint_global_frame = rbd->T_o_lnk_.rotation()*T_to_joint * arg_pos_local;
-          axis_global_frame = rbd->T_o_lnk_.rotation()*Eigen::Vector3d::UnitX();
+          pos_wrt_joint_global_frame = rbd->T_o_lnk_.linear()*T_to_joint * arg_pos_local;
+          axis_global_frame = rbd->T_o_lnk_.linear()*Eigen::Vector3d::UnitX();
           arg_J.block(0,i,3,1) = axis_global_frame.cross(pos_wrt_joint_global_frame);
           //Jω
           arg_J.block(3,i,3,1) = axis_global_frame;
           break;
         case JOINT_TYPE_REVOLUTE_Y:
           //Jv
-          pos_wrt_joint_global_frame = rbd->T_o_lnk_.rotation()*T_to_joint * arg_pos_local;
-          axis_global_frame = rbd->T_o_lnk_.rotation()*Eigen::Vector3d::UnitY();
+          pos_wrt_joint_global_frame = rbd->T_o_lnk_.linear()*T_to_joint * arg_pos_local;
+          axis_global_frame = rbd->T_o_lnk_.linear()*Eigen::Vector3d::UnitY();
           arg_J.block(0,i,3,1) = axis_global_frame.cross(pos_wrt_joint_global_frame);
           //Jω
           arg_J.block(3,i,3,1) = axis_global_frame;
           break;
         case JOINT_TYPE_REVOLUTE_Z:
           //Jv
-          pos_wrt_joint_global_frame = rbd->T_o_lnk_.rotation()*T_to_joint * arg_pos_local;
-          axis_global_frame = rbd->T_o_lnk_.rotation()*Eigen::Vector3d::UnitZ();
+          pos_wrt_joint_global_frame = rbd->T_o_lnk_.linear()*T_to_joint * arg_pos_local;
+          axis_global_frame = rbd->T_o_lnk_.linear()*Eigen::Vector3d::UnitZ();
           arg_J.block(0,i,3,1) = axis_global_frame.cross(pos_wrt_joint_global_frame);
           //Jω
           arg_J.block(3,i,3,1) = axis_global_frame;
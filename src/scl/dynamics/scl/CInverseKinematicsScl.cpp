@@ -0,0 +1,443 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CInverseKinematicsScl.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "CInverseKinematicsScl.hpp"
+
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace scl
+{
+  CInverseKinematicsScl::~CInverseKinematicsScl()
+  {
+    for(size_t i=0; i<ws_.size(); ++i)
+    { delete ws_[i].gc_model_;  }
+  }
+
+  sBool CInverseKinematicsScl::init(const SRobotParsed& arg_robot,
+      CDynamicsScl* arg_dynamics,
+      const sUInt arg_threads)
+  {
+    try
+    {
+      if(S_NULL == arg_dynamics)
+      { throw(std::runtime_error("Passed NULL dynamics object.")); }
+      if(false == arg_dynamics->hasBeenInit())
+      { throw(std::runtime_error("Passed an uninitialized dynamics object.")); }
+      if(0 >= arg_robot.dof_)
+      { throw(std::runtime_error("Can not solve ik for a robot with 0 dof.")); }
+
+      sUInt n_threads = arg_threads;
+#ifdef _OPENMP
+      if(0 == n_threads) { n_threads = static_cast<sUInt>(omp_get_max_threads()); }
+#endif
+      if(0 == n_threads) { n_threads = 1; }
+
+      // Re-initializing : Drop the old workspaces.
+      for(size_t i=0; i<ws_.size(); ++i)
+      { delete ws_[i].gc_model_;  }
+      ws_.clear();
+      ops_.clear();
+      n_rows_ = 0;
+
+      dynamics_ = arg_dynamics;
+      dof_ = arg_robot.dof_;
+
+      // Only use sane limits (some specs leave them at zero)
+      flag_limits_ = (static_cast<sUInt>(arg_robot.gc_pos_limit_max_.rows()) == dof_) &&
+          (static_cast<sUInt>(arg_robot.gc_pos_limit_min_.rows()) == dof_) &&
+          ((arg_robot.gc_pos_limit_max_ - arg_robot.gc_pos_limit_min_).minCoeff() > 0.0);
+      if(flag_limits_)
+      {
+        gc_limit_max_ = arg_robot.gc_pos_limit_max_;
+        gc_limit_min_ = arg_robot.gc_pos_limit_min_;
+      }
+
+      ws_.resize(n_threads);
+      for(sUInt i=0; i<n_threads; ++i)
+      {
+        ws_[i].gc_model_ = new SGcModel();
+        if(false == ws_[i].gc_model_->init(arg_robot))
+        { throw(std::runtime_error("Could not initialize a workspace's gc model.")); }
+        if(false == initWorkspace(ws_[i]))
+        { throw(std::runtime_error("Could not initialize a workspace.")); }
+      }
+
+      has_been_init_ = true;
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCInverseKinematicsScl::init() : "<<e.what();
+      has_been_init_ = false;
+    }
+    return has_been_init_;
+  }
+
+  sBool CInverseKinematicsScl::addOpPoint(const std::string& arg_link_name,
+      const Eigen::Vector3d& arg_pos_in_parent,
+      const sBool arg_use_ori)
+  {
+    try
+    {
+      if(false == has_been_init_)
+      { throw(std::runtime_error("Not initialized.")); }
+      if(S_NULL == ws_[0].gc_model_->rbdyn_tree_.at_const(arg_link_name))
+      { throw(std::runtime_error(std::string("Could not find link : ")+arg_link_name)); }
+
+      SIkOpPoint op;
+      op.link_name_ = arg_link_name;
+      op.pos_in_parent_ = arg_pos_in_parent;
+      op.use_ori_ = arg_use_ori;
+      ops_.push_back(op);
+      n_rows_ += arg_use_ori ? 6 : 3;
+
+      for(size_t i=0; i<ws_.size(); ++i)
+      {
+        if(false == initWorkspace(ws_[i]))
+        { throw(std::runtime_error("Could not update a workspace.")); }
+      }
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCInverseKinematicsScl::addOpPoint() : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+
+  sBool CInverseKinematicsScl::initWorkspace(SIkWorkspace& arg_ws)
+  {
+    arg_ws.chain_.clear();
+    arg_ws.chain_parent_.clear();
+    arg_ws.op_links_.clear();
+
+    for(size_t k=0; k<ops_.size(); ++k)
+    {
+      SRigidBodyDyn* lnk = arg_ws.gc_model_->rbdyn_tree_.at(ops_[k].link_name_);
+      if(S_NULL == lnk) { return false; }
+      arg_ws.op_links_.push_back(lnk);
+
+      // Collect the ancestors that aren't in the chain yet..
+      std::vector<SRigidBodyDyn*> path;
+      for(SRigidBodyDyn* rbd = lnk; S_NULL != rbd; rbd = rbd->parent_addr_)
+      {
+        if(arg_ws.chain_.end() != std::find(arg_ws.chain_.begin(), arg_ws.chain_.end(), rbd))
+        { break; }
+        path.push_back(rbd);
+      }
+      // ..and append them parents first.
+      for(std::vector<SRigidBodyDyn*>::reverse_iterator it = path.rbegin(); it != path.rend(); ++it)
+      { arg_ws.chain_.push_back(*it); }
+    }
+
+    // Index the parents (always earlier in the chain)
+    for(size_t i=0; i<arg_ws.chain_.size(); ++i)
+    {
+      int idx = -1;
+      for(size_t j=0; j<i; ++j)
+      { if(arg_ws.chain_[j] == arg_ws.chain_[i]->parent_addr_) { idx = static_cast<int>(j); break; } }
+      arg_ws.chain_parent_.push_back(idx);
+    }
+    arg_ws.chain_dirty_.assign(arg_ws.chain_.size(), 1);
+    arg_ws.flag_chain_reset_ = true;
+
+    arg_ws.J_.setZero(n_rows_, dof_);
+    arg_ws.J_6_.setZero(6, dof_);
+    arg_ws.JJt_.setZero(n_rows_, n_rows_);
+    arg_ws.e_.setZero(n_rows_);
+    arg_ws.e_try_.setZero(n_rows_);
+    arg_ws.tmp_.setZero(n_rows_);
+    arg_ws.q_.setZero(dof_);
+    arg_ws.q_try_.setZero(dof_);
+    arg_ws.dq_.setZero(dof_);
+    arg_ws.ldlt_ = Eigen::LDLT<Eigen::MatrixXd>(n_rows_);
+    return true;
+  }
+
+  void CInverseKinematicsScl::updateChain(SIkWorkspace& arg_ws,
+      const Eigen::VectorXd& arg_q) const
+  {
+    const size_t n = arg_ws.chain_.size();
+    for(size_t i=0; i<n; ++i)
+    {
+      SRigidBodyDyn* rbd = arg_ws.chain_[i];
+      const int p = arg_ws.chain_parent_[i];
+
+      // Only recomputes the local transform if the link's gc changed.
+      const sFloat q_old = rbd->q_T_;
+      dynamics_->computeTransform(*rbd, arg_q);
+
+      // NOTE : NaN != NaN, so a link that was never computed is dirty.
+      bool dirty = arg_ws.flag_chain_reset_ || (q_old != rbd->q_T_) ||
+          (p >= 0 && arg_ws.chain_dirty_[p]);
+      arg_ws.chain_dirty_[i] = dirty;
+      if(false == dirty) { continue; }
+
+      if(p >= 0)
+      { rbd->T_o_lnk_ = arg_ws.chain_[p]->T_o_lnk_ * rbd->T_lnk_; }
+      else if(S_NULL != rbd->parent_addr_)
+      { rbd->T_o_lnk_ = rbd->parent_addr_->T_o_lnk_ * rbd->T_lnk_; }
+      else
+      { rbd->T_o_lnk_ = rbd->T_lnk_; }
+    }
+    arg_ws.flag_chain_reset_ = false;
+  }
+
+  sFloat CInverseKinematicsScl::computeError(SIkWorkspace& arg_ws,
+      const SIkTarget& arg_target, const Eigen::VectorXd& arg_q,
+      Eigen::VectorXd& ret_e, sFloat& ret_err_pos, sFloat& ret_err_ori) const
+  {
+    updateChain(arg_ws, arg_q);
+
+    ret_err_pos = 0.0; ret_err_ori = 0.0;
+    sUInt row = 0;
+    for(size_t k=0; k<ops_.size(); ++k)
+    {
+      const Eigen::Affine3d& T = arg_ws.op_links_[k]->T_o_lnk_;
+      ret_e.segment<3>(row) = arg_target.pos_[k] - T * ops_[k].pos_in_parent_;
+      ret_err_pos = std::max(ret_err_pos, ret_e.segment<3>(row).norm());
+      row += 3;
+
+      if(ops_[k].use_ori_)
+      {
+        // The rotation that takes the link's frame to the goal (in global coords).
+        // NOTE : linear() is the rotation here (rotation() would do a polar decomposition).
+        Eigen::AngleAxisd aa(arg_target.ori_[k] * T.linear().transpose());
+        ret_e.segment<3>(row) = (opt_.ori_weight_ * aa.angle()) * aa.axis();
+        ret_err_ori = std::max(ret_err_ori, std::fabs(aa.angle()));
+        row += 3;
+      }
+    }
+    return ret_e.squaredNorm();
+  }
+
+  sBool CInverseKinematicsScl::computeJacobian(SIkWorkspace& arg_ws,
+      const Eigen::VectorXd& arg_q) const
+  {
+    updateChain(arg_ws, arg_q);
+
+    bool flag = true;
+    sUInt row = 0;
+    for(size_t k=0; k<ops_.size(); ++k)
+    {
+      flag = flag && dynamics_->computeJacobian(arg_ws.J_6_, *arg_ws.op_links_[k],
+          arg_q, ops_[k].pos_in_parent_);
+      arg_ws.J_.block(row,0,3,dof_) = arg_ws.J_6_.topRows<3>();
+      row += 3;
+      if(ops_[k].use_ori_)
+      {
+        arg_ws.J_.block(row,0,3,dof_) = opt_.ori_weight_ * arg_ws.J_6_.bottomRows<3>();
+        row += 3;
+      }
+    }
+    return flag;
+  }
+
+  void CInverseKinematicsScl::clampToLimits(Eigen::VectorXd& arg_q) const
+  {
+    if(flag_limits_ && opt_.flag_clamp_gc_limits_)
+    { arg_q = arg_q.cwiseMax(gc_limit_min_).cwiseMin(gc_limit_max_); }
+  }
+
+  sBool CInverseKinematicsScl::checkTarget(const SIkTarget& arg_target) const
+  {
+    if(arg_target.pos_.size() != ops_.size()) { return false; }
+    for(size_t k=0; k<ops_.size(); ++k)
+    { if(ops_[k].use_ori_ && arg_target.ori_.size() <= k) { return false; } }
+    return true;
+  }
+
+  sBool CInverseKinematicsScl::solveWs(SIkWorkspace& arg_ws,
+      const SIkTarget& arg_target, const Eigen::VectorXd& arg_seed,
+      Eigen::VectorXd& ret_q, SIkStats& ret_stats) const
+  {
+    SIkWorkspace& w = arg_ws;
+    sFloat err_pos, err_ori, err_pos_try, err_ori_try;
+    sFloat lambda = opt_.damping_;
+
+    w.q_ = arg_seed;
+    clampToLimits(w.q_);
+    sFloat err = computeError(w, arg_target, w.q_, w.e_, err_pos, err_ori);
+
+    ret_stats.iterations_ = 0;
+    ret_stats.converged_ = false;
+    while(ret_stats.iterations_ < opt_.max_iters_)
+    {
+      if(err_pos <= opt_.tol_pos_ && err_ori <= opt_.tol_ori_)
+      { ret_stats.converged_ = true; break; }
+      ret_stats.iterations_++;
+
+      if(false == computeJacobian(w, w.q_)) { break; }
+
+      // dq = J' (J J' + lambda^2 I)^-1 e
+      w.JJt_.noalias() = w.J_ * w.J_.transpose();
+      w.JJt_.diagonal().array() += lambda*lambda;
+      w.ldlt_.compute(w.JJt_);
+      w.tmp_ = w.ldlt_.solve(w.e_);
+      w.dq_.noalias() = w.J_.transpose() * w.tmp_;
+
+      const sFloat step = w.dq_.cwiseAbs().maxCoeff();
+      if(step > opt_.max_step_) { w.dq_ *= opt_.max_step_ / step; }
+
+      w.q_try_ = w.q_ + w.dq_;
+      clampToLimits(w.q_try_);
+      const sFloat err_try = computeError(w, arg_target, w.q_try_, w.e_try_,
+          err_pos_try, err_ori_try);
+
+      if(err_try < err)
+      {// Accept the step and trust the linearization a bit more
+        w.q_.swap(w.q_try_);
+        w.e_.swap(w.e_try_);
+        err = err_try; err_pos = err_pos_try; err_ori = err_ori_try;
+        lambda = std::max(0.5*lambda, opt_.damping_min_);
+      }
+      else
+      {// Reject the step and damp more. Stuck if it can't damp any more.
+        if(lambda >= opt_.damping_max_) { break; }
+        lambda = std::min(4.0*lambda, opt_.damping_max_);
+      }
+    }
+    if(err_pos <= opt_.tol_pos_ && err_ori <= opt_.tol_ori_)
+    { ret_stats.converged_ = true; }
+
+    ret_q = w.q_;
+    ret_stats.err_pos_ = err_pos;
+    ret_stats.err_ori_ = err_ori;
+    return ret_stats.converged_;
+  }
+
+  sBool CInverseKinematicsScl::solve(const SIkTarget& arg_target,
+      const Eigen::VectorXd& arg_seed,
+      Eigen::VectorXd& ret_q,
+      SIkStats& ret_stats)
+  {
+    try
+    {
+      if(false == has_been_init_)
+      { throw(std::runtime_error("Not initialized.")); }
+      if(0 == ops_.size())
+      { throw(std::runtime_error("No op points. Add some first.")); }
+      if(static_cast<sUInt>(arg_seed.rows()) != dof_)
+      { throw(std::runtime_error("Seed size doesn't match the robot's dof.")); }
+      if(false == checkTarget(arg_target))
+      { throw(std::runtime_error("Target doesn't match the op points.")); }
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCInverseKinematicsScl::solve() : "<<e.what();
+      return false;
+    }
+    return solveWs(ws_[0], arg_target, arg_seed, ret_q, ret_stats);
+  }
+
+  sBool CInverseKinematicsScl::solveBatch(const std::vector<SIkTarget>& arg_targets,
+      const std::vector<Eigen::VectorXd>& arg_seeds,
+      std::vector<Eigen::VectorXd>& ret_q,
+      std::vector<SIkStats>& ret_stats)
+  {
+    const int n = static_cast<int>(arg_targets.size());
+    try
+    {
+      if(false == has_been_init_)
+      { throw(std::runtime_error("Not initialized.")); }
+      if(0 == ops_.size())
+      { throw(std::runtime_error("No op points. Add some first.")); }
+      if(1 != arg_seeds.size() && arg_seeds.size() != arg_targets.size())
+      { throw(std::runtime_error("Pass one seed, or one per target.")); }
+      for(size_t i=0; i<arg_seeds.size(); ++i)
+      {
+        if(static_cast<sUInt>(arg_seeds[i].rows()) != dof_)
+        { throw(std::runtime_error("Seed size doesn't match the robot's dof.")); }
+      }
+      for(int i=0; i<n; ++i)
+      {
+        if(false == checkTarget(arg_targets[i]))
+        { throw(std::runtime_error("A target doesn't match the op points.")); }
+      }
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCInverseKinematicsScl::solveBatch() : "<<e.what();
+      return false;
+    }
+
+    // Size the outputs here so the threads don't allocate
+    ret_q.resize(n);
+    ret_stats.resize(n);
+    for(int i=0; i<n; ++i) { ret_q[i].setZero(dof_); }
+
+    const bool one_seed = (1 == arg_seeds.size());
+    int n_failed = 0;
+
+#ifdef _OPENMP
+    const int n_threads = static_cast<int>(ws_.size());
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads) reduction(+:n_failed) if(n > 1)
+#endif
+    for(int i=0; i<n; ++i)
+    {
+#ifdef _OPENMP
+      SIkWorkspace& w = ws_[omp_get_thread_num()];
+#else
+      SIkWorkspace& w = ws_[0];
+#endif
+      if(false == solveWs(w, arg_targets[i], one_seed ? arg_seeds[0] : arg_seeds[i],
+          ret_q[i], ret_stats[i]))
+      { n_failed++; }
+    }
+    return (0 == n_failed);
+  }
+
+  sBool CInverseKinematicsScl::computeOpPoints(const Eigen::VectorXd& arg_q,
+      SIkTarget& ret_x)
+  {
+    if(false == has_been_init_ || static_cast<sUInt>(arg_q.rows()) != dof_)
+    { return false; }
+
+    SIkWorkspace& w = ws_[0];
+    updateChain(w, arg_q);
+
+    ret_x.pos_.resize(ops_.size());
+    ret_x.ori_.resize(ops_.size());
+    for(size_t k=0; k<ops_.size(); ++k)
+    {
+      const Eigen::Affine3d& T = w.op_links_[k]->T_o_lnk_;
+      ret_x.pos_[k] = T * ops_[k].pos_in_parent_;
+      ret_x.ori_[k] = T.linear();
+    }
+    return true;
+  }
+}
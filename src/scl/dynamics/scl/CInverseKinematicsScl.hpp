@@ -0,0 +1,228 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CInverseKinematicsScl.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CINVERSEKINEMATICSSCL_HPP_
+#define CINVERSEKINEMATICSSCL_HPP_
+
+#include <scl/DataTypes.hpp>
+#include <scl/data_structs/SRobotParsed.hpp>
+#include <scl/data_structs/SGcModel.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+
+#include <Eigen/Dense>
+
+#include <string>
+#include <vector>
+
+namespace scl
+{
+  /** An ik goal : One position (and orientation, for op points that
+   * track it) per op point, in the order the op points were added.
+   * All in global coordinates. */
+  struct SIkTarget
+  {
+    std::vector<Eigen::Vector3d> pos_;
+    std::vector<Eigen::Matrix3d> ori_;
+  };
+
+  /** How an ik solve went */
+  struct SIkStats
+  {
+    /** Number of damped least squares steps taken */
+    sUInt iterations_ = 0;
+    /** The largest op point position (m) and orientation (rad) errors */
+    sFloat err_pos_ = 0.0, err_ori_ = 0.0;
+    /** Whether both errors are within the tolerances */
+    sBool converged_ = false;
+  };
+
+  /** Solver settings */
+  struct SIkOptions
+  {
+    sUInt max_iters_ = 100;
+    /** Convergence tolerances (m and rad) */
+    sFloat tol_pos_ = 1e-5, tol_ori_ = 1e-4;
+    /** Damping (lambda). Adapted between the min and max : Halved after
+     * every step that reduces the error, and a step that doesn't is
+     * rejected and retried with 4x the damping. */
+    sFloat damping_ = 0.05, damping_min_ = 1e-6, damping_max_ = 1e3;
+    /** The largest change in any gc in one step */
+    sFloat max_step_ = 0.2;
+    /** Weighs the orientation errors relative to the position errors (rad vs. m) */
+    sFloat ori_weight_ = 0.5;
+    /** Clamps the gcs to the robot's gc position limits (if it has any) */
+    sBool flag_clamp_gc_limits_ = true;
+  };
+
+  /** A damped least squares inverse kinematics solver built on the
+   * scl dynamics engine's transforms and Jacobians.
+   *
+   *   dq = J' (J J' + lambda^2 I)^-1 e
+   *
+   * J stacks the op point Jacobians (3 rows per op point, 6 if it tracks
+   * orientation) and e the op point errors.
+   *
+   * Each iteration only updates the transforms of the links between the
+   * root and the op points, and reuses a link's transforms when its gc
+   * (or an ancestor's) hasn't changed.
+   *
+   * Usage :
+   *   init(robot, dynamics)  // Once
+   *   addOpPoint(...)        // Once per op point
+   *   solve(...)             // Or solveBatch(...) for many goals in parallel
+   *
+   * NOTE : solveBatch() solves on all the threads given to init(). Each
+   *        thread gets its own gc model (link transforms) and matrices,
+   *        so a solve doesn't allocate or share anything. Don't call
+   *        solve() and solveBatch() at the same time. */
+  class CInverseKinematicsScl
+  {
+  public:
+    /** Sets up the solver for a robot. Creates one workspace per thread
+     * (0 threads : as many as OpenMP will run). */
+    sBool init(const SRobotParsed& arg_robot,
+        CDynamicsScl* arg_dynamics,
+        const sUInt arg_threads=0);
+
+    /** Adds an op point : A position on a link (in link coordinates)
+     * and, optionally, the link's orientation. */
+    sBool addOpPoint(const std::string& arg_link_name,
+        const Eigen::Vector3d& arg_pos_in_parent,
+        const sBool arg_use_ori=false);
+
+    /** Solves for a single target starting at (warm starting from) the seed */
+    sBool solve(const SIkTarget& arg_target,
+        const Eigen::VectorXd& arg_seed,
+        Eigen::VectorXd& ret_q,
+        SIkStats& ret_stats);
+
+    /** Solves for many targets in parallel. Pass one seed (used for all
+     * the targets) or one per target. Returns false if any target
+     * failed to converge (see the stats). */
+    sBool solveBatch(const std::vector<SIkTarget>& arg_targets,
+        const std::vector<Eigen::VectorXd>& arg_seeds,
+        std::vector<Eigen::VectorXd>& ret_q,
+        std::vector<SIkStats>& ret_stats);
+
+    /** Computes the op point positions and orientations at a given q.
+     * Useful to build targets (eg. from sampled configurations). */
+    sBool computeOpPoints(const Eigen::VectorXd& arg_q, SIkTarget& ret_x);
+
+    SIkOptions& getOptions() { return opt_; }
+    const SIkOptions& getOptions() const { return opt_; }
+
+    sUInt getNumOpPoints() const { return static_cast<sUInt>(ops_.size()); }
+    sUInt getNumThreads() const { return static_cast<sUInt>(ws_.size()); }
+
+    sBool hasBeenInit() const { return has_been_init_; }
+
+    CInverseKinematicsScl() : dynamics_(S_NULL), dof_(0), n_rows_(0),
+        flag_limits_(false), has_been_init_(false) {}
+    ~CInverseKinematicsScl();
+
+  private:
+    /** Not copyable (owns the workspaces' gc models) */
+    CInverseKinematicsScl(const CInverseKinematicsScl&);
+    CInverseKinematicsScl& operator=(const CInverseKinematicsScl&);
+
+    /** An op point */
+    struct SIkOpPoint
+    {
+      std::string link_name_;
+      Eigen::Vector3d pos_in_parent_;
+      sBool use_ori_;
+    };
+
+    /** A thread's scratch space */
+    struct SIkWorkspace
+    {
+      /** Holds this thread's link transforms */
+      SGcModel* gc_model_;
+      /** The links from the root to all the op points (parents first) */
+      std::vector<SRigidBodyDyn*> chain_;
+      /** Each chain link's parent's index in the chain (-1 for none) */
+      std::vector<int> chain_parent_;
+      /** Whether a chain link's origin transform changed in this update */
+      std::vector<char> chain_dirty_;
+      /** Forces a full update (after the chain changes) */
+      sBool flag_chain_reset_;
+      /** The op point links */
+      std::vector<SRigidBodyDyn*> op_links_;
+      Eigen::MatrixXd J_, J_6_, JJt_;
+      Eigen::VectorXd e_, e_try_, q_, q_try_, dq_, tmp_;
+      Eigen::LDLT<Eigen::MatrixXd> ldlt_;
+      SIkWorkspace() : gc_model_(S_NULL), flag_chain_reset_(true) {}
+    };
+
+    /** Sets up a workspace's chain and matrices for the op points */
+    sBool initWorkspace(SIkWorkspace& arg_ws);
+
+    /** Checks the sizes of a target */
+    sBool checkTarget(const SIkTarget& arg_target) const;
+
+    /** The solver (allocation free). Assumes the inputs were checked. */
+    sBool solveWs(SIkWorkspace& arg_ws, const SIkTarget& arg_target,
+        const Eigen::VectorXd& arg_seed, Eigen::VectorXd& ret_q,
+        SIkStats& ret_stats) const;
+
+    /** Updates the chain's transforms for a q */
+    void updateChain(SIkWorkspace& arg_ws, const Eigen::VectorXd& arg_q) const;
+
+    /** Updates the transforms and computes the weighted error (into
+     * ret_e). Returns its squared norm. */
+    sFloat computeError(SIkWorkspace& arg_ws, const SIkTarget& arg_target,
+        const Eigen::VectorXd& arg_q, Eigen::VectorXd& ret_e,
+        sFloat& ret_err_pos, sFloat& ret_err_ori) const;
+
+    /** Updates the transforms and stacks the op point Jacobians */
+    sBool computeJacobian(SIkWorkspace& arg_ws, const Eigen::VectorXd& arg_q) const;
+
+    /** Clamps q to the gc limits (if enabled) */
+    void clampToLimits(Eigen::VectorXd& arg_q) const;
+
+    const CDynamicsScl* dynamics_;
+    sUInt dof_;
+    /** Rows in the stacked Jacobian */
+    sUInt n_rows_;
+
+    std::vector<SIkOpPoint> ops_;
+    std::vector<SIkWorkspace> ws_;
+
+    Eigen::VectorXd gc_limit_max_, gc_limit_min_;
+    sBool flag_limits_;
+
+    SIkOptions opt_;
+
+    sBool has_been_init_;
+  };
+}
+
+#endif /* CINVERSEKINEMATICSSCL_HPP_ */
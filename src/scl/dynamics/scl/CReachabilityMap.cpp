@@ -0,0 +1,498 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CReachabilityMap.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include <scl/dynamics/scl/CReachabilityMap.hpp>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <random>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace scl
+{
+  namespace
+  {
+    struct SReachHeader
+    {
+      char magic_[8];
+      std::uint32_t header_bytes_, nx_, ny_, nz_, flags_, reserved_;
+      std::uint64_t n_samples_;
+      double origin_[3];
+      double voxel_size_;
+      double manip_max_;
+      char link_name_[48];
+    };
+
+    static_assert(sizeof(SReachHeader) == SCL_REACH_HEADER_BYTES, "Reachability header size changed");
+    static_assert(sizeof(SReachabilityVoxel) == 16, "Reachability voxel size changed");
+
+    /** Samples per chunk (each chunk has its own random number generator) */
+    const sLongLong SCL_REACH_CHUNK = 1024;
+
+    /** The largest grid we'll allocate (voxels) */
+    const std::size_t SCL_REACH_MAX_VOXELS = static_cast<std::size_t>(1)<<30;
+
+    template <typename T>
+    void atomicMax(std::atomic<T>& arg_a, const T arg_val)
+    {
+      T old = arg_a.load(std::memory_order_relaxed);
+      while(old < arg_val && !arg_a.compare_exchange_weak(old, arg_val, std::memory_order_relaxed)) {}
+    }
+
+    void atomicAdd(std::atomic<double>& arg_a, const double arg_val)
+    {
+      double old = arg_a.load(std::memory_order_relaxed);
+      while(!arg_a.compare_exchange_weak(old, old + arg_val, std::memory_order_relaxed)) {}
+    }
+  }
+
+  /* *******************************************************************
+   *                      CReachabilityMap
+   * ******************************************************************* */
+  void CReachabilityMap::close()
+  {
+    if(S_NULL != map_) { munmap(map_, map_size_); }
+    map_ = S_NULL; map_size_ = 0;
+    voxels_ = S_NULL; nx_ = 0; ny_ = 0; nz_ = 0; n_samples_ = 0;
+    origin_.setZero(); voxel_size_ = 0; voxel_size_inv_ = 0; manip_max_ = 0;
+    link_name_ = "";
+  }
+
+  sBool CReachabilityMap::open(const std::string& arg_file)
+  {
+    int fd = -1;
+    try
+    {
+      close();
+
+      fd = ::open(arg_file.c_str(), O_RDONLY);
+      if(0 > fd) { throw(std::runtime_error("Could not open file")); }
+      struct stat st;
+      if(0 != fstat(fd, &st)) { throw(std::runtime_error("Could not stat file")); }
+      if(static_cast<std::size_t>(st.st_size) < SCL_REACH_HEADER_BYTES)
+      { throw(std::runtime_error("File too small for a reachability map header")); }
+
+      map_size_ = static_cast<std::size_t>(st.st_size);
+      map_ = mmap(S_NULL, map_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd); fd = -1;
+      if(MAP_FAILED == map_) { map_ = S_NULL; throw(std::runtime_error("Could not mmap file")); }
+
+      SReachHeader h;
+      std::memcpy(&h, map_, sizeof(h));
+      if(0 != std::memcmp(h.magic_, SCL_REACH_MAGIC, 8))
+      { throw(std::runtime_error("Not a reachability map (or a different version)")); }
+      if(h.header_bytes_ < sizeof(h) || 0 != h.header_bytes_ % sizeof(SReachabilityVoxel) ||
+          0 == h.nx_ || 0 == h.ny_ || 0 == h.nz_ || !(h.voxel_size_ > 0))
+      { throw(std::runtime_error("Corrupt reachability map header")); }
+
+      nx_ = h.nx_; ny_ = h.ny_; nz_ = h.nz_;
+      if(h.header_bytes_ + nx_*ny_*nz_*sizeof(SReachabilityVoxel) > map_size_)
+      { throw(std::runtime_error("Reachability map is truncated")); }
+
+      origin_ = Eigen::Vector3d(h.origin_[0], h.origin_[1], h.origin_[2]);
+      voxel_size_ = h.voxel_size_;
+      voxel_size_inv_ = 1.0/voxel_size_;
+      manip_max_ = h.manip_max_;
+      n_samples_ = static_cast<sLongLong>(h.n_samples_);
+      h.link_name_[sizeof(h.link_name_)-1] = '\0';
+      link_name_ = h.link_name_;
+      voxels_ = reinterpret_cast<const SReachabilityVoxel*>(
+          static_cast<const char*>(map_) + h.header_bytes_);
+
+      // Controllers query it at arbitrary points.
+      madvise(map_, map_size_, MADV_RANDOM);
+    }
+    catch(std::exception& e)
+    {
+      if(0 <= fd) { ::close(fd); }
+      close();
+      std::cerr<<"\nCReachabilityMap::open("<<arg_file<<") : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+
+  /* *******************************************************************
+   *                      CReachabilityMapBuilder
+   * ******************************************************************* */
+  CReachabilityMapBuilder::~CReachabilityMapBuilder()
+  {
+    for(size_t i=0; i<ws_.size(); ++i)
+    { delete ws_[i].gc_model_;  }
+  }
+
+  sBool CReachabilityMapBuilder::init(const SRobotParsed& arg_robot,
+      CDynamicsScl* arg_dynamics,
+      const std::string& arg_link_name,
+      const Eigen::Vector3d& arg_pos_in_parent,
+      const sUInt arg_threads)
+  {
+    try
+    {
+      has_been_init_ = false;
+      if(S_NULL == arg_dynamics)
+      { throw(std::runtime_error("Passed NULL dynamics object.")); }
+      if(false == arg_dynamics->hasBeenInit())
+      { throw(std::runtime_error("Passed an uninitialized dynamics object.")); }
+      if(0 >= arg_robot.dof_)
+      { throw(std::runtime_error("Can not map a robot with 0 dof.")); }
+      if(arg_link_name.size() >= 48)
+      { throw(std::runtime_error("Link name too long (max 47 chars).")); }
+
+      sUInt n_threads = arg_threads;
+#ifdef _OPENMP
+      if(0 == n_threads) { n_threads = static_cast<sUInt>(omp_get_max_threads()); }
+#endif
+      if(0 == n_threads) { n_threads = 1; }
+
+      for(size_t i=0; i<ws_.size(); ++i)
+      { delete ws_[i].gc_model_;  }
+      ws_.clear();
+
+      dynamics_ = arg_dynamics;
+      dof_ = arg_robot.dof_;
+      link_name_ = arg_link_name;
+      pos_in_parent_ = arg_pos_in_parent;
+
+      ws_.resize(n_threads);
+      for(sUInt i=0; i<n_threads; ++i)
+      {
+        SReachWorkspace& w = ws_[i];
+        w.gc_model_ = new SGcModel();
+        if(false == w.gc_model_->init(arg_robot))
+        { throw(std::runtime_error("Could not initialize a workspace's gc model.")); }
+
+        SRigidBodyDyn* lnk = w.gc_model_->rbdyn_tree_.at(arg_link_name);
+        if(S_NULL == lnk)
+        { throw(std::runtime_error(std::string("Could not find link : ")+arg_link_name)); }
+        for(SRigidBodyDyn* rbd = lnk; S_NULL != rbd; rbd = rbd->parent_addr_)
+        { w.chain_.insert(w.chain_.begin(), rbd); }
+
+        w.q_.setZero(dof_);
+        w.J_.setZero(6, dof_);
+      }
+
+      // The gcs that move the op point, and their limits ([-pi,pi] if the
+      // robot doesn't have sane ones).
+      const bool has_limits = (static_cast<sUInt>(arg_robot.gc_pos_limit_max_.rows()) == dof_) &&
+          (static_cast<sUInt>(arg_robot.gc_pos_limit_min_.rows()) == dof_);
+      chain_gcs_.clear();
+      gc_min_.setZero(dof_); gc_max_.setZero(dof_);
+      for(size_t i=0; i<ws_[0].chain_.size(); ++i)
+      {
+        const SRigidBody* lnk = ws_[0].chain_[i]->link_ds_;
+        if(lnk->is_root_ || 0 > lnk->link_id_) { continue; }
+        const sUInt g = static_cast<sUInt>(lnk->link_id_);
+        chain_gcs_.push_back(g);
+        if(has_limits && arg_robot.gc_pos_limit_max_(g) > arg_robot.gc_pos_limit_min_(g))
+        { gc_min_(g) = arg_robot.gc_pos_limit_min_(g); gc_max_(g) = arg_robot.gc_pos_limit_max_(g); }
+        else
+        { gc_min_(g) = -M_PI; gc_max_(g) = M_PI; }
+      }
+      if(chain_gcs_.empty())
+      { throw(std::runtime_error("No gcs move the op point.")); }
+
+      // Bound the reach : A ball around the first joint (which doesn't move
+      // with any sampled gc) that covers the rest of the chain.
+      SReachWorkspace& w = ws_[0];
+      w.q_.setZero(dof_);
+      sFloat radius = pos_in_parent_.norm();
+      Eigen::Vector3d center(0,0,0);
+      bool found_first = false;
+      for(size_t i=0; i<w.chain_.size(); ++i)
+      {
+        SRigidBodyDyn* rbd = w.chain_[i];
+        dynamics_->computeTransform(*rbd, w.q_);
+        if(S_NULL != rbd->parent_addr_) { rbd->T_o_lnk_ = rbd->parent_addr_->T_o_lnk_ * rbd->T_lnk_; }
+        else { rbd->T_o_lnk_ = rbd->T_lnk_; }
+
+        const SRigidBody* lnk = rbd->link_ds_;
+        if(lnk->is_root_ || 0 > lnk->link_id_) { continue; }
+        if(false == found_first)
+        { center = rbd->T_o_lnk_.translation(); found_first = true; }
+        else
+        { radius += lnk->pos_in_parent_.norm(); }
+
+        if(JOINT_TYPE_PRISMATIC_X == lnk->joint_type_ || JOINT_TYPE_PRISMATIC_Y == lnk->joint_type_ ||
+            JOINT_TYPE_PRISMATIC_Z == lnk->joint_type_)
+        { radius += std::max(std::fabs(gc_min_(lnk->link_id_)), std::fabs(gc_max_(lnk->link_id_))); }
+      }
+      radius = 1.05*radius + 0.02;
+
+      has_been_init_ = true;
+      if(false == setGrid(center.array() - radius, center.array() + radius, 0.02))
+      { throw(std::runtime_error("Could not set up the default grid.")); }
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCReachabilityMapBuilder::init() : "<<e.what();
+      has_been_init_ = false;
+    }
+    return has_been_init_;
+  }
+
+  sBool CReachabilityMapBuilder::setGrid(const Eigen::Vector3d& arg_min,
+      const Eigen::Vector3d& arg_max, const sFloat arg_voxel_size)
+  {
+    try
+    {
+      if(false == has_been_init_)
+      { throw(std::runtime_error("Not initialized.")); }
+      if(!(arg_voxel_size > 0))
+      { throw(std::runtime_error("Voxel size must be positive.")); }
+      if(!((arg_max - arg_min).minCoeff() > 0))
+      { throw(std::runtime_error("Grid max must be larger than min.")); }
+
+      const Eigen::Vector3d n = ((arg_max - arg_min) / arg_voxel_size).array().ceil();
+      if(n.prod() > static_cast<double>(SCL_REACH_MAX_VOXELS))
+      { throw(std::runtime_error("Too many voxels. Use a larger voxel size.")); }
+
+      grid_min_ = arg_min;
+      voxel_size_ = arg_voxel_size;
+      nx_ = static_cast<sUInt>(n(0)); ny_ = static_cast<sUInt>(n(1)); nz_ = static_cast<sUInt>(n(2));
+
+      const std::size_t n_vox = static_cast<std::size_t>(nx_)*ny_*nz_;
+      std::vector<std::atomic<std::uint32_t> >(n_vox).swap(count_);
+      std::vector<std::atomic<float> >(n_vox).swap(manip_max_);
+      std::vector<std::atomic<float> >(n_vox).swap(cond_inv_max_);
+      std::vector<std::atomic<double> >(n_vox).swap(manip_sum_);
+      clear();
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCReachabilityMapBuilder::setGrid() : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+
+  void CReachabilityMapBuilder::clear()
+  {
+    // NOTE : Atomics aren't zeroed by their default constructor.
+    for(size_t i=0; i<count_.size(); ++i)
+    {
+      count_[i].store(0, std::memory_order_relaxed);
+      manip_max_[i].store(0.0f, std::memory_order_relaxed);
+      cond_inv_max_[i].store(0.0f, std::memory_order_relaxed);
+      manip_sum_[i].store(0.0, std::memory_order_relaxed);
+    }
+    n_samples_ = 0;
+    n_outside_ = 0;
+    flags_ = 0;
+  }
+
+  sBool CReachabilityMapBuilder::addSample(SReachWorkspace& arg_ws)
+  {
+    const Eigen::VectorXd& q = arg_ws.q_;
+    const size_t n = arg_ws.chain_.size();
+    for(size_t i=0; i<n; ++i)
+    {
+      SRigidBodyDyn* rbd = arg_ws.chain_[i];
+      dynamics_->computeTransform(*rbd, q);
+      if(S_NULL != rbd->parent_addr_) { rbd->T_o_lnk_ = rbd->parent_addr_->T_o_lnk_ * rbd->T_lnk_; }
+      else { rbd->T_o_lnk_ = rbd->T_lnk_; }
+    }
+    const SRigidBodyDyn& op = *arg_ws.chain_[n-1];
+
+    const Eigen::Vector3d idx = (op.T_o_lnk_ * pos_in_parent_ - grid_min_) / voxel_size_;
+    if(idx(0) < 0 || idx(1) < 0 || idx(2) < 0) { return false; }
+    const std::size_t ix = static_cast<std::size_t>(idx(0));
+    const std::size_t iy = static_cast<std::size_t>(idx(1));
+    const std::size_t iz = static_cast<std::size_t>(idx(2));
+    if(ix >= nx_ || iy >= ny_ || iz >= nz_) { return false; }
+    const std::size_t v = (iz*ny_ + iy)*nx_ + ix;
+
+    // The position Jacobian's singular values are the square roots of
+    // the eigenvalues of Jv Jv' (3x3; much cheaper than an svd).
+    dynamics_->computeJacobian(arg_ws.J_, op, q, pos_in_parent_);
+    Eigen::Matrix3d JJt;
+    JJt.noalias() = arg_ws.J_.topRows<3>() * arg_ws.J_.topRows<3>().transpose();
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> es;
+    es.computeDirect(JJt, Eigen::EigenvaluesOnly);
+    const Eigen::Vector3d s = es.eigenvalues().cwiseMax(0.0).cwiseSqrt(); //Ascending
+    const double manip = s(0)*s(1)*s(2);
+    const double cond_inv = (s(2) > 0) ? s(0)/s(2) : 0.0;
+
+    count_[v].fetch_add(1, std::memory_order_relaxed);
+    atomicAdd(manip_sum_[v], manip);
+    atomicMax(manip_max_[v], static_cast<float>(manip));
+    atomicMax(cond_inv_max_[v], static_cast<float>(cond_inv));
+    return true;
+  }
+
+  sBool CReachabilityMapBuilder::sample(const sLongLong arg_n_samples,
+      const sBool arg_stratified, const sUInt arg_seed)
+  {
+    try
+    {
+      if(false == has_been_init_)
+      { throw(std::runtime_error("Not initialized.")); }
+      if(0 >= arg_n_samples)
+      { throw(std::runtime_error("Need a positive number of samples.")); }
+
+      // Stratified : k cells per chain gc, with k^m <= n.
+      const sUInt m = static_cast<sUInt>(chain_gcs_.size());
+      sLongLong k = 1, n_total = arg_n_samples;
+      if(arg_stratified)
+      {
+        k = static_cast<sLongLong>(std::floor(std::pow(static_cast<double>(arg_n_samples), 1.0/m) + 1e-9));
+        if(1 > k) { k = 1; }
+        n_total = 1;
+        for(sUInt j=0; j<m; ++j) { n_total *= k; }
+        if(n_total > arg_n_samples) //Rounding
+        { k--; n_total = 1; for(sUInt j=0; j<m; ++j) { n_total *= k; } }
+        if(1 > k) { throw(std::runtime_error("Too few samples to stratify.")); }
+      }
+
+      const sLongLong n_chunks = (n_total + SCL_REACH_CHUNK - 1) / SCL_REACH_CHUNK;
+      const double k_inv = 1.0/static_cast<double>(k);
+      sLongLong n_out = 0;
+
+#ifdef _OPENMP
+      const int n_threads = static_cast<int>(ws_.size());
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads) reduction(+:n_out)
+#endif
+      for(sLongLong c=0; c<n_chunks; ++c)
+      {
+#ifdef _OPENMP
+        SReachWorkspace& w = ws_[omp_get_thread_num()];
+#else
+        SReachWorkspace& w = ws_[0];
+#endif
+        std::mt19937_64 rng(static_cast<std::uint64_t>(arg_seed) * 0x9E3779B97F4A7C15ULL +
+            static_cast<std::uint64_t>(c));
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+
+        const sLongLong i_end = std::min(n_total, (c+1)*SCL_REACH_CHUNK);
+        for(sLongLong i = c*SCL_REACH_CHUNK; i < i_end; ++i)
+        {
+          sLongLong cell = i;
+          for(sUInt j=0; j<m; ++j)
+          {
+            const sUInt g = chain_gcs_[j];
+            double frac;
+            if(arg_stratified)
+            { frac = (static_cast<double>(cell % k) + u(rng)) * k_inv; cell /= k; }
+            else
+            { frac = u(rng); }
+            w.q_(g) = gc_min_(g) + frac * (gc_max_(g) - gc_min_(g));
+          }
+          if(false == addSample(w)) { n_out++; }
+        }
+      }
+
+      n_samples_ += n_total;
+      n_outside_ += n_out;
+      if(arg_stratified) { flags_ |= 1; }
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCReachabilityMapBuilder::sample() : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+
+  sLongLong CReachabilityMapBuilder::getNumVoxelsReached() const
+  {
+    sLongLong n = 0;
+    for(size_t i=0; i<count_.size(); ++i)
+    { if(0 < count_[i].load(std::memory_order_relaxed)) { n++; } }
+    return n;
+  }
+
+  sBool CReachabilityMapBuilder::write(const std::string& arg_file) const
+  {
+    std::FILE* fp = S_NULL;
+    try
+    {
+      if(false == has_been_init_)
+      { throw(std::runtime_error("Not initialized.")); }
+
+      SReachHeader h;
+      std::memset(&h, 0, sizeof(h));
+      std::memcpy(h.magic_, SCL_REACH_MAGIC, 8);
+      h.header_bytes_ = SCL_REACH_HEADER_BYTES;
+      h.nx_ = nx_; h.ny_ = ny_; h.nz_ = nz_;
+      h.flags_ = flags_;
+      h.n_samples_ = static_cast<std::uint64_t>(n_samples_.load());
+      for(int i=0; i<3; ++i) { h.origin_[i] = grid_min_(i); }
+      h.voxel_size_ = voxel_size_;
+      std::strncpy(h.link_name_, link_name_.c_str(), sizeof(h.link_name_)-1);
+      for(size_t i=0; i<manip_max_.size(); ++i)
+      { h.manip_max_ = std::max(h.manip_max_, static_cast<double>(manip_max_[i].load())); }
+
+      fp = std::fopen(arg_file.c_str(), "wb");
+      if(S_NULL == fp) { throw(std::runtime_error("Could not open file")); }
+      if(1 != std::fwrite(&h, sizeof(h), 1, fp))
+      { throw(std::runtime_error("Could not write header")); }
+
+      // Write the voxels in blocks
+      std::vector<SReachabilityVoxel> buf(4096);
+      const std::size_t n_vox = count_.size();
+      for(std::size_t i0=0; i0<n_vox; i0+=buf.size())
+      {
+        const std::size_t n = std::min(buf.size(), n_vox - i0);
+        for(std::size_t i=0; i<n; ++i)
+        {
+          SReachabilityVoxel& v = buf[i];
+          v.count_ = count_[i0+i].load();
+          v.manip_max_ = manip_max_[i0+i].load();
+          v.manip_mean_ = (0 < v.count_) ? static_cast<float>(manip_sum_[i0+i].load() / v.count_) : 0.0f;
+          v.cond_inv_max_ = cond_inv_max_[i0+i].load();
+        }
+        if(n != std::fwrite(buf.data(), sizeof(SReachabilityVoxel), n, fp))
+        { throw(std::runtime_error("Could not write voxels")); }
+      }
+      const bool flag = (0 == std::fclose(fp));
+      fp = S_NULL;
+      if(false == flag) { throw(std::runtime_error("Could not close file")); }
+    }
+    catch(std::exception& e)
+    {
+      if(S_NULL != fp) { std::fclose(fp); }
+      std::cerr<<"\nCReachabilityMapBuilder::write("<<arg_file<<") : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+}
@@ -0,0 +1,272 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CReachabilityMap.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CREACHABILITYMAP_HPP_
+#define CREACHABILITYMAP_HPP_
+
+#include <scl/DataTypes.hpp>
+#include <scl/data_structs/SRobotParsed.hpp>
+#include <scl/data_structs/SGcModel.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+
+#include <Eigen/Dense>
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+/** The reachability map file's magic string (8 chars; the last two are the version) */
+#define SCL_REACH_MAGIC "SCLRCH01"
+/** The reachability map file's header size (bytes) */
+#define SCL_REACH_HEADER_BYTES 128
+
+namespace scl
+{
+  /** What the sampled configurations did in one voxel.
+   *
+   * Manipulability is computed from the singular values (s) of the op
+   * point's position Jacobian :
+   *   manip   = s0 * s1 * s2   (Yoshikawa's measure : the volume of the
+   *                             velocity ellipsoid)
+   *   cond_inv = s_min / s_max (1 : isotropic, 0 : singular) */
+  struct SReachabilityVoxel
+  {
+    /** The number of samples that landed in the voxel (0 : unreachable) */
+    std::uint32_t count_;
+    float manip_max_;
+    float manip_mean_;
+    float cond_inv_max_;
+  };
+
+  /** A read-only reachability map : A voxel grid over an op point's
+   * workspace. Files are memory mapped, and queries are O(1) and don't
+   * allocate, so controllers can use them in the servo loop.
+   *
+   * File format (native byte order, ie. little-endian on x86) :
+   *   Header : char magic[8] = SCL_REACH_MAGIC, uint32 header_bytes (128),
+   *            uint32 nx, ny, nz, uint32 flags (bit 0 : stratified sampling),
+   *            uint32 reserved, uint64 n_samples, float64 origin[3] (the
+   *            min corner), float64 voxel_size, float64 manip_max (over all
+   *            voxels), char link_name[48], zero padding up to header_bytes.
+   *   Voxels : nx*ny*nz x SReachabilityVoxel, x fastest, then y, then z.
+   *
+   * Build maps with CReachabilityMapBuilder (or the scl_workspace app). */
+  class CReachabilityMap
+  {
+  public:
+    CReachabilityMap() : voxels_(S_NULL), nx_(0), ny_(0), nz_(0), n_samples_(0),
+        voxel_size_(0), voxel_size_inv_(0), manip_max_(0), map_(S_NULL), map_size_(0)
+    { origin_.setZero(); }
+    ~CReachabilityMap() { close(); }
+
+    /** Maps a reachability map file and checks its header */
+    sBool open(const std::string& arg_file);
+
+    /** Unmaps the file */
+    void close();
+
+    sBool isOpen() const { return S_NULL != voxels_; }
+
+    /** The voxel that contains a point (in global coordinates). NULL if
+     * the point is outside the grid. */
+    const SReachabilityVoxel* query(const Eigen::Vector3d& arg_pos) const
+    {
+      const Eigen::Vector3d idx = (arg_pos - origin_) * voxel_size_inv_;
+      if(idx(0) < 0 || idx(1) < 0 || idx(2) < 0) { return S_NULL; }
+      const std::size_t ix = static_cast<std::size_t>(idx(0));
+      const std::size_t iy = static_cast<std::size_t>(idx(1));
+      const std::size_t iz = static_cast<std::size_t>(idx(2));
+      if(ix >= nx_ || iy >= ny_ || iz >= nz_) { return S_NULL; }
+      return voxels_ + (iz*ny_ + iy)*nx_ + ix;
+    }
+
+    /** Whether any sample reached the point's voxel */
+    sBool isReachable(const Eigen::Vector3d& arg_pos) const
+    {
+      const SReachabilityVoxel* v = query(arg_pos);
+      return S_NULL != v && 0 < v->count_;
+    }
+
+    /** The best manipulability reached in the point's voxel, normalized by
+     * the best over the map ([0,1]). 0 if unreachable. */
+    sFloat getManipulability(const Eigen::Vector3d& arg_pos) const
+    {
+      const SReachabilityVoxel* v = query(arg_pos);
+      if(S_NULL == v || 0 == v->count_ || 0 >= manip_max_) { return 0.0; }
+      return v->manip_max_ / manip_max_;
+    }
+
+    /** Voxel accessor. NOTE : No bounds checks. */
+    const SReachabilityVoxel& getVoxel(const sUInt ix, const sUInt iy, const sUInt iz) const
+    { return voxels_[(static_cast<std::size_t>(iz)*ny_ + iy)*nx_ + ix]; }
+
+    /** The voxel's center (in global coordinates) */
+    Eigen::Vector3d getVoxelCenter(const sUInt ix, const sUInt iy, const sUInt iz) const
+    { return origin_ + voxel_size_ * Eigen::Vector3d(ix+0.5, iy+0.5, iz+0.5); }
+
+    sUInt getNx() const { return nx_; }
+    sUInt getNy() const { return ny_; }
+    sUInt getNz() const { return nz_; }
+    const Eigen::Vector3d& getOrigin() const { return origin_; }
+    sFloat getVoxelSize() const { return voxel_size_; }
+    sLongLong getNumSamples() const { return n_samples_; }
+    sFloat getManipulabilityMax() const { return manip_max_; }
+    const std::string& getLinkName() const { return link_name_; }
+
+  private:
+    CReachabilityMap(const CReachabilityMap&);
+    CReachabilityMap& operator = (const CReachabilityMap&);
+
+    const SReachabilityVoxel* voxels_;
+    std::size_t nx_, ny_, nz_;
+    sLongLong n_samples_;
+    Eigen::Vector3d origin_;
+    sFloat voxel_size_, voxel_size_inv_, manip_max_;
+    std::string link_name_;
+
+    void* map_;
+    std::size_t map_size_;
+  };
+
+  /** Builds a reachability map by sampling configurations within the gc
+   * limits (uniformly at random, or stratified : one jittered sample per
+   * cell of a grid over the gcs) and binning the op point's positions.
+   *
+   * Only uses kinematics : Each sample updates the transforms of the
+   * links between the root and the op point and computes one Jacobian.
+   * Only the gcs on that chain are sampled (the others don't move it).
+   *
+   * Samples are processed in parallel (OpenMP) with a gc model per
+   * thread, and accumulated into a shared grid with atomics. Each chunk
+   * of samples has its own random number generator, so the samples don't
+   * depend on the number of threads. */
+  class CReachabilityMapBuilder
+  {
+  public:
+    /** Sets up the builder for an op point (a position on a link, in link
+     * coordinates). Creates one gc model per thread (0 threads : as many
+     * as OpenMP will run). Picks a grid that bounds the op point's reach
+     * with 2cm voxels (change it with setGrid()). */
+    sBool init(const SRobotParsed& arg_robot,
+        CDynamicsScl* arg_dynamics,
+        const std::string& arg_link_name,
+        const Eigen::Vector3d& arg_pos_in_parent,
+        const sUInt arg_threads=0);
+
+    /** Sets the grid's bounds (global coordinates) and voxel size. Clears
+     * the samples. */
+    sBool setGrid(const Eigen::Vector3d& arg_min, const Eigen::Vector3d& arg_max,
+        const sFloat arg_voxel_size);
+
+    /** Samples configurations and accumulates them into the grid. Can be
+     * called repeatedly (use different seeds). Stratified sampling uses
+     * the largest grid over the chain's gcs with at most arg_n_samples
+     * cells. */
+    sBool sample(const sLongLong arg_n_samples,
+        const sBool arg_stratified=false,
+        const sUInt arg_seed=1);
+
+    /** Writes the map (see CReachabilityMap for the format) */
+    sBool write(const std::string& arg_file) const;
+
+    /** Clears the samples */
+    void clear();
+
+    sLongLong getNumSamples() const { return n_samples_; }
+    /** Samples that landed outside the grid */
+    sLongLong getNumSamplesOutside() const { return n_outside_; }
+    /** Voxels reached by at least one sample */
+    sLongLong getNumVoxelsReached() const;
+    /** The number of gcs that move the op point (and are sampled) */
+    sUInt getNumChainGcs() const { return static_cast<sUInt>(chain_gcs_.size()); }
+    sUInt getNumThreads() const { return static_cast<sUInt>(ws_.size()); }
+    const Eigen::Vector3d& getGridMin() const { return grid_min_; }
+    sUInt getNx() const { return nx_; }
+    sUInt getNy() const { return ny_; }
+    sUInt getNz() const { return nz_; }
+
+    sBool hasBeenInit() const { return has_been_init_; }
+
+    CReachabilityMapBuilder() : dynamics_(S_NULL), dof_(0), voxel_size_(0),
+        nx_(0), ny_(0), nz_(0), n_samples_(0), n_outside_(0), flags_(0),
+        has_been_init_(false) {}
+    ~CReachabilityMapBuilder();
+
+  private:
+    CReachabilityMapBuilder(const CReachabilityMapBuilder&);
+    CReachabilityMapBuilder& operator = (const CReachabilityMapBuilder&);
+
+    /** A thread's scratch space */
+    struct SReachWorkspace
+    {
+      SGcModel* gc_model_;
+      /** The links from the root to the op point (parents first) */
+      std::vector<SRigidBodyDyn*> chain_;
+      Eigen::VectorXd q_;
+      Eigen::MatrixXd J_;
+      SReachWorkspace() : gc_model_(S_NULL) {}
+    };
+
+    /** Computes the op point's position and manipulability at the
+     * workspace's q, and adds them to the grid. Returns false if the op
+     * point is outside the grid. */
+    sBool addSample(SReachWorkspace& arg_ws);
+
+    CDynamicsScl* dynamics_;
+    sUInt dof_;
+    std::string link_name_;
+    Eigen::Vector3d pos_in_parent_;
+
+    /** The gcs on the op point's chain, and their limits */
+    std::vector<sUInt> chain_gcs_;
+    Eigen::VectorXd gc_min_, gc_max_;
+
+    std::vector<SReachWorkspace> ws_;
+
+    /** The grid */
+    Eigen::Vector3d grid_min_;
+    sFloat voxel_size_;
+    sUInt nx_, ny_, nz_;
+
+    /** The accumulators (one per voxel) */
+    std::vector<std::atomic<std::uint32_t> > count_;
+    std::vector<std::atomic<float> > manip_max_, cond_inv_max_;
+    std::vector<std::atomic<double> > manip_sum_;
+
+    std::atomic<sLongLong> n_samples_, n_outside_;
+    std::uint32_t flags_;
+
+    sBool has_been_init_;
+  };
+}
+
+#endif /* CREACHABILITYMAP_HPP_ */
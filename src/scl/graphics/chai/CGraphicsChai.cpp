@@ -144,6 +144,7 @@ namespace scl {
 
   sBool CGraphicsChai::destroyGraphics()
   {
+    dropPrefetchedMeshes(S_NULL);
     if(S_NULL!=data_) // Data is created.
     {
       if(S_NULL!= data_->chai_world_)
@@ -204,8 +205,14 @@ namespace scl {
       robot_brrep_root->robot_link_ = tmp_root_link;
       robot_brrep_root->name_ = tmp_root_link->name_; //Have to set the name of this object
 
-      //6. Set the graphics branching representation subtree (sets up this node's graphics and recurses into its children).
-      if(false == addRobotLink(robot_brrep_root))
+      //6. Decode the robot's mesh files in parallel (skips meshes prefetched earlier)
+      std::vector<const SRobotParsed*> tmp_robs(1,arg_rob_parsed);
+      prefetchRobotMeshes(tmp_robs);
+
+      //7. Set the graphics branching representation subtree (sets up this node's graphics and recurses into its children).
+      flag = addRobotLink(robot_brrep_root);
+      dropPrefetchedMeshes(arg_rob_parsed); //Unused meshes (if the links failed)
+      if(false == flag)
       { throw(std::runtime_error("Failed to add child robot-link"));  }
 
       //7. Set random rendering options (Defaults. Override later if you want.)
@@ -328,6 +335,86 @@ namespace scl {
     return true;
   }
 
+  sBool CGraphicsChai::setRobotSnapshotSource(const std::string& arg_robot,
+      const CSeqLock<SRobotSnapshot>* arg_src)
+  {
+    try
+    {
+      if(!has_been_init_) { return false; }
+
+      SRobotRenderObj* rob_gr = data_->robots_rendered_.at(arg_robot);
+      if(S_NULL==rob_gr)
+      { throw(std::runtime_error(std::string("Robot isn't being rendered : ")+arg_robot));  }
+
+      //Size the local copy so the render loop doesn't allocate.
+      rob_gr->snap_.init(rob_gr->io_->dof_, false);
+      rob_gr->snap_src_ = arg_src;
+    }
+    catch(std::exception& ee)
+    {
+      std::cerr<<"\nCGraphicsChai::setRobotSnapshotSource() : "<<ee.what();
+      return false;
+    }
+    return true;
+  }
+
+  sBool CGraphicsChai::prefetchRobotMeshes(const std::vector<const SRobotParsed*>& arg_robots)
+  {
+    //1. Find all the mesh files that haven't been loaded yet
+    std::vector<const SRigidBodyGraphics*> tmp_grs;
+    for(auto rob : arg_robots)
+    {
+      if(S_NULL == rob) { continue; }
+      for(auto it = rob->rb_tree_.begin(), ite = rob->rb_tree_.end(); it!=ite; ++it)
+        for(const auto& lnk_gr : it->graphics_obj_vec_)
+        {
+          if(SRigidBodyGraphics::GRAPHIC_TYPE_FILE_OBJ == lnk_gr.class_ &&
+              mesh_prefetch_.end() == mesh_prefetch_.find(&lnk_gr))
+          { tmp_grs.push_back(&lnk_gr); }
+        }
+    }
+
+    //2. Read and decode them in parallel. The loaders only fill in the
+    // (detached) mesh objects; the scenegraph isn't touched.
+    const int n = static_cast<int>(tmp_grs.size());
+    std::vector<cMultiMesh*> tmp_meshes(n, S_NULL);
+#pragma omp parallel for schedule(dynamic) if(n > 1)
+    for(int i=0; i<n; ++i)
+    {
+      cMultiMesh* tmp = new cMultiMesh();
+      if(false == cLoadFileOBJ(tmp,tmp_grs[i]->file_name_))
+        if(false == cLoadFile3DS(tmp,tmp_grs[i]->file_name_))
+        { delete tmp; tmp = S_NULL; }
+      tmp_meshes[i] = tmp;
+    }
+
+    bool flag = true;
+    for(int i=0; i<n; ++i)
+    {
+      mesh_prefetch_[tmp_grs[i]] = tmp_meshes[i];
+      flag = flag && (S_NULL != tmp_meshes[i]);
+    }
+    return flag;
+  }
+
+  void CGraphicsChai::dropPrefetchedMeshes(const SRobotParsed* arg_robot)
+  {
+    if(S_NULL == arg_robot)
+    {
+      for(auto& it : mesh_prefetch_) { if(S_NULL != it.second) { delete it.second; } }
+      mesh_prefetch_.clear();
+      return;
+    }
+    for(auto it = arg_robot->rb_tree_.begin(), ite = arg_robot->rb_tree_.end(); it!=ite; ++it)
+      for(const auto& lnk_gr : it->graphics_obj_vec_)
+      {
+        auto itm = mesh_prefetch_.find(&lnk_gr);
+        if(mesh_prefetch_.end() == itm) { continue; }
+        if(S_NULL != itm->second) { delete itm->second; }
+        mesh_prefetch_.erase(itm);
+      }
+  }
+
   sBool CGraphicsChai::addRobotLink(SGraphicsChaiRigidBody* arg_link)
   {
     try
@@ -364,14 +451,24 @@ namespace scl {
           const SRigidBodyGraphics& lnk_gr = (*it);
           if(SRigidBodyGraphics::GRAPHIC_TYPE_FILE_OBJ == lnk_gr.class_)
           {
-            cMultiMesh* tmp = new cMultiMesh();
-            if(false == cLoadFileOBJ(tmp,lnk_gr.file_name_))
-              if(false == cLoadFile3DS(tmp,lnk_gr.file_name_))
-              {
-                std::string err_str;
-                err_str = "Couldn't load obj/3ds robot link file: "+ lnk_gr.file_name_;
-                throw(std::runtime_error(err_str.c_str()));
-              }
+            // Use the mesh decoded by prefetchRobotMeshes() if there is one
+            cMultiMesh* tmp = S_NULL;
+            auto itpre = mesh_prefetch_.find(&lnk_gr);
+            if(mesh_prefetch_.end() != itpre)
+            { tmp = itpre->second; mesh_prefetch_.erase(itpre); }
+            else
+            {
+              tmp = new cMultiMesh();
+              if(false == cLoadFileOBJ(tmp,lnk_gr.file_name_))
+                if(false == cLoadFile3DS(tmp,lnk_gr.file_name_))
+                { delete tmp; tmp = S_NULL; }
+            }
+            if(S_NULL == tmp)
+            {
+              std::string err_str;
+              err_str = "Couldn't load obj/3ds robot link file: "+ lnk_gr.file_name_;
+              throw(std::runtime_error(err_str.c_str()));
+            }
             tmp->m_userName = std::string("scl_id_link_mesh_")+lnk_gr.file_name_;
             arg_link->graphics_obj_->addChild(tmp);
 
@@ -1135,6 +1232,12 @@ namespace scl {
         if(S_NULL == rob_io) { throw(std::runtime_error("Robot's I/O database entry is not initialized"));  }
 #endif
 
+        //Prefer a consistent snapshot if the simulation publishes them. If the
+        //sim overwrote it during every read attempt, fall back to the io data.
+        const Eigen::VectorXd* rob_q = &(rob_io->sensors_.q_);
+        if(S_NULL != it->snap_src_ && it->snap_src_->read(it->snap_))
+        { rob_q = &(it->snap_.q_); }
+
         //1.b. Now iterate over the robot's links and update their transformation (from the parent)
         sutil::CMappedTree<std::basic_string<char>, scl::SGraphicsChaiRigidBody>::iterator itgr, itgre;
         for(itgr = rob_brrep.begin(), itgre = rob_brrep.end();
@@ -1160,10 +1263,10 @@ namespace scl {
           { continue; }
 #ifdef DEBUG
           if(-1 > link_id) { throw(std::runtime_error("Found a link with an id less than 0"));  }
-          if(link_id >= rob_io->sensors_.q_.size()) { throw(std::runtime_error("Found a link with an id greater than the max for this robot"));  }
+          if(link_id >= rob_q->size()) { throw(std::runtime_error("Found a link with an id greater than the max for this robot"));  }
 #endif
           sFloat q;
-          q = rob_io->sensors_.q_(link_id);
+          q = (*rob_q)(link_id);
 
           /** Uncomment this if required: */
           //sFloat dq, tau_measured;
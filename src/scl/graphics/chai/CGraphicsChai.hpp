@@ -39,6 +39,14 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <scl/graphics/CGraphicsBase.hpp>
 
 #include <string>
+#include <vector>
+#include <map>
+
+/** Forward declare chai's mesh class */
+namespace chai3d
+{
+  class cMultiMesh;
+}
 
 namespace scl {
 
@@ -118,6 +126,22 @@ public:
    * 2. Any real world entity subject to the laws of physics */
   virtual sBool removeRobotFromRender(const std::string& arg_robot);
 
+  /** Reads and decodes the mesh files of a set of robots in parallel
+   * (OpenMP threads). addRobotToRender() then inserts the decoded meshes
+   * into the (single threaded) scenegraph instead of loading them itself.
+   *
+   * Call this once with all the robots in a scene before adding them.
+   * addRobotToRender() also calls it for its own robot, so single robots
+   * get parallel mesh loads without doing anything. */
+  sBool prefetchRobotMeshes(const std::vector<const SRobotParsed*>& arg_robots);
+
+  /** Renders a robot (already added with addRobotToRender) from state
+   * snapshots published by the simulation thread (see
+   * CRobot::setFlagPublishSnapshots). Pass NULL to go back to reading
+   * the robot's io data directly. */
+  virtual sBool setRobotSnapshotSource(const std::string& arg_robot,
+      const CSeqLock<SRobotSnapshot>* arg_src);
+
   /** Recursively adds links to the chai scenegraph (used by addRobotToRender() ).
    *
    * 1. Creates a graphics object for a passed SGraphicsPhysicalLink* provided the
@@ -250,8 +274,8 @@ public:
   CGraphicsChai() : CGraphicsBase(),data_(NULL),
       data_is_mine_(false), data_parsed_(S_NULL){}
 
-  /** Default destructor. Does nothing */
-  virtual ~CGraphicsChai(){}
+  /** Default destructor. Frees any meshes that were prefetched but not used */
+  virtual ~CGraphicsChai(){ dropPrefetchedMeshes(S_NULL); }
 
   SGraphicsChai* getChaiData()
   { return data_; }
@@ -260,9 +284,16 @@ public:
   { return data_parsed_;  }
 
 protected:
+  /** Frees the prefetched meshes of a robot (all robots if NULL) */
+  void dropPrefetchedMeshes(const SRobotParsed* arg_robot);
+
   SGraphicsChai* data_;
   bool data_is_mine_;
   const SGraphicsParsed* data_parsed_;
+
+  /** Meshes decoded by prefetchRobotMeshes(), waiting to be added to the
+   * scenegraph. NULL if the file couldn't be loaded. */
+  std::map<const SRigidBodyGraphics*, chai3d::cMultiMesh*> mesh_prefetch_;
 };
 
 }
@@ -34,6 +34,8 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <scl/DataTypes.hpp>
 #include <scl/data_structs/SObject.hpp>
 #include <scl/data_structs/SGraphicsParsed.hpp>
+#include <scl/data_structs/SRobotSnapshot.hpp>
+#include <scl/util/CSeqLock.hpp>
 #include <scl/graphics/chai/data_structs/SGraphicsChaiRigidBody.hpp>
 #include <scl/graphics/chai/data_structs/SGraphicsChaiMuscleSet.hpp>
 
@@ -63,6 +65,13 @@ struct SRobotRenderObj
 public:
   sutil::CMappedTree<std::string, SGraphicsChaiRigidBody> gr_tree_;
   const SRobotIO *io_;
+
+  /** Optional : If set, the robot is rendered from consistent state
+   * snapshots instead of reading io_ while the simulation writes it. */
+  const CSeqLock<SRobotSnapshot> *snap_src_ = S_NULL;
+
+  /** The latest snapshot read from snap_src_ */
+  SRobotSnapshot snap_;
 };
 
 /** Enables passing data between a chai rendering instance and the scl control framework.
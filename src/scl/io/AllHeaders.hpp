@@ -33,5 +33,6 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #define SRC_SCL_IO_ALLHEADERS_HPP_
 
 #include <scl/io/CIORedis.hpp>
+#include <scl/io/CIOShm.hpp>
 
 #endif /* SRC_SCL_IO_ALLHEADERS_HPP_ */
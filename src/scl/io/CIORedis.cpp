@@ -32,7 +32,61 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 
 #include "CIORedis.hpp"
 
+#include <scl/util/CPerfStats.hpp>
+
 #include <iostream>
+#include <sstream>
+#include <cstring>
+
+#include <poll.h>
+#include <time.h>
+
+namespace
+{
+  const unsigned int REDIS_MSG_MAGIC = 0x5C1B5B00;
+
+  struct SRedisMsgHeader
+  {
+    unsigned int magic_, n_vecs_;
+    long long seq_, t_pub_ns_;
+  };
+
+  long long getMonotonicNs()
+  {
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec*1000000000LL + t.tv_nsec;
+  }
+
+  /** Gets one reply on a subscribed connection. Returns replies that are
+   * already buffered first. Otherwise waits up to arg_timeout_ms for the
+   * socket (0 : don't wait). */
+  bool getSubscriptionReply(redisContext *arg_ctx, redisReply **ret_reply, int arg_timeout_ms)
+  {
+    void *r = NULL;
+    if(REDIS_OK != redisReaderGetReply(arg_ctx->reader, &r)) { return false; }
+    if(NULL == r)
+    {
+      pollfd pfd;
+      pfd.fd = arg_ctx->fd; pfd.events = POLLIN; pfd.revents = 0;
+      if(0 >= poll(&pfd, 1, arg_timeout_ms)) { return false; } // Timeout (or error)
+      if(REDIS_OK != redisBufferRead(arg_ctx)) { return false; }
+      if(REDIS_OK != redisReaderGetReply(arg_ctx->reader, &r)) { return false; }
+      // Got part of a message. The rest is on its way so just block for it.
+      if(NULL == r && REDIS_OK != redisGetReply(arg_ctx, &r)) { return false; }
+    }
+    *ret_reply = static_cast<redisReply*>(r);
+    return NULL != r;
+  }
+
+  /** Whether a reply is a pub/sub message : ["message", channel, payload] */
+  bool isMessage(const redisReply *arg_r)
+  {
+    return (REDIS_REPLY_ARRAY == arg_r->type) && (3 == arg_r->elements) &&
+        (REDIS_REPLY_STRING == arg_r->element[0]->type) && (0 == strcmp(arg_r->element[0]->str, "message")) &&
+        (REDIS_REPLY_STRING == arg_r->element[2]->type);
+  }
+}
 
 namespace scl
 {
@@ -90,6 +144,7 @@ namespace scl
   /** Sets a string key. */
   bool CIORedis::set(SIORedis &arg_ds, const char* arg_key, const std::string &arg_str)
   {
+    SCL_PERF_SCOPE("io::redis::set");
     bool flag=false;
 
     // Set the key
@@ -103,6 +158,7 @@ namespace scl
   /** Sets an Eigen vector as a string key. */
   bool CIORedis::set(SIORedis &arg_ds, const char* arg_key, const Eigen::VectorXd &arg_vec)
   {
+    SCL_PERF_SCOPE("io::redis::set");
     bool flag=false;
     // NOTE TODO : Probably faster to use sprintf.
     std::stringstream ss;
@@ -120,6 +176,7 @@ namespace scl
   /** Sets an Eigen vector as a string key. */
   bool CIORedis::set(SIORedis &arg_ds, const char* arg_key, const Eigen::Vector3d &arg_vec)
   {
+    SCL_PERF_SCOPE("io::redis::set");
     bool flag=false;
     // NOTE TODO : Probably faster to use sprintf.
     std::stringstream ss;
@@ -137,6 +194,7 @@ namespace scl
   /** Sets an Eigen vector as a string key. */
   bool CIORedis::set(SIORedis &arg_ds, const char* arg_key, const int arg_int)
   {
+    SCL_PERF_SCOPE("io::redis::set");
     bool flag=false;
     // NOTE TODO : Probably faster to use sprintf.
     std::stringstream ss; ss<<arg_int;
@@ -153,6 +211,7 @@ namespace scl
   /** Sets an Eigen vector as a string key. */
   bool CIORedis::get(SIORedis &arg_ds, const char* arg_key, std::string &ret_str)
   {
+    SCL_PERF_SCOPE("io::redis::get");
     // Get the key
     arg_ds.reply_ = (redisReply *)redisCommand(arg_ds.context_, "GET %s",arg_key);
     if(arg_ds.reply_->len <= 0){ freeReplyObject((void*)arg_ds.reply_); return false;  }
@@ -166,6 +225,7 @@ namespace scl
   /** Sets an Eigen vector as a string key. */
   bool CIORedis::get(SIORedis &arg_ds, const char* arg_key, Eigen::VectorXd &ret_vec)
   {
+    SCL_PERF_SCOPE("io::redis::get");
     // Get the key
     arg_ds.reply_ = (redisReply *)redisCommand(arg_ds.context_, "GET %s",arg_key);
     if(arg_ds.reply_->len <= 0){ freeReplyObject((void*)arg_ds.reply_); return false;  }
@@ -181,6 +241,7 @@ namespace scl
   /** Sets an Eigen vector as a string key. */
   bool CIORedis::get(SIORedis &arg_ds, const char* arg_key, Eigen::Vector3d &ret_vec)
   {
+    SCL_PERF_SCOPE("io::redis::get");
     // Get the key
     arg_ds.reply_ = (redisReply *)redisCommand(arg_ds.context_, "GET %s",arg_key);
     if(arg_ds.reply_->len <= 0){ freeReplyObject((void*)arg_ds.reply_); return false;  }
@@ -196,6 +257,7 @@ namespace scl
 
   bool CIORedis::get(SIORedis &arg_ds, const char* arg_key, int &ret_int)
   {
+    SCL_PERF_SCOPE("io::redis::get");
     // Get the key
     arg_ds.reply_ = (redisReply *)redisCommand(arg_ds.context_, "GET %s",arg_key);
     if(arg_ds.reply_->len <= 0){ freeReplyObject((void*)arg_ds.reply_); return false;  }
@@ -219,4 +281,148 @@ namespace scl
     return true;
   }
 
+  bool CIORedis::publish(SIORedis &arg_ds, const char* arg_channel,
+      const Eigen::VectorXd* const arg_vecs[], const int arg_n_vecs,
+      const long long arg_seq)
+  {
+    SCL_PERF_SCOPE("io::redis::publish");
+    if(0 > arg_n_vecs) { return false; }
+
+    // Pack the message (the buffer only grows, so this doesn't allocate after the first tick)
+    std::size_t n_doubles = 0;
+    for(int i=0;i<arg_n_vecs;++i) { n_doubles += arg_vecs[i]->rows(); }
+    const std::size_t sz = sizeof(SRedisMsgHeader) + arg_n_vecs*sizeof(unsigned int) + n_doubles*sizeof(double);
+    if(arg_ds.msg_.size() < sz) { arg_ds.msg_.resize(sz); }
+
+    char *p = arg_ds.msg_.data();
+    SRedisMsgHeader h;
+    h.magic_ = REDIS_MSG_MAGIC; h.n_vecs_ = arg_n_vecs;
+    h.seq_ = arg_seq; h.t_pub_ns_ = getMonotonicNs();
+    memcpy(p, &h, sizeof(h)); p += sizeof(h);
+    for(int i=0;i<arg_n_vecs;++i)
+    { unsigned int len = arg_vecs[i]->rows(); memcpy(p, &len, sizeof(len)); p += sizeof(len); }
+    for(int i=0;i<arg_n_vecs;++i)
+    { memcpy(p, arg_vecs[i]->data(), arg_vecs[i]->rows()*sizeof(double)); p += arg_vecs[i]->rows()*sizeof(double); }
+
+    // Publish it as a binary safe string
+    arg_ds.reply_ = (redisReply *)redisCommand(arg_ds.context_, "PUBLISH %s %b", arg_channel, arg_ds.msg_.data(), sz);
+    if(NULL == arg_ds.reply_) { return false; }
+    bool flag = (REDIS_REPLY_INTEGER == arg_ds.reply_->type);
+    freeReplyObject((void*)arg_ds.reply_);
+    return flag;
+  }
+
+  bool CIORedis::publish(SIORedis &arg_ds, const char* arg_channel,
+      const char* arg_msg, const std::size_t arg_len)
+  {
+    SCL_PERF_SCOPE("io::redis::publish");
+    arg_ds.reply_ = (redisReply *)redisCommand(arg_ds.context_, "PUBLISH %s %b", arg_channel, arg_msg, arg_len);
+    if(NULL == arg_ds.reply_) { return false; }
+    bool flag = (REDIS_REPLY_INTEGER == arg_ds.reply_->type);
+    freeReplyObject((void*)arg_ds.reply_);
+    return flag;
+  }
+
+  bool CIORedis::subscribe(SIORedis &arg_ds, const char* arg_channel)
+  {
+    arg_ds.reply_ = (redisReply *)redisCommand(arg_ds.context_, "SUBSCRIBE %s", arg_channel);
+    if(NULL == arg_ds.reply_) { return false; }
+    // Reply : ["subscribe", channel, number of subscriptions]
+    bool flag = (REDIS_REPLY_ARRAY == arg_ds.reply_->type) && (3 == arg_ds.reply_->elements);
+    freeReplyObject((void*)arg_ds.reply_);
+    arg_ds.msg_seq_last_ = -1;
+    return flag;
+  }
+
+  bool CIORedis::waitForMessage(SIORedis &arg_ds,
+      Eigen::VectorXd* const ret_vecs[], const int arg_n_vecs,
+      long long &ret_seq, const double arg_timeout_sec)
+  {
+    SCL_PERF_SCOPE("io::redis::wait_msg");
+    redisReply *r = NULL, *latest = NULL;
+
+    // 1. Block for a message
+    const long long t_end = getMonotonicNs() + static_cast<long long>(arg_timeout_sec*1e9);
+    while(NULL == latest)
+    {
+      int timeout_ms = static_cast<int>((t_end - getMonotonicNs())/1000000);
+      if(false == getSubscriptionReply(arg_ds.context_, &r, timeout_ms > 0 ? timeout_ms : 0))
+      { return false; }
+      if(isMessage(r)) { latest = r; }
+      else { freeReplyObject(r); } // Not a message (eg. a subscribe confirmation)
+    }
+
+    // 2. Skip to the newest one if we fell behind the publisher
+    while(getSubscriptionReply(arg_ds.context_, &r, 0))
+    {
+      if(isMessage(r)) { freeReplyObject(latest); latest = r; }
+      else { freeReplyObject(r); }
+    }
+
+    // 3. Unpack it
+    bool flag = false;
+    const redisReply *pl = latest->element[2];
+    const char *p = pl->str, *p_end = pl->str + pl->len;
+    SRedisMsgHeader h;
+    if(sizeof(h) <= pl->len)
+    {
+      memcpy(&h, p, sizeof(h)); p += sizeof(h);
+      flag = (REDIS_MSG_MAGIC == h.magic_) && (static_cast<unsigned int>(arg_n_vecs) == h.n_vecs_) &&
+          (p + arg_n_vecs*sizeof(unsigned int) <= p_end);
+    }
+    if(flag)
+    {
+      const char *p_data = p + arg_n_vecs*sizeof(unsigned int);
+      for(int i=0; flag && i<arg_n_vecs; ++i)
+      {
+        unsigned int len; memcpy(&len, p, sizeof(len)); p += sizeof(len);
+        if(p_data + len*sizeof(double) > p_end) { flag = false; break; }
+        if(static_cast<unsigned int>(ret_vecs[i]->rows()) != len) { ret_vecs[i]->resize(len); }
+        memcpy(ret_vecs[i]->data(), p_data, len*sizeof(double));
+        p_data += len*sizeof(double);
+      }
+    }
+    freeReplyObject(latest);
+    if(false == flag) { return false; }
+
+    // 4. Stats
+    const double latency = (getMonotonicNs() - h.t_pub_ns_)*1e-9;
+    arg_ds.msg_ctr_++;
+    arg_ds.msg_latency_sum_ += latency;
+    if(latency > arg_ds.msg_latency_max_) { arg_ds.msg_latency_max_ = latency; }
+    if(0 <= arg_ds.msg_seq_last_ && h.seq_ > arg_ds.msg_seq_last_+1)
+    { arg_ds.msg_ctr_skipped_ += h.seq_ - arg_ds.msg_seq_last_ - 1; }
+    arg_ds.msg_seq_last_ = h.seq_;
+    arg_ds.msg_t_pub_ns_last_ = h.t_pub_ns_;
+    ret_seq = h.seq_;
+    return true;
+  }
+
+  bool CIORedis::setPerfStats(SIORedis &arg_ds, const std::string& arg_prefix)
+  {
+    std::vector<SPerfSummary> s;
+    CPerfStats::getSummaries(s);
+
+    // Pipeline the SETs, then collect the replies
+    std::vector<SPerfSummary>::const_iterator it, ite;
+    for(it = s.begin(), ite = s.end(); it!=ite; ++it)
+    {
+      snprintf(arg_ds.str_, sizeof(arg_ds.str_), "%lld %.3f %.3f %.3f %.3f %.3f", it->n_,
+          it->mean_ns_*1e-3, it->p50_ns_*1e-3, it->p99_ns_*1e-3, it->p999_ns_*1e-3, it->max_ns_*1e-3);
+      if(REDIS_OK != redisAppendCommand(arg_ds.context_, "SET %s%s %s",
+          arg_prefix.c_str(), it->name_.c_str(), arg_ds.str_))
+      { return false; }
+    }
+
+    bool flag = true;
+    for(std::size_t i=0; i<s.size(); ++i)
+    {
+      void *r = NULL;
+      if(REDIS_OK != redisGetReply(arg_ds.context_, &r)) { return false; }
+      flag = flag && (NULL != r) && (REDIS_REPLY_ERROR != ((redisReply*)r)->type);
+      if(NULL != r) { freeReplyObject(r); }
+    }
+    return flag;
+  }
+
 } /* namespace scl */
@@ -37,6 +37,9 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <Eigen/Core>
 #include <hiredis/hiredis.h>
 
+#include <string>
+#include <vector>
+
 #define SCL_MAX_REDIS_KEY_LEN_CHARS 128
 
 namespace scl
@@ -53,6 +56,18 @@ namespace scl
 
     // A scratch string for formatting messages
     char str_[SCL_MAX_REDIS_KEY_LEN_CHARS];
+
+    // A scratch buffer for packed (pub/sub) messages
+    std::vector<char> msg_;
+
+    // Subscriber statistics. Latency is from the PUBLISH call to the
+    // message's arrival, and is only valid if both run on the same host.
+    long long msg_ctr_ = 0, msg_ctr_skipped_ = 0, msg_seq_last_ = -1;
+    double msg_latency_sum_ = 0.0, msg_latency_max_ = 0.0;
+
+    // When the last message was published (CLOCK_MONOTONIC ns, like
+    // CPerfStats::nowNs()). Use it to timestamp the state it carried.
+    long long msg_t_pub_ns_last_ = 0;
   };
 
   /** A class to simplify IO operations using hiredis.
@@ -116,6 +131,44 @@ namespace scl
     /** Deletes this key */
     bool del(SIORedis &arg_ds, const char* arg_key);
 
+    // ****************************** PUB/SUB ******************************************
+    /** Publishes a set of vectors (eg. q, dq, fgc) as one packed binary
+     * message on a channel. Subscribers get all of them at once, and only
+     * when there is a new sample (no polling).
+     *
+     * Message format (native byte order; same host or same architecture):
+     *   uint32 magic, uint32 n_vecs, int64 seq, int64 publish time (ns, CLOCK_MONOTONIC),
+     *   uint32 len[n_vecs], double data[sum(len)] */
+    bool publish(SIORedis &arg_ds, const char* arg_channel,
+        const Eigen::VectorXd* const arg_vecs[], const int arg_n_vecs,
+        const long long arg_seq);
+
+    /** Publishes a string message (eg. a JSON document) on a channel. The
+     * message doesn't need to be null terminated (binary safe). */
+    bool publish(SIORedis &arg_ds, const char* arg_channel,
+        const char* arg_msg, const std::size_t arg_len);
+
+    /** Subscribes to a channel.
+     * NOTE : A subscribed connection can't run any other commands. Use a
+     * separate connection (data structure) for get/set. */
+    bool subscribe(SIORedis &arg_ds, const char* arg_channel);
+
+    /** Blocks until a message arrives on the subscribed channel (or until
+     * the timeout) and unpacks it into the vectors (resizing them if the
+     * sizes don't match). If several messages are queued up, it skips to
+     * the newest one (and counts the others in msg_ctr_skipped_).
+     * Returns false on a timeout, or a malformed message. */
+    bool waitForMessage(SIORedis &arg_ds,
+        Eigen::VectorXd* const ret_vecs[], const int arg_n_vecs,
+        long long &ret_seq, const double arg_timeout_sec);
+
+    // ****************************** PERF ******************************************
+    /** Publishes the CPerfStats timers. One key per timer :
+     *   <prefix><timer name> = "n mean p50 p99 p99.9 max" (times in usec)
+     * Sends all the keys in one round trip (pipelined). Call it at a low
+     * rate (eg. once a second) from a non real-time thread or loop phase. */
+    bool setPerfStats(SIORedis &arg_ds, const std::string& arg_prefix="scl::perf::");
+
     /** Default constructor. Does nothing */
     CIORedis() {}
     /** Default destructor. Does nothing */
@@ -0,0 +1,339 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+ * CIOShm.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "CIOShm.hpp"
+
+#include <scl/util/CPerfStats.hpp>
+
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <climits>
+#include <stdexcept>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+
+namespace
+{
+  const unsigned int SHM_MAGIC = 0x5C1005E6;
+  enum { SHM_FREE=0, SHM_CLAIMING=1, SHM_USED=2 };
+  enum { SHM_TYPE_STR=1, SHM_TYPE_VEC=2, SHM_TYPE_INT=3 };
+  const int SHM_READ_TRIES = 16;
+
+  /** FNV-1a. Never returns 0 (free slots have a zero hash). */
+  unsigned long long hashKey(const char* arg_key)
+  {
+    unsigned long long h = 14695981039346656037ULL;
+    for(; *arg_key; ++arg_key)
+    { h ^= static_cast<unsigned char>(*arg_key); h *= 1099511628211ULL; }
+    return (0 == h) ? 1 : h;
+  }
+
+  /** The futex word is the slot's sequence counter */
+  int* futexWord(std::atomic<unsigned int>& arg_seq)
+  { return reinterpret_cast<int*>(&arg_seq); }
+}
+
+namespace scl
+{
+  static_assert(ATOMIC_INT_LOCK_FREE == 2,
+      "CIOShm needs lock-free (address free) atomics to share them between processes");
+
+  bool CIOShm::connect(SIOShm &arg_ds)
+  {
+    int fd = -1;
+    try
+    {
+      if(NULL != arg_ds.seg_) { throw(std::runtime_error("Already connected. Disconnect first.")); }
+
+      fd = shm_open(arg_ds.name_.c_str(), O_RDWR | O_CREAT, 0666);
+      if(0 > fd) { throw(std::runtime_error(std::string("Could not open shared memory : ")+strerror(errno))); }
+
+      // A new segment is empty (zero size). Size it; the OS zero fills it.
+      struct stat st;
+      if(0 != fstat(fd, &st)) { throw(std::runtime_error(std::string("Could not stat shared memory : ")+strerror(errno))); }
+      if(0 == st.st_size)
+      {
+        if(0 != ftruncate(fd, sizeof(SIOShmSegment)))
+        { throw(std::runtime_error(std::string("Could not size shared memory : ")+strerror(errno))); }
+      }
+      else if(static_cast<std::size_t>(st.st_size) != sizeof(SIOShmSegment))
+      { throw(std::runtime_error("Shared memory segment exists but has a different layout (unlink it, or use another name).")); }
+
+      void* mem = mmap(NULL, sizeof(SIOShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if(MAP_FAILED == mem) { throw(std::runtime_error(std::string("Could not map shared memory : ")+strerror(errno))); }
+      close(fd); fd = -1; // The mapping stays valid.
+
+      arg_ds.seg_ = static_cast<SIOShmSegment*>(mem);
+
+      // The first process to connect stamps the segment.
+      unsigned int magic = 0;
+      if(arg_ds.seg_->magic_.compare_exchange_strong(magic, SHM_MAGIC))
+      { arg_ds.seg_->n_slots_ = SCL_MAX_SHM_KEYS; }
+      else if(SHM_MAGIC != magic)
+      {
+        munmap(arg_ds.seg_, sizeof(SIOShmSegment)); arg_ds.seg_ = NULL;
+        throw(std::runtime_error("Shared memory segment has an unknown format."));
+      }
+    }
+    catch(std::exception& e)
+    {
+      if(0 <= fd) { close(fd); }
+      std::cout<<"\n\n CIOShm::connect() : ERROR : "<<e.what()<<"\n";
+      return false;
+    }
+
+    // Connection successful.
+    return true;
+  }
+
+  bool CIOShm::disconnect(SIOShm &arg_ds)
+  {
+    if(NULL == arg_ds.seg_) { return true; }
+    bool flag = (0 == munmap(arg_ds.seg_, sizeof(SIOShmSegment)));
+    arg_ds.seg_ = NULL;
+    return flag;
+  }
+
+  bool CIOShm::unlink(SIOShm &arg_ds)
+  { return 0 == shm_unlink(arg_ds.name_.c_str()); }
+
+  SIOShmSlot* CIOShm::findSlot(SIOShm &arg_ds, const char* arg_key,
+      const unsigned long long arg_hash, bool arg_create)
+  {
+    if(NULL == arg_ds.seg_) { return NULL; }
+    SIOShmSlot* slots = arg_ds.seg_->slots_;
+
+    // Keys start probing at their hash, so a lookup usually hits the first slot.
+    for(unsigned int k=0; k<SCL_MAX_SHM_KEYS; ++k)
+    {
+      SIOShmSlot& s = slots[(arg_hash+k)%SCL_MAX_SHM_KEYS];
+      if(SHM_USED == s.state_.load(std::memory_order_acquire) && arg_hash == s.hash_ &&
+          0 == strncmp(s.key_, arg_key, SCL_MAX_SHM_KEY_LEN_CHARS))
+      { return &s; }
+    }
+
+    if(false == arg_create) { return NULL; }
+    if(SCL_MAX_SHM_KEY_LEN_CHARS <= strlen(arg_key)) { return NULL; }
+
+    for(unsigned int k=0; k<SCL_MAX_SHM_KEYS; ++k)
+    {
+      SIOShmSlot& s = slots[(arg_hash+k)%SCL_MAX_SHM_KEYS];
+      unsigned int st = SHM_FREE;
+      if(s.state_.compare_exchange_strong(st, SHM_CLAIMING))
+      {
+        strncpy(s.key_, arg_key, SCL_MAX_SHM_KEY_LEN_CHARS);
+        s.hash_ = arg_hash;
+        s.type_ = 0; s.len_ = 0;
+        s.state_.store(SHM_USED, std::memory_order_release);
+        return &s;
+      }
+    }
+    return NULL; // Full
+  }
+
+  bool CIOShm::write(SIOShm &arg_ds, const char* arg_key, int arg_type,
+      const void* arg_data, int arg_len, std::size_t arg_elem_bytes)
+  {
+    SCL_PERF_SCOPE("io::shm::set");
+    if(0 > arg_len || SCL_MAX_SHM_VAL_BYTES < arg_len * arg_elem_bytes) { return false; }
+
+    SIOShmSlot* s = findSlot(arg_ds, arg_key, hashKey(arg_key), true);
+    if(NULL == s) { return false; }
+
+    // Seqlock write : odd while writing, even when done.
+    const unsigned int q = s->seq_.load(std::memory_order_relaxed);
+    s->seq_.store(q+1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s->type_ = arg_type;
+    s->len_ = arg_len;
+    memcpy(s->val_, arg_data, arg_len * arg_elem_bytes);
+    s->seq_.store(q+2, std::memory_order_seq_cst);
+
+    // Only pay for the syscall if a reader is blocked on this key.
+    if(0 < s->waiters_.load(std::memory_order_seq_cst))
+    {
+      syscall(SYS_futex, futexWord(s->seq_), FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+      arg_ds.ctr_futex_wakes_++;
+    }
+    return true;
+  }
+
+  bool CIOShm::read(SIOShm &arg_ds, const char* arg_key, int arg_type,
+      void* ret_data, int& ret_len, int arg_max_len, std::size_t arg_elem_bytes)
+  {
+    SCL_PERF_SCOPE("io::shm::get");
+    const unsigned long long h = hashKey(arg_key);
+    SIOShmSlot* s = findSlot(arg_ds, arg_key, h, false);
+    if(NULL == s) { return false; }
+
+    for(int i=0; i<SHM_READ_TRIES; ++i)
+    {
+      const unsigned int q = s->seq_.load(std::memory_order_acquire);
+      if(q & 1) { arg_ds.ctr_read_retries_++; continue; } // Writer is in the slot
+
+      const int type = s->type_, len = s->len_;
+      const bool fits = (type == arg_type) && (0 <= len) && (len <= arg_max_len);
+      if(fits) { memcpy(ret_data, s->val_, len * arg_elem_bytes); }
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(q != s->seq_.load(std::memory_order_relaxed))
+      { arg_ds.ctr_read_retries_++; continue; }
+
+      // Consistent. Make sure the key wasn't deleted (and the slot reused) under us.
+      if(SHM_USED != s->state_.load(std::memory_order_acquire) || h != s->hash_)
+      { return false; }
+
+      ret_len = len;
+      return fits;
+    }
+    return false;
+  }
+
+  // ****************************** SET ******************************************
+  bool CIOShm::set(SIOShm &arg_ds, const char* arg_key, const std::string &arg_str)
+  { return write(arg_ds, arg_key, SHM_TYPE_STR, arg_str.c_str(), static_cast<int>(arg_str.length()), 1); }
+
+  bool CIOShm::set(SIOShm &arg_ds, const char* arg_key, const Eigen::VectorXd &arg_vec)
+  { return write(arg_ds, arg_key, SHM_TYPE_VEC, arg_vec.data(), static_cast<int>(arg_vec.rows()), sizeof(double)); }
+
+  bool CIOShm::set(SIOShm &arg_ds, const char* arg_key, const Eigen::Vector3d &arg_vec)
+  { return write(arg_ds, arg_key, SHM_TYPE_VEC, arg_vec.data(), 3, sizeof(double)); }
+
+  bool CIOShm::set(SIOShm &arg_ds, const char* arg_key, const int arg_int)
+  { return write(arg_ds, arg_key, SHM_TYPE_INT, &arg_int, 1, sizeof(int)); }
+
+  // ****************************** GET ******************************************
+  bool CIOShm::get(SIOShm &arg_ds, const char* arg_key, std::string &ret_str)
+  {
+    int len = 0;
+    if(false == read(arg_ds, arg_key, SHM_TYPE_STR, arg_ds.str_, len, SCL_MAX_SHM_VAL_BYTES, 1))
+    { return false; }
+    ret_str.assign(arg_ds.str_, len);
+    return true;
+  }
+
+  bool CIOShm::get(SIOShm &arg_ds, const char* arg_key, Eigen::VectorXd &ret_vec)
+  {
+    int len = 0;
+    if(read(arg_ds, arg_key, SHM_TYPE_VEC, ret_vec.data(), len, static_cast<int>(ret_vec.rows()), sizeof(double)))
+    {
+      if(len != ret_vec.rows()) { ret_vec.conservativeResize(len); }
+      return true;
+    }
+    if(len <= ret_vec.rows()) { return false; }
+
+    // The vector was too small. Grow it and try again (only allocates when the size changes).
+    ret_vec.resize(len);
+    if(false == read(arg_ds, arg_key, SHM_TYPE_VEC, ret_vec.data(), len, static_cast<int>(ret_vec.rows()), sizeof(double)))
+    { return false; }
+    if(len != ret_vec.rows()) { ret_vec.conservativeResize(len); }
+    return true;
+  }
+
+  bool CIOShm::get(SIOShm &arg_ds, const char* arg_key, Eigen::Vector3d &ret_vec)
+  {
+    int len = 0;
+    return read(arg_ds, arg_key, SHM_TYPE_VEC, ret_vec.data(), len, 3, sizeof(double)) && (3 == len);
+  }
+
+  bool CIOShm::get(SIOShm &arg_ds, const char* arg_key, int &ret_int)
+  {
+    int len = 0;
+    return read(arg_ds, arg_key, SHM_TYPE_INT, &ret_int, len, 1, sizeof(int)) && (1 == len);
+  }
+
+  // ****************************** DEL ******************************************
+  bool CIOShm::del(SIOShm &arg_ds, const char* arg_key)
+  {
+    SIOShmSlot* s = findSlot(arg_ds, arg_key, hashKey(arg_key), false);
+    if(NULL == s) { return true; } // Nothing to delete
+
+    const unsigned int q = s->seq_.load(std::memory_order_relaxed);
+    s->seq_.store(q+1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s->hash_ = 0; s->key_[0] = '\0'; s->len_ = 0; s->type_ = 0;
+    s->seq_.store(q+2, std::memory_order_seq_cst);
+    s->state_.store(SHM_FREE, std::memory_order_release);
+
+    if(0 < s->waiters_.load(std::memory_order_seq_cst))
+    { syscall(SYS_futex, futexWord(s->seq_), FUTEX_WAKE, INT_MAX, NULL, NULL, 0); }
+    return true;
+  }
+
+  // ****************************** NOTIFY ******************************************
+  bool CIOShm::getSeq(SIOShm &arg_ds, const char* arg_key, unsigned int &ret_seq)
+  {
+    SIOShmSlot* s = findSlot(arg_ds, arg_key, hashKey(arg_key), false);
+    if(NULL == s) { return false; }
+    ret_seq = s->seq_.load(std::memory_order_acquire);
+    return true;
+  }
+
+  bool CIOShm::waitForUpdate(SIOShm &arg_ds, const char* arg_key, const unsigned int arg_seq,
+      const double arg_timeout_sec)
+  {
+    SIOShmSlot* s = findSlot(arg_ds, arg_key, hashKey(arg_key), false);
+    if(NULL == s) { return false; }
+
+    timespec t_end, t_now, t_rem;
+    clock_gettime(CLOCK_MONOTONIC, &t_now);
+    long long ns_end = t_now.tv_sec*1000000000LL + t_now.tv_nsec + static_cast<long long>(arg_timeout_sec*1e9);
+    t_end.tv_sec = ns_end/1000000000LL; t_end.tv_nsec = ns_end%1000000000LL;
+
+    // Register as a waiter before checking the counter, so the writer either
+    // sees us (and wakes us) or we see its update (and the futex returns at once).
+    s->waiters_.fetch_add(1, std::memory_order_seq_cst);
+    bool flag = false;
+    while(true)
+    {
+      if(arg_seq != s->seq_.load(std::memory_order_seq_cst)) { flag = true; break; }
+
+      clock_gettime(CLOCK_MONOTONIC, &t_now);
+      long long ns_rem = (t_end.tv_sec - t_now.tv_sec)*1000000000LL + (t_end.tv_nsec - t_now.tv_nsec);
+      if(0 >= ns_rem) { break; }
+      t_rem.tv_sec = ns_rem/1000000000LL; t_rem.tv_nsec = ns_rem%1000000000LL;
+
+      // Sleeps only while the counter still equals arg_seq. Wakes on EINTR too; just loop.
+      syscall(SYS_futex, futexWord(s->seq_), FUTEX_WAIT, static_cast<int>(arg_seq), &t_rem, NULL, 0);
+    }
+    s->waiters_.fetch_sub(1, std::memory_order_seq_cst);
+    return flag;
+  }
+
+} /* namespace scl */
@@ -0,0 +1,205 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+ * CIOShm.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+
+#ifndef CIOSHM_HPP_
+#define CIOSHM_HPP_
+
+#include <Eigen/Core>
+
+#include <atomic>
+#include <string>
+#include <cstddef>
+
+#define SCL_MAX_SHM_KEY_LEN_CHARS 128
+#define SCL_MAX_SHM_KEYS 128
+/** Max value size (bytes). Fits a 128 dof vector. */
+#define SCL_MAX_SHM_VAL_BYTES 1024
+
+namespace scl
+{
+  /** One key in the shared memory segment. The layout is fixed so that
+   * any process that maps the segment can read it. */
+  struct SIOShmSlot
+  {
+    /** Odd while the writer is updating the value. Readers retry if it
+     * changes while they copy. Also the futex word for waitForUpdate(). */
+    std::atomic<unsigned int> seq_;
+
+    /** 0 : free, 1 : being claimed, 2 : in use */
+    std::atomic<unsigned int> state_;
+
+    /** Number of readers blocked in waitForUpdate(). The writer only makes
+     * the (slow) futex wake syscall if this is non zero. */
+    std::atomic<unsigned int> waiters_;
+
+    /** The value's type and length (in elements) */
+    int type_, len_;
+
+    /** The key and its hash (for fast lookups) */
+    unsigned long long hash_;
+    char key_[SCL_MAX_SHM_KEY_LEN_CHARS];
+
+    /** The value. Aligned for doubles. */
+    double val_[SCL_MAX_SHM_VAL_BYTES/sizeof(double)];
+  };
+
+  /** The shared memory segment's layout. Zero initialized memory is a
+   * valid (empty) segment, so there is no creation race between processes. */
+  struct SIOShmSegment
+  {
+    std::atomic<unsigned int> magic_;
+    unsigned int n_slots_;
+    SIOShmSlot slots_[SCL_MAX_SHM_KEYS];
+  };
+
+  /** Basic data for reading from and writing to a shared memory segment...
+   * Makes it easy to keep track of things..*/
+  class SIOShm{
+  public:
+    /** The POSIX shared memory object's name. All processes on a host that
+     * use the same name see the same keys. */
+    std::string name_ = "/scl_io";
+
+    SIOShmSegment *seg_ = NULL;
+
+    // A scratch string for reading string values
+    char str_[SCL_MAX_SHM_VAL_BYTES+1];
+
+    /** Counters */
+    unsigned long long ctr_read_retries_ = 0, ctr_futex_wakes_ = 0;
+  };
+
+  /** A class to simplify IO operations using POSIX shared memory.
+   *
+   * A drop-in alternative to CIORedis for processes on the same host. It
+   * uses the same key namespace (eg. scl::robot::<name>::sensors::q) but
+   * stores the values as fixed layout binary data, so a set or a get is a
+   * memcpy plus a few atomic operations (no server, no string formatting).
+   *
+   * Each key has a sequence counter (a seqlock). Readers never block
+   * writers. Readers can either poll, or block in waitForUpdate() until a
+   * key's value changes (the writer wakes them with a futex).
+   *
+   * NOTE : Each key should have only one writer at a time.
+   *
+   * Like CIORedis, this class is stateless. */
+  class CIOShm
+  {
+  public:
+    // ****************************** CONNECT ******************************************
+    /** Maps the shared memory segment named in the data structure, creating
+     * it if it doesn't exist. Stores the mapping in the data structure. */
+    bool connect(SIOShm &arg_ds);
+
+    /** Unmaps the segment (the keys persist for other processes) */
+    bool disconnect(SIOShm &arg_ds);
+
+    /** Removes the segment's name from the system. Processes that already
+     * mapped it keep using it. New connects get a new (empty) segment. */
+    bool unlink(SIOShm &arg_ds);
+
+    // ****************************** SET ******************************************
+    /** Sets a string key. */
+    bool set(SIOShm &arg_ds, const char* arg_key, const std::string &arg_str);
+
+    /** Sets an Eigen vector key. */
+    bool set(SIOShm &arg_ds, const char* arg_key, const Eigen::VectorXd &arg_vec);
+
+    /** Sets an Eigen vector 3d key. */
+    bool set(SIOShm &arg_ds, const char* arg_key, const Eigen::Vector3d &arg_vec);
+
+    /** Sets an int key. */
+    bool set(SIOShm &arg_ds, const char* arg_key, const int arg_int);
+
+    /** Sets a bool key. */
+    bool set(SIOShm &arg_ds, const char* arg_key, const bool arg_bool)
+    { return set(arg_ds,arg_key,static_cast<int>(arg_bool?1:0)); } // force a 1/0 type cast to int
+
+    // ****************************** GET ******************************************
+    /** Gets a string key. */
+    bool get(SIOShm &arg_ds, const char* arg_key, std::string &ret_str);
+
+    /** Gets an Eigen vector key. Resizes the vector if its size doesn't match. */
+    bool get(SIOShm &arg_ds, const char* arg_key, Eigen::VectorXd &ret_vec);
+
+    /** Gets an Eigen vector 3d key. */
+    bool get(SIOShm &arg_ds, const char* arg_key, Eigen::Vector3d &ret_vec);
+
+    /** Gets an int key. */
+    bool get(SIOShm &arg_ds, const char* arg_key, int &ret_int);
+
+    /** Gets a bool key. */
+    bool get(SIOShm &arg_ds, const char* arg_key, bool &ret_bool)
+    {//Non zero int casts to true; else false.
+      int x;
+      bool flag = get(arg_ds,arg_key,x);
+      if(flag){ret_bool = (x!=0)?true:false;}
+      return flag;
+    }
+
+    // ****************************** DEL ******************************************
+    /** Deletes this key */
+    bool del(SIOShm &arg_ds, const char* arg_key);
+
+    // ****************************** NOTIFY ******************************************
+    /** Gets a key's sequence counter. It changes every time the key is set. */
+    bool getSeq(SIOShm &arg_ds, const char* arg_key, unsigned int &ret_seq);
+
+    /** Blocks until the key's sequence counter differs from arg_seq (ie. the
+     * key was set after getSeq() returned arg_seq), or until the timeout.
+     * Returns false on a timeout or if the key doesn't exist. */
+    bool waitForUpdate(SIOShm &arg_ds, const char* arg_key, const unsigned int arg_seq,
+        const double arg_timeout_sec);
+
+    /** Default constructor. Does nothing */
+    CIOShm() {}
+    /** Default destructor. Does nothing */
+    virtual ~CIOShm() {}
+
+  protected:
+    /** Finds a key's slot. Creates one if arg_create is true. */
+    SIOShmSlot* findSlot(SIOShm &arg_ds, const char* arg_key,
+        const unsigned long long arg_hash, bool arg_create);
+
+    /** Writes a value (seqlock writer) and wakes any blocked readers */
+    bool write(SIOShm &arg_ds, const char* arg_key, int arg_type,
+        const void* arg_data, int arg_len, std::size_t arg_elem_bytes);
+
+    /** Reads a value (seqlock reader). Returns the length in ret_len. */
+    bool read(SIOShm &arg_ds, const char* arg_key, int arg_type,
+        void* ret_data, int& ret_len, int arg_max_len, std::size_t arg_elem_bytes);
+  };
+
+} /* namespace scl */
+
+#endif /* CIOSHM_HPP_ */
@@ -33,5 +33,6 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #define SRC_SCL_PARSER_ALLHEADERS_HPP_
 
 #include <scl/parser/sclparser/CParserScl.hpp>
+#include <scl/parser/sclparser/CParserSclCache.hpp>
 
 #endif /* SRC_SCL_PARSER_ALLHEADERS_HPP_ */
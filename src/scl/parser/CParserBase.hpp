@@ -91,6 +91,12 @@ namespace scl
          * this data structure */
         scl::SRobotParsed& arg_robot)=0;
 
+    /** Whether readRobotFromFile() may be called for different robots from
+     * several threads at once. Parsers that keep state while reading a
+     * file must return false (default), which makes loads sequential. */
+    virtual bool isThreadSafe() const
+    { return false; }
+
     /** Saves a robot definition to file.
      * Takes the name of the robot and a file name as aguments.
      *
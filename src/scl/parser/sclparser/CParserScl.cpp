@@ -40,11 +40,17 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 //The tinyxml parser implementation for scl xml files
 #include <scl_tinyxml/scl_tinyxml.h>
 #include <scl/parser/sclparser/tixml_parser/CParserSclTiXml.hpp>
+#include <scl/parser/sclparser/CParserSclCache.hpp>
 
 //The Standard cpp headers
 #include <sstream>
 #include <stdexcept>
 #include <utility>
+#include <map>
+#include <mutex>
+#include <memory>
+
+#include <sys/stat.h>
 
 
 using namespace scl_tinyxml; //Tinyxml parser implementation is in a separate namespace
@@ -85,25 +91,123 @@ namespace scl{
 
 namespace scl {
 
+namespace
+{
+  /** A parsed document and the file state it was parsed from */
+  struct SXmlCacheEntry
+  {
+    std::shared_ptr<TiXmlDocument> doc_;
+    struct timespec mtime_;
+    off_t size_;
+  };
+
+  struct SXmlCache
+  {
+    std::mutex mutex_;
+    std::map<std::string, SXmlCacheEntry> docs_;
+    bool enabled_ = true;
+    SXmlCacheStats stats_;
+    /** Number of live load scopes */
+    int loads_ = 0;
+  };
+
+  SXmlCache& xmlCache()
+  { static SXmlCache c; return c; }
+}
+
+std::shared_ptr<TiXmlDocument> CParserScl::loadXmlFile(const std::string& arg_file)
+{
+  struct stat st;
+  if(0 != stat(arg_file.c_str(), &st))
+  { return std::shared_ptr<TiXmlDocument>(); }
+
+  SXmlCache& c = xmlCache();
+  {
+    std::lock_guard<std::mutex> lock(c.mutex_);
+    if(c.enabled_)
+    {
+      auto it = c.docs_.find(arg_file);
+      if(it != c.docs_.end() && it->second.size_ == st.st_size &&
+          it->second.mtime_.tv_sec == st.st_mtim.tv_sec &&
+          it->second.mtime_.tv_nsec == st.st_mtim.tv_nsec)
+      { c.stats_.hits_++; return it->second.doc_; }
+    }
+    c.stats_.misses_++;
+  }
+
+  // Parse outside the lock so different files can load in parallel
+  std::shared_ptr<TiXmlDocument> doc(new TiXmlDocument(arg_file.c_str()));
+  if(false == doc->LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN))
+  { return std::shared_ptr<TiXmlDocument>(); }
+
+  std::lock_guard<std::mutex> lock(c.mutex_);
+  if(c.enabled_)
+  {
+    SXmlCacheEntry& e = c.docs_[arg_file];
+    e.doc_ = doc;
+    e.mtime_ = st.st_mtim;
+    e.size_ = st.st_size;
+  }
+  return doc;
+}
+
+void CParserScl::clearXmlCache()
+{
+  std::lock_guard<std::mutex> lock(xmlCache().mutex_);
+  xmlCache().docs_.clear();
+}
+
+CXmlLoadScope::CXmlLoadScope()
+{
+  std::lock_guard<std::mutex> lock(xmlCache().mutex_);
+  xmlCache().loads_++;
+}
+
+CXmlLoadScope::~CXmlLoadScope()
+{
+  std::lock_guard<std::mutex> lock(xmlCache().mutex_);
+  xmlCache().loads_--;
+  if(0 == xmlCache().loads_) { xmlCache().docs_.clear(); }
+}
+
+void CParserScl::setXmlCacheEnabled(bool arg_flag)
+{
+  std::lock_guard<std::mutex> lock(xmlCache().mutex_);
+  xmlCache().enabled_ = arg_flag;
+  if(false == arg_flag) { xmlCache().docs_.clear(); }
+}
+
+bool CParserScl::getXmlCacheEnabled()
+{
+  std::lock_guard<std::mutex> lock(xmlCache().mutex_);
+  return xmlCache().enabled_;
+}
+
+SXmlCacheStats CParserScl::getXmlCacheStats()
+{
+  std::lock_guard<std::mutex> lock(xmlCache().mutex_);
+  SXmlCacheStats ret = xmlCache().stats_;
+  ret.entries_ = xmlCache().docs_.size();
+  return ret;
+}
+
 bool CParserScl::listRobotsInFile(const std::string& arg_file,
     std::vector<std::string>& arg_robot_names)
 {
-  bool flag;
   try
   {
     //Set up the parser.
     TiXmlElement* tiElem_robot;
     TiXmlHandle tiHndl_glob_settings(NULL), tiHndl_file_handle(NULL), tiHndl_world(NULL);
 
-    TiXmlDocument tiDoc_file(arg_file.c_str());
+    std::shared_ptr<TiXmlDocument> tiDoc_file = loadXmlFile(arg_file);
 
     //Check if file opened properly
-    flag = tiDoc_file.LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN);
-    if(false == flag)
+    if(S_NULL == tiDoc_file)
     { throw std::runtime_error("Could not open xml file to read robots."); }
 
     //Get handles to the tinyxml loaded ds
-    tiHndl_file_handle = TiXmlHandle( &tiDoc_file );
+    tiHndl_file_handle = TiXmlHandle( tiDoc_file.get() );
     tiHndl_world = tiHndl_file_handle.FirstChildElement( "scl" );
 
     //Read in the robots.
@@ -140,6 +244,31 @@ bool CParserScl::readRobotFromFile(const std::string& arg_file,
     const std::string& arg_robot_spec_base_dir,
     const std::string& arg_robot_name,
     scl::SRobotParsed& arg_robot)
+{
+  // Use the compiled cache if none of the robot's xml files have changed
+  if(CParserSclCache::load(arg_file, arg_robot_spec_base_dir, arg_robot_name, arg_robot))
+  { return true; }
+
+  std::string spec_file;
+  bool flag = readRobotFromXml(arg_file, arg_robot_spec_base_dir, arg_robot_name, arg_robot, spec_file);
+  if(false == flag) { return false; }
+
+  // A failed save only costs the next launch a parse.
+  if(CParserSclCache::getEnabled())
+  {
+    std::vector<std::string> deps;
+    deps.push_back(arg_file);
+    if(spec_file != arg_file) { deps.push_back(spec_file); }
+    CParserSclCache::save(arg_file, arg_robot_spec_base_dir, arg_robot_name, deps, arg_robot);
+  }
+  return true;
+}
+
+bool CParserScl::readRobotFromXml(const std::string& arg_file,
+    const std::string& arg_robot_spec_base_dir,
+    const std::string& arg_robot_name,
+    scl::SRobotParsed& arg_robot,
+    std::string& ret_spec_file)
 {
   bool flag;
   SRigidBody* tmp_link_ds=S_NULL;
@@ -149,15 +278,14 @@ bool CParserScl::readRobotFromFile(const std::string& arg_file,
     //Set up the parser.
     TiXmlElement* tiElem_robot;
     TiXmlHandle tiHndl_file_handle(NULL), tiHndl_world(NULL);
-    TiXmlDocument tiDoc_file(arg_file.c_str());
+    std::shared_ptr<TiXmlDocument> tiDoc_file = loadXmlFile(arg_file);
 
     //Check if file opened properly
-    flag = tiDoc_file.LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN);
-    if(false == flag)
+    if(S_NULL == tiDoc_file)
     { throw std::runtime_error("Could not open xml file to read robot definition."); }
 
     //Get handles to the tinyxml loaded ds
-    tiHndl_file_handle = TiXmlHandle( &tiDoc_file );
+    tiHndl_file_handle = TiXmlHandle( tiDoc_file.get() );
     tiHndl_world = tiHndl_file_handle.FirstChildElement( "scl" );
 
     // *****************************************************************
@@ -364,6 +492,7 @@ bool CParserScl::readRobotFromFile(const std::string& arg_file,
       }
       else
       { throw(std::runtime_error("\nError reading robot spec file name")); }
+      ret_spec_file = spec_file;
 
       //Add the root node
       tmp_link_ds = new SRigidBody();
@@ -643,7 +772,7 @@ bool CParserScl::readRobotFromFile(const std::string& arg_file,
   catch(std::exception& e)
   {
     if(S_NULL!=tmp_link_ds) { delete tmp_link_ds; } //Clear out memory
-    std::cerr<<"\nCParserScl::readRobotFromFile("<<arg_file<<", "
+    std::cerr<<"\nCParserScl::readRobotFromXml("<<arg_file<<", "
         <<arg_robot_name<<") : "<<e.what();
   }
   return false;
@@ -662,16 +791,15 @@ bool CParserScl::readRobotSpecFromFile(const std::string& arg_spec_file,
     //Set up the parser.
     TiXmlElement* tiElem_robot;
     TiXmlHandle tiHndl_file_handle(NULL), tiHndl_world(NULL);
-    TiXmlDocument tiDoc_file(arg_spec_file.c_str());
+    std::shared_ptr<TiXmlDocument> tiDoc_file = loadXmlFile(arg_spec_file);
 
     //Check if file opened properly
-    flag = tiDoc_file.LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN);
-    if(false == flag)
+    if(S_NULL == tiDoc_file)
     { throw std::runtime_error("Could not open xml file to read robot spec"); }
 
 
     //Get handles to the tinyxml loaded ds
-    tiHndl_file_handle = TiXmlHandle( &tiDoc_file );
+    tiHndl_file_handle = TiXmlHandle( tiDoc_file.get() );
     tiHndl_world = tiHndl_file_handle.FirstChildElement( "scl" );
 
     //Read in the links.
@@ -764,16 +892,15 @@ bool CParserScl::readActuatorSetMuscleFromFile(
     //Set up the parser.
     TiXmlElement* tiElem_muscle;
     TiXmlHandle tiHndl_file_handle(NULL), tiHndl_world(NULL);
-    TiXmlDocument tiDoc_file(arg_spec_file.c_str());
+    std::shared_ptr<TiXmlDocument> tiDoc_file = loadXmlFile(arg_spec_file);
 
     //Check if file opened properly
-    flag = tiDoc_file.LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN);
-    if(false == flag)
+    if(S_NULL == tiDoc_file)
     { throw std::runtime_error("Could not open xml file to read muscle spec"); }
 
 
     //Get handles to the tinyxml loaded ds
-    tiHndl_file_handle = TiXmlHandle( &tiDoc_file );
+    tiHndl_file_handle = TiXmlHandle( tiDoc_file.get() );
     tiHndl_world = tiHndl_file_handle.FirstChildElement( "scl" );
 
     //Read in the links.
@@ -1046,15 +1173,14 @@ bool CParserScl::readGraphicsFromFile(const std::string &arg_file,
     TiXmlElement* tiElem_graphics, *tiElem_lights, *tiElem_bkg_color;
     TiXmlHandle tiHndl_glob_settings(NULL), tiHndl_file_handle(NULL), tiHndl_world(NULL);
 
-    TiXmlDocument tiDoc_file(arg_file.c_str());
+    std::shared_ptr<TiXmlDocument> tiDoc_file = loadXmlFile(arg_file);
 
     //Check if file opened properly
-    flag = tiDoc_file.LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN);
-    if(false == flag)
+    if(S_NULL == tiDoc_file)
     { throw std::runtime_error("Could not open xml file to read graphics definition."); }
 
     //Get handles to the tinyxml loaded ds
-    tiHndl_file_handle = TiXmlHandle( &tiDoc_file );
+    tiHndl_file_handle = TiXmlHandle( tiDoc_file.get() );
     tiHndl_world = tiHndl_file_handle.FirstChildElement( "scl" );
 
     //2. Read in the links.
@@ -1204,15 +1330,14 @@ bool CParserScl::readUISpecFromFile(const std::string &arg_file,
     TiXmlElement* tiElem_ui, *tiElem_sub;
     TiXmlHandle tiHndl_glob_settings(NULL), tiHndl_file_handle(NULL), tiHndl_world(NULL);
 
-    TiXmlDocument tiDoc_file(arg_file.c_str());
+    std::shared_ptr<TiXmlDocument> tiDoc_file = loadXmlFile(arg_file);
 
     //Check if file opened properly
-    flag = tiDoc_file.LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN);
-    if(false == flag)
+    if(S_NULL == tiDoc_file)
     { throw std::runtime_error("Could not open xml file to read ui definition."); }
 
     //Get handles to the tinyxml loaded ds
-    tiHndl_file_handle = TiXmlHandle( &tiDoc_file );
+    tiHndl_file_handle = TiXmlHandle( tiDoc_file.get() );
     tiHndl_world = tiHndl_file_handle.FirstChildElement( "scl" );
 
     //2. Read in the links.
@@ -1473,22 +1598,20 @@ bool CParserScl::readUISpecFromFile(const std::string &arg_file,
 bool CParserScl::listGraphicsInFile(const std::string& arg_file,
     std::vector<std::string>& arg_graphics_names)
 {
-  bool flag;
   try
   {
     //Set up the parser.
     TiXmlElement* tiElem_robot;
     TiXmlHandle tiHndl_glob_settings(NULL), tiHndl_file_handle(NULL), tiHndl_world(NULL);
 
-    TiXmlDocument tiDoc_file(arg_file.c_str());
+    std::shared_ptr<TiXmlDocument> tiDoc_file = loadXmlFile(arg_file);
 
     //Check if file opened properly
-    flag = tiDoc_file.LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN);
-    if(false == flag)
+    if(S_NULL == tiDoc_file)
     { throw std::runtime_error("Could not open xml file to read graphics."); }
 
     //Get handles to the tinyxml loaded ds
-    tiHndl_file_handle = TiXmlHandle( &tiDoc_file );
+    tiHndl_file_handle = TiXmlHandle( tiDoc_file.get() );
     tiHndl_world = tiHndl_file_handle.FirstChildElement( "scl" );
 
     //2. Read in the robots.
@@ -1532,22 +1655,20 @@ bool CParserScl::listGraphicsInFile(const std::string& arg_file,
 bool CParserScl::listUISpecsInFile(const std::string& arg_file,
     std::vector<std::string>& arg_ui_spec_names)
 {
-  bool flag;
   try
   {
     //Set up the parser.
     TiXmlElement* tiElem_robot;
     TiXmlHandle tiHndl_glob_settings(NULL), tiHndl_file_handle(NULL), tiHndl_world(NULL);
 
-    TiXmlDocument tiDoc_file(arg_file.c_str());
+    std::shared_ptr<TiXmlDocument> tiDoc_file = loadXmlFile(arg_file);
 
     //Check if file opened properly
-    flag = tiDoc_file.LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN);
-    if(false == flag)
+    if(S_NULL == tiDoc_file)
     { throw std::runtime_error("Could not open xml file to read user interfaces."); }
 
     //Get handles to the tinyxml loaded ds
-    tiHndl_file_handle = TiXmlHandle( &tiDoc_file );
+    tiHndl_file_handle = TiXmlHandle( tiDoc_file.get() );
     tiHndl_world = tiHndl_file_handle.FirstChildElement( "scl" );
 
     //2. Read in the robots.
@@ -1591,22 +1712,20 @@ bool CParserScl::listUISpecsInFile(const std::string& arg_file,
 bool CParserScl::listControllersInFile(const std::string &arg_file,
       std::vector<std::pair<std::string,std::string> > &arg_ctrl_name_and_type)
 {
-  bool flag;
   try
   {
     //Set up the parser.
     TiXmlElement* tiElem_ctrl;
     TiXmlHandle tiHndl_glob_settings(NULL), tiHndl_file_handle(NULL), tiHndl_world(NULL);
 
-    TiXmlDocument tiDoc_file(arg_file.c_str());
+    std::shared_ptr<TiXmlDocument> tiDoc_file = loadXmlFile(arg_file);
 
     //Check if file opened properly
-    flag = tiDoc_file.LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN);
-    if(false == flag)
+    if(S_NULL == tiDoc_file)
     { throw std::runtime_error("Could not open xml file to read controllers."); }
 
     //Get handles to the tinyxml loaded ds
-    tiHndl_file_handle = TiXmlHandle( &tiDoc_file );
+    tiHndl_file_handle = TiXmlHandle( tiDoc_file.get() );
     tiHndl_world = tiHndl_file_handle.FirstChildElement( "scl" );
 
     //Read in the robots.
@@ -1652,15 +1771,14 @@ bool CParserScl::readGcControllerFromFile(const std::string &arg_file,
     TiXmlElement* tiElem_gc_ctrl;
     TiXmlHandle tiHndl_glob_settings(NULL), tiHndl_file_handle(NULL), tiHndl_world(NULL);
 
-    TiXmlDocument tiDoc_file(arg_file.c_str());
+    std::shared_ptr<TiXmlDocument> tiDoc_file = loadXmlFile(arg_file);
 
     //Check if file opened properly
-    flag = tiDoc_file.LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN);
-    if(false == flag)
+    if(S_NULL == tiDoc_file)
     { throw std::runtime_error("Could not open xml file to read gc-controller definition."); }
 
     //Get handles to the tinyxml loaded ds
-    tiHndl_file_handle = TiXmlHandle( &tiDoc_file );
+    tiHndl_file_handle = TiXmlHandle( tiDoc_file.get() );
     tiHndl_world = tiHndl_file_handle.FirstChildElement( "scl" );
 
     //2. Read in the controller.
@@ -1860,15 +1978,14 @@ bool CParserScl::readTaskControllerFromFile(const std::string &arg_file,
     TiXmlElement* tiElem_tctrl_ctrl, * tiElem_task_ctrl;
     TiXmlHandle tiHndl_glob_settings(NULL), tiHndl_file_handle(NULL), tiHndl_world(NULL);
 
-    TiXmlDocument tiDoc_file(arg_file.c_str());
+    std::shared_ptr<TiXmlDocument> tiDoc_file = loadXmlFile(arg_file);
 
     //Check if file opened properly
-    flag = tiDoc_file.LoadFile(scl_tinyxml::TIXML_ENCODING_UNKNOWN);
-    if(false == flag)
+    if(S_NULL == tiDoc_file)
     { throw(std::runtime_error("Could not open xml file to read task-controller definition.")); }
 
     //Get handles to the tinyxml loaded ds
-    tiHndl_file_handle = TiXmlHandle( &tiDoc_file );
+    tiHndl_file_handle = TiXmlHandle( tiDoc_file.get() );
     tiHndl_world = tiHndl_file_handle.FirstChildElement( "scl" );
 
     //2. Read in the links.
@@ -37,8 +37,19 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <scl/data_structs/SRobotParsed.hpp>
 #include <scl/data_structs/SGraphicsParsed.hpp>
 
+#include <memory>
+
+namespace scl_tinyxml { class TiXmlDocument; }
+
 namespace scl {
 
+/** Usage counters for the parser's xml document cache */
+struct SXmlCacheStats
+{
+  std::size_t entries_=0;
+  sLongLong hits_=0, misses_=0;
+};
+
 /**
  * This class implements the entire CParserBase API.
  *
@@ -54,6 +65,12 @@ public:
   virtual bool listRobotsInFile(const std::string& arg_file,
       std::vector<std::string>& arg_robot_names);
 
+  /** The scl parser keeps no state between calls (its caches are locked) */
+  virtual bool isThreadSafe() const
+  { return true; }
+
+  /** Reads a robot. Uses the compiled cache (see CParserSclCache)
+   * when the robot's xml files haven't changed since it was written. */
   virtual bool readRobotFromFile(const std::string& arg_file,
       const std::string& arg_robot_spec_base_dir,
       const std::string& arg_robot_name,
@@ -98,7 +115,35 @@ public:
        * Format : <tag>, <data-string> */
       std::vector<scl::sString2> ret_nonstd_params);
 
+  /** Returns a parsed xml document (NULL if the file can't be read or parsed).
+   *
+   * Documents are shared by all the read and list calls (parsing a config file
+   * reads it once per robot, graphics, ui and controller spec). They are keyed
+   * by path and re-parsed if the file's mtime or size changes.
+   *
+   * NOTE : The document is shared. Don't modify it.
+   * NOTE : Thread safe. */
+  static std::shared_ptr<scl_tinyxml::TiXmlDocument> loadXmlFile(const std::string& arg_file);
+
+  /** Drops all the cached documents (readers holding one keep it alive).
+   * Loads clear it when they are done (see CXmlLoadScope). */
+  static void clearXmlCache();
+
+  /** When disabled, every call re-reads its file (and nothing is cached) */
+  static void setXmlCacheEnabled(bool arg_flag);
+  static bool getXmlCacheEnabled();
+
+  static SXmlCacheStats getXmlCacheStats();
+
 private:
+  /** Parses a robot from its xml file (readRobotFromFile() checks the
+   * compiled cache first). Also returns the robot's spec file. */
+  bool readRobotFromXml(const std::string& arg_file,
+      const std::string& arg_robot_spec_base_dir,
+      const std::string& arg_robot_name,
+      scl::SRobotParsed& arg_robot,
+      std::string& ret_spec_file);
+
   /** Reads a robot specification from a file */
   bool readRobotSpecFromFile(const std::string& arg_spec_file,
       const std::string& arg_robot_spec_base_dir,
@@ -115,6 +160,21 @@ private:
       scl::SActuatorSetMuscleParsed& ret_mset);
 };
 
+/** Scopes the xml document cache to a load (eg. parseEverythingInFile()).
+ *
+ * The read and list calls inside the scope share the parsed files. When
+ * the outermost scope ends, the cache is cleared so the documents don't
+ * stay in memory for the rest of the process. Scopes can nest. */
+class CXmlLoadScope
+{
+public:
+  CXmlLoadScope();
+  ~CXmlLoadScope();
+private:
+  CXmlLoadScope(const CXmlLoadScope&);
+  CXmlLoadScope& operator=(const CXmlLoadScope&);
+};
+
 }
 
 #endif /*CPARSERSCL_HPP_*/
@@ -0,0 +1,314 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CParserSclCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include <scl/parser/sclparser/CParserSclCache.hpp>
+#include <scl/serialization/SerializationBinary.hpp>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace scl
+{
+  namespace
+  {
+    const std::uint32_t SCL_CACHE_MAGIC = 0x43534c43; // "CLSC" in a little-endian file
+    const char* SCL_CACHE_EXT = ".sclcache";
+
+    /** Cache settings. Read from the environment on first use. */
+    struct SCacheSettings
+    {
+      std::atomic<bool> enabled_;
+      std::mutex mutex_dir_;
+      std::string dir_;
+      std::atomic<std::uint64_t> hits_, misses_;
+
+      SCacheSettings() : enabled_(true), hits_(0), misses_(0)
+      {
+        const char* env = std::getenv("SCL_MODEL_CACHE");
+        if(NULL != env && std::string("0") == env) { enabled_ = false; }
+
+        env = std::getenv("SCL_MODEL_CACHE_DIR");
+        if(NULL != env && '\0' != env[0]) { dir_ = env; }
+        else
+        {
+          env = std::getenv("HOME");
+          if(NULL != env && '\0' != env[0]) { dir_ = std::string(env) + "/.cache/scl/"; }
+          else { dir_ = "/tmp/scl_cache/"; }
+        }
+        if('/' != dir_[dir_.size()-1]) { dir_ += '/'; }
+      }
+    };
+
+    SCacheSettings& settings()
+    { static SCacheSettings s; return s; }
+
+    /** A read-only mmap of a whole file. Unmaps itself. */
+    class CMappedFile
+    {
+    public:
+      CMappedFile() : data_(NULL), size_(0) {}
+      ~CMappedFile() { if(NULL != data_) { munmap(const_cast<char*>(data_), size_); } }
+
+      bool open(const std::string& arg_file)
+      {
+        int fd = ::open(arg_file.c_str(), O_RDONLY);
+        if(0 > fd) { return false; }
+        struct stat st;
+        if(0 != fstat(fd, &st)) { ::close(fd); return false; }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if(0 == size_) { ::close(fd); return true; } //Can't map empty files
+        void* p = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if(MAP_FAILED == p) { size_ = 0; return false; }
+        data_ = static_cast<const char*>(p);
+        return true;
+      }
+
+      const char* data_;
+      std::size_t size_;
+    };
+
+    /** Creates a directory and its parents (like mkdir -p) */
+    bool makeDir(const std::string& arg_dir)
+    {
+      for(std::size_t i = 1; i <= arg_dir.size(); ++i)
+      {
+        if(i == arg_dir.size() || '/' == arg_dir[i])
+        {
+          std::string d = arg_dir.substr(0,i);
+          if(0 != mkdir(d.c_str(), 0755) && EEXIST != errno) { return false; }
+        }
+      }
+      return true;
+    }
+  }
+
+  bool CParserSclCache::getEnabled()
+  { return settings().enabled_; }
+
+  void CParserSclCache::setEnabled(bool arg_flag)
+  { settings().enabled_ = arg_flag; }
+
+  std::string CParserSclCache::getDir()
+  {
+    std::lock_guard<std::mutex> lock(settings().mutex_dir_);
+    return settings().dir_;
+  }
+
+  void CParserSclCache::setDir(const std::string& arg_dir)
+  {
+    std::lock_guard<std::mutex> lock(settings().mutex_dir_);
+    settings().dir_ = arg_dir;
+    if(settings().dir_.empty() || '/' != settings().dir_[settings().dir_.size()-1])
+    { settings().dir_ += '/'; }
+  }
+
+  std::uint64_t CParserSclCache::getHits()
+  { return settings().hits_; }
+
+  std::uint64_t CParserSclCache::getMisses()
+  { return settings().misses_; }
+
+  std::string CParserSclCache::getCacheFile(const std::string& arg_file,
+      const std::string& arg_robot_spec_base_dir,
+      const std::string& arg_robot_name)
+  {
+    // The separators keep ("ab","c") and ("a","bc") apart
+    std::string key = arg_file + '\n' + arg_robot_spec_base_dir + '\n' + arg_robot_name;
+    std::stringstream ss;
+    ss<<getDir()<<std::hex<<hashFNV1a(key.data(), key.size())<<"-"<<arg_robot_name<<SCL_CACHE_EXT;
+    return ss.str();
+  }
+
+  bool CParserSclCache::hashFile(const std::string& arg_file,
+      std::uint64_t& ret_hash, std::uint64_t& ret_size)
+  {
+    CMappedFile f;
+    if(false == f.open(arg_file)) { return false; }
+    ret_size = f.size_;
+    ret_hash = hashFNV1a(f.data_, f.size_);
+    return true;
+  }
+
+  bool CParserSclCache::load(const std::string& arg_file,
+      const std::string& arg_robot_spec_base_dir,
+      const std::string& arg_robot_name,
+      SRobotParsed& ret_robot)
+  {
+    try
+    {
+      if(false == getEnabled()) { return false; }
+
+      CMappedFile f;
+      if(false == f.open(getCacheFile(arg_file, arg_robot_spec_base_dir, arg_robot_name)))
+      { settings().misses_++; return false; }
+
+      // Check the header
+      CBinaryReader r(f.data_, f.size_);
+      std::uint32_t magic=0, version=0, n_deps=0;
+      std::string file, base_dir, robot_name;
+      r.readU32(magic); r.readU32(version);
+      if(!r.ok() || SCL_CACHE_MAGIC != magic || SCL_BINARY_FORMAT_VERSION != version)
+      { throw(std::runtime_error("Wrong format or version")); }
+
+      r.readString(file); r.readString(base_dir); r.readString(robot_name);
+      if(!r.ok() || file != arg_file || base_dir != arg_robot_spec_base_dir || robot_name != arg_robot_name)
+      { throw(std::runtime_error("Key doesn't match (hash collision?)")); }
+
+      // Check the xml files the robot was parsed from
+      r.readU32(n_deps);
+      if(!r.ok() || 0 == n_deps) { throw(std::runtime_error("Missing dependency list")); }
+      for(std::uint32_t i=0; i<n_deps; ++i)
+      {
+        std::string dep;
+        std::uint64_t size, hash, size_now, hash_now;
+        r.readString(dep); r.readU64(size); r.readU64(hash);
+        if(!r.ok()) { throw(std::runtime_error("Truncated dependency list")); }
+        if(false == hashFile(dep, hash_now, size_now) || size != size_now || hash != hash_now)
+        { throw(std::runtime_error(std::string("Stale. Changed file : ") + dep)); }
+      }
+
+      // Check the payload
+      std::uint64_t size, hash;
+      r.readU64(size); r.readU64(hash);
+      if(!r.ok() || size != r.remaining() || hash != hashFNV1a(r.current(), r.remaining()))
+      { throw(std::runtime_error("Corrupt payload")); }
+
+      if(false == deserializeFromBinary(ret_robot, r.current(), r.remaining()))
+      {
+        ret_robot.reset();
+        throw(std::runtime_error("Could not decode the robot"));
+      }
+    }
+    catch(std::exception& e)
+    {
+#ifdef DEBUG
+      std::cout<<"\nCParserSclCache::load("<<arg_file<<", "<<arg_robot_name<<") : Not using cache. "<<e.what();
+#endif
+      settings().misses_++;
+      return false;
+    }
+    settings().hits_++;
+    return true;
+  }
+
+  bool CParserSclCache::save(const std::string& arg_file,
+      const std::string& arg_robot_spec_base_dir,
+      const std::string& arg_robot_name,
+      const std::vector<std::string>& arg_deps,
+      const SRobotParsed& arg_robot)
+  {
+    std::string tmp_file;
+    try
+    {
+      if(false == getEnabled()) { return false; }
+
+      std::string payload;
+      if(false == serializeToBinary(arg_robot, payload))
+      { throw(std::runtime_error("Could not serialize the robot")); }
+
+      std::string buf;
+      CBinaryWriter w(buf);
+      w.writeU32(SCL_CACHE_MAGIC);
+      w.writeU32(SCL_BINARY_FORMAT_VERSION);
+      w.writeString(arg_file);
+      w.writeString(arg_robot_spec_base_dir);
+      w.writeString(arg_robot_name);
+      w.writeU32(static_cast<std::uint32_t>(arg_deps.size()));
+      for(const auto& dep : arg_deps)
+      {
+        std::uint64_t size, hash;
+        if(false == hashFile(dep, hash, size))
+        { throw(std::runtime_error(std::string("Could not read dependency : ") + dep)); }
+        w.writeString(dep); w.writeU64(size); w.writeU64(hash);
+      }
+      w.writeU64(payload.size());
+      w.writeU64(hashFNV1a(payload.data(), payload.size()));
+      w.writeRaw(payload.data(), payload.size());
+
+      if(false == makeDir(getDir()))
+      { throw(std::runtime_error(std::string("Could not create cache dir : ") + getDir())); }
+
+      // Write a temp file and rename it, so readers (other apps, threads)
+      // never see a partial cache file.
+      std::string cache_file = getCacheFile(arg_file, arg_robot_spec_base_dir, arg_robot_name);
+      std::stringstream ss; ss<<cache_file<<".tmp"<<getpid()<<"."<<static_cast<const void*>(&buf);
+      tmp_file = ss.str();
+
+      FILE* fp = std::fopen(tmp_file.c_str(), "wb");
+      if(NULL == fp) { throw(std::runtime_error(std::string("Could not open : ") + tmp_file)); }
+      bool flag = (buf.size() == std::fwrite(buf.data(), 1, buf.size(), fp));
+      flag = (0 == std::fclose(fp)) && flag;
+      if(false == flag) { throw(std::runtime_error(std::string("Could not write : ") + tmp_file)); }
+
+      if(0 != std::rename(tmp_file.c_str(), cache_file.c_str()))
+      { throw(std::runtime_error(std::string("Could not rename to : ") + cache_file)); }
+    }
+    catch(std::exception& e)
+    {
+      if(!tmp_file.empty()) { std::remove(tmp_file.c_str()); }
+      std::cerr<<"\nCParserSclCache::save("<<arg_file<<", "<<arg_robot_name<<") : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+
+  bool CParserSclCache::clear()
+  {
+    std::string dir = getDir();
+    DIR* d = opendir(dir.c_str());
+    if(NULL == d) { return true; } //Nothing cached yet
+
+    bool flag = true;
+    std::string ext(SCL_CACHE_EXT);
+    for(struct dirent* e = readdir(d); NULL != e; e = readdir(d))
+    {
+      std::string name(e->d_name);
+      if(name.size() > ext.size() && 0 == name.compare(name.size()-ext.size(), ext.size(), ext))
+      { flag = (0 == std::remove((dir+name).c_str())) && flag; }
+    }
+    closedir(d);
+    return flag;
+  }
+}
@@ -0,0 +1,114 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CParserSclCache.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CPARSERSCLCACHE_HPP_
+#define CPARSERSCLCACHE_HPP_
+
+#include <scl/data_structs/SRobotParsed.hpp>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace scl
+{
+  /** A compiled (binary) cache of parsed robots, so that apps don't
+   * re-parse the xml files every time they start.
+   *
+   * Each (file, spec base dir, robot) has one cache file:
+   *   <dir>/<hash of the key>-<robot name>.sclcache
+   *
+   * The cache file stores the format version, the key, and the path, size
+   * and content hash (FNV-1a) of every xml file the robot was read from
+   * (the robot's file and its spec file). A cache is only used if all
+   * of them still match, so editing any xml file falls back to the parser.
+   *
+   * Cache files are mmap'd and decoded in place. The only pointer fixup is
+   * linking and sorting the robot's tree (SRobotParsed::init()).
+   *
+   * Scope : Only robots (SRobotParsed, with their muscle sets) are cached.
+   * A cache hit skips the robot's spec and muscle xml, but the cfg file is
+   * still parsed once per process (shared through CParserScl's xml document
+   * cache) for the list*InFile() calls and for the graphics, UI and
+   * controller specs. Those are small, and the task specs are only
+   * interpreted later by each registered task type (task_nonstd_params_).
+   *
+   * Environment variables:
+   *   SCL_MODEL_CACHE=0      : Disables the cache.
+   *   SCL_MODEL_CACHE_DIR=.. : Cache directory. Default : $HOME/.cache/scl/
+   */
+  class CParserSclCache
+  {
+  public:
+    /** Reads a robot from its cache file. Returns false (and leaves the
+     * robot untouched) if there is no cache or if it is stale. */
+    static bool load(const std::string& arg_file,
+        const std::string& arg_robot_spec_base_dir,
+        const std::string& arg_robot_name,
+        SRobotParsed& ret_robot);
+
+    /** Writes a (freshly parsed) robot's cache file. The dependencies are
+     * the xml files the robot was read from. */
+    static bool save(const std::string& arg_file,
+        const std::string& arg_robot_spec_base_dir,
+        const std::string& arg_robot_name,
+        const std::vector<std::string>& arg_deps,
+        const SRobotParsed& arg_robot);
+
+    /** Deletes all the cache files in the cache directory */
+    static bool clear();
+
+    static bool getEnabled();
+    static void setEnabled(bool arg_flag);
+
+    /** The cache directory (ends with a '/') */
+    static std::string getDir();
+    static void setDir(const std::string& arg_dir);
+
+    /** The cache file for a robot */
+    static std::string getCacheFile(const std::string& arg_file,
+        const std::string& arg_robot_spec_base_dir,
+        const std::string& arg_robot_name);
+
+    /** Hashes a file's contents. Returns false if it can't be read. */
+    static bool hashFile(const std::string& arg_file,
+        std::uint64_t& ret_hash, std::uint64_t& ret_size);
+
+    /** Number of robots read from (or missing in) the cache */
+    static std::uint64_t getHits();
+    static std::uint64_t getMisses();
+
+  private:
+    CParserSclCache();
+  };
+}
+
+#endif /* CPARSERSCLCACHE_HPP_ */
@@ -31,6 +31,8 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdexcept>
 #include <cassert>
+#include <limits>
+#include <iostream>
 
 #include <scl/robot/CRobot.hpp>
 
@@ -38,6 +40,9 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <scl/control/gc/CControllerGc.hpp>
 #include <scl/control/task/CControllerMultiTask.hpp>
 
+#include <scl/util/CPerfStats.hpp>
+#include <scl/serialization/SerializationBinary.hpp>
+
 #include <scl_ext/dynamics/scl_spatial/CDynamicsSclSpatial.hpp>
 
 #include <sutil/CSystemClock.hpp>
@@ -54,6 +59,7 @@ namespace scl
    * Asserts false in debug mode if something bad happens */
   void CRobot::computeServo()
   {
+    SCL_PERF_SCOPE("robot::servo_tick");
     bool flag=true;
     if((S_NULL != ctrl_current_) && data_.has_been_init_)
     {
@@ -78,6 +84,8 @@ namespace scl
   void CRobot::computeDynamics()
   {
     bool flag = true;
+    if(flag_multi_rate_) { return; } //The model thread computes the dynamics.
+    if(asleep_) { return; } //The state hasn't changed, so the model is still valid.
     if((S_NULL != ctrl_current_)
         && data_.has_been_init_
         && data_.parsed_robot_data_->flag_controller_on_)
@@ -89,6 +97,26 @@ namespace scl
 #endif
   }
 
+  /** Multi-rate mode : Computes the robot's dynamic model into a back
+   * buffer and publishes it to the servo.
+   * Asserts false in debug mode if something bad happens */
+  void CRobot::computeDynamicsBuffered()
+  {
+    bool flag = true;
+    if(flag_multi_rate_
+        && false == asleep_
+        && (S_NULL != ctrl_current_)
+        && data_.has_been_init_
+        && data_.parsed_robot_data_->flag_controller_on_)
+    {
+      // NOTE : setFlagMultiRate ensures this is a task controller.
+      flag = static_cast<CControllerMultiTask*>(ctrl_current_)->computeDynamicsBuffered();
+    }
+#ifdef DEBUG
+    assert(flag);
+#endif
+  }
+
   /** Computes the robot's non-control related operations
    * Asserts false in debug mode if something bad happens */
   void CRobot::computeNonControlOperations()
@@ -116,6 +144,9 @@ namespace scl
     if((S_NULL != integrator_)
         && data_.has_been_init_)
     {
+      //A sleeping robot stays where it is.
+      if(flag_sleep_ && updateSleep()) { return; }
+
       //Apply gc limits and collision with heavy energy loss.
       if(data_.parsed_robot_data_->flag_apply_actuator_force_limits_) //Force limits controlled by a flag
       {
@@ -127,6 +158,7 @@ namespace scl
       scl_ext::CDynamicsSclSpatial *dyn_scl_sp = dynamic_cast<scl_ext::CDynamicsSclSpatial *> (integrator_);
       if(NULL != dyn_scl_sp)
       {
+        SCL_PERF_SCOPE("robot::integrate");
         dyn_scl_sp->integrate(data_.dyn_gc_model_, *(data_.io_data_),CDatabase::getData()->sim_dt_);
       }
       else // Must be Tao dyn (no longer supported)
@@ -179,6 +211,9 @@ namespace scl
 #endif
         }
       }
+
+      //Let the other threads see the integrated state
+      if(flag_publish_snapshots_) { publishSnapshot(); }
     }
 
 #ifdef DEBUG
@@ -186,6 +221,251 @@ namespace scl
 #endif
   }
 
+  /** Simulation thread : Publishes the current state */
+  void CRobot::publishSnapshot()
+  {
+    if(false == flag_publish_snapshots_ || false == data_.has_been_init_)
+    { return; }
+
+    SRobotSnapshot& snap = *snapshots_.beginWrite();
+    snap.q_ = data_.io_data_->sensors_.q_;
+    snap.dq_ = data_.io_data_->sensors_.dq_;
+    snap.force_gc_commanded_ = data_.io_data_->actuators_.force_gc_commanded_;
+    snap.tick_ = snapshot_tick_++;
+    snap.t_ = sutil::CSystemClock::getSimTime();
+
+    if(flag_snapshot_transforms_)
+    {
+      // NOTE : The integrator doesn't use the link transforms, so the
+      // integrator's model is free for computing them here.
+      sutil::CMappedTree<std::string, SRigidBodyDyn>& tree = data_.dyn_gc_model_.rbdyn_tree_;
+      dynamics_->computeTransformsForAllLinks(tree, snap.q_);
+
+      sutil::CMappedTree<std::string, SRigidBodyDyn>::iterator it,ite;
+      for(it = tree.begin(), ite = tree.end(); it!=ite; ++it)
+      {
+        if(S_NULL == it->link_ds_) { continue; }
+        const sInt id = it->link_ds_->link_id_;
+        if(0 <= id && static_cast<std::size_t>(id) < snap.T_o_lnk_.size())
+        { snap.T_o_lnk_[id] = it->T_o_lnk_; }
+      }
+    }
+
+    snapshots_.endWrite();
+  }
+
+  // **********************************************************************
+  //                       Sleep/wake (idle robots)
+  // **********************************************************************
+
+  sBool CRobot::setFlagSleep(sBool arg_flag, sFloat arg_ke_max,
+      sFloat arg_dfgc_max, sUInt arg_ticks)
+  {
+    try
+    {
+      if(false == data_.has_been_init_)
+      { throw(std::runtime_error("Robot not initialized"));}
+
+      wake();
+      if(false == arg_flag)
+      { flag_sleep_ = false; return true; }
+
+      if(0 > arg_ke_max || 0 > arg_dfgc_max)
+      { throw(std::runtime_error("The kinetic energy and force change thresholds can't be negative"));}
+      if(0 == arg_ticks)
+      { throw(std::runtime_error("The robot must be idle for at least one tick before it sleeps"));}
+
+      sleep_ke_max_ = arg_ke_max;
+      sleep_dfgc_max_ = arg_dfgc_max;
+      sleep_ticks_ = arg_ticks;
+      sleep_ctr_ticks_ = 0;
+      sleep_ctr_sleeps_ = 0;
+
+      //Preallocate so the servo loop never allocates.
+      const sUInt dof = data_.parsed_robot_data_->dof_;
+      sleep_fgc_.setZero(dof);
+      if(static_cast<sUInt>(data_.io_data_->actuators_.force_gc_commanded_.size()) == dof)
+      { sleep_fgc_ = data_.io_data_->actuators_.force_gc_commanded_; }
+      sleep_tmp_.setZero(dof);
+
+      flag_sleep_ = true;
+      return true;
+    }
+    catch(std::exception & e)
+    { std::cout<<"\nCRobot::setFlagSleep("<<data_.name_<<") Error : "<< e.what();  }
+    return false;
+  }
+
+  sBool CRobot::updateSleep()
+  {
+    SRobotSensors& sensors = data_.io_data_->sensors_;
+    const Eigen::VectorXd& fgc = data_.io_data_->actuators_.force_gc_commanded_;
+
+    //Contacts and pushes keep the robot awake.
+    if(0 < sensors.forces_external_.size() || fgc.size() != sleep_fgc_.size() || 0 == fgc.size())
+    {
+      wake();
+      if(fgc.size() == sleep_fgc_.size()) { sleep_fgc_ = fgc; }
+      return false;
+    }
+
+    const sFloat dfgc = (fgc - sleep_fgc_).cwiseAbs().maxCoeff();
+
+    if(asleep_)
+    {//Wake up as soon as the controller asks for something new.
+      if(dfgc > sleep_dfgc_max_)
+      { wake(); sleep_fgc_ = fgc; return false; }
+      ++sleep_ctr_ticks_;
+      return true;
+    }
+
+    //Awake : Count the idle ticks. The integrator's model has the mass
+    //matrix for the current state.
+    sleep_fgc_ = fgc;
+    const Eigen::MatrixXd& M = data_.dyn_gc_model_.M_gc_;
+    sFloat ke = std::numeric_limits<sFloat>::max();
+    if(M.rows() == sensors.dq_.size() && M.cols() == sensors.dq_.size())
+    {
+      sleep_tmp_.noalias() = M * sensors.dq_;
+      ke = 0.5 * sensors.dq_.dot(sleep_tmp_);
+    }
+
+    if(ke < sleep_ke_max_ && dfgc < sleep_dfgc_max_) { ++sleep_ctr_idle_; }
+    else { sleep_ctr_idle_ = 0; }
+    if(sleep_ctr_idle_ < sleep_ticks_) { return false; }
+
+    //Fall asleep at rest.
+    sensors.dq_.setZero();
+    sensors.ddq_.setZero();
+    asleep_ = true;
+    ++sleep_ctr_sleeps_;
+    ++sleep_ctr_ticks_;
+
+    //Readers see the robot at rest. The state won't change until it wakes.
+    if(flag_publish_snapshots_) { publishSnapshot(); }
+    return true;
+  }
+
+  // **********************************************************************
+  //                       Robot state checkpoints
+  // **********************************************************************
+
+  /** The first bytes of a saved robot state ("SCLS") */
+  static const std::uint32_t SCL_ROBOT_STATE_MAGIC = 0x534c4353;
+
+  std::uint64_t CRobot::hashStateLayout() const
+  {
+    std::uint64_t h = hashFNV1a(data_.name_.data(), data_.name_.size());
+    const std::uint64_t dof = data_.io_data_->dof_;
+    h = hashFNV1a(reinterpret_cast<const char*>(&dof), sizeof(dof), h);
+
+    const sutil::CMappedList<std::string, SForce>& forces = data_.io_data_->sensors_.forces_external_;
+    for(auto it = forces.begin(), ite = forces.end(); it!=ite; ++it)
+    { h = hashFNV1a(it->name_.data(), it->name_.size(), h); }
+
+    for(auto it = data_.controllers_.begin(), ite = data_.controllers_.end(); it!=ite; ++it)
+    {
+      h = hashFNV1a((*it)->name_.data(), (*it)->name_.size(), h);
+      const SControllerMultiTask* ctrl = dynamic_cast<const SControllerMultiTask*>(*it);
+      if(S_NULL == ctrl) { continue; }
+      for(auto itt = ctrl->tasks_.begin(), itte = ctrl->tasks_.end(); itt!=itte; ++itt)
+      {
+        const std::uint64_t dof_task = (*itt)->dof_task_;
+        h = hashFNV1a((*itt)->name_.data(), (*itt)->name_.size(), h);
+        h = hashFNV1a(reinterpret_cast<const char*>(&dof_task), sizeof(dof_task), h);
+      }
+    }
+    return h;
+  }
+
+  sBool CRobot::saveState(std::string& ret_blob) const
+  {
+    try
+    {
+      if(false == data_.has_been_init_)
+      { throw(std::runtime_error("Robot not initialized")); }
+
+      ret_blob.clear();
+      CBinaryWriter w(ret_blob);
+      w.writeU32(SCL_ROBOT_STATE_MAGIC);
+      w.writeU32(SCL_BINARY_FORMAT_VERSION);
+      w.writeU64(hashStateLayout());
+      w.writeDouble(sutil::CSystemClock::getSimTime());
+
+      serializeStateToBinary(*data_.io_data_, w);
+      serializeStateToBinary(data_.dyn_gc_model_, w);
+      w.writeU32(static_cast<std::uint32_t>(data_.controllers_.size()));
+      for(auto it = data_.controllers_.begin(), ite = data_.controllers_.end(); it!=ite; ++it)
+      { serializeStateToBinary(**it, w); }
+    }
+    catch(std::exception & e)
+    {
+      std::cout<<"\nCRobot::saveState("<<data_.name_<<") Error : "<< e.what();
+      return false;
+    }
+    return true;
+  }
+
+  sBool CRobot::restoreState(const char* arg_blob, const std::size_t arg_len)
+  {
+    try
+    {
+      if(false == data_.has_been_init_)
+      { throw(std::runtime_error("Robot not initialized")); }
+      if(flag_multi_rate_)
+      { throw(std::runtime_error("Can't restore a state in multi-rate mode (the model thread may publish an older model)")); }
+
+      CBinaryReader r(arg_blob, arg_len);
+      std::uint32_t magic=0, version=0;
+      std::uint64_t layout=0;
+      double t_sim=0.0;
+      r.readU32(magic); r.readU32(version); r.readU64(layout); r.readDouble(t_sim);
+      if(false == r.ok() || SCL_ROBOT_STATE_MAGIC != magic)
+      { throw(std::runtime_error("Not a saved robot state")); }
+      if(SCL_BINARY_FORMAT_VERSION != version)
+      { throw(std::runtime_error("Saved state has a different format version")); }
+      if(hashStateLayout() != layout)
+      { throw(std::runtime_error("Saved state is for a different robot, or different controllers/tasks/external forces")); }
+
+      if(false == deserializeStateFromBinary(*data_.io_data_, r))
+      { throw(std::runtime_error("Could not read the io data")); }
+      if(false == deserializeStateFromBinary(data_.dyn_gc_model_, r))
+      { throw(std::runtime_error("Could not read the integrator's gc model")); }
+      std::uint32_t n_ctrl=0;
+      if(false == r.readU32(n_ctrl) || n_ctrl != data_.controllers_.size())
+      { throw(std::runtime_error("Saved state has a different number of controllers")); }
+      for(auto it = data_.controllers_.begin(), ite = data_.controllers_.end(); it!=ite; ++it)
+      {
+        if(false == deserializeStateFromBinary(**it, r))
+        { throw(std::runtime_error(std::string("Could not read controller : ")+(*it)->name_)); }
+      }
+      if(0 != r.remaining())
+      { throw(std::runtime_error("Unexpected data after the state")); }
+
+      // The cached Jacobians and the online trajectories were computed for the
+      // state before the restore. Trajectories restart from the restored state.
+      for(auto it = ctrl_.begin(), ite = ctrl_.end(); it!=ite; ++it)
+      {
+        CControllerMultiTask* ctrl = dynamic_cast<CControllerMultiTask*>(*it);
+        if(S_NULL != ctrl) { ctrl->invalidateCaches(); }
+      }
+
+      // The restored state may not be at rest.
+      wake();
+
+      // The sim clock can only be ticked, so tick it back (or forward).
+      sutil::CSystemClock::tick(t_sim - sutil::CSystemClock::getSimTime());
+
+      if(flag_publish_snapshots_) { publishSnapshot(); }
+    }
+    catch(std::exception & e)
+    {
+      std::cout<<"\nCRobot::restoreState("<<data_.name_<<") Error : "<< e.what();
+      return false;
+    }
+    return true;
+  }
+
   // **********************************************************************
   //                       Initialization helper functions
   // **********************************************************************
@@ -503,6 +783,9 @@ namespace scl
       if(S_NULL == tmp_ds)
       { throw(std::runtime_error("Controller data structure not found."));}
 
+      //The buffered model belongs to the old controller.
+      if(flag_multi_rate_) { setFlagMultiRate(false); }
+
       ctrl_current_ = tmp_c;
       data_.controller_current_ = tmp_ds;
 
@@ -513,6 +796,68 @@ namespace scl
     return false;
   }
 
+  sBool CRobot::setFlagMultiRate(sBool arg_flag)
+  {
+    try
+    {
+      if(false == data_.has_been_init_)
+      { throw(std::runtime_error("Robot not initialized"));}
+
+      CControllerMultiTask* tmp_c = dynamic_cast<CControllerMultiTask*>(ctrl_current_);
+      if(S_NULL == tmp_c)
+      { throw(std::runtime_error("Multi-rate mode requires a task controller."));}
+
+      // Set the flag first so the servo stops using the old path right away
+      if(false == arg_flag)
+      { flag_multi_rate_ = false; return tmp_c->setMultiRate(false); }
+
+      //Flush the model once so the servo has something to work with until
+      //the model thread publishes its first update.
+      if(false == tmp_c->computeDynamics())
+      { throw(std::runtime_error("Could not compute the initial dynamic model."));}
+
+      if(false == tmp_c->setMultiRate(true))
+      { throw(std::runtime_error("Could not set up the controller's model buffers."));}
+
+      flag_multi_rate_ = true;
+      return true;
+    }
+    catch(std::exception & e)
+    { std::cout<<"\nCRobot::setFlagMultiRate("<<data_.name_<<") Error : "<< e.what();  }
+    return false;
+  }
+
+  sBool CRobot::setFlagPublishSnapshots(sBool arg_flag, sBool arg_with_transforms)
+  {
+    try
+    {
+      if(false == data_.has_been_init_)
+      { throw(std::runtime_error("Robot not initialized"));}
+
+      if(false == arg_flag)
+      { flag_publish_snapshots_ = false; return true; }
+
+      if(arg_with_transforms && S_NULL == dynamics_)
+      { throw(std::runtime_error("Need a dynamics object to compute the snapshot's link transforms."));}
+
+      //Preallocate both buffers so publishing never allocates.
+      for(unsigned int i=0; i<snapshots_.size(); ++i)
+      { snapshots_.getBuffer(i).init(data_.parsed_robot_data_->dof_, arg_with_transforms); }
+      snapshots_.reset();
+      snapshot_tick_ = 0;
+
+      flag_snapshot_transforms_ = arg_with_transforms;
+      flag_publish_snapshots_ = true;
+
+      //Readers get the initial state right away.
+      publishSnapshot();
+      return true;
+    }
+    catch(std::exception & e)
+    { std::cout<<"\nCRobot::setFlagPublishSnapshots("<<data_.name_<<") Error : "<< e.what();  }
+    return false;
+  }
+
   /** Gets access to the current controller data structure */
   SControllerBase* CRobot::getControllerDataStruct(const std::string& arg_ctrl_name)
   {
@@ -809,33 +1154,75 @@ namespace scl
   //                       Logging functions
   // **********************************************************************
   /** Sets up logging to a file */
-  sBool CRobot::setLogFile(const std::string &arg_file)
+  sBool CRobot::setLogFile(const std::string &arg_file, bool arg_log_gc,
+      bool arg_log_gc_matrices, bool arg_log_task_matrices)
   {
-    if(log_file_name_ == arg_file)
-    {//If it tries to open the same file, do nothing.
-      if(log_file_.is_open())
-      { return true;  }
-    }
-    else
+    try
     {
+      if(S_NULL == data_.io_data_ || S_NULL == data_.controller_current_)
+      { throw(std::runtime_error("Robot not initialized. Can't set up the log columns.")); }
+
       //Once we open a new file, the logging must be reinitalized before it
       //can be turned on.
       logging_on_ = false;
+      logger_.reset();
+      log_cols_ = SLogCols();
       log_file_name_ = arg_file;
-      //Close the file if it is open
-      if(log_file_.is_open())
-      { log_file_.close();  }
-    }
 
-    //Open the file in append mode
-    log_file_.open(arg_file.c_str(), std::ios::out | std::ios::app);
+      const sUInt dof = data_.io_data_->dof_;
+
+      //Logs the time at the very least
+      log_cols_.t_sys_ = logger_.addColumn("t_sys",1);
+      log_cols_.t_sim_ = logger_.addColumn("t_sim",1);
+      if(arg_log_gc)
+      {
+        log_cols_.q_ = logger_.addColumn("q",dof);
+        log_cols_.dq_ = logger_.addColumn("dq",dof);
+        log_cols_.ddq_ = logger_.addColumn("ddq",dof);
+        log_cols_.fgc_ = logger_.addColumn("force_gc_commanded",dof);
+      }
+      if(arg_log_gc_matrices)
+      {
+        log_cols_.M_ = logger_.addColumn("M_gc",dof,dof);
+        log_cols_.Minv_ = logger_.addColumn("M_gc_inv",dof,dof);
+        log_cols_.fcc_ = logger_.addColumn("force_gc_cc",dof);
+        log_cols_.fgrav_ = logger_.addColumn("force_gc_grav",dof);
+      }
+      if(arg_log_task_matrices)
+      {
+        //Well be careful to ask for task logging only when you use a task
+        //controller! Else the dynamic cast won't work.
+        SControllerMultiTask* ds = dynamic_cast<SControllerMultiTask*>(data_.controller_current_);
+        if(S_NULL == ds)
+        { throw(std::runtime_error("Asked to log task matrices but the current controller isn't a task controller.")); }
+
+        sutil::CMappedMultiLevelList<std::string, STaskBase*>::iterator it,ite;
+        for(it = ds->servo_.task_data_->begin(), ite = ds->servo_.task_data_->end();
+            it != ite; ++it)
+        {
+          const std::string& n = (*it)->name_;
+          const sUInt t = (*it)->dof_task_;
+          sInt c = logger_.addColumn(n+"::force_task",t);
+          logger_.addColumn(n+"::force_gc",dof);
+          logger_.addColumn(n+"::J",t,dof);
+          logger_.addColumn(n+"::J_dyn_inv",dof,t);
+          logger_.addColumn(n+"::M_task",t,t);
+          logger_.addColumn(n+"::M_task_inv",t,t);
+          logger_.addColumn(n+"::force_task_cc",t);
+          if(0 > logger_.addColumn(n+"::force_task_grav",t) || 0 > c)
+          { throw(std::runtime_error(std::string("Could not add log columns for task : ")+n)); }
+          log_cols_.task_.push_back(c);
+        }
+      }
+
+      if(false == logger_.open(arg_file))
+      { throw(std::runtime_error(std::string("Could not open log file : ")+arg_file)); }
 
-    //Quick error check.
-    if(log_file_.is_open())
-    {
       logging_on_ = true;
       return true;
     }
+    catch(std::exception& e)
+    { std::cerr<<"\nCRobot::setLogFile() : "<<e.what(); }
     return false;
   }
 
@@ -845,48 +1232,78 @@ namespace scl
   {
     if(!logging_on_)  { return false; }
 
-    bool logged_something=false;
+    double* row = logger_.beginRow();
+    if(S_NULL == row) { return false; } //The writer fell behind. Drop the row.
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
     //Logs the time at the very least
-    log_file_<<sutil::CSystemClock::getSysTime()
-    <<" "<<sutil::CSystemClock::getSimTime();
-    if(arg_log_gc)
-    {
-      log_file_<<"\nq "<<data_.io_data_->sensors_.q_.transpose()
-                <<" "<<data_.io_data_->sensors_.dq_.transpose()
-                <<" "<<data_.io_data_->sensors_.ddq_.transpose()
-                <<" "<<data_.io_data_->actuators_.force_gc_commanded_.transpose();
-      logged_something = true;
-    }
-    if(arg_log_gc_matrices)
-    {
-      log_file_<<"\nA "<<data_.controller_current_->gc_model_->M_gc_
-          <<"\nAinv "<<data_.controller_current_->gc_model_->M_gc_inv_
-          <<"\n"<<data_.controller_current_->gc_model_->force_gc_cc_.transpose()
-          <<" "<<data_.controller_current_->gc_model_->force_gc_grav_.transpose();
-      logged_something = true;
-    }
-    if(arg_log_task_matrices)
-    {
-      //Well be careful to ask for task logging only when you use a task
-      //controller! Else the dynamic cast won't work.
-      SControllerMultiTask* ds = dynamic_cast<SControllerMultiTask*>(data_.controller_current_);
-      sutil::CMappedMultiLevelList<std::string, STaskBase*>::const_iterator it,ite;
+    logger_.setColumn(row, log_cols_.t_sys_, sutil::CSystemClock::getSysTime());
+    logger_.setColumn(row, log_cols_.t_sim_, sutil::CSystemClock::getSimTime());
+
+    if(0 <= log_cols_.q_)
+    {
+      if(arg_log_gc)
+      {
+        logger_.setColumn(row, log_cols_.q_, data_.io_data_->sensors_.q_);
+        logger_.setColumn(row, log_cols_.dq_, data_.io_data_->sensors_.dq_);
+        logger_.setColumn(row, log_cols_.ddq_, data_.io_data_->sensors_.ddq_);
+        logger_.setColumn(row, log_cols_.fgc_, data_.io_data_->actuators_.force_gc_commanded_);
+      }
+      else
+      {
+        logger_.fillColumn(row, log_cols_.q_, nan);   logger_.fillColumn(row, log_cols_.dq_, nan);
+        logger_.fillColumn(row, log_cols_.ddq_, nan); logger_.fillColumn(row, log_cols_.fgc_, nan);
+      }
+    }
+
+    if(0 <= log_cols_.M_)
+    {
+      const SGcModel* gc = data_.controller_current_->gc_model_;
+      if(arg_log_gc_matrices)
+      {
+        logger_.setColumn(row, log_cols_.M_, gc->M_gc_);
+        logger_.setColumn(row, log_cols_.Minv_, gc->M_gc_inv_);
+        logger_.setColumn(row, log_cols_.fcc_, gc->force_gc_cc_);
+        logger_.setColumn(row, log_cols_.fgrav_, gc->force_gc_grav_);
+      }
+      else
+      {
+        logger_.fillColumn(row, log_cols_.M_, nan);   logger_.fillColumn(row, log_cols_.Minv_, nan);
+        logger_.fillColumn(row, log_cols_.fcc_, nan); logger_.fillColumn(row, log_cols_.fgrav_, nan);
+      }
+    }
+
+    if(log_cols_.task_.size() > 0)
+    {
+      SControllerMultiTask* ds = static_cast<SControllerMultiTask*>(data_.controller_current_);
+      sutil::CMappedMultiLevelList<std::string, STaskBase*>::iterator it,ite;
+      std::vector<sInt>::const_iterator itc = log_cols_.task_.begin(), itce = log_cols_.task_.end();
       for(it = ds->servo_.task_data_->begin(), ite = ds->servo_.task_data_->end();
-          it != ite; ++it)
+          it != ite && itc != itce; ++it, ++itc)
       {
-        log_file_<<"\nPri "<<(*it)->priority_
-            <<" "<<(*it)->force_task_.transpose()
-            <<" "<<(*it)->force_gc_.transpose()
-            <<"\nJ "<<(*it)->J_
-            <<"\nJinv "<<(*it)->J_dyn_inv_
-            <<"\n L "<<(*it)->M_task_
-            <<"\n Linv "<<(*it)->M_task_inv_
-            <<"\n "<<(*it)->force_task_cc_
-            <<" "<<(*it)->force_task_grav_;
-        logged_something = true;
+        const sInt c = *itc;
+        if(arg_log_task_matrices)
+        {
+          logger_.setColumn(row, c,   (*it)->force_task_);
+          logger_.setColumn(row, c+1, (*it)->force_gc_);
+          logger_.setColumn(row, c+2, (*it)->J_);
+          logger_.setColumn(row, c+3, (*it)->J_dyn_inv_);
+          logger_.setColumn(row, c+4, (*it)->M_task_);
+          logger_.setColumn(row, c+5, (*it)->M_task_inv_);
+          logger_.setColumn(row, c+6, (*it)->force_task_cc_);
+          logger_.setColumn(row, c+7, (*it)->force_task_grav_);
+        }
+        else
+        { for(int i=0; i<8; ++i) { logger_.fillColumn(row, c+i, nan); } }
       }
+      //Tasks removed since setLogFile()
+      for(; itc != itce; ++itc)
+      { for(int i=0; i<8; ++i) { logger_.fillColumn(row, *itc+i, nan); } }
     }
-    return logged_something;
+
+    logger_.endRow();
+    return true;
   }
 
   // **********************************************************************
@@ -899,6 +1316,18 @@ namespace scl
     dynamics_ = S_NULL;
     integrator_ = S_NULL;
     ctrl_current_ = S_NULL;
+    flag_multi_rate_ = false;
+    flag_sleep_ = false;
+    asleep_ = false;
+    sleep_ke_max_ = 1e-6;
+    sleep_dfgc_max_ = 1e-3;
+    sleep_ticks_ = 100;
+    sleep_ctr_idle_ = 0;
+    sleep_ctr_ticks_ = 0;
+    sleep_ctr_sleeps_ = 0;
+    flag_publish_snapshots_ = false;
+    flag_snapshot_transforms_ = false;
+    snapshot_tick_ = 0;
     logging_on_ = false;
   }
 
@@ -916,8 +1345,12 @@ namespace scl
       if(S_NULL!=integrator_) {  delete integrator_; integrator_ = S_NULL; }
     }
 
-    //Close the log file if it is open.
-    if(log_file_.is_open())
-    { log_file_.close();  }
+    //Close the log file if it is open (writes the pending rows).
+    if(logger_.isOpen())
+    {
+      logger_.close();
+      std::cout<<"\nCRobot::~CRobot() : Log "<<log_file_name_<<" : Wrote "
+          <<logger_.getRowsWritten()<<" rows. Dropped "<<logger_.getRowsDropped();
+    }
   }
 }
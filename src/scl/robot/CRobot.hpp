@@ -38,12 +38,15 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <scl/robot/data_structs/SRobot.hpp>
 #include <scl/dynamics/CDynamicsBase.hpp>
 #include <scl/control/CControllerBase.hpp>
+#include <scl/data_structs/SRobotSnapshot.hpp>
+#include <scl/util/CSeqLock.hpp>
+#include <scl/util/CLoggerBinary.hpp>
 
 #include <sutil/CMappedList.hpp>
 
 #include <string>
 #include <vector>
-#include <fstream>
+#include <cstdint>
 
 namespace scl
 {
@@ -72,9 +75,17 @@ namespace scl
     void computeServo();
 
     /** Computes the robot's dynamic model.
+     * Does nothing in multi-rate mode (the model thread calls
+     * computeDynamicsBuffered() instead), or while the robot sleeps.
      * Asserts false in debug mode if something bad happens */
     void computeDynamics();
 
+    /** Multi-rate mode : Computes the robot's dynamic model into a back
+     * buffer and publishes it to the servo. Call this from the model
+     * thread while another thread calls computeServo().
+     * Asserts false in debug mode if something bad happens */
+    void computeDynamicsBuffered();
+
     /** Computes the robot's non-control related operations
      * Asserts false in debug mode if something bad happens */
     void computeNonControlOperations();
@@ -83,6 +94,8 @@ namespace scl
      * By default, it integrates for a time period dt specifiecd
      * in the database
      *
+     * Does nothing while the robot sleeps (see setFlagSleep).
+     *
      * Asserts false in debug mode if something bad happens */
     void integrateDynamics();
 
@@ -160,6 +173,54 @@ namespace scl
     void setFlagControllerOn(sBool arg_flag)
     { data_.parsed_robot_data_->flag_controller_on_ = arg_flag;  }
 
+    /** Turn multi-rate mode on or off. In multi-rate mode the dynamic
+     * model is computed on a separate thread (see computeDynamicsBuffered)
+     * and the servo never waits for it.
+     * Only supported by task controllers. Returns false otherwise. */
+    sBool setFlagMultiRate(sBool arg_flag);
+
+    /** Whether multi-rate mode is on */
+    sBool getFlagMultiRate() const
+    { return flag_multi_rate_;  }
+
+    // **********************************************************************
+    //                       Sleep/wake (idle robots)
+    // **********************************************************************
+
+    /** Turn sleeping on or off. When on, a robot falls asleep once its
+     * kinetic energy stays below arg_ke_max (J) and its commanded forces
+     * change by less than arg_dfgc_max (per dof, per tick) for
+     * arg_ticks ticks in a row. Falling asleep zeroes dq and ddq.
+     *
+     * A sleeping robot skips computeDynamics() and integrateDynamics().
+     * Its state doesn't change, so the controller's model stays exact and
+     * computeServo() keeps running. The robot wakes as soon as:
+     * (a) its commanded forces move away from their value when it fell
+     *     asleep (eg. a new goal, or a gain change),
+     * (b) it has an external force (eg. a contact or a push), or
+     * (c) something calls wake() (eg. setGeneralizedCoordinates).
+     *
+     * NOTE : Only toggle this while the simulation thread isn't running. */
+    sBool setFlagSleep(sBool arg_flag, sFloat arg_ke_max=1e-6,
+        sFloat arg_dfgc_max=1e-3, sUInt arg_ticks=100);
+
+    /** Whether sleeping is on */
+    sBool getFlagSleep() const
+    { return flag_sleep_;  }
+
+    /** Whether the robot is asleep */
+    sBool isAsleep() const
+    { return asleep_;  }
+
+    /** Wakes the robot up (if it is asleep) and restarts the idle count */
+    void wake()
+    { asleep_ = false; sleep_ctr_idle_ = 0; }
+
+    /** The number of ticks integrateDynamics() skipped, and the number of
+     * times the robot fell asleep */
+    sLongLong getTicksAsleep() const { return sleep_ctr_ticks_; }
+    sLongLong getNumSleeps() const { return sleep_ctr_sleeps_; }
+
     // **********************************************************************
     //                       Robot state helper functions
     // **********************************************************************
@@ -180,10 +241,10 @@ namespace scl
     { return data_.io_data_->actuators_.force_gc_commanded_; }
 
     void setGeneralizedCoordinates(const Eigen::VectorXd& arg_q)
-    {  data_.io_data_->sensors_.q_ = arg_q; }
+    {  data_.io_data_->sensors_.q_ = arg_q; wake(); }
 
     void setGeneralizedVelocities(const Eigen::VectorXd& arg_dq)
-    {  data_.io_data_->sensors_.dq_ = arg_dq; }
+    {  data_.io_data_->sensors_.dq_ = arg_dq; wake(); }
 
     void setGeneralizedAccelerations(const Eigen::VectorXd& arg_ddq)
     {  data_.io_data_->sensors_.ddq_ = arg_ddq; }
@@ -195,10 +256,10 @@ namespace scl
     {  data_.io_data_->actuators_.force_gc_commanded_ = arg_f; }
 
     void setGeneralizedCoordinatesToZero()
-    {  data_.io_data_->sensors_.q_.setZero(data_.parsed_robot_data_->dof_); }
+    {  data_.io_data_->sensors_.q_.setZero(data_.parsed_robot_data_->dof_); wake(); }
 
     void setGeneralizedVelocitiesToZero()
-    {  data_.io_data_->sensors_.dq_.setZero(data_.parsed_robot_data_->dof_); }
+    {  data_.io_data_->sensors_.dq_.setZero(data_.parsed_robot_data_->dof_); wake(); }
 
     void setGeneralizedAccelerationsToZero()
     {  data_.io_data_->sensors_.ddq_.setZero(data_.parsed_robot_data_->dof_); }
@@ -209,6 +270,77 @@ namespace scl
     void setGeneralizedForcesCommandedToZero()
     {  data_.io_data_->actuators_.force_gc_commanded_.setZero(data_.parsed_robot_data_->dof_); }
 
+    // **********************************************************************
+    //                       Robot state snapshots
+    // **********************************************************************
+
+    /** Turn state snapshots on or off. When on, integrateDynamics()
+     * publishes a consistent copy of the robot's state (q, dq, commanded
+     * forces, and optionally the link transforms) at the end of every tick.
+     *
+     * Other threads should read the state with getSnapshot() instead of
+     * reading the io data directly. They never block the simulation.
+     *
+     * NOTE : Only toggle this while the simulation thread isn't running. */
+    sBool setFlagPublishSnapshots(sBool arg_flag, sBool arg_with_transforms=true);
+
+    /** Whether snapshots are published */
+    sBool getFlagPublishSnapshots() const
+    { return flag_publish_snapshots_;  }
+
+    /** Simulation thread : Publishes the current state. Called by
+     * integrateDynamics() if snapshots are on. Call it yourself if
+     * some other code sets the robot's state (eg. a hardware driver). */
+    void publishSnapshot();
+
+    /** Any thread : Copies the latest snapshot. Returns false if
+     * there is no snapshot yet, or if the simulation overwrote it
+     * during every attempted copy (retry at the next tick).
+     *
+     * NOTE : Size ret_snap with the same dof/transforms as the robot to
+     * avoid allocating (see SRobotSnapshot::init). */
+    sBool getSnapshot(SRobotSnapshot& ret_snap) const
+    { return flag_publish_snapshots_ && snapshots_.read(ret_snap);  }
+
+    /** The snapshot buffer (for readers that only get a const pointer,
+     * like the graphics) */
+    const CSeqLock<SRobotSnapshot>* getSnapshotBuffer() const
+    { return &snapshots_;  }
+
+    // **********************************************************************
+    //                       Robot state checkpoints
+    // **********************************************************************
+
+    /** Saves the robot's run-time state into a binary blob : the io data,
+     * the integrator's and controllers' gc models (including the link
+     * transforms), the task state (goals, integral terms, task models) and
+     * the simulation time.
+     *
+     * Use it to run many rollouts from one checkpoint without re-parsing
+     * and re-initializing the robot (save once, restore before each run).
+     *
+     * NOTE : The blob is cleared and refilled. Reuse the same string to
+     * avoid allocating. */
+    sBool saveState(std::string& ret_blob) const;
+
+    /** Restores a state saved by saveState(). Fails (and changes nothing
+     * the blob doesn't cover) if the robot's links, external forces,
+     * controllers or tasks don't match the ones saved.
+     *
+     * Doesn't allocate, and only copies the state, so it is cheap enough
+     * to call before every rollout.
+     *
+     * NOTE : Online trajectory generators (otg_* task params) aren't
+     *        saved. They restart from the restored state, so every rollout
+     *        from a state is the same.
+     *
+     * NOTE : Only call this while no other thread runs the robot. Not
+     *        supported in multi-rate mode. */
+    sBool restoreState(const char* arg_blob, const std::size_t arg_len);
+
+    sBool restoreState(const std::string& arg_blob)
+    { return restoreState(arg_blob.data(), arg_blob.size());  }
+
     // **********************************************************************
     //                       Controller helper functions
     // **********************************************************************
@@ -300,13 +432,24 @@ namespace scl
     //                       Logging functions
     // **********************************************************************
 
-    /** Sets up logging to a file. The files are opened
-     * in append+text mode and the state is written to them
-     * every time the logState() function is called. */
-    sBool setLogFile(const std::string &arg_file);
-
-    /** Logs data to the file. Pass flags to control the data
-     * written to the file. */
+    /** Sets up logging to a binary file (see CLoggerBinary for the format,
+     * and scl_log_convert to convert it to csv/json).
+     *
+     * The flags pick the columns the file has room for. Each logState()
+     * call appends one row : the robot thread only copies the row into a
+     * ring buffer, and a background thread writes it to the file.
+     *
+     * NOTE : The task columns use the task sizes at the time of this call.
+     *        Call it after the controller has been initialized.
+     * NOTE : Appends to an existing log with the same columns. */
+    sBool setLogFile(const std::string &arg_file, bool arg_log_gc=true,
+        bool arg_log_gc_matrices=true, bool arg_log_task_matrices=false);
+
+    /** Logs a row. Pass flags to control the data written to the file.
+     * Columns set up by setLogFile() but not requested here are set to NaN.
+     *
+     * Returns false if logging is off or the row was dropped (the writer
+     * fell behind). Never blocks on file IO. */
     sBool logState(bool arg_log_gc=true, bool arg_log_gc_matrices=true,
         bool arg_log_task_matrices=false);
 
@@ -321,6 +464,13 @@ namespace scl
     virtual ~CRobot();
 
   private:
+    /** Hashes the names and sizes that a saved state depends on */
+    std::uint64_t hashStateLayout() const;
+
+    /** Sleep/wake : Updates the sleep state at the start of a tick.
+     * Returns true if the robot is (now) asleep. */
+    sBool updateSleep();
+
     /** The data is available in the database for other parts of the
      * program to see.
      *
@@ -351,10 +501,38 @@ namespace scl
     /** The current controllers controlling this robot. */
     CControllerBase* ctrl_current_;
 
+    /** Whether the model is computed on a separate thread */
+    sBool flag_multi_rate_;
+
+    /** Sleep/wake state */
+    sBool flag_sleep_;
+    sBool asleep_;
+    sFloat sleep_ke_max_, sleep_dfgc_max_;
+    sUInt sleep_ticks_;
+    sUInt sleep_ctr_idle_;
+    sLongLong sleep_ctr_ticks_, sleep_ctr_sleeps_;
+    /** The commanded forces at the last tick (awake) or when the
+     * robot fell asleep (asleep) */
+    Eigen::VectorXd sleep_fgc_;
+    Eigen::VectorXd sleep_tmp_;
+
+    /** State snapshots for other threads */
+    sBool flag_publish_snapshots_;
+    sBool flag_snapshot_transforms_;
+    sLongLong snapshot_tick_;
+    CSeqLock<SRobotSnapshot> snapshots_;
+
     /** For logging stuff to a file. */
     std::string log_file_name_;
-    std::fstream log_file_;
+    CLoggerBinary logger_;
     sBool logging_on_;
+    /** The logger's column indices (-1 if not logged) */
+    struct SLogCols {
+      sInt t_sys_=-1, t_sim_=-1, q_=-1, dq_=-1, ddq_=-1, fgc_=-1;
+      sInt M_=-1, Minv_=-1, fcc_=-1, fgrav_=-1;
+      /** The first of each task's 8 columns */
+      std::vector<sInt> task_;
+    } log_cols_;
   };
 
 }
@@ -44,6 +44,7 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #endif
 #include <scl/parser/sclparser/CParserScl.hpp>
 #include <scl/util/HelperFunctions.hpp>
+#include <scl/util/CPerfStats.hpp>
 
 #include <sutil/CSystemClock.hpp>
 #include <sutil/CRegisteredCallbacks.hpp>
@@ -60,6 +61,7 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <Eigen/Core>
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <ncurses.h>
 
 namespace scl
@@ -75,8 +77,14 @@ namespace scl
       dyn_scl_sp_(NULL),
       dyn_scl_(NULL),
       ctrl_ctr_(0),
+      servo_to_model_rate_(0),
+      loop_rate_hz_(0),
+      loop_rt_priority_(0),
+      loop_cpu_(-1),
+      flag_loop_mlock_(false),
       t_start_(0.0),
-      t_end_(0.0)
+      t_end_(0.0),
+      ui_cmd_channel_(NULL)
 #ifdef GRAPHICS_ON
       ,
       gr_ctr_(0),
@@ -215,13 +223,53 @@ namespace scl
           {// We know the next argument *should* be the log file's name
             if(args_ctr+1 < argv.size())
             {
-              flag = robot_.setLogFile(argv[args_ctr+1]);
+              //Room for everything the apps log (task matrices only with a task controller)
+              flag = robot_.setLogFile(argv[args_ctr+1], true, true, flag_is_task_controller);
               if(false == flag) { throw(std::runtime_error("Could not set up log file"));  }
               args_ctr+=2;
             }
             else
             { throw(std::runtime_error("Specified -l flag but did not specify log file"));  }
           }
+          else if ("-mr" == argv[args_ctr])
+          {// We know the next argument *should* be the servo to model rate
+            if(args_ctr+1 < argv.size())
+            {
+              int tmp_rate = atoi(argv[args_ctr+1].c_str());
+              if(0 >= tmp_rate) { throw(std::runtime_error("Specified an invalid -mr servo to model rate"));  }
+              servo_to_model_rate_ = static_cast<scl::sUInt>(tmp_rate);
+              args_ctr+=2;
+            }
+            else
+            { throw(std::runtime_error("Specified -mr flag but did not specify the servo to model rate"));  }
+          }
+          else if ("-rate" == argv[args_ctr])
+          {// We know the next argument *should* be the servo loop rate
+            if(args_ctr+1 < argv.size())
+            {
+              loop_rate_hz_ = atof(argv[args_ctr+1].c_str());
+              if(0 >= loop_rate_hz_) { throw(std::runtime_error("Specified an invalid -rate servo loop rate"));  }
+              args_ctr+=2;
+            }
+            else
+            { throw(std::runtime_error("Specified -rate flag but did not specify the servo loop rate (Hz)"));  }
+          }
+          else if ("-rtprio" == argv[args_ctr])
+          {
+            if(args_ctr+1 < argv.size())
+            { loop_rt_priority_ = atoi(argv[args_ctr+1].c_str()); args_ctr+=2; }
+            else
+            { throw(std::runtime_error("Specified -rtprio flag but did not specify the priority"));  }
+          }
+          else if ("-cpu" == argv[args_ctr])
+          {
+            if(args_ctr+1 < argv.size())
+            { loop_cpu_ = atoi(argv[args_ctr+1].c_str()); args_ctr+=2; }
+            else
+            { throw(std::runtime_error("Specified -cpu flag but did not specify the cpu"));  }
+          }
+          else if ("-mlock" == argv[args_ctr])
+          { flag_loop_mlock_ = true; args_ctr++; }
           else if (("-com" == argv[args_ctr]) || ("-op" == argv[args_ctr]) || ("-ui" == argv[args_ctr]))
           {// We know the next argument *should* be the op pos task's name
             if(false == flag_is_task_controller)
@@ -290,6 +338,34 @@ namespace scl
         if(false == flag)
         { throw(std::runtime_error("Could not initialize user's custom controller"));  }
 
+        /**********************Initialize UI Command Channel *******************/
+        //The ui thread sends goals to the ui point tasks through this (see sendUiGoals())
+        if(flag_is_task_controller && 0 < taskvec_ui_ctrl_point_.size())
+        {
+          ui_cmd_channel_ = tmp_task_ctrl->createCommandChannel("ui");
+          if(NULL == ui_cmd_channel_) { throw(std::runtime_error("Could not create the ui command channel"));  }
+        }
+
+        /**********************Initialize Multi-Rate Mode *******************/
+        if(0 < servo_to_model_rate_)
+        {
+          flag = robot_.setFlagMultiRate(true);
+          if(false == flag) { throw(std::runtime_error("Could not enable multi-rate mode"));  }
+          std::cout<<"\nMulti-rate mode. Servo to model rate: "<<servo_to_model_rate_;
+        }
+
+        /**********************Initialize State Snapshots *******************/
+#ifdef GRAPHICS_ON
+        //The graphics thread renders consistent state snapshots instead of
+        //reading q while the simulation integrates it. Chai computes its own
+        //link transforms, so the snapshots skip them.
+        flag = robot_.setFlagPublishSnapshots(true, false);
+        if(false == flag) { throw(std::runtime_error("Could not enable robot state snapshots"));  }
+
+        flag = chai_gr_.setRobotSnapshotSource(robot_name_, robot_.getSnapshotBuffer());
+        if(false == flag) { throw(std::runtime_error("Could not render the robot from state snapshots"));  }
+#endif
+
         ctrl_ctr_=0;//Controller computation counter
 #ifdef GRAPHICS_ON
         gr_ctr_=0;//Controller computation counter
@@ -333,6 +409,37 @@ namespace scl
     /****************************Print Collected Statistics*****************************/
     std::cout<<"\nTotal Simulated Time : "<<sutil::CSystemClock::getSimTime() <<" sec";
     std::cout<<"\nTotal Control Model and Servo Updates : "<<ctrl_ctr_;
+    if(robot_.hasBeenInit() && NULL != ui_cmd_channel_)
+    {
+      CControllerMultiTask* tmp_task_ctrl = dynamic_cast<scl::CControllerMultiTask*> (robot_.getControllerCurrent());
+      if(S_NULL != tmp_task_ctrl)
+      {
+        std::cout<<"\nTask Commands (Applied / Rejected)    : "<<tmp_task_ctrl->getCommandsApplied()
+            <<" / "<<tmp_task_ctrl->getCommandsRejected();
+      }
+    }
+    if(loop_sched_.hasBeenInit())
+    { loop_sched_.printStats(); }
+    if(robot_.hasBeenInit())
+    {
+      CControllerMultiTask* tmp_task_ctrl = dynamic_cast<scl::CControllerMultiTask*> (robot_.getControllerCurrent());
+      if(S_NULL != tmp_task_ctrl)
+      {
+        std::cout<<"\nJacobian Chain Walks (Computed)       : "<<tmp_task_ctrl->getJacobianCache().getChainWalks();
+        std::cout<<"\nJacobian Chain Walks (Saved by cache) : "<<tmp_task_ctrl->getJacobianCache().getChainWalksSaved();
+      }
+    }
+    if(robot_.getFlagMultiRate())
+    {
+      CControllerMultiTask* tmp_task_ctrl = dynamic_cast<scl::CControllerMultiTask*> (robot_.getControllerCurrent());
+      if(S_NULL != tmp_task_ctrl)
+      {
+        std::cout<<"\nMulti-rate Model Updates (Published)  : "<<tmp_task_ctrl->getModelUpdatesPublished();
+        std::cout<<"\nMulti-rate Model Updates (Adopted)    : "<<tmp_task_ctrl->getModelUpdatesAdopted();
+      }
+    }
+    std::cout<<"\nTiming :";
+    CPerfStats::print(std::cout);
 #ifdef GRAPHICS_ON
     std::cout<<"\nTotal Graphics Updates                : "<<gr_ctr_;
 
@@ -350,20 +457,34 @@ namespace scl
     if(thread_id==1)
     {
       //Thread 1 : Run the simulation
+      // NOTE : The scheduler sets up the calling thread, so init it here.
+      initLoopScheduler();
+      const int ph_step = loop_sched_.addPhase("step");
+
+      //Start at the ui points. Later goals arrive through the ui command channel.
+      std::vector<SUiCtrlPointData>::iterator it,ite;
+      for(it = taskvec_ui_ctrl_point_.begin(), ite = taskvec_ui_ctrl_point_.end(); it!=ite; ++it )
+      { it->task_->setGoalPos(db_->s_gui_.ui_point_[it->ui_pt_]); }
+
       while(true == scl::CDatabase::getData()->running_)
       {
         if(scl::CDatabase::getData()->pause_ctrl_dyn_)
-        { sleep(1); continue; }
+        { sleep(1); loop_sched_.resync(); continue; }
         else
-        { stepMySimulation(); }
+        {
+          loop_sched_.startPhase(ph_step);
+          stepMySimulation();
+          loop_sched_.endPhase(ph_step);
+          loop_sched_.waitForNextTick();
+        }
       }
     }
     else
     {
-#ifdef GRAPHICS_ON
-      //Thread 0 : Run the graphics and gui
+      //Thread 0 : Run the graphics and gui. Send the ui goals to the controller.
       while(true == scl::CDatabase::getData()->running_)
       {
+#ifdef GRAPHICS_ON
         if(scl::CDatabase::getData()->pause_graphics_)
         { sleep(1); continue; }
         else
@@ -372,32 +493,132 @@ namespace scl
           glutMainLoopEvent(); //Update the graphics
           gr_ctr_++;
         }
-      }
+#else
+        //No graphics. Still pass on the ui points (eg. moved from the shell)
+        const timespec ts = {0, 15000000};
+        nanosleep(&ts,NULL);
 #endif
+        sendUiGoals();
+      }
+    }
+  }
+
+  void CRobotApp::sendUiGoals()
+  {
+    if(NULL == ui_cmd_channel_) { return; }
+
+    std::vector<SUiCtrlPointData>::iterator it,ite;
+    for(it = taskvec_ui_ctrl_point_.begin(), ite = taskvec_ui_ctrl_point_.end(); it!=ite; ++it )
+    {
+      STaskCommand* cmd = ui_cmd_channel_->getWriteSlot();
+      if(NULL == cmd) { return; } //Full. The servo isn't running; try again next frame.
+      cmd->task_ = it->task_;
+      cmd->type_ = STaskCommand::CMD_GOAL_POS;
+      cmd->val_ = db_->s_gui_.ui_point_[it->ui_pt_];
+      ui_cmd_channel_->commitWrite();
+    }
+  }
+
+  void CRobotApp::runModelLoopThreaded()
+  {
+    if(0 == servo_to_model_rate_ || false == robot_.getFlagMultiRate())
+    { return; }
+
+    //The model runs servo_to_model_rate_ times slower than the servo. If the servo
+    //loop has no fixed rate, assume it runs in real time (one sim timestep per tick).
+    scl::sFloat servo_dt = (0 < loop_rate_hz_) ? 1.0/loop_rate_hz_ : scl::CDatabase::getData()->sim_dt_;
+
+    //The model thread stays at normal priority (and on any cpu) so it never preempts the servo.
+    // NOTE : Missed deadlines are dropped (not caught up on) by the scheduler.
+    scl::CLoopScheduler sched;
+    if(false == sched.init(servo_dt * servo_to_model_rate_))
+    {
+      std::cout<<"\nCRobotApp::runModelLoopThreaded() : ERROR : Could not set up the model loop's scheduler."
+          <<" The servo will keep using the last published model.";
+      return;
+    }
+
+    while(true == scl::CDatabase::getData()->running_)
+    {
+      if(scl::CDatabase::getData()->pause_ctrl_dyn_)
+      { sleep(1); sched.resync(); continue; }
+
+      robot_.computeDynamicsBuffered();
+      sched.waitForNextTick();
+    }
+  }
+
+  scl::sBool CRobotApp::initLoopScheduler()
+  {
+    if(0 >= loop_rate_hz_) { return true; }
+
+    if(false == loop_sched_.init(1.0/loop_rate_hz_, loop_rt_priority_, loop_cpu_, flag_loop_mlock_))
+    {
+      std::cout<<"\nCRobotApp::initLoopScheduler() : ERROR : Could not run the loop at "<<loop_rate_hz_
+          <<"Hz. Falling back to running it as fast as possible.";
+      return false;
     }
+
+    //The scheduler tries these on a best effort basis
+    scl::sBool flag = true;
+    if(0 < loop_rt_priority_ && false == loop_sched_.getFlagRtPriority())
+    { flag = false; std::cout<<"\nCRobotApp::initLoopScheduler() : WARNING : Falling back to normal scheduling (no -rtprio)."; }
+    if(0 <= loop_cpu_ && false == loop_sched_.getFlagCpuPinned())
+    { flag = false; std::cout<<"\nCRobotApp::initLoopScheduler() : WARNING : Falling back to running on any cpu (no -cpu)."; }
+    if(flag_loop_mlock_ && false == loop_sched_.getFlagMemLocked())
+    { flag = false; std::cout<<"\nCRobotApp::initLoopScheduler() : WARNING : Falling back to unlocked memory (no -mlock)."; }
+    return flag;
   }
 
   void CRobotApp::runMainLoop()
   {
+    initLoopScheduler();
+    const int ph_model = loop_sched_.addPhase("model"), ph_step = loop_sched_.addPhase("step");
+
+    scl::sUInt model_ctr = 0;
     while(true == scl::CDatabase::getData()->running_)
     {
       if(scl::CDatabase::getData()->pause_ctrl_dyn_)
-      { sleep(1); continue; }
+      { sleep(1); loop_sched_.resync(); continue; }
       else
-      { stepMySimulation(); }
+      {
+        //No model thread in single threaded mode. Interleave the model updates.
+        //If the loop is falling behind, push the model update to the next tick (never skip the step).
+        if(0 < servo_to_model_rate_ && 0 == model_ctr % servo_to_model_rate_)
+        {
+          if(loop_sched_.hasTimeFor(ph_model))
+          {
+            loop_sched_.startPhase(ph_model);
+            robot_.computeDynamicsBuffered();
+            loop_sched_.endPhase(ph_model);
+            model_ctr++;
+          }
+        }
+        else
+        { model_ctr++; }
+
+        sendUiGoals(); //Single threaded : This is also the ui thread
+        loop_sched_.startPhase(ph_step);
+        stepMySimulation();
+        loop_sched_.endPhase(ph_step);
+      }
 
 #ifdef GRAPHICS_ON
-      if(scl::CDatabase::getData()->pause_graphics_)
-      { continue; }
-      else
+      if(false == scl::CDatabase::getData()->pause_graphics_)
       {
         if(gr_frm_ctr_<=gr_frm_skip_)
-        { gr_frm_ctr_++; continue; }
-        gr_frm_ctr_ = 0;
-        glutMainLoopEvent(); //Update the graphics
-        gr_ctr_++;
+        { gr_frm_ctr_++; }
+        else
+        {
+          gr_frm_ctr_ = 0;
+          glutMainLoopEvent(); //Update the graphics
+          gr_ctr_++;
+        }
       }
 #endif
+
+      //Sleep till the next tick (a no-op without -rate)
+      loop_sched_.waitForNextTick();
     }
   }
 
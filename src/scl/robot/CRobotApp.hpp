@@ -35,7 +35,9 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 //Standard includes
 #include <scl/DataTypes.hpp>
 #include <scl/control/task/CTaskBase.hpp>
+#include <scl/control/task/STaskCommand.hpp>
 #include <scl/robot/CRobot.hpp>
+#include <scl/util/CLoopScheduler.hpp>
 
 #include <scl/dynamics/scl/CDynamicsScl.hpp>
 #include <scl_ext/dynamics/scl_spatial/CDynamicsSclSpatial.hpp>
@@ -120,14 +122,40 @@ namespace scl
 
     /** Runs a simulation using two threads:
      * Thread 1: Computes the robot dynamics
-     * Thread 2: Renders the graphics and handles gui interaction */
+     * Thread 2: Renders the graphics and handles gui interaction
+     *
+     * With "-rate <hz>", thread 1 runs at a fixed rate with absolute
+     * deadlines (and optionally "-rtprio <p> -cpu <n> -mlock"). */
     void runMainLoopThreaded(const int& thread_id);
 
+    /** Multi-rate mode (enabled with the "-mr <servo_to_model_rate>" arg) :
+     * Runs the model thread. Computes the robot's dynamic model every
+     * servo_to_model_rate_ simulation timesteps (in wall clock time) while
+     * runMainLoopThreaded() keeps running the servo.
+     *
+     * Spawn an extra thread for this. Eg. omp_set_num_threads(4); and call
+     * this from thread 3. */
+    void runModelLoopThreaded();
+
+    /** Sends the ui points' positions to their tasks' goals through
+     * the controller's "ui" command channel. The gui thread calls this
+     * (so it never writes task goals while the servo reads them). */
+    void sendUiGoals();
+
     /** Runs a simulation using one thread.
      * 1: Computes the robot dynamics
      * 2: Renders the graphics and handles gui interaction */
     void runMainLoop();
 
+    /** Sets up loop_sched_ for the calling thread with the -rate, -rtprio,
+     * -cpu and -mlock options. Does nothing without -rate.
+     *
+     * If the scheduler can't be set up, the loop runs free (no rate
+     * control). If the rt priority, cpu pinning or memory lock fail, it
+     * runs at the rate without them. Either way, it says so and returns
+     * false. */
+    scl::sBool initLoopScheduler();
+
     //Data types. Feel free to use them.
     scl::SDatabase* db_;                 //Generic database (for sharing data)
 
@@ -144,6 +172,12 @@ namespace scl
     scl::CDynamicsScl* dyn_scl_;          //Generic scl dynamics
 
     scl::sLongLong ctrl_ctr_;             //Controller computation counter
+    scl::sUInt servo_to_model_rate_;      //Multi-rate mode servo:model ratio (0 : single rate)
+    scl::sFloat loop_rate_hz_;            //Servo loop rate (-rate). 0 : As fast as possible
+    int loop_rt_priority_;                //SCHED_FIFO priority (-rtprio). 0 : Normal scheduling
+    int loop_cpu_;                        //Cpu to pin the servo loop to (-cpu). -1 : Any
+    scl::sBool flag_loop_mlock_;          //Lock memory for the servo loop (-mlock)
+    scl::CLoopScheduler loop_sched_;      //Servo loop timing and overrun accounting
     scl::sFloat t_start_, t_end_;         //Start and end times
 
     /** This is an internal class for organizing the control-task
@@ -172,6 +206,9 @@ namespace scl
      * NOTE : This is presently designed for a task controller's xyz ctrl tasks */
     std::vector<SUiCtrlPointData> taskvec_ui_ctrl_point_;
 
+    /** The ui thread's command channel into the controller (NULL if there are no ui points) */
+    scl::CTaskCommandChannel* ui_cmd_channel_;
+
     //Graphics stuff
 #ifdef GRAPHICS_ON
     std::vector<std::string> graphics_parsed_; //Parsed graphics views
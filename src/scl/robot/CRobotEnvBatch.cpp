@@ -0,0 +1,332 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+*/
+/* \file CRobotEnvBatch.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include <scl/robot/CRobotEnvBatch.hpp>
+
+#include <cmath>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace scl
+{
+  CRobotEnvBatch::CRobotEnvBatch() :
+      robot_(S_NULL), dof_(0), dt_(0), model_every_(1), n_threads_(1),
+      has_been_init_(false)
+  { }
+
+  CRobotEnvBatch::~CRobotEnvBatch()
+  { clear(); }
+
+  void CRobotEnvBatch::clear()
+  {
+    for(size_t i=0; i<envs_.size(); ++i)
+    { delete envs_[i];  }
+    envs_.clear();
+  }
+
+  sBool CRobotEnvBatch::init(const SRobotParsed& arg_robot,
+      const SControllerGc& arg_ctrl,
+      const sUInt arg_n_envs,
+      const sFloat arg_dt,
+      const sUInt arg_model_every,
+      const sUInt arg_threads)
+  {
+    try
+    {
+      has_been_init_ = false;
+      clear();
+
+      if(0 >= arg_robot.dof_)
+      { throw(std::runtime_error("Can not simulate a robot with 0 dof.")); }
+      if(0 == arg_n_envs)
+      { throw(std::runtime_error("Need at least one environment.")); }
+      if(0 >= arg_dt)
+      { throw(std::runtime_error("The time step must be positive.")); }
+      if(0 == arg_model_every)
+      { throw(std::runtime_error("The model update interval must be at least one tick.")); }
+
+      sUInt n_threads = arg_threads;
+#ifdef _OPENMP
+      if(0 == n_threads) { n_threads = static_cast<sUInt>(omp_get_max_threads()); }
+#endif
+      if(0 == n_threads) { n_threads = 1; }
+
+      robot_ = &arg_robot;
+      dof_ = arg_robot.dof_;
+      dt_ = arg_dt;
+      model_every_ = arg_model_every;
+      n_threads_ = n_threads;
+
+      if(false == dynamics_.init(arg_robot))
+      { throw(std::runtime_error("Could not initialize the dynamics.")); }
+      if(false == integrator_.init(arg_robot))
+      { throw(std::runtime_error("Could not initialize the integrator.")); }
+
+      // Use the limits only if they are sane (like CRobot does).
+      gc_min_.resize(0); gc_max_.resize(0);
+      if(arg_robot.flag_apply_gc_pos_limits_ &&
+          static_cast<sUInt>(arg_robot.gc_pos_limit_max_.size()) == dof_ &&
+          static_cast<sUInt>(arg_robot.gc_pos_limit_min_.size()) == dof_ &&
+          (arg_robot.gc_pos_limit_max_.array() > arg_robot.gc_pos_limit_min_.array()).all())
+      { gc_min_ = arg_robot.gc_pos_limit_min_; gc_max_ = arg_robot.gc_pos_limit_max_; }
+
+      fgc_min_.resize(0); fgc_max_.resize(0);
+      if(arg_robot.flag_apply_actuator_force_limits_ &&
+          static_cast<sUInt>(arg_robot.actuator_forces_max_.size()) == dof_ &&
+          static_cast<sUInt>(arg_robot.actuator_forces_min_.size()) == dof_)
+      { fgc_min_ = arg_robot.actuator_forces_min_; fgc_max_ = arg_robot.actuator_forces_max_; }
+
+      q_.setZero(arg_n_envs, dof_);
+      dq_.setZero(arg_n_envs, dof_);
+      fgc_.setZero(arg_n_envs, dof_);
+
+      // NOTE : The gc controller's init doesn't modify the robot. It just
+      // doesn't take a const pointer.
+      SRobotParsed* robot = const_cast<SRobotParsed*>(&arg_robot);
+
+      envs_.resize(arg_n_envs, S_NULL);
+      for(sUInt i=0; i<arg_n_envs; ++i)
+      {
+        envs_[i] = new SRobotEnv();
+        SRobotEnv& e = *envs_[i];
+        std::stringstream ss; ss<<arg_robot.name_<<"::env"<<i;
+
+        if(false == e.io_.init(arg_robot))
+        { throw(std::runtime_error(std::string("Could not initialize the io data for ")+ss.str())); }
+        if(false == e.gc_model_ctrl_.init(arg_robot) || false == e.gc_model_integ_.init(arg_robot))
+        { throw(std::runtime_error(std::string("Could not initialize the gc models for ")+ss.str())); }
+
+        if(false == e.ctrl_ds_.init(ss.str(), robot, &e.io_,
+            arg_ctrl.kp_, arg_ctrl.kv_, arg_ctrl.ka_, arg_ctrl.ki_,
+            arg_ctrl.force_gc_max_, arg_ctrl.force_gc_min_, &e.gc_model_ctrl_))
+        { throw(std::runtime_error(std::string("Could not initialize the controller data for ")+ss.str())); }
+        if(false == e.ctrl_.init(&e.ctrl_ds_, &dynamics_))
+        { throw(std::runtime_error(std::string("Could not initialize the controller for ")+ss.str())); }
+      }
+
+      has_been_init_ = true;
+
+      seedAll(0);
+      if(false == resetAll(0))
+      { throw(std::runtime_error("Could not reset the environments.")); }
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCRobotEnvBatch::init() : "<<e.what();
+      clear();
+      has_been_init_ = false;
+    }
+    return has_been_init_;
+  }
+
+  sBool CRobotEnvBatch::stepEnv(SRobotEnv& arg_env)
+  {
+    SRobotSensors& sensors = arg_env.io_.sensors_;
+    Eigen::VectorXd& fgc = arg_env.io_.actuators_.force_gc_commanded_;
+
+    bool flag = true;
+    if(0 == arg_env.ticks_ % model_every_)
+    { flag = arg_env.ctrl_.computeDynamics(); }
+    flag = flag && arg_env.ctrl_.computeControlForces();
+
+    if(0 < fgc_max_.size())
+    { fgc = fgc.cwiseMin(fgc_max_).cwiseMax(fgc_min_); }
+
+    flag = flag && integrator_.integrate(arg_env.gc_model_integ_, arg_env.io_, dt_);
+
+    if(robot_->flag_apply_gc_damping_)
+    { sensors.dq_.array() -= sensors.dq_.array() * robot_->damping_gc_.array(); }
+
+    //Collide with the gc limits with heavy energy loss (like CRobot).
+    if(0 < gc_max_.size())
+    {
+      for(sUInt i=0; i<dof_; ++i)
+      {
+        if(sensors.q_(i) > gc_max_(i)) { sensors.q_(i) = gc_max_(i); }
+        else if(sensors.q_(i) < gc_min_(i)) { sensors.q_(i) = gc_min_(i); }
+        else { continue; }
+        sensors.dq_(i) *= 0.01;
+        sensors.ddq_(i) = 0;
+      }
+    }
+
+    ++arg_env.ticks_;
+    arg_env.t_ = arg_env.ticks_ * dt_;
+    return flag;
+  }
+
+  void CRobotEnvBatch::copyState(const sUInt arg_env)
+  {
+    const SRobotIO& io = envs_[arg_env]->io_;
+    q_.row(arg_env) = io.sensors_.q_.transpose();
+    dq_.row(arg_env) = io.sensors_.dq_.transpose();
+    fgc_.row(arg_env) = io.actuators_.force_gc_commanded_.transpose();
+  }
+
+  sBool CRobotEnvBatch::step(const sUInt arg_ticks)
+  {
+    if(false == has_been_init_) { return false; }
+
+    const int n_envs = static_cast<int>(envs_.size());
+    int n_failed = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads_) reduction(+:n_failed)
+#endif
+    for(int i=0; i<n_envs; ++i)
+    {
+      SRobotEnv& e = *envs_[i];
+      bool flag = true;
+      for(sUInt k=0; k<arg_ticks && flag; ++k)
+      { flag = stepEnv(e); }
+      if(false == flag) { ++n_failed; }
+      copyState(static_cast<sUInt>(i));
+    }
+    return (0 == n_failed);
+  }
+
+  sBool CRobotEnvBatch::seed(const sUInt arg_env, const std::uint64_t arg_seed)
+  {
+    if(arg_env >= envs_.size()) { return false; }
+    envs_[arg_env]->rng_.seed(arg_seed);
+    return true;
+  }
+
+  void CRobotEnvBatch::seedAll(const std::uint64_t arg_seed)
+  {
+    for(size_t i=0; i<envs_.size(); ++i)
+    { envs_[i]->rng_.seed(arg_seed * 0x9E3779B97F4A7C15ULL + i); }
+  }
+
+  sBool CRobotEnvBatch::reset(const sUInt arg_env, const Eigen::VectorXd& arg_q,
+      const Eigen::VectorXd& arg_dq)
+  {
+    try
+    {
+      if(false == has_been_init_)
+      { throw(std::runtime_error("Not initialized.")); }
+      if(arg_env >= envs_.size())
+      { throw(std::runtime_error("No such environment.")); }
+      if(static_cast<sUInt>(arg_q.size()) != dof_ || static_cast<sUInt>(arg_dq.size()) != dof_)
+      { throw(std::runtime_error("The state's size doesn't match the robot's dof.")); }
+
+      SRobotEnv& e = *envs_[arg_env];
+      e.io_.sensors_.q_ = arg_q;
+      e.io_.sensors_.dq_ = arg_dq;
+      e.io_.sensors_.ddq_.setZero(dof_);
+      e.io_.actuators_.force_gc_commanded_.setZero(dof_);
+
+      e.ctrl_ds_.integral_force_.setZero(dof_);
+      e.ctrl_ds_.integral_gain_time_curr_ = -1;
+      e.ctrl_ds_.integral_gain_time_pre_ = -1;
+
+      // The servo needs a model for the new state
+      if(false == e.ctrl_.computeDynamics())
+      { throw(std::runtime_error("Could not compute the model.")); }
+
+      e.ticks_ = 0;
+      e.t_ = 0;
+      copyState(arg_env);
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCRobotEnvBatch::reset("<<arg_env<<") : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+
+  sBool CRobotEnvBatch::reset(const sUInt arg_env, const sFloat arg_noise)
+  {
+    if(false == has_been_init_ || arg_env >= envs_.size()) { return false; }
+
+    SRobotEnv& e = *envs_[arg_env];
+    Eigen::VectorXd q;
+    if(static_cast<sUInt>(robot_->gc_pos_default_.size()) == dof_)
+    { q = robot_->gc_pos_default_; }
+    else
+    { q.setZero(dof_); }
+
+    if(0 < arg_noise)
+    {
+      std::uniform_real_distribution<sFloat> u(-arg_noise, arg_noise);
+      for(sUInt i=0; i<dof_; ++i) { q(i) += u(e.rng_); }
+    }
+    if(0 < gc_max_.size())
+    { q = q.cwiseMin(gc_max_).cwiseMax(gc_min_); }
+
+    return reset(arg_env, q, Eigen::VectorXd::Zero(dof_));
+  }
+
+  sBool CRobotEnvBatch::resetAll(const sFloat arg_noise)
+  {
+    bool flag = true;
+    for(sUInt i=0; i<envs_.size(); ++i)
+    { flag = reset(i, arg_noise) && flag; }
+    return flag;
+  }
+
+  sBool CRobotEnvBatch::setGoal(const sUInt arg_env, const Eigen::VectorXd& arg_q_des)
+  {
+    if(arg_env >= envs_.size() || static_cast<sUInt>(arg_q_des.size()) != dof_)
+    { return false; }
+    envs_[arg_env]->ctrl_ds_.des_q_ = arg_q_des;
+    return true;
+  }
+
+  sBool CRobotEnvBatch::setGoals(const MatrixEnv& arg_q_des)
+  {
+    if(static_cast<size_t>(arg_q_des.rows()) != envs_.size() ||
+        static_cast<sUInt>(arg_q_des.cols()) != dof_)
+    { return false; }
+    for(size_t i=0; i<envs_.size(); ++i)
+    { envs_[i]->ctrl_ds_.des_q_ = arg_q_des.row(i).transpose(); }
+    return true;
+  }
+
+  sBool CRobotEnvBatch::setGains(const sUInt arg_env, const Eigen::VectorXd& arg_kp,
+      const Eigen::VectorXd& arg_kv)
+  {
+    if(arg_env >= envs_.size()) { return false; }
+    const sUInt np = static_cast<sUInt>(arg_kp.size()), nv = static_cast<sUInt>(arg_kv.size());
+    if((1 != np && dof_ != np) || (1 != nv && dof_ != nv))
+    { return false; }
+
+    SControllerGc& c = envs_[arg_env]->ctrl_ds_;
+    if(1 == np) { c.kp_.setConstant(dof_, arg_kp(0)); } else { c.kp_ = arg_kp; }
+    if(1 == nv) { c.kv_.setConstant(dof_, arg_kv(0)); } else { c.kv_ = arg_kv; }
+    return true;
+  }
+}
@@ -0,0 +1,203 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+*/
+/* \file CRobotEnvBatch.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CROBOTENVBATCH_HPP_
+#define CROBOTENVBATCH_HPP_
+
+#include <scl/DataTypes.hpp>
+#include <scl/data_structs/SRobotParsed.hpp>
+#include <scl/data_structs/SRobotIO.hpp>
+#include <scl/data_structs/SGcModel.hpp>
+#include <scl/control/gc/CControllerGc.hpp>
+#include <scl/control/gc/data_structs/SControllerGc.hpp>
+#include <scl/dynamics/scl/CDynamicsScl.hpp>
+
+#include <scl_ext/dynamics/scl_spatial/CDynamicsSclSpatial.hpp>
+
+#include <Eigen/Dense>
+
+#include <vector>
+#include <random>
+#include <cstdint>
+
+namespace scl
+{
+  /** Runs many independent simulations of one robot in one process.
+   * Each environment is a robot with its own state, a gc controller
+   * and an integrator. All of them share the parsed robot and the
+   * (stateless) dynamics engines, so a new environment only costs its
+   * io data, controller data and two gc models.
+   *
+   * step() advances every environment on the OpenMP thread team (which
+   * the runtime keeps alive between calls) and then exposes their states
+   * as contiguous N x dof arrays : row i is environment i.
+   *
+   * Use it for parameter sweeps and learning experiments instead of
+   * launching a simulator process per run :
+   *   init() -> seedAll() -> resetAll() -> { setGoals() -> step() -> getQ() } x n
+   *
+   * NOTE : Environments don't see the database, the sim clock, or each
+   * other. Each keeps its own time (see getTime). */
+  class CRobotEnvBatch
+  {
+  public:
+    /** A row per environment, a column per dof */
+    typedef Eigen::Matrix<sFloat, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> MatrixEnv;
+
+    /** Creates arg_n_envs environments for the robot. Their controllers
+     * copy the gains and force limits of arg_ctrl (eg. a gc controller
+     * parsed from the robot's file).
+     *
+     * arg_dt : The integration time step.
+     * arg_model_every : Updates the controller's model every n ticks.
+     * arg_threads : 0 uses all the OpenMP threads.
+     *
+     * The environments start at the robot's default position
+     * (seeded with their index). */
+    sBool init(const SRobotParsed& arg_robot,
+        const SControllerGc& arg_ctrl,
+        const sUInt arg_n_envs,
+        const sFloat arg_dt,
+        const sUInt arg_model_every=1,
+        const sUInt arg_threads=0);
+
+    /** Advances every environment by arg_ticks time steps, in parallel.
+     * Returns false if any environment failed. */
+    sBool step(const sUInt arg_ticks=1);
+
+    /* ******************************************************************
+     *                      Per environment control
+     * ****************************************************************** */
+    /** Seeds an environment's random number generator (used by reset) */
+    sBool seed(const sUInt arg_env, const std::uint64_t arg_seed);
+
+    /** Seeds every environment. Environment i gets a seed derived from
+     * arg_seed and i, so runs repeat for any thread count. */
+    void seedAll(const std::uint64_t arg_seed);
+
+    /** Puts an environment at (q, dq) with no acceleration and restarts
+     * its time. Also clears its controller's integral term. */
+    sBool reset(const sUInt arg_env, const Eigen::VectorXd& arg_q,
+        const Eigen::VectorXd& arg_dq);
+
+    /** Puts an environment at rest at the robot's default position plus
+     * uniform noise in [-arg_noise, arg_noise] (from its own random
+     * number generator). Stays within the gc limits if the robot has
+     * sane ones. */
+    sBool reset(const sUInt arg_env, const sFloat arg_noise=0);
+
+    /** Resets every environment with reset(i, arg_noise) */
+    sBool resetAll(const sFloat arg_noise=0);
+
+    /** Sets an environment's gc position goal */
+    sBool setGoal(const sUInt arg_env, const Eigen::VectorXd& arg_q_des);
+
+    /** Sets every environment's goal. Row i is environment i's goal. */
+    sBool setGoals(const MatrixEnv& arg_q_des);
+
+    /** Sets an environment's controller gains (size 1 or dof) */
+    sBool setGains(const sUInt arg_env, const Eigen::VectorXd& arg_kp,
+        const Eigen::VectorXd& arg_kv);
+
+    /* ******************************************************************
+     *                              State
+     * ****************************************************************** */
+    /** The environments' generalized coordinates, velocities and
+     * commanded forces, as of the last step() or reset(). */
+    const MatrixEnv& getQ() const { return q_; }
+    const MatrixEnv& getDq() const { return dq_; }
+    const MatrixEnv& getForces() const { return fgc_; }
+
+    /** The time since an environment's last reset */
+    sFloat getTime(const sUInt arg_env) const
+    { return envs_[arg_env]->t_; }
+
+    /** An environment's io data and controller data. Use these for
+     * anything the batch API doesn't cover. */
+    SRobotIO* getIO(const sUInt arg_env)
+    { return (arg_env < envs_.size()) ? &(envs_[arg_env]->io_) : S_NULL; }
+    SControllerGc* getController(const sUInt arg_env)
+    { return (arg_env < envs_.size()) ? &(envs_[arg_env]->ctrl_ds_) : S_NULL; }
+
+    sUInt getNumEnvs() const { return static_cast<sUInt>(envs_.size()); }
+    sUInt getDof() const { return dof_; }
+    sUInt getNumThreads() const { return n_threads_; }
+    sBool hasBeenInit() const { return has_been_init_; }
+
+    CRobotEnvBatch();
+    ~CRobotEnvBatch();
+
+  private:
+    /** One simulation. Heap allocated : the controller points into it. */
+    struct SRobotEnv
+    {
+      SRobotIO io_;
+      SGcModel gc_model_ctrl_;   ///< The controller's model
+      SGcModel gc_model_integ_;  ///< The integrator's scratch model
+      SControllerGc ctrl_ds_;
+      CControllerGc ctrl_;
+      std::mt19937_64 rng_;
+      sLongLong ticks_ = 0;
+      sFloat t_ = 0;
+    };
+
+    /** Advances one environment by a time step */
+    sBool stepEnv(SRobotEnv& arg_env);
+
+    /** Copies an environment's state into the batch arrays */
+    void copyState(const sUInt arg_env);
+
+    /** Deletes the environments */
+    void clear();
+
+    std::vector<SRobotEnv*> envs_;
+
+    /** Shared by all the environments (their methods are const) */
+    CDynamicsScl dynamics_;
+    scl_ext::CDynamicsSclSpatial integrator_;
+
+    const SRobotParsed* robot_;
+    sUInt dof_;
+    sFloat dt_;
+    sUInt model_every_;
+    sUInt n_threads_;
+
+    /** Per gc limits, or empty if the robot doesn't have sane ones */
+    Eigen::VectorXd gc_min_, gc_max_;
+    Eigen::VectorXd fgc_min_, fgc_max_;
+
+    MatrixEnv q_, dq_, fgc_;
+
+    sBool has_been_init_;
+  };
+}
+
+#endif /* CROBOTENVBATCH_HPP_ */
@@ -40,6 +40,7 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <scl/data_structs/SRobotParsed.hpp>
 #include <scl/data_structs/SGraphicsParsed.hpp>
 #include <scl/data_structs/SRobotIO.hpp>
+#include <scl/parser/sclparser/CParserScl.hpp>
 
 #include <scl/control/AllHeaders.hpp>
 #include <scl/actuation/AllHeaders.hpp>
@@ -66,6 +67,8 @@ namespace scl_registry
       std::vector<std::string>* arg_ui_parsed)
   {
     bool flag;
+    // The read and list calls below share the parsed file. It's dropped on return.
+    scl::CXmlLoadScope xml_scope;
     try
     {
       //1. Verify that the database exists
@@ -85,14 +88,12 @@ namespace scl_registry
         throw(std::runtime_error("Could not read robot names from the file"));
       }
 
+      if(false == scl_registry::parseRobots(arg_file, robot_names, arg_parser))
+      { throw(std::runtime_error("Could not register robots with the database"));  }
+      if(S_NULL!=arg_robots_parsed)//To be returned to caller
+      { arg_robots_parsed->insert(arg_robots_parsed->end(), robot_names.begin(), robot_names.end()); }
+
       std::vector<std::string>::iterator itr, itre;
-      for(itr = robot_names.begin(), itre = robot_names.end();itr!=itre;++itr)
-      {
-        if(S_NULL == scl_registry::parseRobot(arg_file, *itr, arg_parser))
-        { throw(std::runtime_error("Could not register robot with the database"));  }
-        if(S_NULL!=arg_robots_parsed)//To be returned to caller
-        { arg_robots_parsed->push_back(*itr); }
-      }
 
       //3. List and parse graphics
       if(S_NULL!=arg_graphics_parsed)
@@ -225,6 +226,78 @@ namespace scl_registry
     return rob;
   }
 
+  bool parseRobots(const std::string &arg_file,
+      const std::vector<std::string> &arg_robot_names,
+      scl::CParserBase *arg_parser)
+  {
+    std::vector<scl::SRobotParsed*> robs(arg_robot_names.size(), S_NULL);
+    std::vector<scl::SRobotIO*> rob_ios(arg_robot_names.size(), S_NULL);
+    const int n_robs = static_cast<int>(arg_robot_names.size());
+    try
+    {
+      if(NULL == scl::CDatabase::getData())
+      { throw(std::runtime_error("Database not initialized.")); }
+
+      if(NULL == arg_parser)
+      { throw(std::runtime_error("Passed a NULL parser.")); }
+
+      //1. Create the ds entries (the database's lists aren't thread safe)
+      for(int i=0; i<n_robs; ++i)
+      {
+        if(1 > arg_robot_names[i].size())
+        { throw(std::runtime_error("Robot name is too short.")); }
+
+        robs[i] = scl::CDatabase::getData()->s_parser_.robots_.create(arg_robot_names[i]);
+        if(NULL==robs[i])
+        { throw(std::runtime_error(std::string("Could not create a robot data structure on the pile : ")+arg_robot_names[i])); }
+      }
+
+      //2. Fill in the ds entries from the file. Each robot only touches its own entry.
+      const std::string& dir_specs = scl::CDatabase::getData()->dir_specs_;
+      std::vector<char> flags(n_robs, 0);
+#pragma omp parallel for schedule(dynamic) if(arg_parser->isThreadSafe() && n_robs > 1)
+      for(int i=0; i<n_robs; ++i)
+      { flags[i] = arg_parser->readRobotFromFile(arg_file, dir_specs, arg_robot_names[i], *robs[i]) ? 1 : 0; }
+
+      //3. Register the robots' I/O
+      for(int i=0; i<n_robs; ++i)
+      {
+        if(0 == flags[i])
+        { throw(std::runtime_error(std::string("Could not parse the robot from the file : ")+arg_robot_names[i])); }
+
+        if(robs[i]->name_ != arg_robot_names[i])
+        { throw(std::runtime_error("Parsed robot has a different name. This should never happen.")); }
+
+        rob_ios[i] = scl::CDatabase::getData()->s_io_.io_data_.create(arg_robot_names[i]);
+        if(NULL==rob_ios[i])
+        { throw(std::runtime_error("Could not create a robot IO data structure on the pile..")); }
+
+        if(false == rob_ios[i]->init(*robs[i]))
+        { throw(std::runtime_error("Could not initialize the robot's I/O data structure.")); }
+
+        rob_ios[i]->setGcPosition(robs[i]->gc_pos_default_);
+
+        std::cout<<"\nscl_registry::parseRobots() : Parsed : "<<arg_robot_names[i];
+      }
+    }
+    catch (std::exception& e)
+    {
+      std::cerr<<"\nscl_registry::parseRobots() : "<<e.what();
+
+      //Deallocate the ds memory for the robots
+      for(int i=0; i<n_robs; ++i)
+      {
+        if(NULL!=robs[i])
+        { scl::CDatabase::getData()->s_parser_.robots_.erase(robs[i]); }
+
+        if(NULL!=rob_ios[i])
+        { scl::CDatabase::getData()->s_io_.io_data_.erase(rob_ios[i]); }
+      }
+      return false;
+    }
+    return true;
+  }
+
   const scl::SGraphicsParsed* parseGraphics(const std::string &arg_file,
       const std::string & arg_graphics_name,
       scl::CParserBase *arg_parser)
@@ -103,6 +103,20 @@ namespace scl_registry
                 const std::string &arg_robot_name,
                 scl::CParserBase *arg_parser);
 
+  /** Loads a set of robots from a file and registers them
+   * with the database (see parseRobot()).
+   *
+   * The robots are independent, so if the parser is thread safe
+   * they are read in parallel (OpenMP threads). The database entries
+   * are created and registered sequentially.
+   *
+   * @return :
+   *    success : true (all the robots were loaded)
+   *    failure : false (none of the robots are left in the database) */
+  bool parseRobots(const std::string &arg_file,
+      const std::vector<std::string> &arg_robot_names,
+      scl::CParserBase *arg_parser);
+
   /** Loads a graphics specification from a file and registers
    * it with the database.
    *
@@ -49,5 +49,6 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <scl/robot/DbRegisterFunctions.hpp>
 #include <scl/robot/data_structs/SRobot.hpp>
 #include <scl/robot/CRobot.hpp>
+#include <scl/robot/CRobotEnvBatch.hpp>
 
 #endif /* SCL_HPP_ */
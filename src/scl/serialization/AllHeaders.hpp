@@ -34,5 +34,7 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #define SRC_SCL_SERIALIZATION_ALLHEADERS_HPP_
 
 #include <scl/serialization/SerializationJSON.hpp>
+#include <scl/serialization/SerializationBinary.hpp>
+#include <scl/serialization/SerializationJSONStream.hpp>
 
 #endif /* SRC_SCL_SERIALIZATION_ALLHEADERS_HPP_ */
@@ -0,0 +1,731 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file SerializationBinary.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include <scl/serialization/SerializationBinary.hpp>
+#include <scl/data_structs/SRobotIO.hpp>
+#include <scl/data_structs/SGcModel.hpp>
+#include <scl/control/task/data_structs/SControllerMultiTask.hpp>
+#include <scl/control/gc/data_structs/SControllerGc.hpp>
+#include <scl/control/task/tasks/data_structs/STaskOpPos.hpp>
+#include <scl/control/task/tasks/data_structs/STaskOpPosPIDA1OrderInfTime.hpp>
+#include <scl/control/task/tasks/data_structs/STaskComPos.hpp>
+#include <scl/control/task/tasks/data_structs/STaskGc.hpp>
+#include <scl/control/task/tasks/data_structs/STaskGcSet.hpp>
+#include <scl/control/task/tasks/data_structs/STaskGcLimitCentering.hpp>
+#include <scl/control/task/tasks/data_structs/STaskConstraintPlane.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace scl
+{
+  namespace
+  {
+    /** The parsed structs are written field by field (they hold strings,
+     * sutil containers and Eigen objects, so they can't be copied as is). */
+    void writeObject(CBinaryWriter& w, const SRigidBodyGraphics& g)
+    {
+      w.writeEigen(g.pos_in_parent_);
+      w.writeEigen(g.ori_parent_quat_);
+      w.writeEigen(g.scaling_);
+      w.writeI32(g.collision_type_);
+      w.writeDouble(g.option_axis_frame_size_);
+      w.writeString(g.file_name_);
+      w.writeI32(static_cast<std::int32_t>(g.class_));
+      for(auto i:{0,1,2}) { w.writeDouble(g.color_[i]); }
+    }
+
+    bool readObject(CBinaryReader& r, SRigidBodyGraphics& g)
+    {
+      std::int32_t cls=0;
+      r.readEigen(g.pos_in_parent_);
+      r.readEigen(g.ori_parent_quat_);
+      r.readEigen(g.scaling_);
+      r.readI32(g.collision_type_);
+      r.readDouble(g.option_axis_frame_size_);
+      r.readString(g.file_name_);
+      r.readI32(cls);
+      g.class_ = static_cast<SRigidBodyGraphics::EGraphicObjectType>(cls);
+      for(auto i:{0,1,2}) { r.readDouble(g.color_[i]); }
+      return r.ok();
+    }
+
+    void writeObject(CBinaryWriter& w, const SRigidBody& l)
+    {
+      w.writeString(l.name_);
+      w.writeBool(l.has_been_init_);
+      w.writeString(l.robot_name_);
+      w.writeI32(l.link_id_);
+      w.writeString(l.parent_name_);
+      w.writeBool(l.is_root_);
+      w.writeEigen(l.pos_in_parent_);
+      w.writeEigen(l.ori_parent_quat_.coeffs());
+      w.writeEigen(l.com_);
+      w.writeDouble(l.mass_);
+      w.writeEigen(l.inertia_);
+      w.writeDouble(l.inertia_gc_);
+      w.writeI32(l.link_is_fixed_);
+      w.writeString(l.joint_name_);
+      w.writeDouble(l.joint_limit_lower_);
+      w.writeDouble(l.joint_limit_upper_);
+      w.writeDouble(l.joint_default_pos_);
+      w.writeI32(static_cast<std::int32_t>(l.joint_type_));
+      w.writeDouble(l.stiction_gc_force_lower_);
+      w.writeDouble(l.stiction_gc_force_upper_);
+      w.writeDouble(l.stiction_gc_vel_lower_);
+      w.writeDouble(l.stiction_gc_vel_upper_);
+      w.writeDouble(l.friction_gc_kv_);
+      w.writeDouble(l.force_gc_lim_lower_);
+      w.writeDouble(l.force_gc_lim_upper_);
+
+      w.writeU32(static_cast<std::uint32_t>(l.sp_joint_name_.size()));
+      for(const auto& s : l.sp_joint_name_) { w.writeString(s); }
+      w.writeU32(static_cast<std::uint32_t>(l.sp_joint_broken_in_spanning_tree_.size()));
+      for(bool b : l.sp_joint_broken_in_spanning_tree_) { w.writeBool(b); }
+      w.writeEigen(l.sp_joint_limit_lower_);
+      w.writeEigen(l.sp_joint_limit_upper_);
+      w.writeEigen(l.sp_joint_default_pos_);
+      w.writeEigen(l.sp_S_joint_);
+      w.writeEigen(l.sp_Sorth_joint_);
+
+      w.writeU32(static_cast<std::uint32_t>(l.graphics_obj_vec_.size()));
+      for(const auto& g : l.graphics_obj_vec_) { writeObject(w,g); }
+      w.writeI32(l.collision_type_);
+      w.writeI32(static_cast<std::int32_t>(l.render_type_));
+    }
+
+    bool readObject(CBinaryReader& r, SRigidBody& l)
+    {
+      std::int32_t itmp=0;
+      std::uint32_t n=0;
+      Eigen::Vector4d q;
+
+      r.readString(l.name_);
+      r.readBool(l.has_been_init_);
+      r.readString(l.robot_name_);
+      r.readI32(l.link_id_);
+      r.readString(l.parent_name_);
+      r.readBool(l.is_root_);
+      r.readEigen(l.pos_in_parent_);
+      r.readEigen(q); l.ori_parent_quat_.coeffs() = q;
+      r.readEigen(l.com_);
+      r.readDouble(l.mass_);
+      r.readEigen(l.inertia_);
+      r.readDouble(l.inertia_gc_);
+      r.readI32(l.link_is_fixed_);
+      r.readString(l.joint_name_);
+      r.readDouble(l.joint_limit_lower_);
+      r.readDouble(l.joint_limit_upper_);
+      r.readDouble(l.joint_default_pos_);
+      r.readI32(itmp); l.joint_type_ = static_cast<EJointType>(itmp);
+      r.readDouble(l.stiction_gc_force_lower_);
+      r.readDouble(l.stiction_gc_force_upper_);
+      r.readDouble(l.stiction_gc_vel_lower_);
+      r.readDouble(l.stiction_gc_vel_upper_);
+      r.readDouble(l.friction_gc_kv_);
+      r.readDouble(l.force_gc_lim_lower_);
+      r.readDouble(l.force_gc_lim_upper_);
+
+      if(!r.readU32(n) || !r.canRead(n)) { return false; }
+      l.sp_joint_name_.resize(n);
+      for(auto& s : l.sp_joint_name_) { r.readString(s); }
+      if(!r.readU32(n) || !r.canRead(n)) { return false; }
+      l.sp_joint_broken_in_spanning_tree_.resize(n);
+      for(std::uint32_t i=0; i<n; ++i)
+      { bool b=false; r.readBool(b); l.sp_joint_broken_in_spanning_tree_[i] = b; }
+      r.readEigen(l.sp_joint_limit_lower_);
+      r.readEigen(l.sp_joint_limit_upper_);
+      r.readEigen(l.sp_joint_default_pos_);
+      r.readEigen(l.sp_S_joint_);
+      r.readEigen(l.sp_Sorth_joint_);
+
+      if(!r.readU32(n) || !r.canRead(n)) { return false; }
+      l.graphics_obj_vec_.resize(n);
+      for(auto& g : l.graphics_obj_vec_)
+      { if(!readObject(r,g)) { return false; } }
+      r.readI32(l.collision_type_);
+      r.readI32(itmp); l.render_type_ = static_cast<ERenderType>(itmp);
+      return r.ok();
+    }
+
+    void writeObject(CBinaryWriter& w, const SMuscleParsed& m)
+    {
+      w.writeString(m.name_);
+      w.writeString(m.muscle_type_);
+      w.writeU32(static_cast<std::uint32_t>(m.points_.size()));
+      for(const auto& p : m.points_)
+      {
+        w.writeEigen(p.pos_in_parent_);
+        w.writeString(p.parent_link_);
+        w.writeU32(static_cast<std::uint32_t>(p.position_on_muscle_));
+      }
+      w.writeDouble(m.max_isometric_force_);
+      w.writeDouble(m.optimal_fiber_length_);
+      w.writeDouble(m.tendon_slack_length_);
+      w.writeDouble(m.pennation_angle_);
+      w.writeDouble(m.activation_time_constt_);
+      w.writeDouble(m.deactivation_time_constt_);
+      w.writeDouble(m.max_contraction_vel_);
+      w.writeDouble(m.max_contraction_vel_low_);
+      w.writeDouble(m.max_contraction_vel_high_);
+      w.writeDouble(m.max_tendon_strain_);
+      w.writeDouble(m.max_muscle_strain_);
+      w.writeDouble(m.stiffness_);
+      w.writeDouble(m.damping_);
+      w.writeDouble(m.stiffness_tendon_);
+    }
+
+    bool readObject(CBinaryReader& r, SMuscleParsed& m)
+    {
+      std::uint32_t n=0;
+      r.readString(m.name_);
+      r.readString(m.muscle_type_);
+      if(!r.readU32(n) || !r.canRead(n)) { return false; }
+      m.points_.resize(n);
+      for(auto& p : m.points_)
+      {
+        std::uint32_t pos=0;
+        r.readEigen(p.pos_in_parent_);
+        r.readString(p.parent_link_);
+        r.readU32(pos); p.position_on_muscle_ = pos;
+      }
+      r.readDouble(m.max_isometric_force_);
+      r.readDouble(m.optimal_fiber_length_);
+      r.readDouble(m.tendon_slack_length_);
+      r.readDouble(m.pennation_angle_);
+      r.readDouble(m.activation_time_constt_);
+      r.readDouble(m.deactivation_time_constt_);
+      r.readDouble(m.max_contraction_vel_);
+      r.readDouble(m.max_contraction_vel_low_);
+      r.readDouble(m.max_contraction_vel_high_);
+      r.readDouble(m.max_tendon_strain_);
+      r.readDouble(m.max_muscle_strain_);
+      r.readDouble(m.stiffness_);
+      r.readDouble(m.damping_);
+      r.readDouble(m.stiffness_tendon_);
+      return r.ok();
+    }
+
+    /** Muscles are written in their sorted order, which is also
+     * the muscle_id_to_name_ order. */
+    void writeObject(CBinaryWriter& w, const SActuatorSetMuscleParsed& ms)
+    {
+      w.writeString(ms.name_);
+      w.writeBool(ms.has_been_init_);
+      w.writeI32(ms.render_muscle_thickness_);
+      w.writeDouble(ms.render_muscle_via_pt_sz_);
+      w.writeU32(static_cast<std::uint32_t>(ms.muscles_.size()));
+      for(auto it = ms.muscles_.begin(), ite = ms.muscles_.end(); it!=ite; ++it)
+      { writeObject(w,*it); }
+      w.writeU32(static_cast<std::uint32_t>(ms.muscle_id_to_name_.size()));
+      for(const auto& s : ms.muscle_id_to_name_) { w.writeString(s); }
+    }
+
+    bool readObject(CBinaryReader& r, SActuatorSetMuscleParsed& ms)
+    {
+      std::uint32_t n=0;
+      r.readString(ms.name_);
+      r.readBool(ms.has_been_init_);
+      r.readI32(ms.render_muscle_thickness_);
+      r.readDouble(ms.render_muscle_via_pt_sz_);
+
+      if(!r.readU32(n) || !r.canRead(n)) { return false; }
+      for(std::uint32_t i=0; i<n; ++i)
+      {
+        SMuscleParsed m;
+        if(!readObject(r,m)) { return false; }
+        if(NULL == ms.muscles_.create(m.name_,m)) { return false; }
+      }
+
+      if(!r.readU32(n) || !r.canRead(n)) { return false; }
+      ms.muscle_id_to_name_.resize(n);
+      for(auto& s : ms.muscle_id_to_name_) { r.readString(s); }
+      if(!r.ok()) { return false; }
+
+      if(n > 0 && false == ms.muscles_.sort(ms.muscle_id_to_name_)) { return false; }
+      for(std::uint32_t i=0; i<n; ++i)
+      {
+        sUInt* id = ms.muscle_name_to_id_.create(ms.muscle_id_to_name_[i]);
+        if(NULL == id) { return false; }
+        *id = i;
+      }
+      ms.n_muscles_ = ms.muscles_.size();
+      return true;
+    }
+  }
+
+  bool serializeToBinary(const SRobotParsed &arg_obj, std::string &ret_buf)
+  {
+    try
+    {
+      CBinaryWriter w(ret_buf);
+      w.writeString(arg_obj.name_);
+      w.writeString(arg_obj.log_file_);
+      w.writeU64(arg_obj.dof_);
+      w.writeEigen(arg_obj.gravity_);
+      w.writeEigen(arg_obj.gc_pos_limit_max_);
+      w.writeEigen(arg_obj.gc_pos_limit_min_);
+      w.writeEigen(arg_obj.gc_pos_default_);
+      w.writeEigen(arg_obj.damping_gc_);
+      w.writeEigen(arg_obj.actuator_forces_max_);
+      w.writeEigen(arg_obj.actuator_forces_min_);
+
+      w.writeBool(arg_obj.flag_apply_gc_damping_);
+      w.writeBool(arg_obj.flag_apply_gc_pos_limits_);
+      w.writeBool(arg_obj.flag_apply_actuator_force_limits_);
+      w.writeBool(arg_obj.flag_apply_actuator_pos_limits_);
+      w.writeBool(arg_obj.flag_apply_actuator_vel_limits_);
+      w.writeBool(arg_obj.flag_apply_actuator_acc_limits_);
+      w.writeBool(arg_obj.flag_controller_on_);
+      w.writeBool(arg_obj.flag_logging_on_);
+      w.writeBool(arg_obj.flag_wireframe_on_);
+      w.writeDouble(arg_obj.option_axis_frame_size_);
+      w.writeDouble(arg_obj.option_muscle_via_pt_sz_);
+
+      // Links (in their sorted order, root at the end)
+      w.writeU32(static_cast<std::uint32_t>(arg_obj.rb_tree_.size()));
+      for(auto it = arg_obj.rb_tree_.begin(), ite = arg_obj.rb_tree_.end(); it!=ite; ++it)
+      { writeObject(w,*it); }
+      w.writeU32(static_cast<std::uint32_t>(arg_obj.robot_tree_numeric_id_to_name_.size()));
+      for(const auto& s : arg_obj.robot_tree_numeric_id_to_name_) { w.writeString(s); }
+
+      // Actuator sets. Only muscle sets are parsed from files for now.
+      std::uint32_t n_sets=0;
+      for(auto it = arg_obj.actuator_sets_.begin(), ite = arg_obj.actuator_sets_.end(); it!=ite; ++it)
+      {
+        if(NULL == dynamic_cast<const SActuatorSetMuscleParsed*>(*it))
+        { throw(std::runtime_error(std::string("Unsupported actuator set type : ") + (*it)->getType())); }
+        n_sets++;
+      }
+      w.writeU32(n_sets);
+      for(auto it = arg_obj.actuator_sets_.begin(), ite = arg_obj.actuator_sets_.end(); it!=ite; ++it)
+      { writeObject(w,*dynamic_cast<const SActuatorSetMuscleParsed*>(*it)); }
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nserializeToBinary() : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+
+  bool deserializeFromBinary(SRobotParsed &ret_obj, const char* arg_buf, const std::size_t arg_len)
+  {
+    try
+    {
+      CBinaryReader r(arg_buf, arg_len);
+      std::uint64_t dof=0;
+      std::uint32_t n=0;
+
+      r.readString(ret_obj.name_);
+      r.readString(ret_obj.log_file_);
+      r.readU64(dof);
+      r.readEigen(ret_obj.gravity_);
+      r.readEigen(ret_obj.gc_pos_limit_max_);
+      r.readEigen(ret_obj.gc_pos_limit_min_);
+      r.readEigen(ret_obj.gc_pos_default_);
+      r.readEigen(ret_obj.damping_gc_);
+      r.readEigen(ret_obj.actuator_forces_max_);
+      r.readEigen(ret_obj.actuator_forces_min_);
+
+      r.readBool(ret_obj.flag_apply_gc_damping_);
+      r.readBool(ret_obj.flag_apply_gc_pos_limits_);
+      r.readBool(ret_obj.flag_apply_actuator_force_limits_);
+      r.readBool(ret_obj.flag_apply_actuator_pos_limits_);
+      r.readBool(ret_obj.flag_apply_actuator_vel_limits_);
+      r.readBool(ret_obj.flag_apply_actuator_acc_limits_);
+      r.readBool(ret_obj.flag_controller_on_);
+      r.readBool(ret_obj.flag_logging_on_);
+      r.readBool(ret_obj.flag_wireframe_on_);
+      r.readDouble(ret_obj.option_axis_frame_size_);
+      r.readDouble(ret_obj.option_muscle_via_pt_sz_);
+      if(!r.ok()) { throw(std::runtime_error("Truncated robot header")); }
+
+      // Links. Their pointers are rebuilt by init() below.
+      if(!r.readU32(n) || !r.canRead(n)) { throw(std::runtime_error("Truncated link list")); }
+      for(std::uint32_t i=0; i<n; ++i)
+      {
+        SRigidBody lnk;
+        if(!readObject(r,lnk)) { throw(std::runtime_error("Truncated link")); }
+        if(NULL == ret_obj.rb_tree_.create(lnk.name_,lnk,lnk.is_root_))
+        { throw(std::runtime_error(std::string("Could not add link : ") + lnk.name_)); }
+      }
+      if(!r.readU32(n) || !r.canRead(n)) { throw(std::runtime_error("Truncated link order")); }
+      ret_obj.robot_tree_numeric_id_to_name_.resize(n);
+      for(auto& s : ret_obj.robot_tree_numeric_id_to_name_) { r.readString(s); }
+      if(!r.ok()) { throw(std::runtime_error("Truncated link order")); }
+
+      if(false == ret_obj.init())
+      { throw(std::runtime_error("Could not link and sort the robot's links")); }
+      if(dof != ret_obj.dof_)
+      { throw(std::runtime_error("Link count doesn't match the robot's dof")); }
+
+      // Actuator sets
+      if(!r.readU32(n) || !r.canRead(n)) { throw(std::runtime_error("Truncated actuator set list")); }
+      for(std::uint32_t i=0; i<n; ++i)
+      {
+        SActuatorSetMuscleParsed *musc = new SActuatorSetMuscleParsed();
+        if(!readObject(r,*musc))
+        { delete musc; throw(std::runtime_error("Could not read a muscle set")); }
+
+        // The parser keys actuator sets by their name
+        SActuatorSetParsed **actset = ret_obj.actuator_sets_.create(musc->name_);
+        if(NULL == actset)
+        {
+          std::string err = std::string("Actuator set already exists : ") + musc->name_;
+          delete musc; throw(std::runtime_error(err));
+        }
+        *actset = musc;
+        musc->robot_ = &ret_obj;
+      }
+
+      if(0 != r.remaining())
+      { throw(std::runtime_error("Unexpected data after the robot")); }
+
+      ret_obj.has_been_init_ = true;
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\ndeserializeFromBinary() : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+
+  /** *****************************************************************************
+   *                          Run-time state
+   * **************************************************************************** */
+  namespace
+  {
+    void writeState(CBinaryWriter& w, const SRigidBodyDyn& l)
+    {
+      w.writeEigen(l.J_com_);
+      w.writeEigen(l.T_o_lnk_.matrix());
+      w.writeEigen(l.T_lnk_.matrix());
+      w.writeDouble(l.q_T_);
+      w.writeEigen(l.sp_q_T_);
+      w.writeEigen(l.sp_dq_T_);
+      w.writeEigen(l.sp_inertia_);
+      w.writeEigen(l.spatial_velocity_);
+      w.writeEigen(l.spatial_acceleration_);
+      w.writeEigen(l.spatial_force_);
+      w.writeEigen(l.sp_X_within_link_);
+      w.writeEigen(l.sp_X_o_lnk_);
+    }
+
+    bool readState(CBinaryReader& r, SRigidBodyDyn& l)
+    {
+      r.readEigen(l.J_com_);
+      r.readEigen(l.T_o_lnk_.matrix());
+      r.readEigen(l.T_lnk_.matrix());
+      r.readDouble(l.q_T_);
+      r.readEigen(l.sp_q_T_);
+      r.readEigen(l.sp_dq_T_);
+      r.readEigen(l.sp_inertia_);
+      r.readEigen(l.spatial_velocity_);
+      r.readEigen(l.spatial_acceleration_);
+      r.readEigen(l.spatial_force_);
+      r.readEigen(l.sp_X_within_link_);
+      r.readEigen(l.sp_X_o_lnk_);
+      return r.ok();
+    }
+
+    /** The task specific state (goals, integral terms etc.) */
+    void writeTaskState(CBinaryWriter& w, const STaskBase& arg_task)
+    {
+      if(const STaskOpPos* t = dynamic_cast<const STaskOpPos*>(&arg_task))
+      {
+        w.writeEigen(t->x_); w.writeEigen(t->dx_); w.writeEigen(t->ddx_);
+        w.writeEigen(t->x_goal_); w.writeEigen(t->dx_goal_); w.writeEigen(t->ddx_goal_);
+        w.writeEigen(t->pos_in_parent_);
+      }
+      else if(const STaskOpPosPIDA1OrderInfTime* t = dynamic_cast<const STaskOpPosPIDA1OrderInfTime*>(&arg_task))
+      {
+        w.writeEigen(t->x_); w.writeEigen(t->dx_); w.writeEigen(t->ddx_);
+        w.writeEigen(t->x_goal_); w.writeEigen(t->dx_goal_); w.writeEigen(t->ddx_goal_);
+        w.writeEigen(t->pos_in_parent_);
+        w.writeEigen(t->integral_force_);
+        w.writeDouble(t->integral_gain_time_pre_);
+        w.writeDouble(t->integral_gain_time_curr_);
+      }
+      else if(const STaskComPos* t = dynamic_cast<const STaskComPos*>(&arg_task))
+      {
+        w.writeEigen(t->x_); w.writeEigen(t->dx_); w.writeEigen(t->ddx_);
+        w.writeEigen(t->x_goal_); w.writeEigen(t->dx_goal_); w.writeEigen(t->ddx_goal_);
+      }
+      else if(const STaskGc* t = dynamic_cast<const STaskGc*>(&arg_task))
+      {
+        w.writeEigen(t->q_); w.writeEigen(t->dq_); w.writeEigen(t->ddq_);
+        w.writeEigen(t->q_goal_); w.writeEigen(t->dq_goal_); w.writeEigen(t->ddq_goal_);
+      }
+      else if(const STaskGcSet* t = dynamic_cast<const STaskGcSet*>(&arg_task))
+      { w.writeEigen(t->q_goal_); w.writeEigen(t->dq_goal_); w.writeEigen(t->ddq_goal_); }
+      else if(const STaskGcLimitCentering* t = dynamic_cast<const STaskGcLimitCentering*>(&arg_task))
+      { w.writeEigen(t->q_); w.writeEigen(t->dq_); w.writeEigen(t->q_goal_); }
+      else if(const STaskConstraintPlane* t = dynamic_cast<const STaskConstraintPlane*>(&arg_task))
+      {
+        w.writeEigen(t->x_); w.writeEigen(t->dx_);
+        w.writeBool(t->is_active_);
+      }
+    }
+
+    bool readTaskState(CBinaryReader& r, STaskBase& arg_task)
+    {
+      if(STaskOpPos* t = dynamic_cast<STaskOpPos*>(&arg_task))
+      {
+        r.readEigen(t->x_); r.readEigen(t->dx_); r.readEigen(t->ddx_);
+        r.readEigen(t->x_goal_); r.readEigen(t->dx_goal_); r.readEigen(t->ddx_goal_);
+        r.readEigen(t->pos_in_parent_);
+      }
+      else if(STaskOpPosPIDA1OrderInfTime* t = dynamic_cast<STaskOpPosPIDA1OrderInfTime*>(&arg_task))
+      {
+        r.readEigen(t->x_); r.readEigen(t->dx_); r.readEigen(t->ddx_);
+        r.readEigen(t->x_goal_); r.readEigen(t->dx_goal_); r.readEigen(t->ddx_goal_);
+        r.readEigen(t->pos_in_parent_);
+        r.readEigen(t->integral_force_);
+        r.readDouble(t->integral_gain_time_pre_);
+        r.readDouble(t->integral_gain_time_curr_);
+      }
+      else if(STaskComPos* t = dynamic_cast<STaskComPos*>(&arg_task))
+      {
+        r.readEigen(t->x_); r.readEigen(t->dx_); r.readEigen(t->ddx_);
+        r.readEigen(t->x_goal_); r.readEigen(t->dx_goal_); r.readEigen(t->ddx_goal_);
+      }
+      else if(STaskGc* t = dynamic_cast<STaskGc*>(&arg_task))
+      {
+        r.readEigen(t->q_); r.readEigen(t->dq_); r.readEigen(t->ddq_);
+        r.readEigen(t->q_goal_); r.readEigen(t->dq_goal_); r.readEigen(t->ddq_goal_);
+      }
+      else if(STaskGcSet* t = dynamic_cast<STaskGcSet*>(&arg_task))
+      { r.readEigen(t->q_goal_); r.readEigen(t->dq_goal_); r.readEigen(t->ddq_goal_); }
+      else if(STaskGcLimitCentering* t = dynamic_cast<STaskGcLimitCentering*>(&arg_task))
+      { r.readEigen(t->q_); r.readEigen(t->dq_); r.readEigen(t->q_goal_); }
+      else if(STaskConstraintPlane* t = dynamic_cast<STaskConstraintPlane*>(&arg_task))
+      {
+        r.readEigen(t->x_); r.readEigen(t->dx_);
+        r.readBool(t->is_active_);
+      }
+      return r.ok();
+    }
+  }
+
+  void serializeStateToBinary(const SRobotIO &arg_obj, CBinaryWriter &ret_w)
+  {
+    const SRobotSensors& s = arg_obj.sensors_;
+    ret_w.writeEigen(s.q_);
+    ret_w.writeEigen(s.dq_);
+    ret_w.writeEigen(s.ddq_);
+    ret_w.writeEigen(s.force_gc_measured_);
+    ret_w.writeU32(static_cast<std::uint32_t>(s.forces_external_.size()));
+    for(auto it = s.forces_external_.begin(), ite = s.forces_external_.end(); it!=ite; ++it)
+    {
+      ret_w.writeEigen(it->force_);
+      ret_w.writeEigen(it->pos_);
+      ret_w.writeEigen(it->direction_);
+      ret_w.writeEigen(it->J_);
+    }
+    ret_w.writeEigen(arg_obj.actuators_.force_gc_commanded_);
+  }
+
+  bool deserializeStateFromBinary(SRobotIO &ret_obj, CBinaryReader &arg_r)
+  {
+    SRobotSensors& s = ret_obj.sensors_;
+    arg_r.readEigen(s.q_);
+    arg_r.readEigen(s.dq_);
+    arg_r.readEigen(s.ddq_);
+    arg_r.readEigen(s.force_gc_measured_);
+    std::uint32_t n=0;
+    if(!arg_r.readU32(n) || n != s.forces_external_.size()) { return false; }
+    for(auto it = s.forces_external_.begin(), ite = s.forces_external_.end(); it!=ite; ++it)
+    {
+      arg_r.readEigen(it->force_);
+      arg_r.readEigen(it->pos_);
+      arg_r.readEigen(it->direction_);
+      arg_r.readEigen(it->J_);
+    }
+    arg_r.readEigen(ret_obj.actuators_.force_gc_commanded_);
+    return arg_r.ok();
+  }
+
+  void serializeStateToBinary(const SGcModel &arg_obj, CBinaryWriter &ret_w)
+  {
+    ret_w.writeEigen(arg_obj.M_gc_);
+    ret_w.writeEigen(arg_obj.M_gc_inv_);
+    ret_w.writeEigen(arg_obj.force_gc_cc_);
+    ret_w.writeEigen(arg_obj.force_gc_grav_);
+    ret_w.writeEigen(arg_obj.q_);
+    ret_w.writeEigen(arg_obj.dq_);
+    ret_w.writeEigen(arg_obj.pos_com_);
+    ret_w.writeDouble(arg_obj.mass_);
+    ret_w.writeBool(arg_obj.computed_spatial_transformation_and_inertia_);
+    ret_w.writeU32(static_cast<std::uint32_t>(arg_obj.rbdyn_tree_.size()));
+    for(auto it = arg_obj.rbdyn_tree_.begin(), ite = arg_obj.rbdyn_tree_.end(); it!=ite; ++it)
+    { writeState(ret_w,*it); }
+  }
+
+  bool deserializeStateFromBinary(SGcModel &ret_obj, CBinaryReader &arg_r)
+  {
+    arg_r.readEigen(ret_obj.M_gc_);
+    arg_r.readEigen(ret_obj.M_gc_inv_);
+    arg_r.readEigen(ret_obj.force_gc_cc_);
+    arg_r.readEigen(ret_obj.force_gc_grav_);
+    arg_r.readEigen(ret_obj.q_);
+    arg_r.readEigen(ret_obj.dq_);
+    arg_r.readEigen(ret_obj.pos_com_);
+    arg_r.readDouble(ret_obj.mass_);
+    arg_r.readBool(ret_obj.computed_spatial_transformation_and_inertia_);
+    std::uint32_t n=0;
+    if(!arg_r.readU32(n) || n != ret_obj.rbdyn_tree_.size()) { return false; }
+    for(auto it = ret_obj.rbdyn_tree_.begin(), ite = ret_obj.rbdyn_tree_.end(); it!=ite; ++it)
+    { if(!readState(arg_r,*it)) { return false; } }
+    return arg_r.ok();
+  }
+
+  void serializeStateToBinary(const STaskBase &arg_obj, CBinaryWriter &ret_w)
+  {
+    ret_w.writeBool(arg_obj.has_been_activated_);
+    ret_w.writeBool(arg_obj.is_engaged_);
+    ret_w.writeEigen(arg_obj.J_);
+    ret_w.writeEigen(arg_obj.J_6_);
+    ret_w.writeEigen(arg_obj.J_dyn_inv_);
+    ret_w.writeEigen(arg_obj.null_space_);
+    ret_w.writeEigen(arg_obj.M_task_);
+    ret_w.writeEigen(arg_obj.M_task_inv_);
+    ret_w.writeEigen(arg_obj.force_task_cc_);
+    ret_w.writeEigen(arg_obj.force_task_grav_);
+    ret_w.writeEigen(arg_obj.force_task_);
+    ret_w.writeEigen(arg_obj.force_task_max_);
+    ret_w.writeEigen(arg_obj.force_task_min_);
+    ret_w.writeEigen(arg_obj.force_gc_);
+    ret_w.writeEigen(arg_obj.range_space_);
+    ret_w.writeEigen(arg_obj.kp_);
+    ret_w.writeEigen(arg_obj.kv_);
+    ret_w.writeEigen(arg_obj.ka_);
+    ret_w.writeEigen(arg_obj.ki_);
+    ret_w.writeEigen(arg_obj.shared_data_);
+    writeTaskState(ret_w, arg_obj);
+  }
+
+  bool deserializeStateFromBinary(STaskBase &ret_obj, CBinaryReader &arg_r)
+  {
+    arg_r.readBool(ret_obj.has_been_activated_);
+    arg_r.readBool(ret_obj.is_engaged_);
+    arg_r.readEigen(ret_obj.J_);
+    arg_r.readEigen(ret_obj.J_6_);
+    arg_r.readEigen(ret_obj.J_dyn_inv_);
+    arg_r.readEigen(ret_obj.null_space_);
+    arg_r.readEigen(ret_obj.M_task_);
+    arg_r.readEigen(ret_obj.M_task_inv_);
+    arg_r.readEigen(ret_obj.force_task_cc_);
+    arg_r.readEigen(ret_obj.force_task_grav_);
+    arg_r.readEigen(ret_obj.force_task_);
+    arg_r.readEigen(ret_obj.force_task_max_);
+    arg_r.readEigen(ret_obj.force_task_min_);
+    arg_r.readEigen(ret_obj.force_gc_);
+    arg_r.readEigen(ret_obj.range_space_);
+    arg_r.readEigen(ret_obj.kp_);
+    arg_r.readEigen(ret_obj.kv_);
+    arg_r.readEigen(ret_obj.ka_);
+    arg_r.readEigen(ret_obj.ki_);
+    arg_r.readEigen(ret_obj.shared_data_);
+    return readTaskState(arg_r, ret_obj);
+  }
+
+  void serializeStateToBinary(const SControllerBase &arg_obj, CBinaryWriter &ret_w)
+  {
+    ret_w.writeBool(S_NULL != arg_obj.gc_model_);
+    if(S_NULL != arg_obj.gc_model_) { serializeStateToBinary(*arg_obj.gc_model_, ret_w); }
+
+    if(const SControllerMultiTask* c = dynamic_cast<const SControllerMultiTask*>(&arg_obj))
+    {
+      ret_w.writeEigen(c->servo_.force_gc_);
+      ret_w.writeU32(static_cast<std::uint32_t>(c->tasks_.size()));
+      for(auto it = c->tasks_.begin(), ite = c->tasks_.end(); it!=ite; ++it)
+      { serializeStateToBinary(**it, ret_w); }
+    }
+    else if(const SControllerGc* c = dynamic_cast<const SControllerGc*>(&arg_obj))
+    {
+      ret_w.writeEigen(c->des_force_gc_);
+      ret_w.writeEigen(c->des_q_);
+      ret_w.writeEigen(c->des_dq_);
+      ret_w.writeEigen(c->des_ddq_);
+      ret_w.writeEigen(c->kp_);
+      ret_w.writeEigen(c->kv_);
+      ret_w.writeEigen(c->ka_);
+      ret_w.writeEigen(c->ki_);
+      ret_w.writeDouble(c->integral_gain_time_pre_);
+      ret_w.writeDouble(c->integral_gain_time_curr_);
+      ret_w.writeEigen(c->integral_force_);
+    }
+  }
+
+  bool deserializeStateFromBinary(SControllerBase &ret_obj, CBinaryReader &arg_r)
+  {
+    bool has_model=false;
+    if(!arg_r.readBool(has_model) || has_model != (S_NULL != ret_obj.gc_model_)) { return false; }
+    if(has_model && !deserializeStateFromBinary(*ret_obj.gc_model_, arg_r)) { return false; }
+
+    if(SControllerMultiTask* c = dynamic_cast<SControllerMultiTask*>(&ret_obj))
+    {
+      arg_r.readEigen(c->servo_.force_gc_);
+      std::uint32_t n=0;
+      if(!arg_r.readU32(n) || n != c->tasks_.size()) { return false; }
+      for(auto it = c->tasks_.begin(), ite = c->tasks_.end(); it!=ite; ++it)
+      { if(!deserializeStateFromBinary(**it, arg_r)) { return false; } }
+    }
+    else if(SControllerGc* c = dynamic_cast<SControllerGc*>(&ret_obj))
+    {
+      arg_r.readEigen(c->des_force_gc_);
+      arg_r.readEigen(c->des_q_);
+      arg_r.readEigen(c->des_dq_);
+      arg_r.readEigen(c->des_ddq_);
+      arg_r.readEigen(c->kp_);
+      arg_r.readEigen(c->kv_);
+      arg_r.readEigen(c->ka_);
+      arg_r.readEigen(c->ki_);
+      arg_r.readDouble(c->integral_gain_time_pre_);
+      arg_r.readDouble(c->integral_gain_time_curr_);
+      arg_r.readEigen(c->integral_force_);
+    }
+    return arg_r.ok();
+  }
+
+  std::uint64_t hashFNV1a(const char* arg_buf, const std::size_t arg_len,
+      std::uint64_t arg_hash)
+  {
+    for(std::size_t i=0; i<arg_len; ++i)
+    {
+      arg_hash ^= static_cast<unsigned char>(arg_buf[i]);
+      arg_hash *= 1099511628211ULL;
+    }
+    return arg_hash;
+  }
+}
@@ -0,0 +1,211 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file SerializationBinary.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef SERIALIZATIONBINARY_HPP_
+#define SERIALIZATIONBINARY_HPP_
+
+#include <scl/DataTypes.hpp>
+#include <scl/data_structs/SRobotParsed.hpp>
+#include <scl/data_structs/SRigidBody.hpp>
+#include <scl/data_structs/SActuatorSetMuscleParsed.hpp>
+
+#include <Eigen/Core>
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+namespace scl
+{
+  // Forward declarations for the run-time state functions
+  class SRobotIO;
+  class SGcModel;
+  class STaskBase;
+  class SControllerBase;
+
+  /** Version of the binary format. Bump it whenever the layout of a
+   * serialized data structure (or what the parser fills into it) changes.
+   * Readers reject other versions, so old model caches are re-parsed. */
+  const std::uint32_t SCL_BINARY_FORMAT_VERSION = 1;
+
+  /** *****************************************************************************
+   *                          Binary streams
+   * **************************************************************************** */
+  /** Appends little-endian binary data to a string buffer.
+   *
+   * All integers are written with a fixed width (sUInt etc. vary across
+   * platforms). Strings and Eigen objects are length-prefixed. */
+  class CBinaryWriter
+  {
+  public:
+    explicit CBinaryWriter(std::string& arg_buf) : buf_(arg_buf) {}
+
+    void writeU32(const std::uint32_t arg) { writeRaw(&arg, sizeof(arg)); }
+    void writeU64(const std::uint64_t arg) { writeRaw(&arg, sizeof(arg)); }
+    void writeI32(const std::int32_t arg)  { writeRaw(&arg, sizeof(arg)); }
+    void writeDouble(const double arg)     { writeRaw(&arg, sizeof(arg)); }
+    void writeBool(const bool arg)         { char c = arg ? 1 : 0; writeRaw(&c, 1); }
+
+    void writeString(const std::string& arg)
+    { writeU32(static_cast<std::uint32_t>(arg.size())); writeRaw(arg.data(), arg.size()); }
+
+    /** Writes rows, cols and the (column major) coefficients */
+    template <typename Derived>
+    void writeEigen(const Eigen::DenseBase<Derived>& arg)
+    {
+      writeU32(static_cast<std::uint32_t>(arg.rows()));
+      writeU32(static_cast<std::uint32_t>(arg.cols()));
+      for(Eigen::Index j=0; j<arg.cols(); ++j)
+        for(Eigen::Index i=0; i<arg.rows(); ++i)
+        { writeDouble(static_cast<double>(arg(i,j))); }
+    }
+
+    void writeRaw(const void* arg_data, const std::size_t arg_len)
+    { buf_.append(static_cast<const char*>(arg_data), arg_len); }
+
+    std::size_t size() const { return buf_.size(); }
+
+  private:
+    std::string& buf_;
+  };
+
+  /** Reads data written by a CBinaryWriter from a (possibly mmap'd)
+   * buffer. Never reads past the end of the buffer: all the read
+   * functions return false once the data runs out (and stay false). */
+  class CBinaryReader
+  {
+  public:
+    CBinaryReader(const char* arg_buf, const std::size_t arg_len) :
+      buf_(arg_buf), len_(arg_len), pos_(0), ok_(true) {}
+
+    bool readU32(std::uint32_t& ret)  { return readRaw(&ret, sizeof(ret)); }
+    bool readU64(std::uint64_t& ret)  { return readRaw(&ret, sizeof(ret)); }
+    bool readI32(std::int32_t& ret)   { return readRaw(&ret, sizeof(ret)); }
+    bool readDouble(double& ret)      { return readRaw(&ret, sizeof(ret)); }
+    bool readBool(bool& ret)
+    { char c=0; if(!readRaw(&c, 1)) { return false; } ret = (0 != c); return true; }
+
+    bool readString(std::string& ret)
+    {
+      std::uint32_t n;
+      if(!readU32(n) || !canRead(n)) { return ok_ = false; }
+      ret.assign(buf_+pos_, n); pos_ += n;
+      return true;
+    }
+
+    /** Reads into a dynamic or fixed size Eigen object. Fixed size objects
+     * fail if the stored size doesn't match. */
+    template <typename Derived>
+    bool readEigen(Eigen::PlainObjectBase<Derived>& ret)
+    {
+      std::uint32_t r, c;
+      if(!readU32(r) || !readU32(c)) { return false; }
+      if(!canRead(static_cast<std::size_t>(r)*c*sizeof(double))) { return ok_ = false; }
+      if( (Derived::RowsAtCompileTime != Eigen::Dynamic && Derived::RowsAtCompileTime != static_cast<int>(r)) ||
+          (Derived::ColsAtCompileTime != Eigen::Dynamic && Derived::ColsAtCompileTime != static_cast<int>(c)) )
+      { return ok_ = false; }
+      ret.resize(r,c);
+      double d;
+      for(Eigen::Index j=0; j<static_cast<Eigen::Index>(c); ++j)
+        for(Eigen::Index i=0; i<static_cast<Eigen::Index>(r); ++i)
+        { readDouble(d); ret(i,j) = d; }
+      return true;
+    }
+
+    bool readRaw(void* ret_data, const std::size_t arg_len)
+    {
+      if(!canRead(arg_len)) { return ok_ = false; }
+      std::memcpy(ret_data, buf_+pos_, arg_len); pos_ += arg_len;
+      return true;
+    }
+
+    bool canRead(const std::size_t arg_len) const
+    { return ok_ && arg_len <= len_ - pos_; }
+
+    /** The unread part of the buffer */
+    const char* current() const { return buf_+pos_; }
+    std::size_t remaining() const { return len_ - pos_; }
+
+    /** False if any read failed */
+    bool ok() const { return ok_; }
+
+  private:
+    const char* buf_;
+    std::size_t len_, pos_;
+    bool ok_;
+  };
+
+  /** *****************************************************************************
+   *                          Parsed robot data
+   * **************************************************************************** */
+  /** Appends a parsed robot (links, graphics, muscles and options) to
+   * the buffer. Tree pointers are not stored; they are rebuilt when the
+   * robot is deserialized. */
+  bool serializeToBinary(const SRobotParsed &arg_obj, std::string &ret_buf);
+
+  /** Reads a parsed robot from a buffer written by serializeToBinary().
+   *
+   * The robot should be empty (freshly constructed or reset). Once the
+   * data is read, the tree is linked and sorted with SRobotParsed::init(),
+   * which is the only pointer fixup needed. */
+  bool deserializeFromBinary(SRobotParsed &ret_obj, const char* arg_buf, const std::size_t arg_len);
+
+  /** *****************************************************************************
+   *                          Run-time state
+   * **************************************************************************** */
+  /** Appends the state that changes while a robot runs : sensor readings,
+   * commanded forces, the cached model, task goals and integral terms etc.
+   *
+   * Names, pointers and constants aren't stored. The state must be read
+   * back into the same (initialized) objects, or copies with the same
+   * links, tasks and sizes (see CRobot::saveState(), which checks this).
+   * Reading into objects of the same size doesn't allocate.
+   *
+   * Tasks are dispatched on their data type. Task types these functions
+   * don't know only get their STaskBase state saved. */
+  void serializeStateToBinary(const SRobotIO &arg_obj, CBinaryWriter &ret_w);
+  void serializeStateToBinary(const SGcModel &arg_obj, CBinaryWriter &ret_w);
+  void serializeStateToBinary(const STaskBase &arg_obj, CBinaryWriter &ret_w);
+  void serializeStateToBinary(const SControllerBase &arg_obj, CBinaryWriter &ret_w);
+
+  /** Reads the state written by serializeStateToBinary(). Returns false
+   * if the data runs out or doesn't match the object's sizes. */
+  bool deserializeStateFromBinary(SRobotIO &ret_obj, CBinaryReader &arg_r);
+  bool deserializeStateFromBinary(SGcModel &ret_obj, CBinaryReader &arg_r);
+  bool deserializeStateFromBinary(STaskBase &ret_obj, CBinaryReader &arg_r);
+  bool deserializeStateFromBinary(SControllerBase &ret_obj, CBinaryReader &arg_r);
+
+  /** A 64 bit FNV-1a hash. Pass the previous hash to chain buffers. */
+  std::uint64_t hashFNV1a(const char* arg_buf, const std::size_t arg_len,
+      std::uint64_t arg_hash = 14695981039346656037ULL);
+}
+
+#endif /* SERIALIZATIONBINARY_HPP_ */
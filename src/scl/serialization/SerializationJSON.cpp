@@ -486,6 +486,15 @@ namespace scl
     MACRO_SER_ARGOBJ_RETJSONVAL(flag_pause_at_start_)
     MACRO_SER_ARGOBJ_RETJSONVAL(flag_pause_at_start_)
     MACRO_SER_ARGOBJ_RETJSONVAL(flag_is_redis_master_)
+    MACRO_SER_ARGOBJ_RETJSONVAL(loop_rate_hz_)
+    MACRO_SER_ARGOBJ_RETJSONVAL(loop_rt_priority_)
+    MACRO_SER_ARGOBJ_RETJSONVAL(loop_cpu_)
+    MACRO_SER_ARGOBJ_RETJSONVAL(flag_loop_mlock_)
+    MACRO_SER_ARGOBJ_RETJSONVAL(flag_io_shm_)
+    MACRO_SER_ARGOBJ_RETJSONVAL(name_io_shm_)
+    MACRO_SER_ARGOBJ_RETJSONVAL(flag_io_redis_sub_)
+    MACRO_SER_ARGOBJ_RETJSONVAL(flag_predict_)
+    MACRO_SER_ARGOBJ_RETJSONVAL(predict_lookahead_)
 
     // Std vector of strings (iterable)
     ret_json_val["name_tasks_"] = Json::Value(Json::arrayValue);
@@ -507,6 +516,7 @@ namespace scl
 
     MACRO_SER_ARGOBJ_RETJSONVAL(type_task_)
     MACRO_SER_ARGOBJ_RETJSONVAL(has_been_activated_)
+    MACRO_SER_ARGOBJ_RETJSONVAL(is_engaged_)
     MACRO_SER_ARGOBJ_RETJSONVAL(has_control_null_space_)
     MACRO_SER_ARGOBJ_RETJSONVAL(priority_)
     MACRO_SER_ARGOBJ_RETJSONVAL(dof_task_)
@@ -0,0 +1,337 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file SerializationJSONStream.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include <scl/serialization/SerializationJSONStream.hpp>
+#include <scl/control/task/data_structs/SControllerMultiTask.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace scl
+{
+  /** *****************************************************************************
+   *                          The writer
+   * **************************************************************************** */
+  void CJSONStreamWriter::value(const long long arg)
+  {
+    separate();
+    char tmp[32];
+    int n = std::snprintf(tmp, sizeof(tmp), "%lld", arg);
+    buf_.append(tmp, n);
+  }
+
+  void CJSONStreamWriter::value(const unsigned long long arg)
+  {
+    separate();
+    char tmp[32];
+    int n = std::snprintf(tmp, sizeof(tmp), "%llu", arg);
+    buf_.append(tmp, n);
+  }
+
+  void CJSONStreamWriter::value(const double arg)
+  {
+    separate();
+    char tmp[32];
+    int n = formatDouble(arg, tmp);
+    buf_.append(tmp, n);
+  }
+
+  int CJSONStreamWriter::formatDouble(const double arg, char* arg_buf)
+  {
+    if(!std::isfinite(arg))
+    { std::memcpy(arg_buf, "null", 5); return 4; }
+
+    // Zeros are common (velocities at rest, unused forces)
+    if(0 == arg) { arg_buf[0] = '0'; arg_buf[1] = '\0'; return 1; }
+
+    // 17 digits always read back to the same double. %g drops trailing
+    // zeros, so short values (0.25, 1e-3) still come out short.
+    return std::snprintf(arg_buf, 32, "%.17g", arg);
+  }
+
+  void CJSONStreamWriter::writeEscaped(const char* arg_str, std::size_t arg_len)
+  {
+    if(std::string::npos == arg_len) { arg_len = std::strlen(arg_str); }
+
+    static const char hex[] = "0123456789abcdef";
+    buf_.push_back('"');
+    for(std::size_t i=0; i<arg_len; ++i)
+    {
+      const unsigned char c = static_cast<unsigned char>(arg_str[i]);
+      switch(c)
+      {
+        case '"':  buf_.append("\\\""); break;
+        case '\\': buf_.append("\\\\"); break;
+        case '\b': buf_.append("\\b"); break;
+        case '\f': buf_.append("\\f"); break;
+        case '\n': buf_.append("\\n"); break;
+        case '\r': buf_.append("\\r"); break;
+        case '\t': buf_.append("\\t"); break;
+        default:
+          if(c < 0x20)
+          {
+            buf_.append("\\u00");
+            buf_.push_back(hex[c>>4]);
+            buf_.push_back(hex[c&0xf]);
+          }
+          else { buf_.push_back(static_cast<char>(c)); }
+      }
+    }
+    buf_.push_back('"');
+  }
+
+  /** *****************************************************************************
+   *                          Stream the data structures
+   * **************************************************************************** */
+  // Writes a member (skipped in delta mode if it didn't change)
+#define MACRO_STREAM_ARGOBJ_RETWRITER(AAA) \
+    ret_writer.member(#AAA, arg_obj.AAA, (S_NULL == arg_prev) ? S_NULL : &(arg_prev->AAA));
+
+  // Writes a member object (dropped in delta mode if nothing in it changed)
+#define MACRO_STREAM_ARGOBJ_RETWRITER_MemberObj(AAA) \
+    if(!streamMemberObj(#AAA, arg_obj.AAA, (S_NULL == arg_prev) ? S_NULL : &(arg_prev->AAA), ret_writer)) { \
+      std::cout<<"\n serializeToJSONStream() Error : Could not serialize : "<<#AAA<<std::flush; \
+      return false; \
+    }
+
+  namespace
+  {
+    // The member-only writers. The public functions wrap them in {}.
+    bool streamFields(const sutil::CMappedList<std::string, SForce> &arg_obj,
+        CJSONStreamWriter &ret_writer, const sutil::CMappedList<std::string, SForce>* arg_prev);
+    bool streamFields(const SRobotSensors &arg_obj, CJSONStreamWriter &ret_writer, const SRobotSensors* arg_prev);
+
+    bool streamFields(const SObject &arg_obj, CJSONStreamWriter &ret_writer, const SObject* arg_prev)
+    {
+      MACRO_STREAM_ARGOBJ_RETWRITER(has_been_init_)
+      // Always send the name so the receiver knows what a delta is for.
+      ret_writer.member("name_", arg_obj.name_);
+      ret_writer.member("type_", arg_obj.getType(),
+          (S_NULL == arg_prev) ? S_NULL : &(arg_prev->getType()));
+      return true;
+    }
+
+    bool streamFields(const SForce &arg_obj, CJSONStreamWriter &ret_writer, const SForce* arg_prev)
+    {
+      streamFields(static_cast<const SObject&>(arg_obj), ret_writer, arg_prev);
+
+      if(S_NULL == arg_obj.robot_) { return false; }
+      if(S_NULL == arg_prev || S_NULL == arg_prev->robot_ || arg_obj.robot_ != arg_prev->robot_)
+      { ret_writer.member("robot_name_", arg_obj.robot_->name_); }
+      MACRO_STREAM_ARGOBJ_RETWRITER(link_name_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(force_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(pos_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(direction_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(J_)
+      return true;
+    }
+
+    bool streamFields(const SRobotActuators &arg_obj, CJSONStreamWriter &ret_writer, const SRobotActuators* arg_prev)
+    {
+      MACRO_STREAM_ARGOBJ_RETWRITER(force_gc_commanded_)
+      return true;
+    }
+
+    template <typename T>
+    bool streamMemberObj(const char* arg_key, const T& arg_obj, const T* arg_prev,
+        CJSONStreamWriter &ret_writer)
+    {
+      CJSONStreamWriter::SMark mark = ret_writer.mark();
+      ret_writer.key(arg_key);
+      ret_writer.beginObject();
+      if(false == streamFields(arg_obj, ret_writer, arg_prev)) { return false; }
+      if(false == ret_writer.endObject() && S_NULL != arg_prev)
+      { ret_writer.rewind(mark); }
+      return true;
+    }
+
+    /** Forces are keyed by name (like the mapped list's json). If forces were
+     * added or removed since the last message, the whole list is sent (and
+     * replaces the receiver's list, which "__replace" marks in delta mode). */
+    bool streamFields(const sutil::CMappedList<std::string, SForce> &arg_obj,
+        CJSONStreamWriter &ret_writer, const sutil::CMappedList<std::string, SForce>* arg_prev)
+    {
+      if(S_NULL != arg_prev)
+      {
+        bool same_keys = (arg_prev->size() == arg_obj.size());
+        for(auto it = arg_obj.begin(); same_keys && it != arg_obj.end(); ++it)
+        { if(S_NULL == arg_prev->at_const(!it)) { same_keys = false; } }
+
+        if(!same_keys)
+        { ret_writer.member("__replace", true); arg_prev = S_NULL; }
+      }
+
+      for(auto it = arg_obj.begin(); it != arg_obj.end(); ++it)
+      {
+        const std::string& index = !it;
+        const SForce* prev = (S_NULL == arg_prev) ? S_NULL : arg_prev->at_const(index);
+        if(false == streamMemberObj(index.c_str(), *it, prev, ret_writer))
+        { return false; }
+      }
+      return true;
+    }
+
+    bool streamFields(const SRobotSensors &arg_obj, CJSONStreamWriter &ret_writer, const SRobotSensors* arg_prev)
+    {
+      MACRO_STREAM_ARGOBJ_RETWRITER(q_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(dq_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(ddq_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(force_gc_measured_)
+      MACRO_STREAM_ARGOBJ_RETWRITER_MemberObj(forces_external_)
+      return true;
+    }
+
+    bool streamFields(const SRobotIO &arg_obj, CJSONStreamWriter &ret_writer, const SRobotIO* arg_prev)
+    {
+      streamFields(static_cast<const SObject&>(arg_obj), ret_writer, arg_prev);
+      MACRO_STREAM_ARGOBJ_RETWRITER(name_robot_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(dof_)
+      MACRO_STREAM_ARGOBJ_RETWRITER_MemberObj(sensors_)
+      MACRO_STREAM_ARGOBJ_RETWRITER_MemberObj(actuators_)
+      return true;
+    }
+
+    bool isEqual(const std::vector<sString2>& a, const std::vector<sString2>& b)
+    {
+      if(a.size() != b.size()) { return false; }
+      for(std::size_t i=0; i<a.size(); ++i)
+      {
+        if(a[i].data_[0] != b[i].data_[0] || a[i].data_[1] != b[i].data_[1])
+        { return false; }
+      }
+      return true;
+    }
+
+    /** NOTE : Unlike the DOM serializer, this doesn't write the pointer
+     * addresses (they mean nothing to a remote receiver). */
+    bool streamFields(const STaskBase &arg_obj, CJSONStreamWriter &ret_writer, const STaskBase* arg_prev)
+    {
+      streamFields(static_cast<const SObject&>(arg_obj), ret_writer, arg_prev);
+
+      MACRO_STREAM_ARGOBJ_RETWRITER(type_task_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(has_been_activated_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(is_engaged_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(has_control_null_space_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(priority_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(dof_task_)
+
+      MACRO_STREAM_ARGOBJ_RETWRITER(J_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(J_6_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(J_dyn_inv_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(null_space_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(M_task_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(M_task_inv_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(force_task_cc_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(force_task_grav_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(force_task_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(force_task_max_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(force_task_min_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(force_gc_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(range_space_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(kp_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(kv_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(ka_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(ki_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(shared_data_)
+
+      if(S_NULL == arg_prev || !isEqual(arg_obj.task_nonstd_params_, arg_prev->task_nonstd_params_))
+      {
+        ret_writer.key("task_nonstd_params_");
+        ret_writer.beginArray();
+        for (auto&& element: arg_obj.task_nonstd_params_) {
+          // Same format as the DOM : "name : value"
+          ret_writer.value(element.data_[0]+std::string(" : ") +element.data_[1]);
+        }
+        ret_writer.endArray();
+      }
+      return true;
+    }
+
+    bool streamFields(const STaskOpPos &arg_obj, CJSONStreamWriter &ret_writer, const STaskOpPos* arg_prev)
+    {
+      if(false == streamFields(static_cast<const STaskBase&>(arg_obj), ret_writer, arg_prev))
+      { return false; }
+
+      if(S_NULL != arg_obj.parent_controller_ &&
+          (S_NULL == arg_prev || arg_obj.parent_controller_ != arg_prev->parent_controller_))
+      { ret_writer.member("parent_controller_", arg_obj.parent_controller_->name_); }
+      MACRO_STREAM_ARGOBJ_RETWRITER(link_name_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(spatial_resolution_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(flag_compute_op_gravity_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(flag_compute_op_cc_forces_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(flag_compute_op_inertia_)
+
+      MACRO_STREAM_ARGOBJ_RETWRITER(x_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(dx_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(ddx_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(x_goal_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(dx_goal_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(ddx_goal_)
+      MACRO_STREAM_ARGOBJ_RETWRITER(pos_in_parent_)
+      return true;
+    }
+
+    template <typename T>
+    bool streamObject(const T &arg_obj, CJSONStreamWriter &ret_writer, const T* arg_prev)
+    {
+      ret_writer.beginObject();
+      bool flag = streamFields(arg_obj, ret_writer, arg_prev);
+      ret_writer.endObject();
+      return flag && ret_writer.isComplete();
+    }
+  }
+
+  bool serializeToJSONStream(const SForce &arg_obj, CJSONStreamWriter &ret_writer,
+      const SForce* arg_prev)
+  { return streamObject(arg_obj, ret_writer, arg_prev); }
+
+  bool serializeToJSONStream(const SRobotSensors &arg_obj, CJSONStreamWriter &ret_writer,
+      const SRobotSensors* arg_prev)
+  { return streamObject(arg_obj, ret_writer, arg_prev); }
+
+  bool serializeToJSONStream(const SRobotActuators &arg_obj, CJSONStreamWriter &ret_writer,
+      const SRobotActuators* arg_prev)
+  { return streamObject(arg_obj, ret_writer, arg_prev); }
+
+  bool serializeToJSONStream(const SRobotIO &arg_obj, CJSONStreamWriter &ret_writer,
+      const SRobotIO* arg_prev)
+  { return streamObject(arg_obj, ret_writer, arg_prev); }
+
+  bool serializeToJSONStream(const STaskBase &arg_obj, CJSONStreamWriter &ret_writer,
+      const STaskBase* arg_prev)
+  { return streamObject(arg_obj, ret_writer, arg_prev); }
+
+  bool serializeToJSONStream(const STaskOpPos &arg_obj, CJSONStreamWriter &ret_writer,
+      const STaskOpPos* arg_prev)
+  { return streamObject(arg_obj, ret_writer, arg_prev); }
+}
@@ -33,7 +33,9 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #ifndef SRC_SCL_TRAJECTORY_ALLHEADERS_HPP_
 #define SRC_SCL_TRAJECTORY_ALLHEADERS_HPP_
 
-// NOTE TODO : This is under construction
-// #include <scl/trajectory/CTrajectoryGenerator.hpp>
+#include <scl/trajectory/CTrajectoryFile.hpp>
+#include <scl/trajectory/CTrajectorySpline.hpp>
+#include <scl/trajectory/CTrajectoryGenerator.hpp>
+#include <scl/trajectory/CTrajectoryOtg.hpp>
 
 #endif /* SRC_SCL_TRAJECTORY_ALLHEADERS_HPP_ */
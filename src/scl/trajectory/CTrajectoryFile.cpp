@@ -0,0 +1,278 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CTrajectoryFile.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include <scl/trajectory/CTrajectoryFile.hpp>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace scl
+{
+  namespace
+  {
+    struct STrajHeader
+    {
+      char magic_[8];
+      std::uint32_t header_bytes_, dof_, flags_, reserved_;
+      std::uint64_t n_points_;
+    };
+  }
+
+  CTrajectoryFile::CTrajectoryFile() :
+      data_(S_NULL), dof_(0), has_vel_(false), n_points_(0), stride_(0),
+      map_(S_NULL), map_size_(0)
+  {}
+
+  CTrajectoryFile::~CTrajectoryFile()
+  { close(); }
+
+  void CTrajectoryFile::close()
+  {
+    if(S_NULL != map_) { munmap(map_, map_size_); }
+    map_ = S_NULL; map_size_ = 0;
+    std::vector<double>().swap(mem_);
+    data_ = S_NULL; dof_ = 0; has_vel_ = false; n_points_ = 0; stride_ = 0;
+  }
+
+  sBool CTrajectoryFile::open(const std::string& arg_file)
+  {
+    int fd = -1;
+    try
+    {
+      close();
+
+      fd = ::open(arg_file.c_str(), O_RDONLY);
+      if(0 > fd) { throw(std::runtime_error("Could not open file")); }
+      struct stat st;
+      if(0 != fstat(fd, &st)) { throw(std::runtime_error("Could not stat file")); }
+      if(static_cast<std::size_t>(st.st_size) < SCL_TRAJ_HEADER_BYTES)
+      { throw(std::runtime_error("File too small for a trajectory header")); }
+
+      map_size_ = static_cast<std::size_t>(st.st_size);
+      map_ = mmap(S_NULL, map_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd); fd = -1;
+      if(MAP_FAILED == map_) { map_ = S_NULL; throw(std::runtime_error("Could not mmap file")); }
+
+      STrajHeader h;
+      std::memcpy(&h, map_, sizeof(h));
+      if(0 != std::memcmp(h.magic_, SCL_TRAJ_MAGIC, 8))
+      { throw(std::runtime_error("Not a trajectory file (or a different version)")); }
+      if(h.header_bytes_ < sizeof(h) || 0 != h.header_bytes_ % sizeof(double) || 0 == h.dof_)
+      { throw(std::runtime_error("Corrupt trajectory header")); }
+
+      dof_ = h.dof_;
+      has_vel_ = (0 != (h.flags_ & 1));
+      stride_ = 1 + dof_ * (has_vel_ ? 2 : 1);
+      n_points_ = static_cast<sLongLong>(h.n_points_);
+      if(h.header_bytes_ + n_points_*stride_*sizeof(double) > map_size_)
+      { throw(std::runtime_error("Trajectory file is truncated")); }
+
+      data_ = reinterpret_cast<const double*>(static_cast<const char*>(map_) + h.header_bytes_);
+      if(false == checkTimes())
+      { throw(std::runtime_error("Trajectory times don't increase")); }
+
+      // Servo loops read the file sequentially.
+      madvise(map_, map_size_, MADV_SEQUENTIAL);
+    }
+    catch(std::exception& e)
+    {
+      if(0 <= fd) { ::close(fd); }
+      close();
+      std::cerr<<"\nCTrajectoryFile::open("<<arg_file<<") : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+
+  sBool CTrajectoryFile::setFromMemory(std::vector<double>& arg_points, const sUInt arg_dof,
+      const sBool arg_has_vel)
+  {
+    try
+    {
+      close();
+      if(0 == arg_dof) { throw(std::runtime_error("Zero dof trajectory")); }
+      const sLongLong stride = 1 + arg_dof * (arg_has_vel ? 2 : 1);
+      if(arg_points.empty() || 0 != arg_points.size() % stride)
+      { throw(std::runtime_error("Points don't match the dofs")); }
+
+      mem_.swap(arg_points);
+      dof_ = arg_dof;
+      has_vel_ = arg_has_vel;
+      stride_ = stride;
+      n_points_ = static_cast<sLongLong>(mem_.size()) / stride_;
+      data_ = mem_.data();
+      if(false == checkTimes())
+      { throw(std::runtime_error("Trajectory times don't increase")); }
+    }
+    catch(std::exception& e)
+    {
+      close();
+      std::cerr<<"\nCTrajectoryFile::setFromMemory() : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+
+  sBool CTrajectoryFile::checkTimes() const
+  {
+    for(sLongLong i=1; i<n_points_; ++i)
+    { if(!(getTime(i) > getTime(i-1))) { return false; } }
+    return true;
+  }
+
+  sLongLong CTrajectoryFile::findPoint(const double arg_t) const
+  {
+    sLongLong lo = 0, hi = n_points_-1;
+    if(0 >= n_points_ || arg_t <= getTime(0)) { return 0; }
+    if(arg_t >= getTime(hi)) { return hi; }
+    //Invariant : t(lo) <= arg_t < t(hi)
+    while(hi - lo > 1)
+    {
+      const sLongLong mid = lo + (hi-lo)/2;
+      if(getTime(mid) <= arg_t) { lo = mid; } else { hi = mid; }
+    }
+    return lo;
+  }
+
+  sBool CTrajectoryFile::convertTxtFile(const std::string& arg_txt_file,
+      const std::string& arg_bin_file, const sUInt arg_dof,
+      const sBool arg_has_time, const double arg_dt, const sBool arg_has_vel)
+  {
+    try
+    {
+      std::ifstream txt(arg_txt_file.c_str());
+      if(!txt.is_open()) { throw(std::runtime_error("Could not open text file")); }
+      if(!arg_has_time && 0 >= arg_dt) { throw(std::runtime_error("Need a positive dt for a trajectory without times")); }
+
+      CTrajectoryFileWriter w;
+      if(false == w.open(arg_bin_file, arg_dof, arg_has_vel))
+      { throw(std::runtime_error("Could not open binary file")); }
+
+      const sUInt n_cols = (arg_has_time ? 1 : 0) + arg_dof * (arg_has_vel ? 2 : 1);
+      std::vector<double> row(n_cols);
+      std::string line;
+      sLongLong line_no = 0;
+      while(std::getline(txt, line))
+      {
+        line_no++;
+        if(line.find_first_not_of(" \t\r") == std::string::npos) { continue; }
+
+        std::istringstream ss(line);
+        for(sUInt i=0; i<n_cols; ++i)
+        {
+          if(!(ss >> row[i]))
+          {
+            std::stringstream err;
+            err<<"Too few columns at line "<<line_no<<" (need "<<n_cols<<")";
+            throw(std::runtime_error(err.str()));
+          }
+        }
+
+        const double t = arg_has_time ? row[0] : w.getNumPoints() * arg_dt;
+        const double* pos = row.data() + (arg_has_time ? 1 : 0);
+        if(false == w.append(t, pos, arg_has_vel ? pos + arg_dof : S_NULL))
+        {
+          std::stringstream err;
+          err<<"Could not write the point at line "<<line_no;
+          throw(std::runtime_error(err.str()));
+        }
+      }
+      if(false == w.close()) { throw(std::runtime_error("Could not finish the binary file")); }
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCTrajectoryFile::convertTxtFile("<<arg_txt_file<<") : "<<e.what();
+      return false;
+    }
+    return true;
+  }
+
+  sBool CTrajectoryFileWriter::open(const std::string& arg_file, const sUInt arg_dof,
+      const sBool arg_has_vel)
+  {
+    close();
+    if(0 == arg_dof) { return false; }
+    file_ = std::fopen(arg_file.c_str(), "wb");
+    if(S_NULL == file_) { return false; }
+
+    dof_ = arg_dof; has_vel_ = arg_has_vel; n_points_ = 0;
+
+    char buf[SCL_TRAJ_HEADER_BYTES];
+    std::memset(buf, 0, sizeof(buf));
+    STrajHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic_, SCL_TRAJ_MAGIC, 8);
+    h.header_bytes_ = SCL_TRAJ_HEADER_BYTES;
+    h.dof_ = arg_dof;
+    h.flags_ = arg_has_vel ? 1 : 0;
+    std::memcpy(buf, &h, sizeof(h));
+    if(1 != std::fwrite(buf, sizeof(buf), 1, file_))
+    { std::fclose(file_); file_ = S_NULL; return false; }
+    return true;
+  }
+
+  sBool CTrajectoryFileWriter::append(const double arg_t, const double* arg_pos, const double* arg_vel)
+  {
+    if(S_NULL == file_ || S_NULL == arg_pos) { return false; }
+    if(has_vel_ && S_NULL == arg_vel) { return false; }
+    if(0 < n_points_ && !(arg_t > t_last_)) { return false; }
+
+    bool flag = (1 == std::fwrite(&arg_t, sizeof(double), 1, file_));
+    flag = flag && (dof_ == std::fwrite(arg_pos, sizeof(double), dof_, file_));
+    if(has_vel_) { flag = flag && (dof_ == std::fwrite(arg_vel, sizeof(double), dof_, file_)); }
+    if(!flag) { return false; }
+
+    t_last_ = arg_t;
+    n_points_++;
+    return true;
+  }
+
+  sBool CTrajectoryFileWriter::close()
+  {
+    if(S_NULL == file_) { return false; }
+    const std::uint64_t n = static_cast<std::uint64_t>(n_points_);
+    bool flag = (0 == std::fseek(file_, offsetof(STrajHeader, n_points_), SEEK_SET));
+    flag = flag && (1 == std::fwrite(&n, sizeof(n), 1, file_));
+    flag = (0 == std::fclose(file_)) && flag;
+    file_ = S_NULL;
+    return flag;
+  }
+}
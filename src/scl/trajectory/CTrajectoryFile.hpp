@@ -0,0 +1,155 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CTrajectoryFile.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CTRAJECTORYFILE_HPP_
+#define CTRAJECTORYFILE_HPP_
+
+#include <scl/DataTypes.hpp>
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+
+/** The trajectory file's magic string (8 chars; the last two are the version) */
+#define SCL_TRAJ_MAGIC "SCLTRJ01"
+/** The trajectory file's header size (bytes) */
+#define SCL_TRAJ_HEADER_BYTES 64
+
+namespace scl
+{
+  /** A read-only trajectory of waypoints : (time, position[, velocity])
+   * for a fixed number of dofs.
+   *
+   * Files are memory mapped, so opening an hour-long 1kHz trajectory costs
+   * no reads and no RAM up front; the OS pages in the parts the servo reaches.
+   *
+   * File format (native byte order, ie. little-endian on x86) :
+   *   Header : char magic[8] = SCL_TRAJ_MAGIC, uint32 header_bytes (64),
+   *            uint32 dof, uint32 flags (bit 0 : has velocities),
+   *            uint32 reserved, uint64 n_points, zero padding up to header_bytes.
+   *   Points : n_points x { float64 t, float64 pos[dof], [float64 vel[dof]] }
+   *            with strictly increasing t.
+   *
+   * Write files with CTrajectoryFileWriter, or convert text files (one
+   * waypoint per line) with convertTxtFile(). */
+  class CTrajectoryFile
+  {
+  public:
+    CTrajectoryFile();
+    ~CTrajectoryFile();
+
+    /** Maps a trajectory file. Checks the header and that the times increase. */
+    sBool open(const std::string& arg_file);
+
+    /** Uses waypoints in memory instead of a file (eg. generated ones). The
+     * buffer uses the file's point layout and is moved into this object. */
+    sBool setFromMemory(std::vector<double>& arg_points, const sUInt arg_dof,
+        const sBool arg_has_vel=false);
+
+    /** Unmaps the file (or frees the memory) */
+    void close();
+
+    sBool isOpen() const { return S_NULL != data_; }
+    sUInt getDof() const { return dof_; }
+    sLongLong getNumPoints() const { return n_points_; }
+    sBool hasVelocities() const { return has_vel_; }
+
+    /** Point accessors. NOTE : No bounds checks. */
+    double getTime(const sLongLong i) const { return data_[i*stride_]; }
+    const double* getPos(const sLongLong i) const { return data_ + i*stride_ + 1; }
+    /** NULL if the trajectory has no velocities */
+    const double* getVel(const sLongLong i) const
+    { return has_vel_ ? data_ + i*stride_ + 1 + dof_ : S_NULL; }
+
+    /** The last point at or before arg_t (0 if arg_t is before the start).
+     * Binary search : O(log n) */
+    sLongLong findPoint(const double arg_t) const;
+
+    /** Converts a text trajectory (one waypoint per line : [t] pos[dof]
+     * [vel[dof]]) to a binary file. Streams it, so the text file can be
+     * larger than memory. If there is no time column, waypoint i is at
+     * time i*arg_dt. */
+    static sBool convertTxtFile(const std::string& arg_txt_file,
+        const std::string& arg_bin_file, const sUInt arg_dof,
+        const sBool arg_has_time=true, const double arg_dt=0.001,
+        const sBool arg_has_vel=false);
+
+  private:
+    CTrajectoryFile(const CTrajectoryFile&);
+    CTrajectoryFile& operator = (const CTrajectoryFile&);
+
+    /** Checks the (increasing) times */
+    sBool checkTimes() const;
+
+    const double* data_;
+    sUInt dof_;
+    sBool has_vel_;
+    sLongLong n_points_;
+    sLongLong stride_;
+
+    /** The mapping (if the points are in a file) */
+    void* map_;
+    std::size_t map_size_;
+
+    /** The points (if they are in memory) */
+    std::vector<double> mem_;
+  };
+
+  /** Writes a trajectory file one point at a time (constant memory).
+   * The point count in the header is filled in by close(). */
+  class CTrajectoryFileWriter
+  {
+  public:
+    CTrajectoryFileWriter() : file_(S_NULL), dof_(0), has_vel_(false), n_points_(0), t_last_(0) {}
+    ~CTrajectoryFileWriter() { close(); }
+
+    sBool open(const std::string& arg_file, const sUInt arg_dof, const sBool arg_has_vel=false);
+
+    /** Appends a point. Times must increase. arg_vel is ignored if the file
+     * has no velocities (and required if it does). */
+    sBool append(const double arg_t, const double* arg_pos, const double* arg_vel=S_NULL);
+
+    /** Writes the point count and closes the file */
+    sBool close();
+
+    sLongLong getNumPoints() const { return n_points_; }
+
+  private:
+    std::FILE* file_;
+    sUInt dof_;
+    sBool has_vel_;
+    sLongLong n_points_;
+    double t_last_;
+  };
+}
+
+#endif /* CTRAJECTORYFILE_HPP_ */
@@ -33,12 +33,16 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #define CTRAJECTORYGENERATOR_HPP_
 
 #include <scl/DataTypes.hpp>
-#include <scl/util/FileFunctions.hpp>
+#include <scl/trajectory/CTrajectoryFile.hpp>
+#include <scl/trajectory/CTrajectorySpline.hpp>
 
 #include <sutil/CMappedList.hpp>
 
 #include <Eigen/Core>
 #include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
 
 namespace scl
 {
@@ -46,6 +50,12 @@ namespace scl
    * Reads a trajectory from file or generates
    * trajectories on the fly.
    *
+   * The waypoints live in a (memory mapped) CTrajectoryFile and are
+   * interpolated with a cursor spline, so each servo tick costs O(1)
+   * regardless of the trajectory's length. The achieved trajectory is
+   * logged into a ring buffer preallocated by initTraj(), so logging
+   * never allocates in the servo loop.
+   *
    * Use this to build trajectory controllers.*/
   template <sUInt task_dof_>
   class CTrajectoryGenerator
@@ -69,7 +79,10 @@ namespace scl
         /** The minimum velocity along the task's directions */
         const Eigen::Matrix<sFloat,task_dof_,1>& arg_min_vel,
         /** The minimum acceleration along the task's directions */
-        const Eigen::Matrix<sFloat,task_dof_,1>& arg_min_acc);
+        const Eigen::Matrix<sFloat,task_dof_,1>& arg_min_acc,
+        /** The number of states the achieved trajectory log keeps.
+         * Older states are overwritten. */
+        const sLongLong arg_log_capacity=10000);
 
     /** Reads a trajectory and checks the trajectory for
      * errors:
@@ -79,15 +92,29 @@ namespace scl
      *
      * Assumes : A trajectory in a text file. One time
      * slice per line.
+     *
+     * NOTE : The text is converted (streamed) once into a binary
+     * trajectory file next to it (arg_file + ".scltraj"), which is
+     * then memory mapped. Use setTrajFromBinFile() to skip the
+     * conversion next time.
      */
     virtual sBool setTrajFromTxtFile(
         /** The file to read in a trajectory from */
         const std::string& arg_file,
-        /** The number of time slices (waypoints) along the trajectory */
+        /** The number of time slices (waypoints) along the trajectory.
+         * Checked if positive. */
         const sLongLong arg_traj_slices,
-        /** Is the first collumn of the trajectory time? */
+        /** Is the first collumn of the trajectory time? If not,
+         * the slices are one cycle time apart. */
         const sBool arg_has_time=true);
 
+    /** Memory maps a binary trajectory file (see CTrajectoryFile) */
+    virtual sBool setTrajFromBinFile(
+        /** The file to read in a trajectory from */
+        const std::string& arg_file,
+        /** How to interpolate between the waypoints */
+        const CTrajectorySpline::ESplineType arg_type=CTrajectorySpline::SPLINE_CUBIC);
+
     /** Generates an arbitrary function based trajectory
      * along all the dofs.
      *
@@ -107,17 +134,21 @@ namespace scl
          * Ie. dof_i = sin(t)+arg_stagger(i); */
         const Eigen::Matrix<sFloat,task_dof_,1>& arg_stagger);
 
-    /** Generates an arbitrary function based trajectory
-     * along all the dofs.
+    /** Returns the trajectory's goal at the current time and advances
+     * the time by one cycle.
      *
-     * Verifies whether the trajectory is achievable.
      * Returns false if there is no current goal (ie. traj is over). */
     virtual sBool getCurrGoal(Eigen::Matrix<sFloat,task_dof_,1>& arg_pos_curr,
         Eigen::Matrix<sFloat,task_dof_,1>& arg_vel_curr,
         Eigen::Matrix<sFloat,task_dof_,1>& arg_acc_curr);
 
+    /** Restarts the trajectory from its first waypoint */
+    virtual void resetTrajTime()
+    { traj_curr_time_ = traj_file_.isOpen() ? traj_spline_.getTimeStart() : 0; traj_spline_.reset(); }
+
     /** Logs a step in the trajectory. Takes the passed configuration
-     * and stores it in the achieved trajectory, indexed by a timestamp. */
+     * and stores it in the achieved trajectory, indexed by a timestamp.
+     * Overwrites the oldest state once the log is full. */
     virtual sBool saveCurrState(
         /** The present config measured by the sensors */
         const Eigen::Matrix<sFloat,task_dof_,1>& arg_state,
@@ -130,37 +161,35 @@ namespace scl
     virtual sBool getLoggedPositions(
         sutil::CMappedList<sFloat, Eigen::Matrix<sFloat,task_dof_,1> >& ret_traj);
 
+    /** The number of states in the log (at most its capacity) */
+    sLongLong getNumLoggedStates() const { return log_size_; }
+
   protected:
-    /** The desired trajectory, indexed by time or numerical index */
-    sutil::CMappedList<sFloat, Eigen::Matrix<sFloat,task_dof_,1> > traj_desired_;
-
-    /** The achieved trajectory, indexed by time */
-    sutil::CMappedList<sFloat, Eigen::Matrix<sFloat,task_dof_,1> > traj_achieved_;
-
-    /** The current trajectory position. Index into mapped list. */
-    Eigen::Matrix<sFloat,task_dof_,1>* traj_curr_pos_;
-    /** The current trajectory velocity. Computed on the fly. */
-    Eigen::Matrix<sFloat,task_dof_,1> traj_curr_vel_;
-    /** The current trajectory acceleration. Computed on the fly. */
-    Eigen::Matrix<sFloat,task_dof_,1> traj_curr_acc_;
-
-    /** The current trajectory position. Index into mapped list. */
-    Eigen::Matrix<sFloat,task_dof_,1>* traj_curr_pos_;
-    /** The current trajectory velocity. Computed on the fly. */
-    Eigen::Matrix<sFloat,task_dof_,1> traj_curr_vel_;
-    /** The current trajectory acceleration. Computed on the fly. */
-    Eigen::Matrix<sFloat,task_dof_,1> traj_curr_acc_;
+    /** Starts the spline on the loaded trajectory file */
+    sBool initSpline(const CTrajectorySpline::ESplineType arg_type);
+
+    /** The desired trajectory's waypoints (memory mapped or generated) */
+    CTrajectoryFile traj_file_;
+
+    /** Interpolates the desired trajectory */
+    CTrajectorySpline traj_spline_;
+
+    /** The achieved trajectory. A ring of (time, state) rows. */
+    std::vector<sFloat> log_ring_;
+    sLongLong log_capacity_, log_head_, log_size_;
+
+    /** Spline outputs (preallocated) */
+    Eigen::VectorXd traj_curr_pos_, traj_curr_vel_, traj_curr_acc_;
 
     /** The current trajectory time */
     sFloat traj_curr_time_;
-    /** The current trajectory index */
-    sLongLong traj_curr_idx_;
+
+    /** The cycle time of the control loop */
+    sFloat cycle_time_;
 
     Eigen::Matrix<sFloat,task_dof_,1> max_pos_, max_vel_, max_acc_,
     min_pos_, min_vel_, min_acc_;
 
-    TypeIOTG otg_;
-
     sBool traj_has_been_init_;
 
   public:
@@ -169,13 +198,12 @@ namespace scl
   };
 
 
-  //NOTE TODO : Don't really like initializing stuff in the constructor.
-  //Ask Torsten to update his OTG API and move stuff to an init function.
-  //Else hack it yourself.
   template <sUInt task_dof_>
   CTrajectoryGenerator<task_dof_>::CTrajectoryGenerator() :
-  otg_(task_dof_)
-  { traj_has_been_init_ = false;  }
+  log_capacity_(0), log_head_(0), log_size_(0),
+  traj_curr_time_(0), cycle_time_(0),
+  traj_has_been_init_(false)
+  { }
 
   template <sUInt task_dof_>
   CTrajectoryGenerator<task_dof_>::~CTrajectoryGenerator()
@@ -196,7 +224,9 @@ namespace scl
       /** The minimum velocity along the task's directions */
       const Eigen::Matrix<sFloat,task_dof_,1>& arg_min_vel,
       /** The minimum acceleration along the task's directions */
-      const Eigen::Matrix<sFloat,task_dof_,1>& arg_min_acc)
+      const Eigen::Matrix<sFloat,task_dof_,1>& arg_min_acc,
+      /** The number of states the achieved trajectory log keeps */
+      const sLongLong arg_log_capacity)
   {
     try
     {
@@ -205,20 +235,10 @@ namespace scl
       { throw(std::runtime_error("Can't generate a trajectory for negative or zero servo cycle time.")); }
       if(0 >= task_dof_)
       { throw(std::runtime_error("Can't generate a trajectory for zero task dofs.")); }
-      if(arg_max_pos.size() != static_cast<sInt>(task_dof_))
-      { throw(std::runtime_error("Max position vector doesn't match task dimensions.")); }
-      if(arg_max_vel.size() != static_cast<sInt>(task_dof_))
-      { throw(std::runtime_error("Max velocity vector doesn't match task dimensions.")); }
-      if(arg_max_acc.size() != static_cast<sInt>(task_dof_))
-      { throw(std::runtime_error("Max acceleration vector doesn't match task dimensions.")); }
-      if(arg_min_pos.size() != static_cast<sInt>(task_dof_))
-      { throw(std::runtime_error("Min position vector doesn't match task dimensions.")); }
-      if(arg_min_vel.size() != static_cast<sInt>(task_dof_))
-      { throw(std::runtime_error("Min velocity vector doesn't match task dimensions.")); }
-      if(arg_min_acc.size() != static_cast<sInt>(task_dof_))
-      { throw(std::runtime_error("Min acceleration vector doesn't match task dimensions.")); }
-
-      otg_.SetCycleTimeInSeconds(arg_cycle_time);
+      if(0 >= arg_log_capacity)
+      { throw(std::runtime_error("Can't log a trajectory in a zero sized log.")); }
+
+      cycle_time_ = arg_cycle_time;
 
       max_pos_ = arg_max_pos;
       max_vel_ = arg_max_vel;
@@ -227,6 +247,14 @@ namespace scl
       min_vel_ = arg_min_vel;
       min_acc_ = arg_min_acc;
 
+      // Allocate everything the servo loop uses up front
+      log_capacity_ = arg_log_capacity;
+      log_ring_.assign(log_capacity_*(task_dof_+1), 0.0);
+      log_head_ = 0; log_size_ = 0;
+      traj_curr_pos_.setZero(task_dof_);
+      traj_curr_vel_.setZero(task_dof_);
+      traj_curr_acc_.setZero(task_dof_);
+
       traj_has_been_init_ = true;
     }
     catch(std::exception& e)
@@ -235,6 +263,16 @@ namespace scl
     return traj_has_been_init_;
   }
 
+  template <sUInt task_dof_>
+  sBool CTrajectoryGenerator<task_dof_>::initSpline(
+      const CTrajectorySpline::ESplineType arg_type)
+  {
+    if(false == traj_spline_.init(&traj_file_, arg_type))
+    { traj_file_.close(); return false; }
+    traj_curr_time_ = traj_spline_.getTimeStart();
+    return true;
+  }
+
   template <sUInt task_dof_>
   sBool CTrajectoryGenerator<task_dof_>::setTrajFromTxtFile(
       /** The file to read in a trajectory from */
@@ -244,61 +282,64 @@ namespace scl
       /** Is the first collumn of the trajectory time? */
       const sBool arg_has_time)
   {
-    bool flag;
     try
     {
-      Eigen::MatrixXd traj;
+      if(false == traj_has_been_init_)
+      { throw(std::runtime_error("Trajectory not initialized. Call initTraj() first."));  }
+
+      std::string bin_file = arg_file + ".scltraj";
+      if(false == CTrajectoryFile::convertTxtFile(arg_file, bin_file,
+          task_dof_, arg_has_time, cycle_time_))
+      { throw(std::runtime_error("Could not convert the text trajectory to a binary one."));  }
+
+      if(false == traj_file_.open(bin_file))
+      { throw(std::runtime_error("Could not map the converted trajectory file."));  }
 
-      if(arg_has_time)
+      if(0 < arg_traj_slices && arg_traj_slices != traj_file_.getNumPoints())
       {
-        traj.resize(arg_traj_slices,task_dof_+1);
-        flag = scl_util::readEigenMatFromFile(traj,
-            arg_traj_slices,task_dof_+1,arg_file);
-        if(false==flag)
-        { throw(std::runtime_error("Could not read trajectory and time from the file."));  }
-
-        //Load the trajectory into the pilemap
-        for(sUInt i = 0; i< arg_traj_slices; ++i)
-        {
-          Eigen::Matrix<sFloat,task_dof_,1> t = traj.row(i);
-          throw(std::runtime_error("Traj row needs to go from 1 to end"));
-          Eigen::Matrix<sFloat,task_dof_,1> * slice = traj_desired_.create(traj(i,0), t);
-          if(S_NULL == slice)
-          {
-            traj_desired_.clear();
-            std::stringstream ss;
-            ss<<i;
-            std::string s("Could not allocate trajectory's slice on the pilemap. At slice : ");
-            s = s + ss.str();
-            throw(std::runtime_error(s.c_str()));
-          }
-        }
+        traj_file_.close();
+        throw(std::runtime_error("The file's trajectory slices don't match the expected number."));
       }
-      else
+
+      if(false == initSpline(CTrajectorySpline::SPLINE_CUBIC))
+      { throw(std::runtime_error("Could not interpolate the trajectory."));  }
+
+      return true;
+    }
+    catch(std::exception& e)
+    {
+      std::cout<<"\nCTrajectoryGenerator::readTrajFromTxtFile() Error : "<<e.what();
+      return false;
+    }
+  }
+
+  template <sUInt task_dof_>
+  sBool CTrajectoryGenerator<task_dof_>::setTrajFromBinFile(
+      const std::string& arg_file,
+      const CTrajectorySpline::ESplineType arg_type)
+  {
+    try
+    {
+      if(false == traj_has_been_init_)
+      { throw(std::runtime_error("Trajectory not initialized. Call initTraj() first."));  }
+
+      if(false == traj_file_.open(arg_file))
+      { throw(std::runtime_error("Could not map the trajectory file."));  }
+
+      if(task_dof_ != traj_file_.getDof())
       {
-        traj.resize(arg_traj_slices,task_dof_);
-        flag = scl_util::readEigenMatFromFile(traj,
-            arg_traj_slices,task_dof_,arg_file);
-        if(false==flag)
-        { throw(std::runtime_error("Could not read trajectory from the file."));  }
-
-        //Load the trajectory into the pilemap
-        for(sUInt i = 0; i< arg_traj_slices; ++i)
-        {
-          Eigen::Matrix<sFloat,task_dof_,1> * slice = traj_desired_.create(i, traj.row(i));
-          if(S_NULL == slice)
-          {
-            traj_desired_.clear();
-            throw(std::runtime_error("Could not allocate trajectory's slice on the pilemap."));
-          }
-        }
+        traj_file_.close();
+        throw(std::runtime_error("The file's trajectory dofs don't match the task's."));
       }
 
+      if(false == initSpline(arg_type))
+      { throw(std::runtime_error("Could not interpolate the trajectory."));  }
+
       return true;
     }
     catch(std::exception& e)
     {
-      std::cout<<"\nCTrajectoryGenerator::readTrajFromTxtFile() Error : "<<e.what();
+      std::cout<<"\nCTrajectoryGenerator::setTrajFromBinFile() Error : "<<e.what();
       return false;
     }
   }
@@ -320,32 +361,38 @@ namespace scl
   {
     try
     {
-      if(arg_pos_start.size() != static_cast<sInt>(task_dof_))
-      { throw(std::runtime_error("Start position vector doesn't match task dimensions.")); }
-      if(arg_scale.size() != static_cast<sInt>(task_dof_))
-      { throw(std::runtime_error("Scale vector doesn't match task dimensions.")); }
-      if(arg_stagger.size() != static_cast<sInt>(task_dof_))
-      { throw(std::runtime_error("Stagger vector doesn't match task dimensions.")); }
+      if(false == traj_has_been_init_)
+      { throw(std::runtime_error("Trajectory not initialized. Call initTraj() first."));  }
+      if(2 > arg_traj_slices)
+      { throw(std::runtime_error("Need at least two trajectory slices.")); }
+      if(0 >= arg_time_per_slice)
+      { throw(std::runtime_error("Need a positive time per slice.")); }
 
-      sFloat time=0.0;
+      // Build the waypoints in the trajectory file's point layout
+      std::vector<double> pts;
+      pts.reserve(arg_traj_slices*(task_dof_+1));
 
+      sFloat time=0.0;
       Eigen::Matrix<sFloat,task_dof_,1> slice;
-      slice = arg_pos_start;
 
-      for(sUInt i=0; i<arg_traj_slices;++i)
+      for(sLongLong i=0; i<arg_traj_slices;++i)
       {
         //Compute the next step according to the given function
         sFloat x = arg_func(time);
         slice = arg_pos_start + arg_scale*x + arg_stagger;
 
-        //Store the trajectory in the pilemap.
-        Eigen::Matrix<sFloat,task_dof_,1> * vec = S_NULL;
-        vec = traj_desired_.create(time,slice);
-        if(S_NULL==vec)
-        { throw(std::runtime_error("Could not create trajectory slice on the pile.")); }
+        pts.push_back(time);
+        for(sUInt j=0; j<task_dof_; ++j) { pts.push_back(slice(j)); }
 
         time+=arg_time_per_slice;//Increment the time
       }
+
+      if(false == traj_file_.setFromMemory(pts, task_dof_))
+      { throw(std::runtime_error("Could not store the trajectory slices.")); }
+
+      if(false == initSpline(CTrajectorySpline::SPLINE_CUBIC))
+      { throw(std::runtime_error("Could not interpolate the trajectory."));  }
+
       return true;
     }
     catch(std::exception& e)
@@ -362,10 +409,19 @@ namespace scl
       Eigen::Matrix<sFloat,task_dof_,1>& arg_vel_curr,
       Eigen::Matrix<sFloat,task_dof_,1>& arg_acc_curr)
   {
-//    for(int i=0;i<task_dof_;++i)
-//    {
-//      otg_.GetNextMotionState_Position();
-//    }
+    if(false == traj_has_been_init_ || false == traj_file_.isOpen())
+    { return false; }
+
+    if(false == traj_spline_.evaluate(traj_curr_time_,
+        traj_curr_pos_, traj_curr_vel_, traj_curr_acc_))
+    { return false; }
+
+    arg_pos_curr = traj_curr_pos_;
+    arg_vel_curr = traj_curr_vel_;
+    arg_acc_curr = traj_curr_acc_;
+
+    traj_curr_time_ += cycle_time_;
+    return true;
   }
 
   template <sUInt task_dof_>
@@ -375,13 +431,36 @@ namespace scl
       /** The present time */
       const sFloat arg_time)
   {
-    Eigen::Matrix<sFloat,task_dof_,1> * vec = S_NULL;
-    //Adds an entry to the trajectory logs
-    vec = traj_achieved_.create(arg_time,arg_state);
-    if(S_NULL == vec)
-    { return false; }
-    else
-    { return true;  }
+    if(0 >= log_capacity_) { return false; }
+
+    //Overwrites the oldest entry once the ring is full
+    sFloat* row = &log_ring_[log_head_*(task_dof_+1)];
+    row[0] = arg_time;
+    for(sUInt i=0; i<task_dof_; ++i) { row[i+1] = arg_state(i); }
+
+    if(++log_head_ == log_capacity_) { log_head_ = 0; }
+    if(log_size_ < log_capacity_) { log_size_++; }
+    return true;
+  }
+
+  template <sUInt task_dof_>
+  sBool CTrajectoryGenerator<task_dof_>::getLoggedPositions(
+      sutil::CMappedList<sFloat, Eigen::Matrix<sFloat,task_dof_,1> >& ret_traj)
+  {
+    if(0 == log_size_) { return false; }
+
+    //Oldest first
+    sLongLong idx = (log_size_ < log_capacity_) ? 0 : log_head_;
+    Eigen::Matrix<sFloat,task_dof_,1> state;
+    for(sLongLong k=0; k<log_size_; ++k)
+    {
+      const sFloat* row = &log_ring_[idx*(task_dof_+1)];
+      for(sUInt i=0; i<task_dof_; ++i) { state(i) = row[i+1]; }
+      if(S_NULL == ret_traj.create(row[0],state))
+      { return false; }
+      if(++idx == log_capacity_) { idx = 0; }
+    }
+    return true;
   }
 
 }
@@ -0,0 +1,208 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CTrajectoryOtg.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include <scl/trajectory/CTrajectoryOtg.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+namespace scl
+{
+  /** Bisection steps for the jerk limited acceleration (resolves it to
+   * 2 J dt / 2^steps) */
+  static const int SCL_OTG_BISECTION_STEPS = 24;
+
+  namespace
+  {
+    inline sFloat sign(const sFloat x) { return (x > 0) ? 1.0 : ((x < 0) ? -1.0 : 0.0); }
+
+    inline sFloat clamp(const sFloat x, const sFloat lim)
+    { return (x > lim) ? lim : ((x < -lim) ? -lim : x); }
+
+    /** Integrates a constant jerk phase (continuous time) */
+    inline void integratePhase(sFloat& d, sFloat& v, sFloat& a, const sFloat j, const sFloat T)
+    {
+      d += T*(v + T*(a/2 + T*j/6));
+      v += T*(a + T*j/2);
+      a += T*j;
+    }
+
+    /** The displacement of a time optimal, jerk limited stop from velocity
+     * arg_v and acceleration arg_a (continuous time) : Ramp the acceleration
+     * to -a_b, hold it (if a_b hits the limit A), ramp it back to zero. */
+    sFloat stopDisplacement(sFloat arg_v, sFloat arg_a, const sFloat A, const sFloat J)
+    {
+      // Brake the velocity the reference would have once the acceleration is zero
+      const sFloat s = (arg_v + arg_a*std::fabs(arg_a)/(2*J) >= 0) ? 1.0 : -1.0;
+      arg_v *= s; arg_a *= s;
+
+      sFloat a_b = std::sqrt(std::max(0.0, arg_a*arg_a/2 + J*arg_v)), t_hold = 0;
+      if(a_b > A) { a_b = A; t_hold = (arg_v + arg_a*arg_a/(2*J) - A*A/J)/A; }
+
+      sFloat d = 0;
+      integratePhase(d, arg_v, arg_a, -J, (arg_a + a_b)/J);
+      integratePhase(d, arg_v, arg_a, 0, t_hold);
+      integratePhase(d, arg_v, arg_a, J, a_b/J);
+      return s*d;
+    }
+
+    /** Whether applying acceleration arg_a for a cycle (from velocity arg_v,
+     * with the goal arg_e ahead) keeps the velocity within V and leaves room
+     * for a jerk limited stop before the goal */
+    inline bool isSafeAcc(const sFloat arg_a, const sFloat arg_e, const sFloat arg_v,
+        const sFloat V, const sFloat A, const sFloat J, const sFloat dt)
+    {
+      const sFloat v = arg_v + arg_a*dt;
+      if(v + ((arg_a > 0) ? arg_a*arg_a/(2*J) : 0) > V) { return false; }
+      return v*dt + stopDisplacement(v, arg_a, A, J) <= arg_e;
+    }
+
+    /** The fastest (discrete) speed at distance arg_dist from a goal from
+     * which braking at arg_rate per cycle (semi-implicit integration) ends
+     * exactly at the goal, including this cycle's step.
+     *
+     * Braking from speed v covers dt * sum_k max(v - k rate dt, 0), k>=0.
+     * That is piecewise linear in v, so it is inverted exactly (unlike the
+     * continuous v^2/2a curve, which lets the last step overshoot). */
+    inline sFloat discreteStopVel(const sFloat arg_dist, const sFloat arg_rate, const sFloat dt)
+    {
+      const sFloat r = arg_rate*dt*dt;
+      const sFloat n = std::floor(0.5*(std::sqrt(1 + 8*arg_dist/r) - 1));
+      return (arg_dist/dt + 0.5*arg_rate*dt*n*(n+1))/(n+1);
+    }
+
+    /** Sets a vector limit from a size 1 or size arg_dof one */
+    void setLimit(Eigen::VectorXd& ret_lim, const Eigen::VectorXd& arg_lim,
+        const sUInt arg_dof, const sBool arg_allow_empty)
+    {
+      if(0 == arg_lim.size() && arg_allow_empty) { ret_lim.setZero(arg_dof); }
+      else if(1 == arg_lim.size()) { ret_lim.setConstant(arg_dof, arg_lim(0)); }
+      else if(arg_dof == static_cast<sUInt>(arg_lim.size())) { ret_lim = arg_lim; }
+      else { throw(std::runtime_error("Limit vector size should be 1 or dof")); }
+    }
+  }
+
+  sBool CTrajectoryOtg::init(const sUInt arg_dof,
+      const Eigen::VectorXd& arg_max_vel,
+      const Eigen::VectorXd& arg_max_acc,
+      const Eigen::VectorXd& arg_max_jerk,
+      const sFloat arg_cycle_time)
+  {
+    try
+    {
+      if(0 == arg_dof)
+      { throw(std::runtime_error("Can't generate a trajectory for zero dofs")); }
+      if(0 >= arg_cycle_time)
+      { throw(std::runtime_error("Can't generate a trajectory for a negative or zero cycle time")); }
+
+      setLimit(max_vel_, arg_max_vel, arg_dof, false);
+      setLimit(max_acc_, arg_max_acc, arg_dof, false);
+      setLimit(max_jerk_, arg_max_jerk, arg_dof, true);
+
+      if(0 >= max_vel_.minCoeff() || 0 >= max_acc_.minCoeff())
+      { throw(std::runtime_error("Velocity and acceleration limits must be positive")); }
+
+      pos_.setZero(arg_dof);
+      vel_.setZero(arg_dof);
+      acc_.setZero(arg_dof);
+      cycle_time_ = arg_cycle_time;
+      is_started_ = false;
+      has_been_init_ = true;
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCTrajectoryOtg::init() : "<<e.what();
+      has_been_init_ = false;
+    }
+    return has_been_init_;
+  }
+
+  void CTrajectoryOtg::reset(const Eigen::Ref<const Eigen::VectorXd>& arg_pos,
+      const Eigen::Ref<const Eigen::VectorXd>& arg_vel)
+  {
+    pos_ = arg_pos;
+    vel_ = arg_vel;
+    acc_.setZero();
+    is_started_ = true;
+  }
+
+  sBool CTrajectoryOtg::update(const Eigen::Ref<const Eigen::VectorXd>& arg_goal)
+  {
+    sBool at_goal = true;
+    for(sUInt i=0; i<static_cast<sUInt>(pos_.size()); ++i)
+    { at_goal = updateDof(i, arg_goal(i)) && at_goal; }
+    return at_goal;
+  }
+
+  sBool CTrajectoryOtg::updateDof(const sUInt i, const sFloat arg_goal)
+  {
+    const sFloat dt = cycle_time_, V = max_vel_(i), A = max_acc_(i), J = max_jerk_(i);
+    sFloat &p = pos_(i), &v = vel_(i), &a = acc_(i);
+    const sFloat e = arg_goal - p;
+
+    if(0 >= J || J*dt >= A)
+    {// No (effective) jerk limit : Track the discrete stopping curve with the max acceleration
+      const sFloat v_des = sign(e) * std::min(V, discreteStopVel(std::fabs(e), A, dt));
+      a = clamp((v_des - v)/dt, A);
+    }
+    else
+    {
+      // Close enough to land in one cycle without exceeding the jerk limit
+      if(std::fabs(e) < J*dt*dt*dt && std::fabs(v) < J*dt*dt && std::fabs(a) < J*dt)
+      { p = arg_goal; v = 0; a = 0; return true; }
+
+      // Pick the largest acceleration toward the goal (within one cycle's jerk)
+      // after which a full jerk limited stop still ends short of the goal and
+      // the velocity stays within its limit. Both checks are monotonic in the
+      // acceleration, so bisect between the cycle's min and max acceleration.
+      const sFloat s = (e >= 0) ? 1.0 : -1.0; // Normalize : the goal is ahead
+      const sFloat e_n = s*e, v_n = s*v;
+      sFloat a_lo = std::max(-A, s*a - J*dt), a_hi = std::min(A, s*a + J*dt);
+
+      if(isSafeAcc(a_hi, e_n, v_n, V, A, J, dt)) { a_lo = a_hi; }
+      else if(isSafeAcc(a_lo, e_n, v_n, V, A, J, dt))
+      {
+        for(int k=0; k<SCL_OTG_BISECTION_STEPS; ++k)
+        {
+          const sFloat c = 0.5*(a_lo + a_hi);
+          if(isSafeAcc(c, e_n, v_n, V, A, J, dt)) { a_lo = c; } else { a_hi = c; }
+        }
+      }
+      a = s*a_lo; //If nothing is safe, this brakes as hard as possible
+    }
+
+    // Semi-implicit integration (so the reference lands exactly on the goal)
+    v += a*dt;
+    p += v*dt;
+    return (p == arg_goal) && (0 == v);
+  }
+}
@@ -0,0 +1,182 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CTrajectorySpline.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include <scl/trajectory/CTrajectorySpline.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace scl
+{
+  /** Cursor steps to take before falling back to a binary search */
+  static const int SCL_TRAJ_SPLINE_MAX_STEPS = 4;
+
+  sBool CTrajectorySpline::init(const CTrajectoryFile* arg_traj, const ESplineType arg_type)
+  {
+    try
+    {
+      if(S_NULL == arg_traj || false == arg_traj->isOpen())
+      { throw(std::runtime_error("Passed a null or closed trajectory")); }
+      if(2 > arg_traj->getNumPoints())
+      { throw(std::runtime_error("Need at least two waypoints")); }
+
+      traj_ = arg_traj;
+      type_ = arg_type;
+      seg_ = 0;
+      ctr_searches_ = 0;
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCTrajectorySpline::init() : "<<e.what();
+      traj_ = S_NULL;
+      return false;
+    }
+    return true;
+  }
+
+  namespace
+  {
+    /** Derivative at an end point from three points (second order).
+     * f1 and f2 are h1 and h1+h2 away (negative spacings for the last point). */
+    inline double diffEnd(const double f0, const double f1, const double f2,
+        const double h1, const double h2)
+    {
+      return -(2*h1+h2)/(h1*(h1+h2))*f0 + (h1+h2)/(h1*h2)*f1 - h1/(h2*(h1+h2))*f2;
+    }
+
+    /** Derivative at waypoint arg_i of the values arg_f(i) : central
+     * differences inside, one-sided ones at the ends. */
+    template <typename F>
+    double diffAt(const CTrajectoryFile* arg_traj, const sLongLong arg_i, const F& arg_f)
+    {
+      const sLongLong n = arg_traj->getNumPoints();
+      if(3 > n)
+      { return (arg_f(1) - arg_f(0)) / (arg_traj->getTime(1) - arg_traj->getTime(0)); }
+      if(0 == arg_i)
+      {
+        return diffEnd(arg_f(0), arg_f(1), arg_f(2),
+            arg_traj->getTime(1) - arg_traj->getTime(0),
+            arg_traj->getTime(2) - arg_traj->getTime(1));
+      }
+      if(n-1 == arg_i)
+      {
+        return diffEnd(arg_f(n-1), arg_f(n-2), arg_f(n-3),
+            arg_traj->getTime(n-2) - arg_traj->getTime(n-1),
+            arg_traj->getTime(n-3) - arg_traj->getTime(n-2));
+      }
+      return (arg_f(arg_i+1) - arg_f(arg_i-1)) /
+          (arg_traj->getTime(arg_i+1) - arg_traj->getTime(arg_i-1));
+    }
+  }
+
+  double CTrajectorySpline::vel(const sLongLong arg_i, const sUInt arg_d) const
+  {
+    if(traj_->hasVelocities()) { return traj_->getVel(arg_i)[arg_d]; }
+
+    const CTrajectoryFile* traj = traj_;
+    return diffAt(traj_, arg_i,
+        [traj, arg_d](sLongLong i) { return traj->getPos(i)[arg_d]; });
+  }
+
+  double CTrajectorySpline::acc(const sLongLong arg_i, const sUInt arg_d) const
+  {
+    return diffAt(traj_, arg_i,
+        [this, arg_d](sLongLong i) { return vel(i, arg_d); });
+  }
+
+  sBool CTrajectorySpline::evaluate(const double arg_t, Eigen::VectorXd& ret_pos,
+      Eigen::VectorXd& ret_vel, Eigen::VectorXd& ret_acc)
+  {
+    if(S_NULL == traj_) { return false; }
+
+    const sUInt dof = traj_->getDof();
+    const sLongLong n = traj_->getNumPoints();
+    if(static_cast<sUInt>(ret_pos.size()) != dof) { ret_pos.resize(dof); }
+    if(static_cast<sUInt>(ret_vel.size()) != dof) { ret_vel.resize(dof); }
+    if(static_cast<sUInt>(ret_acc.size()) != dof) { ret_acc.resize(dof); }
+
+    // Hold the ends
+    if(arg_t <= traj_->getTime(0) || arg_t >= traj_->getTime(n-1))
+    {
+      const bool at_start = arg_t <= traj_->getTime(0);
+      const double* p = traj_->getPos(at_start ? 0 : n-1);
+      for(sUInt d=0; d<dof; ++d) { ret_pos(d) = p[d]; }
+      ret_vel.setZero(); ret_acc.setZero();
+      seg_ = at_start ? 0 : n-2;
+      return at_start || arg_t <= traj_->getTime(n-1);
+    }
+
+    // Move the cursor to the segment that contains arg_t
+    if(arg_t < traj_->getTime(seg_))
+    { seg_ = traj_->findPoint(arg_t); ctr_searches_++; }
+    else
+    {
+      int steps = 0;
+      while(arg_t >= traj_->getTime(seg_+1))
+      {
+        ++seg_;
+        if(++steps > SCL_TRAJ_SPLINE_MAX_STEPS)
+        { seg_ = traj_->findPoint(arg_t); ctr_searches_++; break; }
+      }
+    }
+    if(seg_ > n-2) { seg_ = n-2; }
+
+    // Evaluate the segment's polynomial in s = (t-t0)/h, s in [0,1)
+    const double t0 = traj_->getTime(seg_), h = traj_->getTime(seg_+1) - t0;
+    const double s = (arg_t - t0)/h;
+    const double* p0 = traj_->getPos(seg_);
+    const double* p1 = traj_->getPos(seg_+1);
+
+    for(sUInt d=0; d<dof; ++d)
+    {
+      const double dp = p1[d] - p0[d];
+      const double v0 = h*vel(seg_,d), v1 = h*vel(seg_+1,d);
+      double c2, c3, c4=0.0, c5=0.0;
+      if(SPLINE_QUINTIC == type_)
+      {
+        const double a0 = h*h*acc(seg_,d), a1 = h*h*acc(seg_+1,d);
+        c2 = 0.5*a0;
+        c3 = 10*dp - 6*v0 - 4*v1 - 1.5*a0 + 0.5*a1;
+        c4 = -15*dp + 8*v0 + 7*v1 + 1.5*a0 - a1;
+        c5 = 6*dp - 3*v0 - 3*v1 - 0.5*a0 + 0.5*a1;
+      }
+      else
+      {
+        c2 = 3*dp - 2*v0 - v1;
+        c3 = -2*dp + v0 + v1;
+      }
+      ret_pos(d) = p0[d] + s*(v0 + s*(c2 + s*(c3 + s*(c4 + s*c5))));
+      ret_vel(d) = (v0 + s*(2*c2 + s*(3*c3 + s*(4*c4 + s*5*c5)))) / h;
+      ret_acc(d) = (2*c2 + s*(6*c3 + s*(12*c4 + s*20*c5))) / (h*h);
+    }
+    return true;
+  }
+}
@@ -0,0 +1,98 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CTrajectorySpline.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CTRAJECTORYSPLINE_HPP_
+#define CTRAJECTORYSPLINE_HPP_
+
+#include <scl/DataTypes.hpp>
+#include <scl/trajectory/CTrajectoryFile.hpp>
+
+#include <Eigen/Core>
+
+namespace scl
+{
+  /** Interpolates a trajectory's waypoints with a piecewise cubic or
+   * quintic Hermite spline.
+   *
+   * Keeps a cursor at the current segment. Servo loops evaluate at
+   * (mostly) increasing times, so each evaluate() only steps the cursor
+   * ahead a segment or two : O(1) per tick regardless of the trajectory's
+   * length. Jumps (backwards, or far ahead) fall back to a binary search.
+   *
+   * Velocities at the waypoints are read from the trajectory if it has
+   * them, else estimated with (non-uniform) central differences. The
+   * quintic spline also matches accelerations at the waypoints, estimated
+   * from the velocities the same way.
+   *
+   * Doesn't allocate once the output vectors have the trajectory's dofs. */
+  class CTrajectorySpline
+  {
+  public:
+    enum ESplineType { SPLINE_CUBIC, SPLINE_QUINTIC };
+
+    CTrajectorySpline() : traj_(S_NULL), type_(SPLINE_CUBIC), seg_(0), ctr_searches_(0) {}
+
+    /** The trajectory must stay open while the spline uses it.
+     * Needs at least two waypoints. */
+    sBool init(const CTrajectoryFile* arg_traj, const ESplineType arg_type=SPLINE_CUBIC);
+
+    /** Evaluates the spline at time arg_t. Before the start (after the end)
+     * it holds the first (last) waypoint with zero velocity and acceleration.
+     * Returns false once arg_t is past the end. */
+    sBool evaluate(const double arg_t, Eigen::VectorXd& ret_pos,
+        Eigen::VectorXd& ret_vel, Eigen::VectorXd& ret_acc);
+
+    /** Moves the cursor back to the start */
+    void reset() { seg_ = 0; }
+
+    /** The segment the cursor is at (waypoint index) */
+    sLongLong getSegment() const { return seg_; }
+
+    /** How many times the cursor fell back to a binary search */
+    sLongLong getNumSearches() const { return ctr_searches_; }
+
+    double getTimeStart() const { return traj_->getTime(0); }
+    double getTimeEnd() const { return traj_->getTime(traj_->getNumPoints()-1); }
+
+  private:
+    /** Velocity of dof arg_d at waypoint arg_i */
+    double vel(const sLongLong arg_i, const sUInt arg_d) const;
+    /** Acceleration of dof arg_d at waypoint arg_i (quintic only) */
+    double acc(const sLongLong arg_i, const sUInt arg_d) const;
+
+    const CTrajectoryFile* traj_;
+    ESplineType type_;
+    sLongLong seg_;
+    sLongLong ctr_searches_;
+  };
+}
+
+#endif /* CTRAJECTORYSPLINE_HPP_ */
@@ -44,4 +44,15 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 
 #include <scl/util/RobotMath.hpp>
 
+#include <scl/util/CTripleBuffer.hpp>
+
+#include <scl/util/CSeqLock.hpp>
+#include <scl/util/CLoggerBinary.hpp>
+#include <scl/util/CPerfStats.hpp>
+#include <scl/util/CAllocTracker.hpp>
+
+#include <scl/util/CSpscQueue.hpp>
+
+#include <scl/util/CLoopScheduler.hpp>
+
 #endif /* SRC_SCL_UTIL_ALLHEADERS_HPP_ */
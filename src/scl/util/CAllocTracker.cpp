@@ -0,0 +1,139 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CAllocTracker.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "CAllocTracker.hpp"
+#include "CPerfStats.hpp"
+
+#include <atomic>
+#include <cstdio>
+
+namespace
+{
+  //NOTE : Everything here is constant-initialized (no constructors run),
+  //so the hooks can count allocations made during static init.
+  std::atomic<bool> alloc_hooks_installed(false);
+  std::atomic<bool> alloc_enabled(false);
+
+  /** Slot SCL_ALLOC_MAX_PHASES is phase -1 (untimed) */
+  std::atomic<long long> alloc_phase_n[SCL_ALLOC_MAX_PHASES+1];
+  std::atomic<long long> alloc_phase_bytes[SCL_ALLOC_MAX_PHASES+1];
+
+  thread_local int tl_alloc_phase = -1;
+  thread_local long long tl_alloc_n = 0;
+  thread_local long long tl_alloc_bytes = 0;
+
+  inline int slot(const int arg_phase)
+  {
+    if(0 > arg_phase) { return SCL_ALLOC_MAX_PHASES; }
+    if(arg_phase >= SCL_ALLOC_MAX_PHASES) { return SCL_ALLOC_MAX_PHASES-1; }
+    return arg_phase;
+  }
+}
+
+namespace scl
+{
+  sBool CAllocTracker::getHooksInstalled()
+  { return alloc_hooks_installed.load(std::memory_order_relaxed); }
+
+  void CAllocTracker::setHooksInstalled()
+  { alloc_hooks_installed.store(true, std::memory_order_relaxed); }
+
+  void CAllocTracker::setEnabled(const sBool arg_flag)
+  { alloc_enabled.store(arg_flag, std::memory_order_relaxed); }
+
+  sBool CAllocTracker::getEnabled()
+  { return alloc_enabled.load(std::memory_order_relaxed); }
+
+  SAllocCount CAllocTracker::getThreadCount()
+  {
+    SAllocCount c;
+    c.allocs_ = tl_alloc_n;
+    c.bytes_ = tl_alloc_bytes;
+    return c;
+  }
+
+  SAllocCount CAllocTracker::getPhaseCount(const int arg_phase)
+  {
+    SAllocCount c;
+    c.allocs_ = alloc_phase_n[slot(arg_phase)].load(std::memory_order_relaxed);
+    c.bytes_ = alloc_phase_bytes[slot(arg_phase)].load(std::memory_order_relaxed);
+    return c;
+  }
+
+  void CAllocTracker::print(std::ostream& arg_os)
+  {
+    if(false == getHooksInstalled())
+    { arg_os<<"\nAllocation tracking isn't available (link in CAllocTrackerHooks.cpp)"; return; }
+
+    char buf[256];
+    snprintf(buf, sizeof(buf), "\n%-36s %12s %14s", "phase", "allocs", "bytes");
+    arg_os<<buf;
+    bool flag_any = false;
+    for(int i=-1; i<SCL_ALLOC_MAX_PHASES; ++i)
+    {
+      SAllocCount c = getPhaseCount(i);
+      if(0 == c.allocs_) { continue; }
+      flag_any = true;
+      std::string name = (0 > i) ? std::string("(untimed)") : CPerfStats::getName(i);
+      if(SCL_ALLOC_MAX_PHASES-1 == i) { name += " (+ later ids)"; }
+      snprintf(buf, sizeof(buf), "\n%-36s %12lld %14lld", name.c_str(), c.allocs_, c.bytes_);
+      arg_os<<buf;
+    }
+    if(false == flag_any)
+    { arg_os<<"\nNo allocations"<<(getEnabled() ? "" : " (counting is off)"); }
+  }
+
+  void CAllocTracker::reset()
+  {
+    for(int i=0; i<=SCL_ALLOC_MAX_PHASES; ++i)
+    {
+      alloc_phase_n[i].store(0, std::memory_order_relaxed);
+      alloc_phase_bytes[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  int CAllocTracker::setPhase(const int arg_phase)
+  {
+    const int old = tl_alloc_phase;
+    tl_alloc_phase = arg_phase;
+    return old;
+  }
+
+  void CAllocTracker::recordAlloc(const std::size_t arg_bytes)
+  {
+    if(false == alloc_enabled.load(std::memory_order_relaxed)) { return; }
+    tl_alloc_n++;
+    tl_alloc_bytes += static_cast<long long>(arg_bytes);
+    const int s = slot(tl_alloc_phase);
+    alloc_phase_n[s].fetch_add(1, std::memory_order_relaxed);
+    alloc_phase_bytes[s].fetch_add(static_cast<long long>(arg_bytes), std::memory_order_relaxed);
+  }
+}
@@ -0,0 +1,102 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CAllocTracker.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CALLOCTRACKER_HPP_
+#define CALLOCTRACKER_HPP_
+
+#include <scl/DataTypes.hpp>
+
+#include <cstddef>
+#include <ostream>
+
+/** Phases (CPerfStats timer ids) with their own counters. Larger ids share
+ * the last slot. */
+#define SCL_ALLOC_MAX_PHASES 256
+
+namespace scl
+{
+  /** A number of heap allocations and their total size */
+  struct SAllocCount
+  {
+    sLongLong allocs_ = 0;
+    sLongLong bytes_ = 0;
+  };
+
+  /** Counts heap allocations, per thread and per phase.
+   *
+   * A phase is the innermost CPerfScope (or SCL_PERF_SCOPE) that is
+   * running on the allocating thread, so allocations are attributed to
+   * the same names as the timers (eg. "ctrl::servo", "task::hand::model").
+   * Allocations outside any timed scope go to phase -1.
+   *
+   * The counting needs the malloc hooks, which are opt-in : Add
+   * src/scl/util/CAllocTrackerHooks.cpp to an executable's sources (the
+   * scl lib doesn't include it). Without the hooks all counts stay zero.
+   *
+   * Counting is off by default. While it is on, every allocation pays a
+   * few atomic increments, so only use it in test builds. */
+  class CAllocTracker
+  {
+  public:
+    /** Whether the executable linked in the malloc hooks */
+    static sBool getHooksInstalled();
+
+    /** Turns counting on or off (off by default) */
+    static void setEnabled(const sBool arg_flag);
+    static sBool getEnabled();
+
+    /** The calling thread's counts (while counting was on). To check a
+     * block of code, diff the counts before and after it. */
+    static SAllocCount getThreadCount();
+
+    /** The counts for a phase (a CPerfStats timer id) across all threads.
+     * Phase -1 is everything outside a timed scope. */
+    static SAllocCount getPhaseCount(const int arg_phase);
+
+    /** Prints the phases with allocations */
+    static void print(std::ostream& arg_os);
+
+    /** Zeros the phase counts (the thread counts are monotonic) */
+    static void reset();
+
+    /** Sets the calling thread's phase and returns the previous one.
+     * CPerfScope calls this on entry and exit. */
+    static int setPhase(const int arg_phase);
+
+    /** Hooks : Count an allocation. Must not allocate. */
+    static void recordAlloc(const std::size_t arg_bytes);
+
+    /** Hooks : Called once when they are linked in */
+    static void setHooksInstalled();
+  };
+}
+
+#endif /* CALLOCTRACKER_HPP_ */
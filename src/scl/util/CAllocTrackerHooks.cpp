@@ -0,0 +1,98 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CAllocTrackerHooks.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+/* Malloc hooks for CAllocTracker.
+ *
+ * NOTE : This file is NOT part of the scl lib. Add it to the sources of an
+ * executable (eg. scl_test) to count its allocations. It replaces glibc's
+ * malloc family and forwards to glibc's internal implementation, so it
+ * also catches operator new (which calls malloc) and Eigen's aligned
+ * allocations. Frees aren't counted. */
+
+#include <scl/util/CAllocTracker.hpp>
+
+#include <cerrno>
+#include <cstddef>
+
+extern "C"
+{
+  //glibc's implementations
+  void* __libc_malloc(size_t arg_size);
+  void* __libc_calloc(size_t arg_n, size_t arg_size);
+  void* __libc_realloc(void* arg_ptr, size_t arg_size);
+  void* __libc_memalign(size_t arg_align, size_t arg_size);
+
+  void* malloc(size_t arg_size)
+  {
+    scl::CAllocTracker::recordAlloc(arg_size);
+    return __libc_malloc(arg_size);
+  }
+
+  void* calloc(size_t arg_n, size_t arg_size)
+  {
+    scl::CAllocTracker::recordAlloc(arg_n*arg_size);
+    return __libc_calloc(arg_n, arg_size);
+  }
+
+  void* realloc(void* arg_ptr, size_t arg_size)
+  {
+    scl::CAllocTracker::recordAlloc(arg_size);
+    return __libc_realloc(arg_ptr, arg_size);
+  }
+
+  void* memalign(size_t arg_align, size_t arg_size)
+  {
+    scl::CAllocTracker::recordAlloc(arg_size);
+    return __libc_memalign(arg_align, arg_size);
+  }
+
+  void* aligned_alloc(size_t arg_align, size_t arg_size)
+  {
+    scl::CAllocTracker::recordAlloc(arg_size);
+    return __libc_memalign(arg_align, arg_size);
+  }
+
+  int posix_memalign(void** ret_ptr, size_t arg_align, size_t arg_size)
+  {
+    scl::CAllocTracker::recordAlloc(arg_size);
+    void* p = __libc_memalign(arg_align, arg_size);
+    if(NULL == p) { return ENOMEM; }
+    *ret_ptr = p;
+    return 0;
+  }
+}
+
+namespace
+{
+  struct SAllocHooksInit
+  { SAllocHooksInit() { scl::CAllocTracker::setHooksInstalled(); } };
+  SAllocHooksInit alloc_hooks_init;
+}
@@ -0,0 +1,280 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CLoggerBinary.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "CLoggerBinary.hpp"
+
+#include <stdexcept>
+#include <iostream>
+#include <cstring>
+#include <chrono>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  struct SLogFileHeader
+  {
+    char magic_[8];
+    unsigned int header_bytes_, n_cols_, row_doubles_, reserved_;
+  };
+
+  struct SLogFileColumn
+  {
+    char name_[SCL_LOG_MAX_COL_NAME_CHARS];
+    unsigned int offset_, rows_, cols_, reserved_;
+  };
+
+  unsigned int headerBytes(const std::size_t arg_n_cols)
+  {
+    std::size_t sz = sizeof(SLogFileHeader) + arg_n_cols*sizeof(SLogFileColumn);
+    return static_cast<unsigned int>((sz + 63)/64*64);
+  }
+}
+
+namespace scl
+{
+  sInt CLoggerBinary::addColumn(const std::string& arg_name, const sUInt arg_rows, const sUInt arg_cols)
+  {
+    try
+    {
+      if(running_) { throw(std::runtime_error("Can't add columns to an open log.")); }
+      if(arg_name.length() >= SCL_LOG_MAX_COL_NAME_CHARS || 0 == arg_name.length())
+      { throw(std::runtime_error(std::string("Invalid column name (empty, or too long) : ")+arg_name)); }
+
+      SLogColumn c;
+      c.name_ = arg_name;
+      c.offset_ = row_doubles_;
+      c.rows_ = arg_rows;
+      c.cols_ = arg_cols;
+      cols_.push_back(c);
+      row_doubles_ += c.size();
+      return static_cast<sInt>(cols_.size()) - 1;
+    }
+    catch(std::exception& e)
+    { std::cerr<<"\nCLoggerBinary::addColumn() : "<<e.what(); }
+    return -1;
+  }
+
+  sBool CLoggerBinary::open(const std::string& arg_file, const sUInt arg_ring_rows,
+      const sFloat arg_flush_period)
+  {
+    try
+    {
+      if(running_) { throw(std::runtime_error("Log is already open. Close it first.")); }
+      if(0 == cols_.size() || 0 == row_doubles_) { throw(std::runtime_error("Log has no columns.")); }
+      if(0 == arg_ring_rows) { throw(std::runtime_error("Ring buffer needs at least one row.")); }
+
+      const unsigned int hbytes = headerBytes(cols_.size());
+      const long row_bytes = row_doubles_*sizeof(double);
+
+      // 1. If the file exists, its schema must match. Then append to it.
+      struct stat st;
+      bool flag_append = (0 == stat(arg_file.c_str(), &st) && 0 < st.st_size);
+      if(flag_append)
+      {
+        FILE* f = fopen(arg_file.c_str(), "rb");
+        if(S_NULL == f) { throw(std::runtime_error(std::string("Could not read existing log : ")+arg_file)); }
+        std::vector<SLogColumn> fcols; sUInt frd, fhb;
+        bool same = readHeader(f, fcols, frd, fhb);
+        fclose(f);
+        same = same && (frd == row_doubles_) && (fhb == hbytes) && (fcols.size() == cols_.size());
+        for(std::size_t i=0; same && i<cols_.size(); ++i)
+        {
+          same = (fcols[i].name_ == cols_[i].name_) && (fcols[i].rows_ == cols_[i].rows_) &&
+              (fcols[i].cols_ == cols_[i].cols_);
+        }
+        if(false == same)
+        { throw(std::runtime_error(std::string("Existing log has a different schema : ")+arg_file)); }
+
+        // Trim a partial row (eg. if the last run crashed mid-write)
+        const long n_rows = (st.st_size - hbytes)/row_bytes;
+        if(st.st_size != hbytes + n_rows*row_bytes)
+        {
+          if(0 != truncate(arg_file.c_str(), hbytes + n_rows*row_bytes))
+          { throw(std::runtime_error(std::string("Could not trim a partial row from : ")+arg_file)); }
+        }
+        file_ = fopen(arg_file.c_str(), "ab");
+      }
+      else
+      {
+        // 2. New file. Write the header.
+        file_ = fopen(arg_file.c_str(), "wb");
+        if(S_NULL == file_) { throw(std::runtime_error(std::string("Could not open log : ")+arg_file)); }
+
+        if(false == writeHeader(file_, cols_))
+        { fclose(file_); file_ = S_NULL; throw(std::runtime_error(std::string("Could not write the log's header : ")+arg_file)); }
+        fflush(file_);
+      }
+      if(S_NULL == file_) { throw(std::runtime_error(std::string("Could not open log : ")+arg_file)); }
+
+      // 3. Preallocate the ring and start the writer.
+      ring_rows_ = arg_ring_rows;
+      ring_.assign(static_cast<std::size_t>(ring_rows_)*row_doubles_, 0.0);
+      flush_period_ = arg_flush_period;
+      head_ = 0; tail_ = 0; ctr_dropped_ = 0;
+      running_ = true;
+      writer_ = std::thread(&CLoggerBinary::runWriter, this);
+      return true;
+    }
+    catch(std::exception& e)
+    { std::cerr<<"\nCLoggerBinary::open() : "<<e.what(); }
+    return false;
+  }
+
+  sBool CLoggerBinary::close()
+  {
+    if(false == running_) { return true; }
+    running_ = false;
+    if(writer_.joinable()) { writer_.join(); } // Writes the pending rows before exiting
+    bool flag = (0 == fclose(file_));
+    file_ = S_NULL;
+    return flag;
+  }
+
+  void CLoggerBinary::runWriter()
+  {
+    const std::chrono::microseconds dt(static_cast<long long>(flush_period_*1e6));
+    while(running_)
+    {
+      if(false == writePending())
+      { std::cerr<<"\nCLoggerBinary::runWriter() : Error writing the log. Dropping rows."; }
+      std::this_thread::sleep_for(dt);
+    }
+    writePending();
+  }
+
+  sBool CLoggerBinary::writePending()
+  {
+    bool flag = true;
+    const sLongLong h = head_.load(std::memory_order_acquire);
+    sLongLong t = tail_.load(std::memory_order_relaxed);
+    while(t < h)
+    {// Write contiguous chunks (the ring wraps around)
+      const sLongLong idx = t % ring_rows_;
+      sLongLong n = h - t;
+      if(idx + n > ring_rows_) { n = ring_rows_ - idx; }
+      if(static_cast<std::size_t>(n) != fwrite(&ring_[idx*row_doubles_], row_doubles_*sizeof(double), n, file_))
+      { flag = false; }
+      t += n;
+      tail_.store(t, std::memory_order_release); // Frees the rows for the logging thread
+    }
+    fflush(file_); // Readers (and mmaps) see whole rows as soon as possible
+    return flag;
+  }
+
+  void CLoggerBinary::setColumn(double* arg_row, const sInt arg_col, const double* arg_data, const sUInt arg_n) const
+  {
+    if(S_NULL == arg_row || 0 > arg_col || static_cast<std::size_t>(arg_col) >= cols_.size()) { return; }
+    const SLogColumn& c = cols_[arg_col];
+    const sUInt n = (arg_n < c.size()) ? arg_n : c.size();
+    memcpy(arg_row + c.offset_, arg_data, n*sizeof(double));
+    for(sUInt i=n; i<c.size(); ++i) { arg_row[c.offset_+i] = 0.0; }
+  }
+
+  void CLoggerBinary::fillColumn(double* arg_row, const sInt arg_col, const double arg_val) const
+  {
+    if(S_NULL == arg_row || 0 > arg_col || static_cast<std::size_t>(arg_col) >= cols_.size()) { return; }
+    const SLogColumn& c = cols_[arg_col];
+    for(sUInt i=0; i<c.size(); ++i) { arg_row[c.offset_+i] = arg_val; }
+  }
+
+  sBool CLoggerBinary::writeHeader(FILE* arg_file, const std::vector<SLogColumn>& arg_cols)
+  {
+    try
+    {
+      if(S_NULL == arg_file) { throw(std::runtime_error("Passed a NULL file")); }
+      if(0 == arg_cols.size()) { throw(std::runtime_error("Log has no columns.")); }
+
+      const unsigned int hbytes = headerBytes(arg_cols.size());
+      std::vector<char> hbuf(hbytes, 0);
+      SLogFileHeader h;
+      memcpy(h.magic_, SCL_LOG_MAGIC, 8);
+      h.header_bytes_ = hbytes; h.n_cols_ = arg_cols.size();
+      h.row_doubles_ = 0; h.reserved_ = 0;
+      for(std::size_t i=0; i<arg_cols.size(); ++i)
+      {
+        if(arg_cols[i].offset_ != h.row_doubles_)
+        { throw(std::runtime_error("Columns aren't packed (offsets don't add up)")); }
+        if(arg_cols[i].name_.length() >= SCL_LOG_MAX_COL_NAME_CHARS || 0 == arg_cols[i].name_.length())
+        { throw(std::runtime_error(std::string("Invalid column name (empty, or too long) : ")+arg_cols[i].name_)); }
+        SLogFileColumn c;
+        memset(&c, 0, sizeof(c));
+        strncpy(c.name_, arg_cols[i].name_.c_str(), SCL_LOG_MAX_COL_NAME_CHARS-1);
+        c.offset_ = arg_cols[i].offset_; c.rows_ = arg_cols[i].rows_; c.cols_ = arg_cols[i].cols_;
+        memcpy(hbuf.data() + sizeof(h) + i*sizeof(c), &c, sizeof(c));
+        h.row_doubles_ += arg_cols[i].size();
+      }
+      memcpy(hbuf.data(), &h, sizeof(h));
+      if(1 != fwrite(hbuf.data(), hbytes, 1, arg_file)) { throw(std::runtime_error("Could not write the header")); }
+      return true;
+    }
+    catch(std::exception& e)
+    { std::cerr<<"\nCLoggerBinary::writeHeader() : "<<e.what(); }
+    return false;
+  }
+
+  sBool CLoggerBinary::readHeader(FILE* arg_file, std::vector<SLogColumn>& ret_cols,
+      sUInt& ret_row_doubles, sUInt& ret_header_bytes)
+  {
+    try
+    {
+      if(S_NULL == arg_file) { throw(std::runtime_error("Passed a NULL file")); }
+      SLogFileHeader h;
+      if(1 != fread(&h, sizeof(h), 1, arg_file)) { throw(std::runtime_error("Could not read the header")); }
+      if(0 != memcmp(h.magic_, SCL_LOG_MAGIC, 8)) { throw(std::runtime_error("Not an scl binary log (or a different version)")); }
+      if(h.header_bytes_ != headerBytes(h.n_cols_)) { throw(std::runtime_error("Corrupt header (size)")); }
+
+      ret_cols.clear();
+      sUInt row_doubles = 0;
+      for(unsigned int i=0; i<h.n_cols_; ++i)
+      {
+        SLogFileColumn c;
+        if(1 != fread(&c, sizeof(c), 1, arg_file)) { throw(std::runtime_error("Could not read the column table")); }
+        c.name_[SCL_LOG_MAX_COL_NAME_CHARS-1] = '\0';
+        SLogColumn col;
+        col.name_ = c.name_; col.offset_ = c.offset_; col.rows_ = c.rows_; col.cols_ = c.cols_;
+        if(col.offset_ != row_doubles) { throw(std::runtime_error("Corrupt header (column offsets)")); }
+        row_doubles += col.size();
+        ret_cols.push_back(col);
+      }
+      if(row_doubles != h.row_doubles_) { throw(std::runtime_error("Corrupt header (row size)")); }
+
+      if(0 != fseek(arg_file, h.header_bytes_, SEEK_SET)) { throw(std::runtime_error("Could not seek to the first row")); }
+      ret_row_doubles = h.row_doubles_;
+      ret_header_bytes = h.header_bytes_;
+      return true;
+    }
+    catch(std::exception& e)
+    { std::cerr<<"\nCLoggerBinary::readHeader() : "<<e.what(); }
+    return false;
+  }
+}
@@ -0,0 +1,192 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CLoggerBinary.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CLOGGERBINARY_HPP_
+#define CLOGGERBINARY_HPP_
+
+#include <scl/DataTypes.hpp>
+
+#include <Eigen/Core>
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <cstdio>
+
+/** The log file's magic string (8 chars; the last two are the version) */
+#define SCL_LOG_MAGIC "SCLLOG01"
+#define SCL_LOG_MAX_COL_NAME_CHARS 48
+
+namespace scl
+{
+  /** A column in a binary log. Each column holds a (rows x cols) block of
+   * doubles per row of the log, stored column-major (like Eigen). */
+  struct SLogColumn
+  {
+    std::string name_;
+    sUInt offset_ = 0;  ///< Offset (in doubles) from the start of a row
+    sUInt rows_ = 0, cols_ = 0;
+    sUInt size() const { return rows_*cols_; }
+  };
+
+  /** Logs fixed-schema rows of doubles to a binary file without slowing
+   * down the thread that logs them.
+   *
+   * The logging thread copies each row into a preallocated ring buffer
+   * (no locks, no allocation, no IO). A background thread writes the
+   * rows to the file in batches. If the writer falls behind and the ring
+   * fills up, rows are dropped (and counted) instead of blocking.
+   *
+   * File format (native byte order, ie. little-endian on x86; append-only):
+   *   Header : char magic[8] = SCL_LOG_MAGIC, uint32 header_bytes,
+   *            uint32 n_cols, uint32 row_doubles, uint32 reserved,
+   *            n_cols x { char name[48], uint32 offset, uint32 rows,
+   *                       uint32 cols, uint32 reserved },
+   *            zero padding up to header_bytes (a multiple of 64).
+   *   Rows   : row_doubles float64s per row, back to back.
+   *
+   * So row i starts at byte header_bytes + i*row_doubles*8. The file can
+   * be memory mapped (eg. as a numpy structured array) while it grows.
+   *
+   * Usage :
+   *   addColumn() x n  -> open() -> { beginRow(), setColumn() x n, endRow() } x ticks -> close()
+   *
+   * NOTE : Only one thread may log rows (beginRow/endRow). */
+  class CLoggerBinary
+  {
+  public:
+    /** Adds a (rows x cols) column. Returns its index (-1 on error).
+     * Only works before open(). */
+    sInt addColumn(const std::string& arg_name, const sUInt arg_rows, const sUInt arg_cols=1);
+
+    /** Opens the log file and starts the writer thread.
+     *
+     * If the file already exists with the same schema, new rows are
+     * appended to it (a partial row left by a crash is trimmed first).
+     * If its schema differs, this fails.
+     *
+     * @param arg_ring_rows The ring buffer's capacity (rows)
+     * @param arg_flush_period How often (sec) the writer thread flushes rows to the file */
+    sBool open(const std::string& arg_file, const sUInt arg_ring_rows=4096,
+        const sFloat arg_flush_period=0.01);
+
+    /** Stops the writer thread after it writes all the pending rows,
+     * and closes the file. */
+    sBool close();
+
+    sBool isOpen() const { return running_; }
+
+    /** Closes the log and clears the columns (to set up a new schema) */
+    void reset() { close(); cols_.clear(); row_doubles_ = 0; ring_.clear(); }
+
+    /** Logging thread : Returns the next row to fill, or NULL if the
+     * ring buffer is full (the row is dropped). Call endRow() when done. */
+    double* beginRow()
+    {
+      const sLongLong h = head_.load(std::memory_order_relaxed);
+      if(h - tail_.load(std::memory_order_acquire) >= static_cast<sLongLong>(ring_rows_))
+      { ctr_dropped_++; return S_NULL; }
+      return &ring_[(h % ring_rows_) * row_doubles_];
+    }
+
+    /** Logging thread : Hands the row filled after beginRow() to the writer */
+    void endRow()
+    { head_.store(head_.load(std::memory_order_relaxed)+1, std::memory_order_release); }
+
+    /** Copies data into a column of a row. Copies at most the column's size
+     * and zero fills the rest (if arg_n is smaller). */
+    void setColumn(double* arg_row, const sInt arg_col, const double* arg_data, const sUInt arg_n) const;
+
+    void setColumn(double* arg_row, const sInt arg_col, const Eigen::VectorXd& arg_v) const
+    { setColumn(arg_row, arg_col, arg_v.data(), static_cast<sUInt>(arg_v.size())); }
+
+    void setColumn(double* arg_row, const sInt arg_col, const Eigen::MatrixXd& arg_m) const
+    { setColumn(arg_row, arg_col, arg_m.data(), static_cast<sUInt>(arg_m.size())); }
+
+    void setColumn(double* arg_row, const sInt arg_col, const double arg_val) const
+    { setColumn(arg_row, arg_col, &arg_val, 1); }
+
+    /** Fills a column with a value (eg. NaN for "not logged this row") */
+    void fillColumn(double* arg_row, const sInt arg_col, const double arg_val) const;
+
+    /** The schema */
+    const std::vector<SLogColumn>& getColumns() const { return cols_; }
+    sUInt getRowDoubles() const { return row_doubles_; }
+
+    /** Counters : Rows logged (handed to the writer), dropped (ring
+     * full) and written to the file */
+    sLongLong getRowsLogged() const { return head_.load(std::memory_order_relaxed); }
+    sLongLong getRowsDropped() const { return ctr_dropped_; }
+    sLongLong getRowsWritten() const { return tail_.load(std::memory_order_relaxed); }
+
+    // ****************************** READING ******************************
+    /** Reads a log file's header. Leaves the file at the first row.
+     * Used by offline tools (see scl_log_convert). */
+    static sBool readHeader(FILE* arg_file, std::vector<SLogColumn>& ret_cols,
+        sUInt& ret_row_doubles, sUInt& ret_header_bytes);
+
+    /** Writes a log file's header for a set of packed columns (each
+     * column's offset is the sum of the previous columns' sizes). Leaves
+     * the file at the first row. Used by offline tools that write whole
+     * logs at once (see CInverseDynamicsBatch). */
+    static sBool writeHeader(FILE* arg_file, const std::vector<SLogColumn>& arg_cols);
+
+    CLoggerBinary() : row_doubles_(0), ring_rows_(0), flush_period_(0.01),
+        file_(S_NULL), running_(false), head_(0), tail_(0), ctr_dropped_(0) {}
+    ~CLoggerBinary() { close(); }
+
+  private:
+    /** The writer thread's loop */
+    void runWriter();
+
+    /** Writes the pending rows. Returns false on an IO error. */
+    sBool writePending();
+
+    std::vector<SLogColumn> cols_;
+    sUInt row_doubles_;
+
+    /** The ring buffer (ring_rows_ rows of row_doubles_) */
+    std::vector<double> ring_;
+    sUInt ring_rows_;
+    sFloat flush_period_;
+
+    FILE* file_;
+    std::thread writer_;
+    std::atomic<sBool> running_;
+
+    /** Rows handed over by the logging thread, and rows written */
+    std::atomic<sLongLong> head_, tail_;
+    sLongLong ctr_dropped_;
+  };
+}
+
+#endif /* CLOGGERBINARY_HPP_ */
@@ -0,0 +1,237 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CLoopScheduler.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "CLoopScheduler.hpp"
+#include "CPerfStats.hpp"
+
+#include <stdexcept>
+#include <iostream>
+#include <string.h>
+#include <errno.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+/** The stack to touch after locking memory. Keep this larger than the
+ * deepest stack the control loop needs. */
+#define SCL_LOOP_STACK_PREFAULT_BYTES (256*1024)
+
+namespace
+{
+  const long long NSEC_PER_SEC = 1000000000LL;
+
+  long long timespecToNs(const timespec& arg_t)
+  { return static_cast<long long>(arg_t.tv_sec)*NSEC_PER_SEC + arg_t.tv_nsec; }
+
+  timespec nsToTimespec(const long long arg_ns)
+  {
+    timespec t;
+    t.tv_sec = static_cast<time_t>(arg_ns / NSEC_PER_SEC);
+    t.tv_nsec = static_cast<long>(arg_ns % NSEC_PER_SEC);
+    return t;
+  }
+
+  long long nowNs()
+  {
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return timespecToNs(t);
+  }
+
+  /** Touches the stack so its pages are mapped (and locked) before the loop runs */
+  void prefaultStack()
+  {
+    unsigned char buf[SCL_LOOP_STACK_PREFAULT_BYTES];
+    memset(buf, 0, sizeof(buf));
+    //Stop the compiler from optimizing the memset away
+    volatile unsigned char* vbuf = buf;
+    vbuf[0] = vbuf[sizeof(buf)-1];
+  }
+}
+
+namespace scl
+{
+  sBool CLoopScheduler::init(const sFloat arg_period, const int arg_rt_priority,
+      const int arg_cpu, const sBool arg_lock_memory)
+  {
+    try
+    {
+      if(0 >= arg_period)
+      { throw(std::runtime_error("Loop period must be positive.")); }
+      if(0 > arg_rt_priority || 99 < arg_rt_priority)
+      { throw(std::runtime_error("Real-time priority must be in [0,99] (0 : don't change).")); }
+
+      period_ns_ = static_cast<sLongLong>(arg_period*1e9);
+      if(0 >= period_ns_)
+      { throw(std::runtime_error("Loop period is less than a nanosecond.")); }
+
+      //These are best effort. A loop without them still runs at the right rate.
+      flag_mem_locked_ = false;
+      if(arg_lock_memory)
+      {
+        if(0 == mlockall(MCL_CURRENT | MCL_FUTURE))
+        { prefaultStack(); flag_mem_locked_ = true; }
+        else
+        { std::cout<<"\nCLoopScheduler::init() : WARNING : Could not lock memory (mlockall). "<<strerror(errno); }
+      }
+
+      flag_cpu_pinned_ = false;
+      if(0 <= arg_cpu)
+      {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(arg_cpu, &cpus);
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if(0 == err) { flag_cpu_pinned_ = true; }
+        else
+        { std::cout<<"\nCLoopScheduler::init() : WARNING : Could not pin thread to cpu "<<arg_cpu<<". "<<strerror(err); }
+      }
+
+      flag_rt_prio_ = false;
+      if(0 < arg_rt_priority)
+      {
+        sched_param sp;
+        memset(&sp, 0, sizeof(sp));
+        sp.sched_priority = arg_rt_priority;
+        int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+        if(0 == err) { flag_rt_prio_ = true; }
+        else
+        { std::cout<<"\nCLoopScheduler::init() : WARNING : Could not set SCHED_FIFO priority "<<arg_rt_priority<<". "<<strerror(err); }
+      }
+
+      ticks_ = 0; overruns_ = 0; ticks_dropped_ = 0;
+      flag_last_tick_overran_ = false;
+      for(size_t i=0; i<phases_.size(); ++i)
+      {
+        phases_[i].last_ns_ = 0; phases_[i].max_ns_ = 0;
+        phases_[i].runs_ = 0; phases_[i].overruns_ = 0;
+        phases_[i].skips_ = 0; phases_[i].skips_in_row_ = 0;
+        if(0 == phases_[i].budget_ns_) { phases_[i].budget_ns_ = period_ns_; }
+      }
+
+      has_been_init_ = true;
+      resync();
+    }
+    catch(std::exception& e)
+    {
+      std::cerr<<"\nCLoopScheduler::init() : "<<e.what();
+      has_been_init_ = false;
+    }
+    return has_been_init_;
+  }
+
+  int CLoopScheduler::addPhase(const std::string& arg_name, const sFloat arg_budget,
+      const sUInt arg_max_skips_in_row)
+  {
+    SLoopPhase ph;
+    ph.name_ = arg_name;
+    ph.budget_ns_ = (0 < arg_budget) ? static_cast<sLongLong>(arg_budget*1e9) : period_ns_;
+    ph.max_skips_in_row_ = arg_max_skips_in_row;
+    ph.perf_id_ = CPerfStats::getId(std::string("loop::")+arg_name);
+    phases_.push_back(ph);
+    return static_cast<int>(phases_.size()) - 1;
+  }
+
+  void CLoopScheduler::startPhase(const int arg_phase)
+  { clock_gettime(CLOCK_MONOTONIC, &(phases_[arg_phase].t_start_)); }
+
+  void CLoopScheduler::endPhase(const int arg_phase)
+  {
+    SLoopPhase& ph = phases_[arg_phase];
+    ph.last_ns_ = nowNs() - timespecToNs(ph.t_start_);
+    if(ph.last_ns_ > ph.max_ns_) { ph.max_ns_ = ph.last_ns_; }
+    if(0 < ph.budget_ns_ && ph.last_ns_ > ph.budget_ns_) { ph.overruns_++; }
+    ph.runs_++;
+    if(CPerfStats::getEnabled()) { CPerfStats::record(ph.perf_id_, ph.last_ns_); }
+  }
+
+  sBool CLoopScheduler::hasTimeFor(const int arg_phase)
+  {
+    if(false == has_been_init_) { return true; }
+
+    SLoopPhase& ph = phases_[arg_phase];
+    if(ph.skips_in_row_ < ph.max_skips_in_row_ &&
+        (flag_last_tick_overran_ || nowNs() + ph.last_ns_ > timespecToNs(t_next_)))
+    { ph.skips_++; ph.skips_in_row_++; return false; }
+    ph.skips_in_row_ = 0;
+    return true;
+  }
+
+  sBool CLoopScheduler::waitForNextTick()
+  {
+    ticks_++;
+    if(false == has_been_init_) { return true; }
+
+    sLongLong t_next = timespecToNs(t_next_);
+    sLongLong t_now = nowNs();
+
+    flag_last_tick_overran_ = (t_now > t_next);
+    if(flag_last_tick_overran_)
+    {//Drop the missed ticks and stay aligned to the period boundaries
+      overruns_++;
+      sLongLong missed = (t_now - t_next) / period_ns_ + 1;
+      ticks_dropped_ += missed - 1;
+      t_next += missed * period_ns_;
+    }
+
+    t_next_ = nsToTimespec(t_next);
+    //Retry if a signal interrupts the sleep. The deadline is absolute so this is safe.
+    while(EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t_next_, NULL)) {}
+
+    t_next_ = nsToTimespec(t_next + period_ns_);
+    return !flag_last_tick_overran_;
+  }
+
+  void CLoopScheduler::resync()
+  {
+    t_next_ = nsToTimespec(nowNs() + period_ns_);
+    flag_last_tick_overran_ = false;
+  }
+
+  void CLoopScheduler::printStats() const
+  {
+    if(has_been_init_)
+    {
+      std::cout<<"\nLoop Period (sec)                     : "<<getPeriod()
+        <<(flag_rt_prio_?" [SCHED_FIFO]":"")<<(flag_cpu_pinned_?" [pinned]":"")<<(flag_mem_locked_?" [mlocked]":"");
+    }
+    else
+    { std::cout<<"\nLoop Period (sec)                     : Free running (no rate control)"; }
+    std::cout<<"\nLoop Ticks (Run / Overran / Dropped)  : "<<ticks_<<" / "<<overruns_<<" / "<<ticks_dropped_;
+    for(size_t i=0; i<phases_.size(); ++i)
+    {
+      const SLoopPhase& ph = phases_[i];
+      std::cout<<"\n  Phase "<<ph.name_<<" : runs "<<ph.runs_<<", over budget "<<ph.overruns_
+          <<", skipped "<<ph.skips_<<", max (usec) "<<static_cast<double>(ph.max_ns_)*1e-3;
+    }
+  }
+}
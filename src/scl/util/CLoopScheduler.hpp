@@ -0,0 +1,178 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CLoopScheduler.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CLOOPSCHEDULER_HPP_
+#define CLOOPSCHEDULER_HPP_
+
+#include <scl/DataTypes.hpp>
+
+#include <string>
+#include <vector>
+#include <time.h>
+
+namespace scl
+{
+  /** Timing statistics for one phase of a loop tick (eg. io, model, servo) */
+  struct SLoopPhase
+  {
+    std::string name_;
+    /** Overrun if a single run takes longer than this. In nsec. */
+    sLongLong budget_ns_;
+    /** Last and worst run durations. In nsec. */
+    sLongLong last_ns_, max_ns_;
+    /** Times the phase ran, ran over budget and was skipped for lack of time */
+    sLongLong runs_, overruns_, skips_;
+    /** hasTimeFor() never skips the phase more than this many ticks in a row.
+     * Stops one slow run from starving the phase forever. */
+    sUInt max_skips_in_row_, skips_in_row_;
+    /** Internal : When the current run started */
+    timespec t_start_;
+    /** The phase's CPerfStats timer ("loop::<name>"), for its percentiles */
+    int perf_id_;
+
+    SLoopPhase() : budget_ns_(0), last_ns_(0), max_ns_(0),
+        runs_(0), overruns_(0), skips_(0), max_skips_in_row_(1), skips_in_row_(0), perf_id_(-1)
+    { t_start_.tv_sec = 0; t_start_.tv_nsec = 0; }
+  };
+
+  /** Runs a loop at a fixed period with absolute deadlines.
+   *
+   * Each tick sleeps till an absolute deadline on CLOCK_MONOTONIC
+   * (clock_nanosleep with TIMER_ABSTIME), so jitter in one tick doesn't
+   * accumulate into the next. Optionally, the calling thread gets
+   * SCHED_FIFO priority, is pinned to a cpu, and locks (and prefaults)
+   * its memory so that page faults don't show up in the loop.
+   *
+   * The loop's work is split into phases with per-phase overrun
+   * counters. When the loop can't keep up, optional phases are skipped
+   * deterministically with hasTimeFor(). Eg. :
+   *
+   *   sched.init(0.001);
+   *   int ph_model = sched.addPhase("model"), ph_servo = sched.addPhase("servo");
+   *   while(running)
+   *   {
+   *     if(sched.hasTimeFor(ph_model))
+   *     { sched.startPhase(ph_model); ctrl.computeDynamics(); sched.endPhase(ph_model); }
+   *     sched.startPhase(ph_servo); ctrl.computeControlForces(); sched.endPhase(ph_servo);
+   *     sched.waitForNextTick();
+   *   }
+   *
+   * Without init(), the scheduler is free running : It never sleeps or
+   * skips, but still times the phases. So a loop can use the same code
+   * with and without rate control.
+   *
+   * NOTE : Use one scheduler per thread. It isn't thread-safe.
+   * NOTE : Real-time priority and memory locking usually need root (or
+   *        CAP_SYS_NICE / CAP_IPC_LOCK). If they fail, init() prints a
+   *        warning and the loop runs with normal scheduling. */
+  class CLoopScheduler
+  {
+  public:
+    /** Sets up the calling thread and starts the clock. The first
+     * deadline is one period from now. */
+    sBool init(
+        /** The loop period. In seconds. */
+        const sFloat arg_period,
+        /** SCHED_FIFO priority (1-99). 0 : Don't change the scheduler. */
+        const int arg_rt_priority=0,
+        /** Pin the thread to this cpu. -1 : Don't pin. */
+        const int arg_cpu=-1,
+        /** Lock all current and future memory and prefault the stack */
+        const sBool arg_lock_memory=false);
+
+    /** Adds a phase and returns its id. */
+    int addPhase(const std::string& arg_name,
+        /** Overrun budget. In seconds. 0 : The whole period. */
+        const sFloat arg_budget=0,
+        /** Optional phases : Max ticks in a row that hasTimeFor() may skip it */
+        const sUInt arg_max_skips_in_row=1);
+
+    /** Call these around a phase's work */
+    void startPhase(const int arg_phase);
+    void endPhase(const int arg_phase);
+
+    /** Deterministic fallback for optional phases.
+     *
+     * Returns false (and counts a skip) if the last tick overran or if
+     * the phase's last run wouldn't fit in the time left before the
+     * deadline. Never skips more than max_skips_in_row_ ticks in a row,
+     * so an overloaded loop runs the phase at a reduced (but fixed) rate.
+     * Required phases (like the servo) shouldn't ask. */
+    sBool hasTimeFor(const int arg_phase);
+
+    /** Sleeps till the next deadline.
+     *
+     * Returns false if this tick overran its deadline. The loop then
+     * drops the missed ticks and resumes at the next period boundary
+     * (so it never runs a burst of back-to-back ticks to catch up). */
+    sBool waitForNextTick();
+
+    /** Restarts the deadlines from now (eg. after a pause) */
+    void resync();
+
+    sLongLong getTicks() const { return ticks_; }
+    sLongLong getOverruns() const { return overruns_; }
+    sLongLong getTicksDropped() const { return ticks_dropped_; }
+    sFloat getPeriod() const { return static_cast<sFloat>(period_ns_)*1e-9; }
+    const std::vector<SLoopPhase>& getPhases() const { return phases_; }
+
+    /** Whether the rt priority, cpu affinity and memory lock requests worked */
+    sBool getFlagRtPriority() const { return flag_rt_prio_; }
+    sBool getFlagCpuPinned() const { return flag_cpu_pinned_; }
+    sBool getFlagMemLocked() const { return flag_mem_locked_; }
+
+    /** Prints the tick and per-phase overrun statistics */
+    void printStats() const;
+
+    sBool hasBeenInit() const { return has_been_init_; }
+
+    CLoopScheduler() : period_ns_(0), ticks_(0), overruns_(0), ticks_dropped_(0),
+      flag_last_tick_overran_(false), flag_rt_prio_(false), flag_cpu_pinned_(false),
+      flag_mem_locked_(false), has_been_init_(false)
+    { t_next_.tv_sec = 0; t_next_.tv_nsec = 0; }
+
+  private:
+    sLongLong period_ns_;
+
+    /** The next absolute deadline (CLOCK_MONOTONIC) */
+    timespec t_next_;
+
+    sLongLong ticks_, overruns_, ticks_dropped_;
+    sBool flag_last_tick_overran_;
+
+    std::vector<SLoopPhase> phases_;
+
+    sBool flag_rt_prio_, flag_cpu_pinned_, flag_mem_locked_;
+    sBool has_been_init_;
+  };
+}
+
+#endif /* CLOOPSCHEDULER_HPP_ */
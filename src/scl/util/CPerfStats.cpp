@@ -0,0 +1,189 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CPerfStats.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include "CPerfStats.hpp"
+
+#include <mutex>
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+  /** A timer and its histograms (one per thread that recorded a sample) */
+  struct SPerfTimer
+  {
+    std::string name_;
+    std::vector<scl::SPerfHistogram*> hists_;
+  };
+
+  /** The timers. Nothing is ever deallocated, so the histograms of threads
+   * that have exited can still be read. */
+  struct SPerfRegistry
+  {
+    std::mutex mutex_;
+    std::vector<SPerfTimer*> timers_;
+  };
+
+  SPerfRegistry& registry()
+  { static SPerfRegistry r; return r; }
+
+  /** The calling thread's histograms, indexed by timer id */
+  thread_local std::vector<scl::SPerfHistogram*> tl_hists;
+}
+
+namespace scl
+{
+  std::atomic<sBool> CPerfStats::enabled_(true);
+
+  void SPerfHistogram::clear()
+  {
+    for(int i=0; i<SCL_PERF_HIST_BUCKETS; ++i)
+    { counts_[i].store(0, std::memory_order_relaxed); }
+    n_.store(0, std::memory_order_relaxed);
+    sum_ns_.store(0, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+    reset_requested_.store(false, std::memory_order_release);
+  }
+
+  int CPerfStats::getId(const std::string& arg_name)
+  {
+    SPerfRegistry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex_);
+    for(std::size_t i=0; i<r.timers_.size(); ++i)
+    { if(r.timers_[i]->name_ == arg_name) { return static_cast<int>(i); } }
+    SPerfTimer* t = new SPerfTimer();
+    t->name_ = arg_name;
+    r.timers_.push_back(t);
+    return static_cast<int>(r.timers_.size()) - 1;
+  }
+
+  std::string CPerfStats::getName(const int arg_id)
+  {
+    SPerfRegistry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex_);
+    if(0 > arg_id || static_cast<std::size_t>(arg_id) >= r.timers_.size()) { return ""; }
+    return r.timers_[arg_id]->name_;
+  }
+
+  void CPerfStats::record(const int arg_id, const sLongLong arg_ns)
+  {
+    if(0 > arg_id) { return; }
+    const std::size_t id = static_cast<std::size_t>(arg_id);
+    if(id >= tl_hists.size() || S_NULL == tl_hists[id])
+    {//This thread's first sample for the timer. Allocate its histogram.
+      SPerfRegistry& r = registry();
+      std::lock_guard<std::mutex> lock(r.mutex_);
+      if(id >= r.timers_.size()) { return; }
+      SPerfHistogram* h = new SPerfHistogram();
+      r.timers_[id]->hists_.push_back(h);
+      if(id >= tl_hists.size()) { tl_hists.resize(id+1, S_NULL); }
+      tl_hists[id] = h;
+    }
+    tl_hists[id]->record(arg_ns);
+  }
+
+  void CPerfStats::getSummaries(std::vector<SPerfSummary>& ret_summaries)
+  {
+    ret_summaries.clear();
+    std::vector<sLongLong> counts(SCL_PERF_HIST_BUCKETS);
+
+    SPerfRegistry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex_);
+    for(std::size_t i=0; i<r.timers_.size(); ++i)
+    {
+      //Merge the threads' histograms
+      SPerfSummary s;
+      s.name_ = r.timers_[i]->name_;
+      sLongLong sum = 0;
+      std::fill(counts.begin(), counts.end(), 0);
+      for(std::size_t j=0; j<r.timers_[i]->hists_.size(); ++j)
+      {
+        const SPerfHistogram& h = *(r.timers_[i]->hists_[j]);
+        if(h.reset_requested_.load(std::memory_order_acquire)) { continue; }
+        for(int b=0; b<SCL_PERF_HIST_BUCKETS; ++b)
+        { counts[b] += h.counts_[b].load(std::memory_order_relaxed); }
+        sum += h.sum_ns_.load(std::memory_order_relaxed);
+        const sLongLong mx = h.max_ns_.load(std::memory_order_relaxed);
+        if(mx > s.max_ns_) { s.max_ns_ = mx; }
+      }
+      for(int b=0; b<SCL_PERF_HIST_BUCKETS; ++b) { s.n_ += counts[b]; }
+      if(0 == s.n_) { continue; }
+      s.mean_ns_ = static_cast<sFloat>(sum)/s.n_;
+
+      //Walk up the buckets till each percentile's rank. Report the bucket's
+      //upper bound (but never more than the max seen).
+      const sLongLong rank50 = (s.n_*50 + 99)/100, rank99 = (s.n_*99 + 99)/100,
+          rank999 = (s.n_*999 + 999)/1000;
+      sLongLong cum = 0;
+      sBool f50 = false, f99 = false;
+      for(int b=0; b<SCL_PERF_HIST_BUCKETS; ++b)
+      {
+        if(0 == counts[b]) { continue; }
+        cum += counts[b];
+        sLongLong v = SPerfHistogram::bucketMax(b);
+        if(v > s.max_ns_) { v = s.max_ns_; }
+        if(!f50 && cum >= rank50) { s.p50_ns_ = v; f50 = true; }
+        if(!f99 && cum >= rank99) { s.p99_ns_ = v; f99 = true; }
+        if(cum >= rank999) { s.p999_ns_ = v; break; }
+      }
+      ret_summaries.push_back(s);
+    }
+  }
+
+  void CPerfStats::print(std::ostream& arg_os)
+  {
+    std::vector<SPerfSummary> s;
+    getSummaries(s);
+    if(0 == s.size())
+    { arg_os<<"\nNo timing samples"<<(getEnabled() ? "" : " (timing is off)"); return; }
+
+    char buf[256];
+    snprintf(buf, sizeof(buf), "\n%-36s %12s %10s %10s %10s %10s %10s",
+        "timer (usec)", "n", "mean", "p50", "p99", "p99.9", "max");
+    arg_os<<buf;
+    for(std::size_t i=0; i<s.size(); ++i)
+    {
+      snprintf(buf, sizeof(buf), "\n%-36s %12lld %10.2f %10.2f %10.2f %10.2f %10.2f",
+          s[i].name_.c_str(), s[i].n_, s[i].mean_ns_*1e-3, s[i].p50_ns_*1e-3,
+          s[i].p99_ns_*1e-3, s[i].p999_ns_*1e-3, s[i].max_ns_*1e-3);
+      arg_os<<buf;
+    }
+  }
+
+  void CPerfStats::reset()
+  {
+    SPerfRegistry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex_);
+    for(std::size_t i=0; i<r.timers_.size(); ++i)
+      for(std::size_t j=0; j<r.timers_[i]->hists_.size(); ++j)
+      { r.timers_[i]->hists_[j]->reset_requested_.store(true, std::memory_order_release); }
+  }
+}
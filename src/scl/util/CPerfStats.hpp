@@ -0,0 +1,194 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CPerfStats.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CPERFSTATS_HPP_
+#define CPERFSTATS_HPP_
+
+#include <scl/DataTypes.hpp>
+#include <scl/util/CAllocTracker.hpp>
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <ostream>
+#include <time.h>
+
+/** Histogram resolution : 2^SUB_BITS buckets per power of two (ie. ~6% error) */
+#define SCL_PERF_HIST_SUB_BITS 4
+/** Histogram range : [0, 2^MAX_BITS) nsec (~18 minutes). Larger values are clamped. */
+#define SCL_PERF_HIST_MAX_BITS 40
+#define SCL_PERF_HIST_BUCKETS ((SCL_PERF_HIST_MAX_BITS - SCL_PERF_HIST_SUB_BITS + 1) << SCL_PERF_HIST_SUB_BITS)
+
+namespace scl
+{
+  /** A log-linear (HDR-style) histogram of durations in nsec.
+   *
+   * Written by one thread (lock-free : plain relaxed stores), and read
+   * by any thread. Each (timer, thread) pair gets its own histogram, so
+   * threads never contend on a cache line. */
+  struct SPerfHistogram
+  {
+    std::atomic<sLongLong> counts_[SCL_PERF_HIST_BUCKETS];
+    std::atomic<sLongLong> n_, sum_ns_, max_ns_;
+    /** Set by reset() (any thread). The owning thread clears the histogram. */
+    std::atomic<sBool> reset_requested_;
+
+    /** Owning thread : Adds a sample */
+    void record(sLongLong arg_ns)
+    {
+      if(reset_requested_.load(std::memory_order_relaxed)) { clear(); }
+      if(0 > arg_ns) { arg_ns = 0; }
+      const int b = bucket(arg_ns);
+      counts_[b].store(counts_[b].load(std::memory_order_relaxed)+1, std::memory_order_relaxed);
+      n_.store(n_.load(std::memory_order_relaxed)+1, std::memory_order_relaxed);
+      sum_ns_.store(sum_ns_.load(std::memory_order_relaxed)+arg_ns, std::memory_order_relaxed);
+      if(arg_ns > max_ns_.load(std::memory_order_relaxed)) { max_ns_.store(arg_ns, std::memory_order_relaxed); }
+    }
+
+    /** Owning thread : Zeros the histogram */
+    void clear();
+
+    /** The bucket for a duration */
+    static int bucket(sLongLong arg_ns)
+    {
+      const sLongLong sub = 1LL << SCL_PERF_HIST_SUB_BITS;
+      if(arg_ns < sub) { return static_cast<int>(arg_ns); }
+      if(arg_ns >= (1LL << SCL_PERF_HIST_MAX_BITS)) { arg_ns = (1LL << SCL_PERF_HIST_MAX_BITS) - 1; }
+      const int shift = (63 - __builtin_clzll(static_cast<unsigned long long>(arg_ns))) - SCL_PERF_HIST_SUB_BITS;
+      return ((shift+1) << SCL_PERF_HIST_SUB_BITS) + static_cast<int>((arg_ns >> shift) - sub);
+    }
+
+    /** The largest duration that falls in a bucket */
+    static sLongLong bucketMax(const int arg_b)
+    {
+      const int sub = 1 << SCL_PERF_HIST_SUB_BITS;
+      if(arg_b < sub) { return arg_b; }
+      const int shift = (arg_b >> SCL_PERF_HIST_SUB_BITS) - 1;
+      return ((static_cast<sLongLong>(sub + (arg_b & (sub-1))) + 1) << shift) - 1;
+    }
+
+    SPerfHistogram() : n_(0), sum_ns_(0), max_ns_(0), reset_requested_(false)
+    { for(int i=0; i<SCL_PERF_HIST_BUCKETS; ++i) { counts_[i] = 0; } }
+  };
+
+  /** Percentiles for one timer (merged across threads). In nsec. */
+  struct SPerfSummary
+  {
+    std::string name_;
+    sLongLong n_ = 0;
+    sFloat mean_ns_ = 0;
+    sLongLong p50_ns_ = 0, p99_ns_ = 0, p999_ns_ = 0, max_ns_ = 0;
+  };
+
+  /** Named timers with per-thread histograms.
+   *
+   * Time a block with SCL_PERF_SCOPE("name") (or a CPerfScope with an id
+   * from getId()). Query the percentiles from any thread with
+   * getSummaries(). The shell's "perf" command prints them, and the redis
+   * apps publish them to "scl::perf::<name>" (see CIORedis::setPerfStats).
+   *
+   * The hot path is two clock_gettime calls and a few relaxed stores.
+   * A thread's first sample for a timer allocates its histogram (once).
+   *
+   * Compile with -DSCL_PERF_OFF to remove the scoped timers. */
+  class CPerfStats
+  {
+  public:
+    /** Returns the id for a timer name (registers it the first time).
+     * Takes a lock. Don't call it in a loop; cache the id. */
+    static int getId(const std::string& arg_name);
+
+    /** Returns a timer's name ("" for an unknown id). Takes a lock. */
+    static std::string getName(const int arg_id);
+
+    /** Adds a sample to the calling thread's histogram for a timer */
+    static void record(const int arg_id, const sLongLong arg_ns);
+
+    /** Merges each timer's per-thread histograms and computes the percentiles.
+     * Skips timers with no samples. */
+    static void getSummaries(std::vector<SPerfSummary>& ret_summaries);
+
+    /** Prints a table of the summaries (in usec) */
+    static void print(std::ostream& arg_os);
+
+    /** Clears all the histograms. Each thread clears its own on its next
+     * sample, so (till then) its old samples are hidden. */
+    static void reset();
+
+    /** Turns all timing on or off at runtime (on by default) */
+    static void setEnabled(const sBool arg_flag) { enabled_.store(arg_flag, std::memory_order_relaxed); }
+    static sBool getEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    static sLongLong nowNs()
+    {
+      timespec t;
+      clock_gettime(CLOCK_MONOTONIC, &t);
+      return static_cast<sLongLong>(t.tv_sec)*1000000000LL + t.tv_nsec;
+    }
+
+  private:
+    static std::atomic<sBool> enabled_;
+  };
+
+  /** Times its own lifetime into a timer. Also makes the timer the
+   * thread's allocation phase (see CAllocTracker) till it exits. */
+  class CPerfScope
+  {
+  public:
+    explicit CPerfScope(const int arg_id) : id_(arg_id),
+      phase_prev_(CAllocTracker::setPhase(arg_id)),
+      t_start_ns_(CPerfStats::getEnabled() ? CPerfStats::nowNs() : -1) {}
+    ~CPerfScope()
+    {
+      if(0 <= t_start_ns_) { CPerfStats::record(id_, CPerfStats::nowNs() - t_start_ns_); }
+      CAllocTracker::setPhase(phase_prev_);
+    }
+  private:
+    const int id_;
+    const int phase_prev_;
+    const sLongLong t_start_ns_;
+  };
+}
+
+#define SCL_PERF_CAT_(a,b) a##b
+#define SCL_PERF_CAT(a,b) SCL_PERF_CAT_(a,b)
+
+#ifndef SCL_PERF_OFF
+/** Times the rest of the enclosing block into the timer "arg_name".
+ * The name is registered once per call site (thread-safe static init). */
+#define SCL_PERF_SCOPE(arg_name) \
+  static const int SCL_PERF_CAT(scl_perf_id_,__LINE__) = scl::CPerfStats::getId(arg_name); \
+  scl::CPerfScope SCL_PERF_CAT(scl_perf_scope_,__LINE__)(SCL_PERF_CAT(scl_perf_id_,__LINE__))
+#else
+#define SCL_PERF_SCOPE(arg_name)
+#endif
+
+#endif /* CPERFSTATS_HPP_ */
@@ -0,0 +1,136 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CSeqLock.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CSEQLOCK_HPP_
+#define CSEQLOCK_HPP_
+
+#include <atomic>
+
+namespace scl
+{
+  /** A double-buffered sequence lock (seqlock) with one writer and any
+   * number of readers.
+   *
+   * The writer fills the buffer that isn't currently published, bumping
+   * that buffer's sequence counter to odd while it writes and back to even
+   * once it is done, and then publishes the buffer's index. Readers copy
+   * the published buffer and retry if its counter changed during the copy.
+   *
+   * The writer never waits on a reader. Since it alternates buffers, a
+   * reader only has to retry if it is still copying when the writer comes
+   * back around to the same buffer (ie. a full publish period later).
+   *
+   * NOTE : Exactly one thread may call the writer functions.
+   *
+   * NOTE : Readers copy with plain assignment, so T's assignment must not
+   *        allocate or follow pointers into the buffer (fixed size Eigen
+   *        and std::vector members are fine once all the buffers and the
+   *        reader's copy have been sized). */
+  template <typename T>
+  class CSeqLock
+  {
+  public:
+    /** Writer : Returns the (unpublished) buffer to fill. Call
+     * endWrite() when done. */
+    T* beginWrite()
+    {
+      idx_write_ = 1 - idx_pub_.load(std::memory_order_relaxed);
+      seq_[idx_write_].fetch_add(1, std::memory_order_relaxed);//Odd : Being written
+      std::atomic_thread_fence(std::memory_order_release);
+      return &buf_[idx_write_];
+    }
+
+    /** Writer : Marks the buffer consistent and publishes it */
+    void endWrite()
+    {
+      seq_[idx_write_].fetch_add(1, std::memory_order_release);//Even : Consistent
+      idx_pub_.store(idx_write_, std::memory_order_release);
+      ctr_published_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Reader : Copies the latest consistent buffer into ret_data.
+     * Never blocks. Returns false (leaving ret_data in an unspecified
+     * state) if the writer kept overwriting the buffer for
+     * arg_max_tries attempts, or if nothing has been published yet. */
+    bool read(T& ret_data, const unsigned int arg_max_tries = 8) const
+    {
+      for(unsigned int i=0; i<arg_max_tries; ++i)
+      {
+        const int idx = idx_pub_.load(std::memory_order_acquire);
+        const unsigned long s0 = seq_[idx].load(std::memory_order_acquire);
+        if(s0 & 1) { continue; }//The writer lapped us. Retry.
+        ret_data = buf_[idx];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(s0 == seq_[idx].load(std::memory_order_relaxed))
+        { return 0 < s0; }
+      }
+      return false;
+    }
+
+    /** Number of buffers the writer has published */
+    unsigned long getPublishCount() const
+    { return ctr_published_.load(std::memory_order_relaxed); }
+
+    /** Direct access to the raw buffers. Only use this to initialize
+     * (size) the buffers before the reader and writer threads start. */
+    T& getBuffer(const unsigned int arg_i) { return buf_[arg_i]; }
+
+    /** Number of buffers (for initialization loops) */
+    static unsigned int size() { return 2; }
+
+    /** Forgets any published data. Only call this while neither
+     * the readers nor the writer are running. */
+    void reset()
+    {
+      idx_write_ = 1; idx_pub_.store(0, std::memory_order_release);
+      seq_[0].store(0); seq_[1].store(0); ctr_published_.store(0);
+    }
+
+    CSeqLock() : idx_write_(1), idx_pub_(0), ctr_published_(0)
+    { seq_[0].store(0); seq_[1].store(0); }
+
+  private:
+    T buf_[2];
+
+    /** Per-buffer sequence counters. Odd while the writer is in the buffer. */
+    std::atomic<unsigned long> seq_[2];
+
+    /** Owned by the writer */
+    int idx_write_;
+
+    /** The index of the most recently published buffer */
+    std::atomic<int> idx_pub_;
+
+    std::atomic<unsigned long> ctr_published_;
+  };
+}
+
+#endif /* CSEQLOCK_HPP_ */
@@ -0,0 +1,117 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CSpscQueue.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CSPSCQUEUE_HPP_
+#define CSPSCQUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+namespace scl
+{
+  /** A lock-free single-producer single-consumer ring buffer.
+   *
+   * The producer fills a slot in place and commits it. The consumer
+   * reads the oldest slot in place and releases it. Neither side ever
+   * blocks : A full queue rejects the push and an empty queue returns
+   * NULL. Slots are reused, so a consumer that reads in place never
+   * allocates (the slots' storage is allocated by the producer).
+   *
+   * NOTE : Exactly one thread may call the producer functions and
+   *        exactly one thread may call the consumer functions.
+   * NOTE : N must be a power of two. The queue holds up to N-1 items. */
+  template <typename T, unsigned int N>
+  class CSpscQueue
+  {
+  public:
+    /** Producer : The next free slot (NULL if the queue is full).
+     * Fill it and then call commitWrite(). */
+    T* getWriteSlot()
+    {
+      const unsigned int w = idx_write_.load(std::memory_order_relaxed);
+      if(((w+1) & MASK) == idx_read_.load(std::memory_order_acquire))
+      { return NULL; }
+      return &buf_[w];
+    }
+
+    /** Producer : Hands the slot from getWriteSlot() to the consumer */
+    void commitWrite()
+    {
+      const unsigned int w = idx_write_.load(std::memory_order_relaxed);
+      idx_write_.store((w+1) & MASK, std::memory_order_release);
+    }
+
+    /** Producer : Copies an item in. Returns false if the queue is full. */
+    bool push(const T& arg_item)
+    {
+      T* slot = getWriteSlot();
+      if(NULL == slot) { return false; }
+      *slot = arg_item;
+      commitWrite();
+      return true;
+    }
+
+    /** Consumer : The oldest item (NULL if the queue is empty) */
+    T* front()
+    {
+      const unsigned int r = idx_read_.load(std::memory_order_relaxed);
+      if(r == idx_write_.load(std::memory_order_acquire))
+      { return NULL; }
+      return &buf_[r];
+    }
+
+    /** Consumer : Releases the item from front() back to the producer */
+    void pop()
+    {
+      const unsigned int r = idx_read_.load(std::memory_order_relaxed);
+      idx_read_.store((r+1) & MASK, std::memory_order_release);
+    }
+
+    /** Either side : Approximate (the other side may be running) */
+    bool empty() const
+    { return idx_read_.load(std::memory_order_acquire) == idx_write_.load(std::memory_order_acquire); }
+
+    static unsigned int capacity() { return N-1; }
+
+    CSpscQueue() : idx_write_(0), idx_read_(0) {}
+
+  private:
+    static_assert(N >= 2 && 0 == (N & (N-1)), "CSpscQueue size must be a power of two");
+    static const unsigned int MASK = N-1;
+
+    T buf_[N];
+
+    /** Written only by the producer and the consumer respectively */
+    std::atomic<unsigned int> idx_write_, idx_read_;
+  };
+}
+
+#endif /* CSPSCQUEUE_HPP_ */
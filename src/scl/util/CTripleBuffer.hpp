@@ -0,0 +1,107 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CTripleBuffer.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CTRIPLEBUFFER_HPP_
+#define CTRIPLEBUFFER_HPP_
+
+#include <atomic>
+
+namespace scl
+{
+  /** A lock-free single-producer single-consumer triple buffer.
+   *
+   * The writer fills its private buffer and publishes it with one
+   * atomic exchange. The reader picks up the latest published buffer
+   * with another exchange. Neither side ever waits for the other, and
+   * the reader always gets the most recent complete buffer (older
+   * un-read buffers are silently overwritten).
+   *
+   * Typical use : A model thread publishes dynamic models that a
+   * servo thread picks up at its own (higher) rate.
+   *
+   * NOTE : Exactly one thread may call the writer functions and
+   *        exactly one thread may call the reader functions. */
+  template <typename T>
+  class CTripleBuffer
+  {
+  public:
+    /** Writer : The buffer to fill before calling publish() */
+    T* getWriteBuffer() { return &buf_[idx_write_]; }
+
+    /** Writer : Publishes the write buffer and grabs a free one */
+    void publish()
+    { idx_write_ = state_.exchange(idx_write_ | FLAG_FRESH, std::memory_order_acq_rel) & MASK_IDX; }
+
+    /** Reader : True if a buffer was published after the last consume() */
+    bool hasFresh() const
+    { return 0 != (state_.load(std::memory_order_acquire) & FLAG_FRESH); }
+
+    /** Reader : Swaps in the latest published buffer (if any).
+     * Returns true if the read buffer changed. */
+    bool consume()
+    {
+      if(false == hasFresh()) { return false; }
+      idx_read_ = state_.exchange(idx_read_, std::memory_order_acq_rel) & MASK_IDX;
+      return true;
+    }
+
+    /** Reader : The most recently consumed buffer */
+    T* getReadBuffer() { return &buf_[idx_read_]; }
+
+    /** Direct access to the raw buffers. Only use this to initialize
+     * the buffers before the reader and writer threads start. */
+    T& getBuffer(const unsigned int arg_i) { return buf_[arg_i]; }
+
+    /** Number of buffers (for initialization loops) */
+    static unsigned int size() { return 3; }
+
+    /** Forgets any published data. Only call this while neither
+     * the reader nor the writer are running. */
+    void reset()
+    { idx_write_ = 0; idx_read_ = 1; state_.store(2, std::memory_order_release); }
+
+    CTripleBuffer() : idx_write_(0), idx_read_(1), state_(2) {}
+
+  private:
+    static const int FLAG_FRESH = 0x4;
+    static const int MASK_IDX = 0x3;
+
+    T buf_[3];
+
+    /** Owned by the writer and the reader respectively */
+    int idx_write_, idx_read_;
+
+    /** The index of the shared (middle) buffer + the fresh flag */
+    std::atomic<int> state_;
+  };
+}
+
+#endif /* CTRIPLEBUFFER_HPP_ */
@@ -35,6 +35,7 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 #include <iostream>
 #include <string>
 #include <vector>
+#include <stdlib.h>
 
 namespace scl
 {
@@ -98,6 +99,53 @@ namespace scl
         {
           ret_cmd_ds.flag_muscles_ = true;
         }
+        else if (std::string(argv[args_ctr]) == "-rate")
+        {
+          if(args_ctr+1 >= argc) {  throw(std::runtime_error("Specified -rate but did not specify the loop rate (Hz)"));  }
+          ret_cmd_ds.loop_rate_hz_ = atof(argv[args_ctr+1]);
+          if(0 > ret_cmd_ds.loop_rate_hz_) {  throw(std::runtime_error("Specified a negative -rate"));  }
+          args_ctr++;
+        }
+        else if (std::string(argv[args_ctr]) == "-rtprio")
+        {
+          if(args_ctr+1 >= argc) {  throw(std::runtime_error("Specified -rtprio but did not specify the priority"));  }
+          ret_cmd_ds.loop_rt_priority_ = atoi(argv[args_ctr+1]);
+          args_ctr++;
+        }
+        else if (std::string(argv[args_ctr]) == "-cpu")
+        {
+          if(args_ctr+1 >= argc) {  throw(std::runtime_error("Specified -cpu but did not specify the cpu"));  }
+          ret_cmd_ds.loop_cpu_ = atoi(argv[args_ctr+1]);
+          args_ctr++;
+        }
+        else if (std::string(argv[args_ctr]) == "-mlock")
+        {
+          ret_cmd_ds.flag_loop_mlock_ = true;
+        }
+        else if (std::string(argv[args_ctr]) == "-shm")
+        {
+          ret_cmd_ds.flag_io_shm_ = true;
+        }
+        else if (std::string(argv[args_ctr]) == "-shmname")
+        {//Implies -shm
+          if(args_ctr+1 >= argc) {  throw(std::runtime_error("Specified -shmname but did not specify the shared memory name"));  }
+          if('/' != argv[args_ctr+1][0]) {  throw(std::runtime_error("The -shmname shared memory name must start with a '/'"));  }
+          ret_cmd_ds.flag_io_shm_ = true;
+          ret_cmd_ds.name_io_shm_ = argv[args_ctr+1];
+          args_ctr++;
+        }
+        else if (std::string(argv[args_ctr]) == "-sub")
+        {
+          ret_cmd_ds.flag_io_redis_sub_ = true;
+        }
+        else if (std::string(argv[args_ctr]) == "-predict")
+        {
+          if(args_ctr+1 >= argc) {  throw(std::runtime_error("Specified -predict but did not specify the lookahead (sec)"));  }
+          ret_cmd_ds.flag_predict_ = true;
+          ret_cmd_ds.predict_lookahead_ = atof(argv[args_ctr+1]);
+          if(0 > ret_cmd_ds.predict_lookahead_) {  throw(std::runtime_error("Specified a negative -predict lookahead"));  }
+          args_ctr++;
+        }
         else if (std::string(argv[args_ctr]) == "-actuatorset" || std::string(argv[args_ctr]) == "-aset" )
         {
           ret_cmd_ds.name_actuator_set_ = argv[args_ctr+1];
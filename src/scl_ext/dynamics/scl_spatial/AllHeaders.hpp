@@ -36,4 +36,6 @@ scl. If not, see <http://www.gnu.org/licenses/>.
 
 #include <scl_ext/dynamics/scl_spatial/CDynamicsSclSpatialMath.hpp>
 
+#include <scl_ext/dynamics/scl_spatial/CInverseDynamicsBatch.hpp>
+
 #endif /* SRC_SCL_EXT_DYNAMICS_SCL_SPATIAL_ALLHEADERS_HPP_ */
@@ -0,0 +1,426 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CInverseDynamicsBatch.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#include <scl_ext/dynamics/scl_spatial/CInverseDynamicsBatch.hpp>
+#include <scl_ext/dynamics/scl_spatial/CDynamicsSclSpatialMath.hpp>
+
+#include <scl/util/CLoggerBinary.hpp>
+
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace scl_ext
+{
+  namespace
+  {
+    /** Samples per parallel work item */
+    const scl::sLongLong SCL_ID_BATCH_GRAIN = 256;
+
+    double secondsSince(const std::chrono::steady_clock::time_point& arg_t)
+    { return std::chrono::duration<double>(std::chrono::steady_clock::now() - arg_t).count(); }
+
+    /** Finds a (arg_size x 1) column by name. Returns its offset (-1 if missing). */
+    scl::sInt findColumn(const std::vector<scl::SLogColumn>& arg_cols,
+        const std::string& arg_name, const scl::sUInt arg_size)
+    {
+      for(std::size_t i=0; i<arg_cols.size(); ++i)
+      {
+        if(arg_cols[i].name_ == arg_name && arg_cols[i].size() == arg_size)
+        { return static_cast<scl::sInt>(arg_cols[i].offset_); }
+      }
+      return -1;
+    }
+  }
+
+  scl::sBool CInverseDynamicsBatch::init(const scl::SRobotParsed& arg_robot,
+      const scl::sUInt arg_threads)
+  {
+    try
+    {
+      has_been_init_ = false;
+      links_.clear(); ws_.clear();
+
+      if(false == arg_robot.has_been_init_)
+      { throw(std::runtime_error("Passed an uninitialized robot.")); }
+      if(0 >= arg_robot.dof_)
+      { throw(std::runtime_error("Can not compute dynamics for a robot with 0 dof.")); }
+
+      // 1. Sort the links by depth so parents come before their children.
+      std::vector<std::pair<scl::sUInt, const scl::SRigidBody*> > order;
+      sutil::CMappedTree<std::string, scl::SRigidBody>::const_iterator it, ite;
+      for(it = arg_robot.rb_tree_.begin(), ite = arg_robot.rb_tree_.end(); it!=ite; ++it)
+      {
+        if(it->is_root_) { continue; }
+        if(0 > it->link_id_ || static_cast<scl::sUInt>(it->link_id_) >= arg_robot.dof_)
+        { throw(std::runtime_error(std::string("Link has an invalid id : ")+it->name_)); }
+        scl::sUInt depth = 0;
+        for(const scl::SRigidBody* p = it->parent_addr_; S_NULL != p && false == p->is_root_; p = p->parent_addr_)
+        { ++depth; }
+        order.push_back(std::make_pair(depth, &(*it)));
+      }
+      if(order.size() != arg_robot.dof_)
+      { throw(std::runtime_error("The robot's tree doesn't have one link per dof.")); }
+      std::stable_sort(order.begin(), order.end(),
+          [](const std::pair<scl::sUInt, const scl::SRigidBody*>& a,
+              const std::pair<scl::sUInt, const scl::SRigidBody*>& b)
+          { return a.first < b.first; });
+
+      // 2. Flatten them (uses the same transforms and inertias as CDynamicsSclSpatial)
+      Eigen::MatrixXd Xrot(6,6);
+      links_.resize(order.size());
+      for(std::size_t i=0; i<order.size(); ++i)
+      {
+        const scl::SRigidBody& lnk = *(order[i].second);
+        SIdLink& l = links_[i];
+        l.gc_ = static_cast<scl::sUInt>(lnk.link_id_);
+
+        l.parent_ = -1;
+        if(S_NULL == lnk.parent_addr_)
+        { throw(std::runtime_error(std::string("Link has no parent : ")+lnk.name_)); }
+        if(false == lnk.parent_addr_->is_root_)
+        {
+          for(std::size_t j=0; j<i; ++j)
+          { if(order[j].second == lnk.parent_addr_) { l.parent_ = static_cast<scl::sInt>(j); break; } }
+          if(0 > l.parent_)
+          { throw(std::runtime_error(std::string("Could not find the parent of : ")+lnk.name_)); }
+        }
+
+        switch(lnk.joint_type_)
+        {
+          case scl::JOINT_TYPE_PRISMATIC_X: l.revolute_ = false; l.axis_ = 0; break;
+          case scl::JOINT_TYPE_PRISMATIC_Y: l.revolute_ = false; l.axis_ = 1; break;
+          case scl::JOINT_TYPE_PRISMATIC_Z: l.revolute_ = false; l.axis_ = 2; break;
+          case scl::JOINT_TYPE_REVOLUTE_X: l.revolute_ = true; l.axis_ = 0; break;
+          case scl::JOINT_TYPE_REVOLUTE_Y: l.revolute_ = true; l.axis_ = 1; break;
+          case scl::JOINT_TYPE_REVOLUTE_Z: l.revolute_ = true; l.axis_ = 2; break;
+          default:
+            throw(std::runtime_error(std::string("Unsupported joint type (only 1-dof prismatic/revolute) : ")+lnk.name_));
+        }
+
+        computeRotFromQuaternion(Xrot, lnk.ori_parent_quat_);
+        l.E_ = Xrot.block(0,0,3,3);
+        l.r_ = lnk.pos_in_parent_;
+        calculateSpatialInertia(l.I_, lnk.inertia_, lnk.com_, lnk.mass_);
+      }
+      gravity_ = arg_robot.gravity_;
+
+      // 3. The workspaces
+      scl::sUInt n_threads = arg_threads;
+#ifdef _OPENMP
+      if(0 == n_threads) { n_threads = static_cast<scl::sUInt>(omp_get_max_threads()); }
+#endif
+      if(0 == n_threads) { n_threads = 1; }
+
+      const scl::sUInt n = static_cast<scl::sUInt>(links_.size());
+      ws_.resize(n_threads);
+      for(scl::sUInt i=0; i<n_threads; ++i)
+      {
+        ws_[i].E_.resize(n);
+        ws_[i].r_.setZero(3,n);
+        ws_[i].v_.setZero(6,n);
+        ws_[i].a_.setZero(6,n);
+        ws_[i].f_.setZero(6,n);
+      }
+
+      has_been_init_ = true;
+    }
+    catch(std::exception& e)
+    { std::cerr<<"\nCInverseDynamicsBatch::init() : "<<e.what(); }
+    return has_been_init_;
+  }
+
+  void CInverseDynamicsBatch::rnea(SIdWorkspace& arg_ws, const double* arg_q,
+      const double* arg_dq, const double* arg_ddq, double* ret_fgc) const
+  {
+    typedef Eigen::Matrix<scl::sFloat,6,1> sVec6;
+    const std::size_t n = links_.size();
+
+    // Forward pass : Link velocities, accelerations and forces.
+    // The spatial vectors are [angular; linear], in link coordinates.
+    for(std::size_t i=0; i<n; ++i)
+    {
+      const SIdLink& l = links_[i];
+      const double q = arg_q[l.gc_], dq = arg_dq[l.gc_], ddq = arg_ddq[l.gc_];
+      Eigen::Matrix3d& E = arg_ws.E_[i];
+      const scl::sUInt k = l.axis_, k1 = (k+1)%3, k2 = (k+2)%3;
+
+      // Xup = XJ * Xtree = rot(E) * xlt(r)
+      if(l.revolute_)
+      {
+        const double c = std::cos(q), s = std::sin(q);
+        E.row(k) = l.E_.row(k);
+        E.row(k1) = c*l.E_.row(k1) + s*l.E_.row(k2);
+        E.row(k2) = c*l.E_.row(k2) - s*l.E_.row(k1);
+        arg_ws.r_.col(i) = l.r_;
+      }
+      else
+      {
+        E = l.E_;
+        arg_ws.r_.col(i) = l.r_ + q*l.E_.row(k).transpose();
+      }
+      const Eigen::Vector3d r = arg_ws.r_.col(i);
+
+      // v = Xup v_parent + S dq ; a = Xup a_parent + S ddq + v x (S dq)
+      sVec6 v, a;
+      if(0 > l.parent_)
+      {// The root doesn't move. Its "acceleration" is gravity.
+        v.setZero();
+        a.head<3>().setZero();
+        a.tail<3>() = -(E*gravity_);
+      }
+      else
+      {
+        const sVec6& vp = arg_ws.v_.col(l.parent_);
+        const sVec6& ap = arg_ws.a_.col(l.parent_);
+        v.head<3>() = E*vp.head<3>();
+        v.tail<3>() = E*(vp.tail<3>() - r.cross(vp.head<3>()));
+        a.head<3>() = E*ap.head<3>();
+        a.tail<3>() = E*(ap.tail<3>() - r.cross(ap.head<3>()));
+
+        // v x (S dq), before adding S dq to v (the joint's own term is zero)
+        Eigen::Vector3d sdq(0,0,0); sdq(k) = dq;
+        if(l.revolute_)
+        { a.head<3>() += v.head<3>().cross(sdq); a.tail<3>() += v.tail<3>().cross(sdq); }
+        else
+        { a.tail<3>() += v.head<3>().cross(sdq); }
+      }
+      const scl::sUInt j = l.revolute_ ? k : k+3;
+      v(j) += dq;
+      a(j) += ddq;
+
+      // f = I a + v x* (I v)
+      const sVec6 h = l.I_ * v;
+      sVec6 f = l.I_ * a;
+      f.head<3>() += v.head<3>().cross(h.head<3>()) + v.tail<3>().cross(h.tail<3>());
+      f.tail<3>() += v.head<3>().cross(h.tail<3>());
+
+      arg_ws.v_.col(i) = v;
+      arg_ws.a_.col(i) = a;
+      arg_ws.f_.col(i) = f;
+    }
+
+    // Backward pass : Project the forces onto the joints and pass them on
+    // to the parents (f_parent += Xup' f).
+    for(std::size_t i=n; i-- > 0;)
+    {
+      const SIdLink& l = links_[i];
+      const sVec6& f = arg_ws.f_.col(i);
+      ret_fgc[l.gc_] = f(l.revolute_ ? l.axis_ : l.axis_+3);
+
+      if(0 <= l.parent_)
+      {
+        const Eigen::Matrix3d& E = arg_ws.E_[i];
+        const Eigen::Vector3d fl = E.transpose()*f.tail<3>();
+        arg_ws.f_.col(l.parent_).head<3>() += E.transpose()*f.head<3>() + arg_ws.r_.col(i).cross(fl);
+        arg_ws.f_.col(l.parent_).tail<3>() += fl;
+      }
+    }
+  }
+
+  scl::sBool CInverseDynamicsBatch::computeTorques(const Eigen::VectorXd& arg_q,
+      const Eigen::VectorXd& arg_dq, const Eigen::VectorXd& arg_ddq,
+      Eigen::VectorXd& ret_fgc)
+  {
+    if(false == has_been_init_) { return false; }
+    const Eigen::VectorXd::Index dof = static_cast<Eigen::VectorXd::Index>(links_.size());
+    if(arg_q.size() != dof || arg_dq.size() != dof || arg_ddq.size() != dof)
+    {
+      std::cerr<<"\nCInverseDynamicsBatch::computeTorques() : State vectors don't match the robot's dof";
+      return false;
+    }
+    if(ret_fgc.size() != dof) { ret_fgc.setZero(dof); }
+    rnea(ws_[0], arg_q.data(), arg_dq.data(), arg_ddq.data(), ret_fgc.data());
+    return true;
+  }
+
+  scl::sBool CInverseDynamicsBatch::computeBatch(const double* arg_rows,
+      const scl::sLongLong arg_n_rows, const scl::sUInt arg_row_doubles,
+      const scl::sUInt arg_offset_q, const scl::sUInt arg_offset_dq,
+      const scl::sUInt arg_offset_ddq, double* ret_fgc)
+  {
+    try
+    {
+      if(false == has_been_init_) { throw(std::runtime_error("Not initialized.")); }
+      if(S_NULL == arg_rows || S_NULL == ret_fgc) { throw(std::runtime_error("Passed NULL data.")); }
+      const scl::sUInt dof = static_cast<scl::sUInt>(links_.size());
+      if(arg_offset_q + dof > arg_row_doubles || arg_offset_dq + dof > arg_row_doubles ||
+          arg_offset_ddq + dof > arg_row_doubles)
+      { throw(std::runtime_error("The q, dq and ddq offsets don't fit in a row.")); }
+
+      const scl::sLongLong n_items = (arg_n_rows + SCL_ID_BATCH_GRAIN - 1)/SCL_ID_BATCH_GRAIN;
+      const int n_threads = static_cast<int>(ws_.size());
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads)
+      for(scl::sLongLong c=0; c<n_items; ++c)
+      {
+#ifdef _OPENMP
+        SIdWorkspace& w = ws_[omp_get_thread_num()];
+#else
+        SIdWorkspace& w = ws_[0];
+#endif
+        const scl::sLongLong i_end = std::min(arg_n_rows, (c+1)*SCL_ID_BATCH_GRAIN);
+        for(scl::sLongLong i=c*SCL_ID_BATCH_GRAIN; i<i_end; ++i)
+        {
+          const double* row = arg_rows + i*arg_row_doubles;
+          rnea(w, row+arg_offset_q, row+arg_offset_dq, row+arg_offset_ddq, ret_fgc + i*dof);
+        }
+      }
+      return true;
+    }
+    catch(std::exception& e)
+    { std::cerr<<"\nCInverseDynamicsBatch::computeBatch() : "<<e.what(); }
+    return false;
+  }
+
+  scl::sBool CInverseDynamicsBatch::processLog(const std::string& arg_file_in,
+      const std::string& arg_file_out, const scl::sUInt arg_chunk_rows,
+      SIdBatchStats* ret_stats)
+  {
+    FILE *fin = S_NULL, *fout = S_NULL;
+    // NOTE : The reader thread fills these. If a chunk fails, it is joined
+    // after the try block, so they have to live out here too.
+    std::vector<double> in[2], fgc, out;
+    std::size_t n_read[2] = {0, 0};
+    std::thread reader;
+    try
+    {
+      const std::chrono::steady_clock::time_point t_start = std::chrono::steady_clock::now();
+      double t_compute = 0;
+
+      if(false == has_been_init_) { throw(std::runtime_error("Not initialized.")); }
+      if(0 == arg_chunk_rows) { throw(std::runtime_error("Chunks need at least one row.")); }
+      const scl::sUInt dof = static_cast<scl::sUInt>(links_.size());
+
+      // 1. The input's schema and size
+      fin = fopen(arg_file_in.c_str(), "rb");
+      if(S_NULL == fin) { throw(std::runtime_error(std::string("Could not open : ")+arg_file_in)); }
+      std::vector<scl::SLogColumn> cols;
+      scl::sUInt row_doubles, header_bytes;
+      if(false == scl::CLoggerBinary::readHeader(fin, cols, row_doubles, header_bytes))
+      { throw(std::runtime_error(std::string("Could not read the log's header : ")+arg_file_in)); }
+
+      const scl::sInt off_q = findColumn(cols, "q", dof), off_dq = findColumn(cols, "dq", dof),
+          off_ddq = findColumn(cols, "ddq", dof), off_t = findColumn(cols, "t_sim", 1);
+      if(0 > off_q || 0 > off_dq || 0 > off_ddq)
+      { throw(std::runtime_error("The log doesn't have q, dq and ddq columns of the robot's dof.")); }
+
+      struct stat st;
+      if(0 != stat(arg_file_in.c_str(), &st)) { throw(std::runtime_error("Could not stat the log.")); }
+      const scl::sLongLong n_rows = (static_cast<scl::sLongLong>(st.st_size) - header_bytes)/
+          (static_cast<scl::sLongLong>(row_doubles)*sizeof(double)); // Ignores a partial last row
+
+      // 2. The output's schema
+      std::vector<scl::SLogColumn> cols_out;
+      scl::SLogColumn c;
+      if(0 <= off_t)
+      { c.name_ = "t_sim"; c.offset_ = 0; c.rows_ = 1; c.cols_ = 1; cols_out.push_back(c); }
+      c.name_ = "force_gc_id"; c.offset_ = (0 <= off_t) ? 1 : 0; c.rows_ = dof; c.cols_ = 1;
+      cols_out.push_back(c);
+      const scl::sUInt out_doubles = c.offset_ + dof;
+
+      fout = fopen(arg_file_out.c_str(), "wb");
+      if(S_NULL == fout) { throw(std::runtime_error(std::string("Could not open : ")+arg_file_out)); }
+      if(false == scl::CLoggerBinary::writeHeader(fout, cols_out))
+      { throw(std::runtime_error(std::string("Could not write the header : ")+arg_file_out)); }
+
+      // 3. Stream the chunks. Reads chunk i+1 while computing chunk i.
+      const std::size_t chunk = arg_chunk_rows;
+      in[0].resize(chunk*row_doubles); in[1].resize(chunk*row_doubles);
+      fgc.resize(chunk*dof); out.resize(chunk*out_doubles);
+
+      n_read[0] = fread(in[0].data(), row_doubles*sizeof(double), std::min<scl::sLongLong>(chunk, n_rows), fin);
+      scl::sLongLong rows_done = 0;
+      for(int b = 0; rows_done < n_rows; b = 1-b)
+      {
+        const std::size_t n_cur = n_read[b];
+        if(0 == n_cur) { throw(std::runtime_error("Could not read the log's rows.")); }
+
+        const scl::sLongLong n_next = std::min<scl::sLongLong>(chunk, n_rows - rows_done - n_cur);
+        if(0 < n_next)
+        {
+          double* buf = in[1-b].data();
+          std::size_t* ret = &n_read[1-b];
+          const std::size_t sz = row_doubles*sizeof(double);
+          reader = std::thread([=](){ *ret = fread(buf, sz, n_next, fin); });
+        }
+
+        const std::chrono::steady_clock::time_point t_c = std::chrono::steady_clock::now();
+        if(false == computeBatch(in[b].data(), n_cur, row_doubles, off_q, off_dq, off_ddq, fgc.data()))
+        { throw(std::runtime_error("Could not compute a chunk.")); }
+        t_compute += secondsSince(t_c);
+
+        const double* src = fgc.data();
+        if(0 <= off_t)
+        {// Interleave the times and forces
+          for(std::size_t i=0; i<n_cur; ++i)
+          {
+            out[i*out_doubles] = in[b][i*row_doubles + off_t];
+            std::copy(fgc.begin() + i*dof, fgc.begin() + (i+1)*dof, out.begin() + i*out_doubles + 1);
+          }
+          src = out.data();
+        }
+        if(n_cur != fwrite(src, out_doubles*sizeof(double), n_cur, fout))
+        { throw(std::runtime_error(std::string("Could not write to : ")+arg_file_out)); }
+        rows_done += n_cur;
+
+        if(reader.joinable()) { reader.join(); }
+      }
+
+      fclose(fin); fin = S_NULL;
+      if(0 != fclose(fout)) { fout = S_NULL; throw(std::runtime_error(std::string("Could not close : ")+arg_file_out)); }
+      fout = S_NULL;
+
+      if(S_NULL != ret_stats)
+      {
+        ret_stats->rows_ = rows_done;
+        ret_stats->t_total_ = secondsSince(t_start);
+        ret_stats->t_compute_ = t_compute;
+      }
+      return true;
+    }
+    catch(std::exception& e)
+    { std::cerr<<"\nCInverseDynamicsBatch::processLog() : "<<e.what(); }
+    if(reader.joinable()) { reader.join(); }
+    if(S_NULL != fin) { fclose(fin); }
+    if(S_NULL != fout) { fclose(fout); }
+    return false;
+  }
+}
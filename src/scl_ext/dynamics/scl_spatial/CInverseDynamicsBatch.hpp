@@ -0,0 +1,158 @@
+/* This file is part of scl, a control and simulation library
+for robots and biomechanical models.
+
+scl is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Alternatively, you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License, or (at your option) any later version.
+
+scl is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License and a copy of the GNU General Public License along with
+scl. If not, see <http://www.gnu.org/licenses/>.
+ */
+/* \file CInverseDynamicsBatch.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Copyright (C) 2026
+ *
+ *  Author: agent <agent@local>
+ */
+
+#ifndef CINVERSEDYNAMICSBATCH_HPP_
+#define CINVERSEDYNAMICSBATCH_HPP_
+
+#include <scl/DataTypes.hpp>
+#include <scl/data_structs/SRobotParsed.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include <string>
+#include <vector>
+
+namespace scl_ext
+{
+  /** Timing for a batch of inverse dynamics samples */
+  struct SIdBatchStats
+  {
+    scl::sLongLong rows_ = 0;      ///< Samples processed
+    scl::sFloat t_total_ = 0;      ///< Wall time (sec), including IO
+    scl::sFloat t_compute_ = 0;    ///< Wall time (sec) spent in the RNEA
+    /** Samples per second (wall time) */
+    scl::sFloat rate() const { return (t_total_ > 0) ? rows_/t_total_ : 0; }
+  };
+
+  /** Computes inverse dynamics (recursive Newton-Euler) for large batches
+   * of recorded robot states, eg. to estimate the torques that a logged
+   * trajectory needed.
+   *
+   * Uses the same spatial algebra as CDynamicsSclSpatial::inverseDynamicsNER,
+   * but flattens the robot's tree into arrays (parents first) once, and
+   * works on fixed size matrices. So a sample doesn't allocate, look up
+   * links by name or multiply 6x6 transforms.
+   *
+   * Samples are split across threads (OpenMP), with a workspace per
+   * thread. Log files are streamed in chunks : The next chunk is read
+   * while the threads work on the current one.
+   *
+   * Usage :
+   *   init() -> { computeTorques() | computeBatch() | processLog() } x n */
+  class CInverseDynamicsBatch
+  {
+  public:
+    /** Flattens the robot's tree. Creates one workspace per thread
+     * (0 threads : as many as OpenMP will run). */
+    scl::sBool init(const scl::SRobotParsed& arg_robot,
+        const scl::sUInt arg_threads=0);
+
+    /** The generalized forces required for one state (uses the first
+     * thread's workspace) */
+    scl::sBool computeTorques(const Eigen::VectorXd& arg_q,
+        const Eigen::VectorXd& arg_dq,
+        const Eigen::VectorXd& arg_ddq,
+        Eigen::VectorXd& ret_fgc);
+
+    /** The generalized forces for a batch of rows, in parallel.
+     *
+     * Row i starts at arg_rows + i*arg_row_doubles and holds q, dq and ddq
+     * (dof doubles each) at the given offsets. Writes dof doubles per row
+     * to ret_fgc (row i at ret_fgc + i*dof). */
+    scl::sBool computeBatch(const double* arg_rows,
+        const scl::sLongLong arg_n_rows,
+        const scl::sUInt arg_row_doubles,
+        const scl::sUInt arg_offset_q,
+        const scl::sUInt arg_offset_dq,
+        const scl::sUInt arg_offset_ddq,
+        double* ret_fgc);
+
+    /** Streams a binary log (see CLoggerBinary) with "q", "dq" and "ddq"
+     * columns through the solver, and writes a binary log with a
+     * "force_gc_id" column (and "t_sim", if the input has it). Row i of
+     * the output matches row i of the input. */
+    scl::sBool processLog(const std::string& arg_file_in,
+        const std::string& arg_file_out,
+        const scl::sUInt arg_chunk_rows=16384,
+        SIdBatchStats* ret_stats=S_NULL);
+
+    scl::sUInt getDof() const { return static_cast<scl::sUInt>(links_.size()); }
+    scl::sUInt getNumThreads() const { return static_cast<scl::sUInt>(ws_.size()); }
+    scl::sBool hasBeenInit() const { return has_been_init_; }
+
+    CInverseDynamicsBatch() : has_been_init_(false) {}
+
+  private:
+    /** A link in the flattened tree */
+    struct SIdLink
+    {
+      /** The parent's index in links_ (-1 if the parent is the root) */
+      scl::sInt parent_;
+      /** The link's gc (its link id) */
+      scl::sUInt gc_;
+      /** The joint's axis (0:x, 1:y, 2:z) */
+      scl::sUInt axis_;
+      scl::sBool revolute_;
+      /** The parent-to-link transform at q=0 (Xtree = rot(E) * xlt(r)) */
+      Eigen::Matrix3d E_;
+      Eigen::Vector3d r_;
+      /** The link's spatial inertia */
+      scl::sSpatialXForm I_;
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+
+    /** A thread's scratch space (one column / matrix per link) */
+    struct SIdWorkspace
+    {
+      /** The parent-to-link transforms at the current q */
+      std::vector<Eigen::Matrix3d> E_;
+      Eigen::Matrix3Xd r_;
+      /** Spatial velocities, accelerations and forces */
+      Eigen::Matrix<scl::sFloat,6,Eigen::Dynamic> v_, a_, f_;
+    };
+
+    /** The RNEA for one sample. Reads dof doubles from each of q, dq and
+     * ddq, and writes dof doubles to ret_fgc. */
+    void rnea(SIdWorkspace& arg_ws, const double* arg_q, const double* arg_dq,
+        const double* arg_ddq, double* ret_fgc) const;
+
+    std::vector<SIdLink, Eigen::aligned_allocator<SIdLink> > links_;
+    std::vector<SIdWorkspace> ws_;
+
+    /** Gravity (global coordinates) */
+    Eigen::Vector3d gravity_;
+
+    scl::sBool has_been_init_;
+  };
+}
+
+#endif /* CINVERSEDYNAMICSBATCH_HPP_ */